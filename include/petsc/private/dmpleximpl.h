@@ -95,6 +95,19 @@ struct _PetscGridHash {
   DMLabel      cellsSparse; /* Sparse storage for cell map */
 };
 
+typedef struct _n_DMPlexBVH *DMPlexBVH;
+struct _n_DMPlexBVH {
+  PetscInt         dim;
+  PetscInt         numNodes;       /* The number of nodes, the root is node 0 */
+  PetscReal       *box;            /* The lower and upper corners of the box of each node */
+  PetscInt        *child;          /* The first child of each node, the second child follows it, or -1 for a leaf */
+  PetscInt        *start;          /* The offset of the cells of each node in cells[] */
+  PetscInt        *size;           /* The number of cells of each node */
+  PetscInt        *cells;          /* The local cells, ordered so that the cells of each node are contiguous */
+  PetscObjectId    coordId[2];     /* The vertex and cellwise coordinates the hierarchy was built from */
+  PetscObjectState coordState[2];
+};
+
 typedef struct {
   PetscBool isotropic;               /* Is the metric isotropic? */
   PetscBool uniform;                 /* Is the metric uniform? */
@@ -226,6 +239,8 @@ typedef struct {
   PetscReal     minradius;                        /* Minimum distance from cell centroid to face */
   PetscBool     useHashLocation;                  /* Use grid hashing for point location */
   PetscGridHash lbox;                             /* Local box for searching */
+  PetscBool     useBVHLocation;                   /* Use a bounding volume hierarchy for point location */
+  DMPlexBVH     bvh;                              /* Bounding volume hierarchy over the local cells */
   void (*coordFunc)(PetscInt, PetscInt, PetscInt, /* Function used to remap newly introduced vertices */
                     const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
 
@@ -344,6 +359,7 @@ PETSC_EXTERN PetscErrorCode DMPlexAnchorsModifyMat(DM, PetscSection, PetscInt, P
 PETSC_EXTERN PetscErrorCode indicesPoint_private(PetscSection, PetscInt, PetscInt, PetscInt *, PetscBool, PetscInt, PetscInt[]);
 PETSC_EXTERN PetscErrorCode indicesPointFields_private(PetscSection, PetscInt, PetscInt, PetscInt[], PetscBool, PetscInt, PetscInt[]);
 PETSC_INTERN PetscErrorCode DMPlexLocatePoint_Internal(DM, PetscInt, const PetscScalar[], PetscInt, PetscInt *);
+PETSC_INTERN PetscErrorCode DMPlexBVHDestroy_Internal(DMPlexBVH *);
 /* these two are PETSC_EXTERN just because of src/dm/impls/plex/tests/ex18.c */
 PETSC_EXTERN PetscErrorCode DMPlexOrientInterface_Internal(DM);
 
@@ -787,8 +803,8 @@ PETSC_INTERN PetscErrorCode DMPlexGetIndicesPointFields_Internal(PetscSection, P
 PETSC_INTERN PetscErrorCode DMPlexGetTransitiveClosure_Internal(DM, PetscInt, PetscInt, PetscBool, PetscInt *, PetscInt *[]);
 
 PETSC_EXTERN PetscErrorCode DMPlexGetAllCells_Internal(DM, IS *);
-PETSC_EXTERN PetscErrorCode DMSNESGetFEGeom(DMField, IS, PetscQuadrature, PetscBool, PetscFEGeom **);
-PETSC_EXTERN PetscErrorCode DMSNESRestoreFEGeom(DMField, IS, PetscQuadrature, PetscBool, PetscFEGeom **);
+PETSC_EXTERN PetscErrorCode DMSNESGetFEGeom(DM, DMField, IS, PetscQuadrature, PetscBool, PetscFEGeom **);
+PETSC_EXTERN PetscErrorCode DMSNESRestoreFEGeom(DM, DMField, IS, PetscQuadrature, PetscBool, PetscFEGeom **);
 PETSC_EXTERN PetscErrorCode DMPlexComputeResidual_Patch_Internal(DM, PetscSection, IS, PetscReal, Vec, Vec, Vec, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Patch_Internal(DM, PetscSection, PetscSection, IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_INTERN PetscErrorCode DMCreateSubDomainDM_Plex(DM, DMLabel, PetscInt, IS *, DM *);
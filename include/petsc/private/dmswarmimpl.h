@@ -71,5 +71,6 @@ struct _p_DMSwarmSort {
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_Push_Basic(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMScatter(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMExact(DM, PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmMigrate_DMPlexNeighbor(DM, PetscBool);
 
 #endif /* _SWARMIMPL_H */
@@ -664,6 +664,10 @@ struct _p_MatFDColoring {
   PetscBool    fset;                              /* indicates that the initial function value F(X) is set */
   PetscErrorCode (*f)(void);                      /* function that defines Jacobian */
   void          *fctx;                            /* optional user-defined context for use by the function f */
+  PetscErrorCode (*fbatch)(void *, PetscInt, Vec[], Vec[], void *); /* function evaluating a block of colors at once */
+  void          *fbatchctx;                       /* optional user-defined context for use by the function fbatch */
+  PetscInt       nbatch;                          /* number of work vectors in w2b and w3b */
+  Vec           *w2b, *w3b;                       /* work vectors used by fbatch */
   Vec            vscale;                          /* holds FD scaling, i.e. 1/dx for each perturbed column */
   PetscInt       currentcolor;                    /* color for which function evaluation is being done now */
   const char    *htype;                           /* "wp" or "ds" */
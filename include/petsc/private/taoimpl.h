@@ -14,9 +14,11 @@ struct _TaoOps {
   /* Methods set by application */
   PetscErrorCode (*computeobjective)(Tao, Vec, PetscReal *, void *);
   PetscErrorCode (*computeobjectiveandgradient)(Tao, Vec, PetscReal *, Vec, void *);
+  PetscErrorCode (*computeobjectivebatch)(Tao, PetscInt, Vec[], PetscReal[], void *);
   PetscErrorCode (*computegradient)(Tao, Vec, Vec, void *);
   PetscErrorCode (*computehessian)(Tao, Vec, Mat, Mat, void *);
   PetscErrorCode (*computeresidual)(Tao, Vec, Vec, void *);
+  PetscErrorCode (*computeresidualbatch)(Tao, PetscInt, Vec[], Vec[], void *);
   PetscErrorCode (*computeresidualjacobian)(Tao, Vec, Mat, Mat, void *);
   PetscErrorCode (*computeconstraints)(Tao, Vec, Vec, void *);
   PetscErrorCode (*computeinequalityconstraints)(Tao, Vec, Vec, void *);
@@ -47,9 +49,11 @@ struct _p_Tao {
   void *user;
   void *user_objP;
   void *user_objgradP;
+  void *user_objbatchP;
   void *user_gradP;
   void *user_hessP;
   void *user_lsresP;
+  void *user_lsresbatchP;
   void *user_lsjacP;
   void *user_conP;
   void *user_con_equalityP;
@@ -261,6 +261,37 @@ struct _p_TS {
     PetscReal shift; /* The derivative of the lhs wrt to Xdot */
   } ijacobian;
 
+  /* Adaptive reuse of the Jacobian and preconditioner requested by the nonlinear solver, see TSSetJacobianReuse() */
+  struct {
+    PetscBool        enabled;
+    PetscBool        active;         /* set by SNESTSFormJacobian() while the integrator computes the Jacobian */
+    PetscBool        valid;          /* the matrices hold a Jacobian that may be reused */
+    PetscBool        rebuilt;        /* the preconditioner was rebuilt at the last request */
+    PetscReal        shift;          /* shift of the matrices */
+    PetscReal        time;           /* time at which the matrices were last evaluated or updated */
+    PetscReal        shift_tol;      /* relative change of the shift below which the matrices are reused as they are */
+    PetscReal        rate_tol;       /* nonlinear contraction rate above which the Jacobian is evaluated */
+    PetscReal        ksp_growth;     /* growth of the linear iterations above which the Jacobian is evaluated */
+    PetscInt         max_steps;      /* maximum number of steps between two evaluations */
+    PetscInt         step;           /* step at which the Jacobian was last evaluated */
+    PetscInt         snes_failures;  /* number of nonlinear solve failures at the last request */
+    PetscInt         snes_it;        /* nonlinear iteration and residual norm at the last request */
+    PetscReal        fnorm;
+    PetscInt         ksp_its;        /* linear iterations of the first solve after the preconditioner was rebuilt */
+    PetscObjectState Astate, Bstate; /* states of the matrices after the last request */
+    PetscInt         evals, shifts, reuses;
+  } jacreuse;
+
+  /* Split of the IJacobian into dF/dUdot and dF/dU, see TSSetIJacobianSplit() */
+  struct {
+    PetscBool        enabled;
+    Mat              M, K;  /* dF/dUdot and dF/dU */
+    MatStructure     str;   /* relation between the nonzero patterns of M, K and the preconditioning matrix */
+    PetscBool        owned; /* the split was assembled by the TS from the IJacobian */
+    PetscReal        shift; /* shift of the last formed matrix */
+    PetscObjectState Bstate;
+  } ijacsplit;
+
   MatStructure axpy_pattern; /* information about the nonzero pattern of the RHS Jacobian in reference to the implicit Jacobian */
   /* --------------------Nonlinear Iteration------------------------------*/
   SNES      snes;
@@ -29,7 +29,8 @@ typedef enum {
   DMSWARM_MIGRATE_BASIC = 0,
   DMSWARM_MIGRATE_DMCELLNSCATTER,
   DMSWARM_MIGRATE_DMCELLEXACT,
-  DMSWARM_MIGRATE_USER
+  DMSWARM_MIGRATE_USER,
+  DMSWARM_MIGRATE_DMPLEXNEIGHBOR
 } DMSwarmMigrateType;
 
 typedef enum {
@@ -90,6 +91,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmAddPoint(DM);
 PETSC_EXTERN PetscErrorCode DMSwarmAddNPoints(DM, PetscInt);
 PETSC_EXTERN PetscErrorCode DMSwarmRemovePoint(DM);
 PETSC_EXTERN PetscErrorCode DMSwarmRemovePointAtIndex(DM, PetscInt);
+PETSC_EXTERN PetscErrorCode DMSwarmRemovePoints(DM, PetscInt, const PetscInt[]);
+PETSC_EXTERN PetscErrorCode DMSwarmRemovePointsWithMask(DM, const PetscBool[]);
 PETSC_EXTERN PetscErrorCode DMSwarmCopyPoint(DM dm, PetscInt, PetscInt);
 
 PETSC_EXTERN PetscErrorCode DMSwarmGetLocalSize(DM, PetscInt *);
@@ -119,8 +122,10 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM, PetscInt, PetscInt *
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetNumberOfPointsPerCell(DM, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetIsValid(DM, PetscBool *);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMSwarmSortPoints(DM);
 
 PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM, PetscInt, const char **, Vec **, PetscBool);
+PETSC_EXTERN PetscErrorCode DMSwarmInterpolateFields(DM, PetscInt, const char *[], Vec[]);
 PETSC_EXTERN PetscErrorCode DMSwarmCreateMassMatrixSquare(DM, DM, Mat *);
 
 PETSC_EXTERN PetscErrorCode DMSwarmGetCellSwarm(DM, PetscInt, DM);
@@ -109,6 +109,7 @@ typedef const char *MatType;
 #define MATHYPRE                     "hypre"
 #define MATHYPRESTRUCT               "hyprestruct"
 #define MATHYPRESSTRUCT              "hypresstruct"
+#define MATSTENCIL                   "stencil"
 #define MATSUBMATRIX                 "submatrix"
 #define MATLOCALREF                  "localref"
 #define MATNEST                      "nest"
@@ -1666,6 +1667,7 @@ PETSC_EXTERN PetscErrorCode MatFDColoringDestroy(MatFDColoring *);
 PETSC_EXTERN PetscErrorCode MatFDColoringView(MatFDColoring, PetscViewer);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetFunction(MatFDColoring, PetscErrorCode (*)(void), void *);
 PETSC_EXTERN PetscErrorCode MatFDColoringGetFunction(MatFDColoring, PetscErrorCode (**)(void), void **);
+PETSC_EXTERN PetscErrorCode MatFDColoringSetBatchFunction(MatFDColoring, PetscErrorCode (*)(void *, PetscInt, Vec[], Vec[], void *), void *);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetParameters(MatFDColoring, PetscReal, PetscReal);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetFromOptions(MatFDColoring);
 PETSC_EXTERN PetscErrorCode MatFDColoringApply(Mat, MatFDColoring, Vec, void *);
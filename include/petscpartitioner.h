@@ -26,12 +26,13 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerFinalizePackage(void);
 .seealso: `PetscPartitionerSetType()`, `PetscPartitioner`
 J*/
 typedef const char *PetscPartitionerType;
-#define PETSCPARTITIONERPARMETIS "parmetis"
-#define PETSCPARTITIONERPTSCOTCH "ptscotch"
-#define PETSCPARTITIONERCHACO    "chaco"
-#define PETSCPARTITIONERSIMPLE   "simple"
-#define PETSCPARTITIONERSHELL    "shell"
-#define PETSCPARTITIONERGATHER   "gather"
+#define PETSCPARTITIONERPARMETIS  "parmetis"
+#define PETSCPARTITIONERPTSCOTCH  "ptscotch"
+#define PETSCPARTITIONERCHACO     "chaco"
+#define PETSCPARTITIONERSIMPLE    "simple"
+#define PETSCPARTITIONERSHELL     "shell"
+#define PETSCPARTITIONERGATHER    "gather"
+#define PETSCPARTITIONERDIFFUSION "diffusion"
 
 PETSC_EXTERN PetscFunctionList PetscPartitionerList;
 PETSC_EXTERN PetscErrorCode    PetscPartitionerRegister(const char[], PetscErrorCode (*)(PetscPartitioner));
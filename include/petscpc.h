@@ -135,6 +135,9 @@ PETSC_EXTERN PetscErrorCode PCSORSetOmega(PC, PetscReal);
 PETSC_EXTERN PetscErrorCode PCSORGetOmega(PC, PetscReal *);
 PETSC_EXTERN PetscErrorCode PCSORSetIterations(PC, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode PCSORGetIterations(PC, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode PCTBJacobiSetOmega(PC, PetscReal);
+PETSC_EXTERN PetscErrorCode PCTBJacobiSetIterations(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCTBJacobiSetBlocking(PC, PetscInt, PetscInt);
 
 PETSC_EXTERN PetscErrorCode PCEisenstatSetOmega(PC, PetscReal);
 PETSC_EXTERN PetscErrorCode PCEisenstatGetOmega(PC, PetscReal *);
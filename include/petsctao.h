@@ -296,6 +296,7 @@ PETSC_DEPRECATED_FUNCTION("Use TaoGetSolution() (since version 3.17)") static in
 
 PETSC_EXTERN PetscErrorCode TaoSetObjective(Tao, PetscErrorCode (*)(Tao, Vec, PetscReal *, void *), void *);
 PETSC_EXTERN PetscErrorCode TaoGetObjective(Tao, PetscErrorCode (**)(Tao, Vec, PetscReal *, void *), void **);
+PETSC_EXTERN PetscErrorCode TaoSetObjectiveBatch(Tao, PetscErrorCode (*)(Tao, PetscInt, Vec[], PetscReal[], void *), void *);
 PETSC_EXTERN PetscErrorCode TaoSetGradient(Tao, Vec, PetscErrorCode (*)(Tao, Vec, Vec, void *), void *);
 PETSC_EXTERN PetscErrorCode TaoGetGradient(Tao, Vec *, PetscErrorCode (**)(Tao, Vec, Vec, void *), void **);
 PETSC_EXTERN PetscErrorCode TaoSetObjectiveAndGradient(Tao, Vec, PetscErrorCode (*)(Tao, Vec, PetscReal *, Vec, void *), void *);
@@ -334,6 +335,7 @@ PETSC_EXTERN PetscErrorCode TaoLMVMGetH0(Tao, Mat *);
 PETSC_EXTERN PetscErrorCode TaoLMVMGetH0KSP(Tao, KSP *);
 PETSC_EXTERN PetscErrorCode TaoLMVMRecycle(Tao, PetscBool);
 PETSC_EXTERN PetscErrorCode TaoSetResidualRoutine(Tao, Vec, PetscErrorCode (*)(Tao, Vec, Vec, void *), void *);
+PETSC_EXTERN PetscErrorCode TaoSetResidualBatchRoutine(Tao, Vec, PetscErrorCode (*)(Tao, PetscInt, Vec[], Vec[], void *), void *);
 PETSC_EXTERN PetscErrorCode TaoSetResidualWeights(Tao, Vec, PetscInt, PetscInt *, PetscInt *, PetscReal *);
 PETSC_EXTERN PetscErrorCode TaoSetConstraintsRoutine(Tao, Vec, PetscErrorCode (*)(Tao, Vec, Vec, void *), void *);
 PETSC_EXTERN PetscErrorCode TaoSetInequalityConstraintsRoutine(Tao, Vec, PetscErrorCode (*)(Tao, Vec, Vec, void *), void *);
@@ -364,7 +366,9 @@ PETSC_DEPRECATED_FUNCTION("Use TaoSetResidualWeights() (since version 3.11)") st
 PETSC_EXTERN PetscErrorCode TaoSetStateDesignIS(Tao, IS, IS);
 
 PETSC_EXTERN PetscErrorCode TaoComputeObjective(Tao, Vec, PetscReal *);
+PETSC_EXTERN PetscErrorCode TaoComputeObjectiveBatch(Tao, PetscInt, Vec[], PetscReal[]);
 PETSC_EXTERN PetscErrorCode TaoComputeResidual(Tao, Vec, Vec);
+PETSC_EXTERN PetscErrorCode TaoComputeResidualBatch(Tao, PetscInt, Vec[], Vec[]);
 PETSC_EXTERN PetscErrorCode TaoTestGradient(Tao, Vec, Vec);
 PETSC_EXTERN PetscErrorCode TaoComputeGradient(Tao, Vec, Vec);
 PETSC_EXTERN PetscErrorCode TaoComputeObjectiveAndGradient(Tao, Vec, PetscReal *, Vec);
@@ -50,6 +50,8 @@ typedef const char *TSType;
 #define TSMPRK            "mprk"
 #define TSDISCGRAD        "discgrad"
 #define TSIRK             "irk"
+#define TSPARAREAL        "parareal"
+#define TSBATCH           "batch"
 
 /*E
     TSProblemType - Determines the type of problem this `TS` object is to be used to solve
@@ -438,6 +440,11 @@ PETSC_EXTERN PetscErrorCode TSGetStepRejections(TS, PetscInt *);
 PETSC_EXTERN PetscErrorCode TSSetMaxStepRejections(TS, PetscInt);
 PETSC_EXTERN PetscErrorCode TSGetSNESFailures(TS, PetscInt *);
 PETSC_EXTERN PetscErrorCode TSSetMaxSNESFailures(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSSetJacobianReuse(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSSetJacobianReuseTolerances(TS, PetscReal, PetscReal, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode TSGetJacobianReuseCounts(TS, PetscInt *, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode TSSetIJacobianSplit(TS, Mat, Mat, MatStructure);
+PETSC_EXTERN PetscErrorCode TSGetIJacobianSplit(TS, Mat *, Mat *);
 PETSC_EXTERN PetscErrorCode TSSetErrorIfStepFails(TS, PetscBool);
 PETSC_EXTERN PetscErrorCode TSRestartStep(TS);
 PETSC_EXTERN PetscErrorCode TSRollBack(TS);
@@ -880,6 +887,8 @@ PETSC_EXTERN PetscErrorCode TSRKSetType(TS, TSRKType);
 PETSC_EXTERN PetscErrorCode TSRKGetTableau(TS, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, PetscInt *, const PetscReal **, PetscBool *);
 PETSC_EXTERN PetscErrorCode TSRKSetMultirate(TS, PetscBool);
 PETSC_EXTERN PetscErrorCode TSRKGetMultirate(TS, PetscBool *);
+PETSC_EXTERN PetscErrorCode TSRKSetFused(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSRKGetFused(TS, PetscBool *);
 PETSC_EXTERN PetscErrorCode TSRKRegister(TSRKType, PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscReal[], const PetscReal[], PetscInt, const PetscReal[]);
 PETSC_EXTERN PetscErrorCode TSRKInitializePackage(void);
 PETSC_EXTERN PetscErrorCode TSRKFinalizePackage(void);
@@ -1016,6 +1025,7 @@ typedef const char *TSRosWType;
 PETSC_EXTERN PetscErrorCode TSRosWGetType(TS, TSRosWType *);
 PETSC_EXTERN PetscErrorCode TSRosWSetType(TS, TSRosWType);
 PETSC_EXTERN PetscErrorCode TSRosWSetRecomputeJacobian(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSRosWGetTableau(TS, PetscInt *, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **);
 PETSC_EXTERN PetscErrorCode TSRosWRegister(TSRosWType, PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscReal[], const PetscReal[], PetscInt, const PetscReal[]);
 PETSC_EXTERN PetscErrorCode TSRosWRegisterRos4(TSRosWType, PetscReal, PetscReal, PetscReal, PetscReal, PetscReal);
 PETSC_EXTERN PetscErrorCode TSRosWInitializePackage(void);
@@ -1056,6 +1066,25 @@ PETSC_EXTERN PetscErrorCode TSDiscGradSetFormulation(TS, PetscErrorCode (*)(TS,
 PETSC_EXTERN PetscErrorCode TSDiscGradIsGonzalez(TS, PetscBool *);
 PETSC_EXTERN PetscErrorCode TSDiscGradUseGonzalez(TS, PetscBool);
 
+PETSC_EXTERN PetscErrorCode TSPararealSetTimeCommunicator(TS, MPI_Comm);
+PETSC_EXTERN PetscErrorCode TSPararealGetFineTS(TS, TS *);
+PETSC_EXTERN PetscErrorCode TSPararealGetCoarseTS(TS, TS *);
+PETSC_EXTERN PetscErrorCode TSPararealSetNumSlices(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetCoarseningFactor(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetTolerances(TS, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetFCFRelaxation(TS, PetscBool);
+PETSC_EXTERN PetscErrorCode TSPararealGetIterationNumber(TS, PetscInt *);
+
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*TSBatchRHSFunction)(TS, PetscInt, const PetscReal[], const PetscScalar[], PetscScalar[], void *);
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*TSBatchRHSJacobian)(TS, PetscInt, const PetscReal[], const PetscScalar[], PetscScalar[], void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetSystemSize(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSBatchGetSystemSize(TS, PetscInt *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSFunction(TS, TSBatchRHSFunction, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSJacobian(TS, TSBatchRHSJacobian, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRKType(TS, TSRKType);
+PETSC_EXTERN PetscErrorCode TSBatchSetRosWType(TS, TSRosWType);
+PETSC_EXTERN PetscErrorCode TSBatchGetStepCounts(TS, PetscInt *, PetscInt *);
+
 /*
        PETSc interface to Sundials
 */
@@ -249,39 +249,55 @@ PetscErrorCode PetscFEGeomGetCellPoint(PetscFEGeom *geom, PetscInt c, PetscInt p
 
   Level: intermediate
 
+  Note:
+  If `isAffine` is set in geom, the derived quantities are computed at the first point of each cell and copied to the other points
+
 .seealso: `PetscFEGeom`, `PetscFEGeomCreate()`
 @*/
 PetscErrorCode PetscFEGeomComplete(PetscFEGeom *geom)
 {
-  PetscInt i, j, N, dE;
+  PetscInt i, j, N, Np, dE, stride;
 
   PetscFunctionBeginHot;
-  N  = geom->numPoints * geom->numCells;
+  Np = geom->numPoints;
+  N  = Np * geom->numCells;
   dE = geom->dimEmbed;
+  /* An affine map has the same Jacobian at every point of a cell, so only the first point of each cell is computed */
+  stride = geom->isAffine ? Np : 1;
   switch (dE) {
   case 3:
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += stride) {
       DMPlex_Det3D_Internal(&geom->detJ[i], &geom->J[dE * dE * i]);
       if (geom->invJ) DMPlex_Invert3D_Internal(&geom->invJ[dE * dE * i], &geom->J[dE * dE * i], geom->detJ[i]);
     }
     break;
   case 2:
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += stride) {
       DMPlex_Det2D_Internal(&geom->detJ[i], &geom->J[dE * dE * i]);
       if (geom->invJ) DMPlex_Invert2D_Internal(&geom->invJ[dE * dE * i], &geom->J[dE * dE * i], geom->detJ[i]);
     }
     break;
   case 1:
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += stride) {
       geom->detJ[i] = PetscAbsReal(geom->J[i]);
       if (geom->invJ) geom->invJ[i] = 1. / geom->J[i];
     }
     break;
   }
   if (geom->n) {
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += stride) {
       for (j = 0; j < dE; j++) geom->n[dE * i + j] = geom->J[dE * dE * i + dE * j + dE - 1] * ((dE == 2) ? -1. : 1.);
     }
   }
+  if (stride > 1) {
+    for (i = 0; i < N; i += stride) {
+      for (j = 1; j < Np; ++j) {
+        PetscCall(PetscArraycpy(&geom->J[dE * dE * (i + j)], &geom->J[dE * dE * i], dE * dE));
+        if (geom->invJ) PetscCall(PetscArraycpy(&geom->invJ[dE * dE * (i + j)], &geom->invJ[dE * dE * i], dE * dE));
+        if (geom->n) PetscCall(PetscArraycpy(&geom->n[dE * (i + j)], &geom->n[dE * i], dE));
+        geom->detJ[i + j] = geom->detJ[i];
+      }
+    }
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
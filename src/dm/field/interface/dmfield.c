@@ -494,9 +494,9 @@ PetscErrorCode DMFieldCreateFEGeom(DMField field, IS pointIS, PetscQuadrature qu
       for (j = 0; j < dE * dE; j++) g->J[i * dE * dE + j] = J[j];
     }
   }
-  PetscCall(PetscFEGeomComplete(g));
   PetscCall(DMFieldGetDegree(field, pointIS, NULL, &maxDegree));
   g->isAffine = (maxDegree <= 1) ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(PetscFEGeomComplete(g));
   if (faceData) PetscCall((*field->ops->computeFaceData)(field, pointIS, quad, g));
   *geom = g;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -283,6 +283,120 @@ PetscErrorCode DMDAGetCorners(DM da, PetscInt *x, PetscInt *y, PetscInt *z, Pets
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Owned box of the process shrunk on each side where the ghost box extends past it */
+static PetscErrorCode DMDAGetInteriorBox_Private(DM da, PetscInt lo[], PetscInt hi[], PetscInt olo[], PetscInt ohi[])
+{
+  PetscInt gs[3], gm[3], s[3], m[3];
+
+  PetscFunctionBegin;
+  PetscCall(DMDAGetCorners(da, &s[0], &s[1], &s[2], &m[0], &m[1], &m[2]));
+  PetscCall(DMDAGetGhostCorners(da, &gs[0], &gs[1], &gs[2], &gm[0], &gm[1], &gm[2]));
+  for (PetscInt d = 0; d < 3; ++d) {
+    olo[d] = s[d];
+    ohi[d] = s[d] + m[d];
+    lo[d]  = PetscMin(s[d] + (s[d] - gs[d]), ohi[d]);
+    hi[d]  = PetscMax(lo[d], ohi[d] - (gs[d] + gm[d] - ohi[d]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   DMDAGetInteriorCorners - Returns the global (x,y,z) indices of the lower left corner and size of the part of the local
+   region whose stencil contains no ghost points
+
+   Not collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameters:
++  x - the corner index for the first dimension
+.  y - the corner index for the second dimension (only used in 2D and 3D problems)
+.  z - the corner index for the third dimension (only used in 3D problems)
+.  m - the width in the first dimension
+.  n - the width in the second dimension (only used in 2D and 3D problems)
+-  p - the width in the third dimension (only used in 3D problems)
+
+  Level: intermediate
+
+   Notes:
+   These points can be computed from the values of a global vector, or of a local vector between `DMGlobalToLocalBegin()`
+   and `DMGlobalToLocalEnd()`, so that the computation hides the exchange of the ghost values. The remaining owned points
+   are given by `DMDAGetShellCorners()`.
+
+   The region is empty, with a zero width, when the local region is not wider than two stencil widths.
+   Any of y, z, n, and p can be passed in as NULL if not needed.
+
+.seealso: `DM`, `DMDA`, `DMDAGetCorners()`, `DMDAGetGhostCorners()`, `DMDAGetShellCorners()`, `DMDASNESSetFunctionLocalSplit()`
+@*/
+PetscErrorCode DMDAGetInteriorCorners(DM da, PetscInt *x, PetscInt *y, PetscInt *z, PetscInt *m, PetscInt *n, PetscInt *p)
+{
+  PetscInt lo[3], hi[3], olo[3], ohi[3];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscCall(DMDAGetInteriorBox_Private(da, lo, hi, olo, ohi));
+  if (x) *x = lo[0];
+  if (y) *y = lo[1];
+  if (z) *z = lo[2];
+  if (m) *m = hi[0] - lo[0];
+  if (n) *n = hi[1] - lo[1];
+  if (p) *p = hi[2] - lo[2];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   DMDAGetShellCorners - Returns the boxes covering the part of the local region whose stencil contains ghost points
+
+   Not collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameters:
++  nb - the number of boxes, at most 6
+-  corners - the corners and widths of the boxes, x, y, z, m, n, p for each box as returned by `DMDAGetCorners()`, an array of length at least 36
+
+  Level: intermediate
+
+   Note:
+   The boxes are disjoint and, together with the box of `DMDAGetInteriorCorners()`, cover the local region. Empty boxes
+   are not returned.
+
+.seealso: `DM`, `DMDA`, `DMDAGetCorners()`, `DMDAGetInteriorCorners()`, `DMDASNESSetFunctionLocalSplit()`
+@*/
+PetscErrorCode DMDAGetShellCorners(DM da, PetscInt *nb, PetscInt corners[])
+{
+  PetscInt lo[3], hi[3], olo[3], ohi[3];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscValidIntPointer(nb, 2);
+  PetscValidIntPointer(corners, 3);
+  PetscCall(DMDAGetInteriorBox_Private(da, lo, hi, olo, ohi));
+  *nb = 0;
+  /* Slabs below and above the interior along z over the whole box, then along y within the interior z range, then along x */
+  for (PetscInt d = 2; d >= 0; --d) {
+    for (PetscInt side = 0; side < 2; ++side) {
+      PetscInt blo[3], bhi[3];
+
+      for (PetscInt e = 0; e < 3; ++e) {
+        blo[e] = e < d ? olo[e] : lo[e];
+        bhi[e] = e < d ? ohi[e] : hi[e];
+      }
+      blo[d] = side ? hi[d] : olo[d];
+      bhi[d] = side ? ohi[d] : lo[d];
+      if (bhi[0] <= blo[0] || bhi[1] <= blo[1] || bhi[2] <= blo[2]) continue;
+      for (PetscInt e = 0; e < 3; ++e) {
+        corners[*nb * 6 + e]     = blo[e];
+        corners[*nb * 6 + 3 + e] = bhi[e] - blo[e];
+      }
+      ++*nb;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMGetLocalBoundingIndices_DMDA(DM dm, PetscReal lmin[], PetscReal lmax[])
 {
   DMDALocalInfo info;
@@ -0,0 +1,875 @@
+/*
+    Matrix for constant-stencil operators on a DMDA that stores only the coefficients of each row
+*/
+#include <petsc/private/matimpl.h>
+#include <petsc/private/dmdaimpl.h> /*I "petscdmda.h" I*/
+
+typedef struct {
+  DM                     da;
+  ISLocalToGlobalMapping ltog;
+  const PetscInt        *gidx;                         /* global block index of each ghosted point */
+  PetscInt               dim, bs, sw;                  /* dimension, dof per point, and stencil width */
+  DMDAStencilType        st;                           /* star or box stencil */
+  PetscInt               ns, center;                   /* number of stencil entries and the diagonal entry */
+  PetscInt              *offset;                       /* (di, dj, dk) of each stencil entry */
+  PetscInt              *entry;                        /* stencil entry of each offset in the (2 sw + 1)^3 box, or -1 */
+  PetscInt               xs, ys, zs, nx, ny, nz;       /* owned points */
+  PetscInt               gxs, gys, gzs, gnx, gny, gnz; /* ghosted points */
+  PetscInt               n;                            /* number of owned points */
+  PetscInt               M[3];
+  DMBoundaryType         bd[3];
+  PetscScalar           *a; /* coefficients in stencil-major layout, a[((e bs + r) bs + c) n + p] */
+  PetscInt              *rowcols;
+  PetscScalar           *rowvals;
+  PetscBool              getrowactive;
+
+  /* MatStencilJacobi() works on a copy of the operator extended by a halo of width wdepth * sw */
+  DM               wda, cda;       /* DMDAs with the wide halo for the vectors and for the coefficients */
+  PetscInt         wdepth, maxdepth;
+  PetscObjectState wstate;
+  PetscInt         W[3], Wn[3], nw; /* wide ghosted points */
+  PetscScalar     *aw, *dw;         /* coefficients and inverse diagonal on the wide box */
+  PetscScalar     *wbuf, *wtmp;     /* 2 sw + 1 planes for each intermediate sweep, and one line */
+} Mat_Stencil;
+
+/*MC
+   MATSTENCIL - MATSTENCIL = "stencil" - A matrix type for operators on a `DMDA` with the same stencil at every grid point.
+
+   Level: intermediate
+
+   Notes:
+   Only the coefficients are stored, one array per stencil entry (and per pair of components when there are several
+   degrees of freedom per grid point) ordered like the locally owned grid points. The column of each coefficient is
+   computed from the grid point (i, j, k) and the fixed offset of the stencil entry, so no column indices are stored.
+   This roughly halves the memory traffic of `MatMult()` compared to `MATAIJ`, and the inner loops of `MatMult()` and
+   `MatGetDiagonal()` run over contiguous arrays.
+
+   The stencil is the one of the `DMDA`, `DMDA_STENCIL_STAR` or `DMDA_STENCIL_BOX` with its stencil width; the blocks
+   coupling the degrees of freedom of two grid points are dense, `DMDASetBlockFills()` is ignored.
+
+   The matrix is obtained with `DMCreateMatrix()` after `DMSetMatType`(da, `MATSTENCIL`) or with -dm_mat_type stencil,
+   or with `MatCreate()` followed by `MatSetDM()`. Values can be set with `MatSetValuesStencil()`, `MatSetValuesLocal()`
+   or `MatSetValues()`, only into locally owned rows.
+
+   `MatSOR()` performs local sweeps, ghost values are updated once per outer iteration as for `MATMPIAIJ`. For
+   factorizations or algebraic multigrid convert the matrix with `MatConvert()` to `MATAIJ`. `MatStencilJacobi()`, used
+   by `PCTBJACOBI`, fuses several Jacobi sweeps between two ghost exchanges.
+
+.seealso: `DMDA`, `DMCreateMatrix()`, `DMSetMatType()`, `MatSetValuesStencil()`, `MatStencilJacobi()`, `MATAIJ`, `MATHYPRESTRUCT`
+M*/
+
+/* Returns the ghosted point of (i, j, k) + d, or -1 if it is not on this process. A periodic image of an owned point
+   is mapped to the owned point itself so that updates to it are seen, as when the matrix is assembled. */
+static inline PetscInt MatStencilGetNeighbor_Private(const Mat_Stencil *ms, PetscInt i, PetscInt j, PetscInt k, const PetscInt d[])
+{
+  const PetscInt lo[3] = {ms->gxs, ms->gys, ms->gzs}, hi[3] = {ms->gxs + ms->gnx, ms->gys + ms->gny, ms->gzs + ms->gnz};
+  const PetscInt olo[3] = {ms->xs, ms->ys, ms->zs}, ohi[3] = {ms->xs + ms->nx, ms->ys + ms->ny, ms->zs + ms->nz};
+  PetscInt       q[3]   = {i + d[0], j + d[1], k + d[2]}, dd;
+
+  for (dd = 0; dd < 3; ++dd) {
+    if (q[dd] < lo[dd] || q[dd] >= hi[dd]) return -1;
+    if (ms->bd[dd] == DM_BOUNDARY_PERIODIC && (q[dd] < olo[dd] || q[dd] >= ohi[dd])) {
+      const PetscInt w = ((q[dd] % ms->M[dd]) + ms->M[dd]) % ms->M[dd];
+
+      if (w >= olo[dd] && w < ohi[dd]) q[dd] = w;
+    }
+  }
+  return ((q[2] - ms->gzs) * ms->gny + (q[1] - ms->gys)) * ms->gnx + (q[0] - ms->gxs);
+}
+
+/* Rows and columns are ghosted local indices, as in MatSetValuesLocal() */
+static PetscErrorCode MatSetValuesLocal_Stencil(Mat A, PetscInt nrow, const PetscInt irow[], PetscInt ncol, const PetscInt icol[], const PetscScalar y[], InsertMode addv)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  const PetscInt bs = ms->bs, sw = ms->sw, w = 2 * ms->sw + 1;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < nrow; ++i) {
+    PetscInt rq, r, rc[3], p;
+
+    if (irow[i] < 0) continue;
+    rq    = irow[i] / bs;
+    r     = irow[i] % bs;
+    rc[0] = ms->gxs + rq % ms->gnx;
+    rc[1] = ms->gys + (rq / ms->gnx) % ms->gny;
+    rc[2] = ms->gzs + rq / (ms->gnx * ms->gny);
+    PetscCheck(rc[0] >= ms->xs && rc[0] < ms->xs + ms->nx && rc[1] >= ms->ys && rc[1] < ms->ys + ms->ny && rc[2] >= ms->zs && rc[2] < ms->zs + ms->nz, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Row %" PetscInt_FMT " is not locally owned, only local rows can be set in a MATSTENCIL matrix", irow[i]);
+    p = ((rc[2] - ms->zs) * ms->ny + (rc[1] - ms->ys)) * ms->nx + (rc[0] - ms->xs);
+    for (PetscInt j = 0; j < ncol; ++j) {
+      PetscInt     cq, c, d[3], e;
+      PetscScalar *v;
+
+      if (icol[j] < 0) continue;
+      cq   = icol[j] / bs;
+      c    = icol[j] % bs;
+      d[0] = ms->gxs + cq % ms->gnx - rc[0];
+      d[1] = ms->gys + (cq / ms->gnx) % ms->gny - rc[1];
+      d[2] = ms->gzs + cq / (ms->gnx * ms->gny) - rc[2];
+      for (PetscInt dd = 0; dd < 3; ++dd) {
+        if (ms->bd[dd] == DM_BOUNDARY_PERIODIC) {
+          if (d[dd] > sw) d[dd] -= ms->M[dd];
+          else if (d[dd] < -sw) d[dd] += ms->M[dd];
+        }
+        PetscCheck(PetscAbsInt(d[dd]) <= sw, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Local row %" PetscInt_FMT " local column %" PetscInt_FMT " are farther apart than the stencil width %" PetscInt_FMT, irow[i], icol[j], sw);
+      }
+      e = ms->entry[((d[2] + sw) * w + d[1] + sw) * w + d[0] + sw];
+      PetscCheck(e >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Local row %" PetscInt_FMT " local column %" PetscInt_FMT " is not in the %s stencil", irow[i], icol[j], ms->st == DMDA_STENCIL_STAR ? "star" : "box");
+      v = &ms->a[((e * bs + r) * bs + c) * ms->n + p];
+      if (addv == ADD_VALUES) *v += y[i * ncol + j];
+      else *v = y[i * ncol + j];
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSetValues_Stencil(Mat A, PetscInt nrow, const PetscInt irow[], PetscInt ncol, const PetscInt icol[], const PetscScalar y[], InsertMode addv)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+  PetscInt    *lrow, *lcol, *bcol, rstart, rend, nout;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(PetscMalloc3(nrow, &lrow, ncol, &lcol, ncol, &bcol));
+  for (PetscInt i = 0; i < nrow; ++i) {
+    PetscInt p;
+
+    if (irow[i] < 0) {
+      lrow[i] = -1;
+      continue;
+    }
+    PetscCheck(irow[i] >= rstart && irow[i] < rend, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Row %" PetscInt_FMT " is not locally owned, only local rows can be set in a MATSTENCIL matrix", irow[i]);
+    p       = (irow[i] - rstart) / ms->bs;
+    lrow[i] = ((ms->zs + p / (ms->nx * ms->ny) - ms->gzs) * ms->gny + (ms->ys + (p / ms->nx) % ms->ny - ms->gys)) * ms->gnx + (ms->xs + p % ms->nx - ms->gxs);
+    lrow[i] = lrow[i] * ms->bs + (irow[i] - rstart) % ms->bs;
+  }
+  for (PetscInt j = 0; j < ncol; ++j) bcol[j] = icol[j] < 0 ? -1 : icol[j] / ms->bs;
+  PetscCall(ISGlobalToLocalMappingApplyBlock(ms->ltog, IS_GTOLM_MASK, ncol, bcol, &nout, bcol));
+  for (PetscInt j = 0; j < ncol; ++j) {
+    PetscCheck(icol[j] < 0 || bcol[j] >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Column %" PetscInt_FMT " is not in the stencil of any local row", icol[j]);
+    lcol[j] = icol[j] < 0 ? -1 : bcol[j] * ms->bs + icol[j] % ms->bs;
+  }
+  PetscCall(MatSetValuesLocal_Stencil(A, nrow, lrow, ncol, lcol, y, addv));
+  PetscCall(PetscFree3(lrow, lcol, bcol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetRow_Stencil(Mat A, PetscInt row, PetscInt *nz, PetscInt **idx, PetscScalar **v)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  const PetscInt bs = ms->bs;
+  PetscInt       rstart, p, r, i, j, k, cnt = 0;
+
+  PetscFunctionBegin;
+  PetscCheck(!ms->getrowactive, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Already active");
+  ms->getrowactive = PETSC_TRUE;
+  PetscCall(MatGetOwnershipRange(A, &rstart, NULL));
+  p = (row - rstart) / bs;
+  r = (row - rstart) % bs;
+  i = ms->xs + p % ms->nx;
+  j = ms->ys + (p / ms->nx) % ms->ny;
+  k = ms->zs + p / (ms->nx * ms->ny);
+  for (PetscInt e = 0; e < ms->ns; ++e) {
+    const PetscInt q = MatStencilGetNeighbor_Private(ms, i, j, k, &ms->offset[e * 3]);
+
+    if (q < 0) continue;
+    for (PetscInt c = 0; c < bs; ++c, ++cnt) {
+      ms->rowcols[cnt] = ms->gidx[q] * bs + c;
+      ms->rowvals[cnt] = ms->a[((e * bs + r) * bs + c) * ms->n + p];
+    }
+  }
+  if (nz) *nz = cnt;
+  if (idx) *idx = ms->rowcols;
+  if (v) *v = ms->rowvals;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatRestoreRow_Stencil(Mat A, PetscInt row, PetscInt *nz, PetscInt **idx, PetscScalar **v)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+
+  PetscFunctionBegin;
+  ms->getrowactive = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_Stencil(Mat A, Vec x, Vec z, Vec y)
+{
+  Mat_Stencil       *ms = (Mat_Stencil *)A->data;
+  const PetscInt     bs = ms->bs, n = ms->n;
+  const PetscScalar *xl;
+  PetscScalar       *yy;
+  Vec                xlocal;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetLocalVector(ms->da, &xlocal));
+  PetscCall(DMGlobalToLocalBegin(ms->da, x, INSERT_VALUES, xlocal));
+  PetscCall(DMGlobalToLocalEnd(ms->da, x, INSERT_VALUES, xlocal));
+  if (!z) PetscCall(VecSet(y, 0.0));
+  else if (z != y) PetscCall(VecCopy(z, y));
+  PetscCall(VecGetArrayRead(xlocal, &xl));
+  PetscCall(VecGetArray(y, &yy));
+  /* Apply all stencil entries to one grid line at a time, so that the line of y stays in cache */
+  for (PetscInt k = ms->zs; k < ms->zs + ms->nz; ++k) {
+    for (PetscInt j = ms->ys; j < ms->ys + ms->ny; ++j) {
+      const PetscInt p0 = ((k - ms->zs) * ms->ny + (j - ms->ys)) * ms->nx - ms->xs;
+
+      for (PetscInt e = 0; e < ms->ns; ++e) {
+        const PetscInt di = ms->offset[e * 3], dj = ms->offset[e * 3 + 1], dk = ms->offset[e * 3 + 2];
+        const PetscInt ilo = PetscMax(ms->xs, ms->gxs - di), ihi = PetscMin(ms->xs + ms->nx, ms->gxs + ms->gnx - di);
+        PetscInt       q0;
+
+        if (j + dj < ms->gys || j + dj >= ms->gys + ms->gny || k + dk < ms->gzs || k + dk >= ms->gzs + ms->gnz || ihi <= ilo) continue;
+        q0 = ((k + dk - ms->gzs) * ms->gny + (j + dj - ms->gys)) * ms->gnx + (ilo + di - ms->gxs);
+        if (bs == 1) {
+          const PetscScalar *ae = &ms->a[e * n + p0 + ilo], *xe = &xl[q0];
+          PetscScalar       *ye = &yy[p0 + ilo];
+
+          PetscPragmaSIMD
+          for (PetscInt i = 0; i < ihi - ilo; ++i) ye[i] += ae[i] * xe[i];
+        } else {
+          for (PetscInt r = 0; r < bs; ++r) {
+            for (PetscInt c = 0; c < bs; ++c) {
+              const PetscScalar *ae = &ms->a[((e * bs + r) * bs + c) * n + p0 + ilo], *xe = &xl[q0 * bs + c];
+              PetscScalar       *ye = &yy[(p0 + ilo) * bs + r];
+
+              PetscPragmaSIMD
+              for (PetscInt i = 0; i < ihi - ilo; ++i) ye[i * bs] += ae[i] * xe[i * bs];
+            }
+          }
+        }
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(y, &yy));
+  PetscCall(VecRestoreArrayRead(xlocal, &xl));
+  PetscCall(DMRestoreLocalVector(ms->da, &xlocal));
+  PetscCall(PetscLogFlops(2.0 * ms->ns * bs * bs * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_Stencil(Mat A, Vec x, Vec y)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_Stencil(A, x, NULL, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetDiagonal_Stencil(Mat A, Vec d)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  const PetscInt bs = ms->bs, n = ms->n;
+  PetscScalar   *dd;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayWrite(d, &dd));
+  for (PetscInt r = 0; r < bs; ++r) {
+    const PetscScalar *ae = &ms->a[((ms->center * bs + r) * bs + r) * n];
+
+    PetscPragmaSIMD
+    for (PetscInt p = 0; p < n; ++p) dd[p * bs + r] = ae[p];
+  }
+  PetscCall(VecRestoreArrayWrite(d, &dd));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Relaxes all rows of the grid point (i, j, k) in place in the ghosted array xl */
+static inline PetscErrorCode MatSORPoint_Stencil_Private(const Mat_Stencil *ms, PetscInt i, PetscInt j, PetscInt k, PetscBool forward, const PetscScalar b[], PetscReal omega, PetscReal fshift, PetscScalar xl[])
+{
+  const PetscInt bs = ms->bs, n = ms->n;
+  const PetscInt p = ((k - ms->zs) * ms->ny + (j - ms->ys)) * ms->nx + (i - ms->xs);
+  const PetscInt q = ((k - ms->gzs) * ms->gny + (j - ms->gys)) * ms->gnx + (i - ms->gxs);
+
+  PetscFunctionBegin;
+  for (PetscInt rr = 0; rr < bs; ++rr) {
+    const PetscInt    r    = forward ? rr : bs - 1 - rr;
+    const PetscScalar diag = ms->a[((ms->center * bs + r) * bs + r) * n + p] + fshift;
+    PetscScalar       sum  = b[p * bs + r];
+
+    PetscCheck(PetscAbsScalar(diag) != 0.0, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "Zero diagonal on row %" PetscInt_FMT, p * bs + r);
+    for (PetscInt e = 0; e < ms->ns; ++e) {
+      const PetscInt qe = MatStencilGetNeighbor_Private(ms, i, j, k, &ms->offset[e * 3]);
+
+      if (qe < 0) continue;
+      for (PetscInt c = 0; c < bs; ++c) {
+        if (qe == q && c == r) continue;
+        sum -= ms->a[((e * bs + r) * bs + c) * n + p] * xl[qe * bs + c];
+      }
+    }
+    xl[q * bs + r] = (1. - omega) * xl[q * bs + r] + omega * sum / diag;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSOR_Stencil(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_Stencil       *ms = (Mat_Stencil *)A->data;
+  const PetscInt     bs = ms->bs;
+  const PetscScalar *b;
+  PetscScalar       *x, *xl;
+  Vec                xlocal;
+  PetscMPIInt        size;
+
+  PetscFunctionBegin;
+  PetscCheck(!(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "Only forward, backward and symmetric sweeps are supported");
+  PetscCheck(its > 0 && lits > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Relaxation requires global its %" PetscInt_FMT " and local its %" PetscInt_FMT " both positive", its, lits);
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)A), &size));
+  if (size > 1) PetscCheck(!(flag & SOR_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "Parallel SOR not supported");
+  PetscCall(DMGetLocalVector(ms->da, &xlocal));
+  PetscCall(VecGetArrayRead(bb, &b));
+  for (PetscInt it = 0; it < its; ++it) {
+    if (!it && (flag & SOR_ZERO_INITIAL_GUESS)) PetscCall(VecSet(xlocal, 0.0));
+    else {
+      PetscCall(DMGlobalToLocalBegin(ms->da, xx, INSERT_VALUES, xlocal));
+      PetscCall(DMGlobalToLocalEnd(ms->da, xx, INSERT_VALUES, xlocal));
+    }
+    PetscCall(VecGetArray(xlocal, &xl));
+    for (PetscInt l = 0; l < lits; ++l) {
+      if (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) {
+        for (PetscInt k = ms->zs; k < ms->zs + ms->nz; ++k)
+          for (PetscInt j = ms->ys; j < ms->ys + ms->ny; ++j)
+            for (PetscInt i = ms->xs; i < ms->xs + ms->nx; ++i) PetscCall(MatSORPoint_Stencil_Private(ms, i, j, k, PETSC_TRUE, b, omega, fshift, xl));
+      }
+      if (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) {
+        for (PetscInt k = ms->zs + ms->nz - 1; k >= ms->zs; --k)
+          for (PetscInt j = ms->ys + ms->ny - 1; j >= ms->ys; --j)
+            for (PetscInt i = ms->xs + ms->nx - 1; i >= ms->xs; --i) PetscCall(MatSORPoint_Stencil_Private(ms, i, j, k, PETSC_FALSE, b, omega, fshift, xl));
+      }
+    }
+    /* Copy the owned part back, line by line */
+    PetscCall(VecGetArray(xx, &x));
+    for (PetscInt k = ms->zs; k < ms->zs + ms->nz; ++k) {
+      for (PetscInt j = ms->ys; j < ms->ys + ms->ny; ++j) {
+        const PetscInt p = ((k - ms->zs) * ms->ny + (j - ms->ys)) * ms->nx;
+        const PetscInt q = ((k - ms->gzs) * ms->gny + (j - ms->gys)) * ms->gnx + (ms->xs - ms->gxs);
+
+        PetscCall(PetscArraycpy(&x[p * bs], &xl[q * bs], ms->nx * bs));
+      }
+    }
+    PetscCall(VecRestoreArray(xx, &x));
+    PetscCall(VecRestoreArray(xlocal, &xl));
+  }
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(DMRestoreLocalVector(ms->da, &xlocal));
+  PetscCall(PetscLogFlops(2.0 * its * lits * ms->ns * bs * bs * ms->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Creates a DMDA with the layout of the one of the matrix, dof components per point and a box halo of the given width */
+static PetscErrorCode MatStencilCreateWideDMDA_Private(Mat_Stencil *ms, PetscInt dof, PetscInt width, DM *wda)
+{
+  const PetscInt *lx, *ly, *lz;
+  PetscInt        m, n, p;
+
+  PetscFunctionBegin;
+  PetscCall(DMDAGetInfo(ms->da, NULL, NULL, NULL, NULL, &m, &n, &p, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetOwnershipRanges(ms->da, &lx, &ly, &lz));
+  PetscCall(DMDACreate(PetscObjectComm((PetscObject)ms->da), wda));
+  PetscCall(DMSetDimension(*wda, ms->dim));
+  PetscCall(DMDASetSizes(*wda, ms->M[0], ms->M[1], ms->M[2]));
+  PetscCall(DMDASetNumProcs(*wda, m, n, p));
+  PetscCall(DMDASetOwnershipRanges(*wda, lx, ly, lz));
+  PetscCall(DMDASetBoundaryType(*wda, ms->bd[0], ms->bd[1], ms->bd[2]));
+  PetscCall(DMDASetDof(*wda, dof));
+  PetscCall(DMDASetStencilType(*wda, DMDA_STENCIL_BOX));
+  PetscCall(DMDASetStencilWidth(*wda, width));
+  PetscCall(DMSetUp(*wda));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Sets up the halo of width depth * sw and copies the coefficients of the rows in the halo, if the matrix changed */
+static PetscErrorCode MatStencilSetUpWide_Private(Mat A, PetscInt depth)
+{
+  Mat_Stencil     *ms = (Mat_Stencil *)A->data;
+  const PetscInt   bs = ms->bs, nc = ms->ns * bs * bs;
+  PetscObjectState state;
+  Vec              cg, cl;
+  PetscScalar     *c;
+  PetscInt         P;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (depth == ms->wdepth && state == ms->wstate) PetscFunctionReturn(PETSC_SUCCESS);
+  if (depth != ms->wdepth) {
+    PetscCall(DMDestroy(&ms->wda));
+    PetscCall(DMDestroy(&ms->cda));
+    PetscCall(PetscFree2(ms->aw, ms->dw));
+    PetscCall(PetscFree2(ms->wbuf, ms->wtmp));
+    PetscCall(MatStencilCreateWideDMDA_Private(ms, bs, depth * ms->sw, &ms->wda));
+    PetscCall(MatStencilCreateWideDMDA_Private(ms, nc, depth * ms->sw, &ms->cda));
+    PetscCall(DMDAGetGhostCorners(ms->wda, &ms->W[0], &ms->W[1], &ms->W[2], &ms->Wn[0], &ms->Wn[1], &ms->Wn[2]));
+    for (PetscInt d = ms->dim; d < 3; ++d) {
+      ms->W[d]  = 0;
+      ms->Wn[d] = 1;
+    }
+    ms->nw = ms->Wn[0] * ms->Wn[1] * ms->Wn[2];
+    P      = ms->dim == 3 ? ms->Wn[0] * ms->Wn[1] : (ms->dim == 2 ? ms->Wn[0] : 1);
+    PetscCall(PetscMalloc2(nc * ms->nw, &ms->aw, bs * ms->nw, &ms->dw));
+    PetscCall(PetscMalloc2((depth - 1) * (2 * ms->sw + 1) * P * bs, &ms->wbuf, ms->Wn[0] * bs, &ms->wtmp));
+    ms->wdepth = depth;
+  }
+  /* Exchange the coefficients point by point, then go back to the stencil-major layout */
+  PetscCall(DMGetGlobalVector(ms->cda, &cg));
+  PetscCall(DMGetLocalVector(ms->cda, &cl));
+  PetscCall(VecGetArrayWrite(cg, &c));
+  for (PetscInt m = 0; m < nc; ++m)
+    for (PetscInt p = 0; p < ms->n; ++p) c[p * nc + m] = ms->a[m * ms->n + p];
+  PetscCall(VecRestoreArrayWrite(cg, &c));
+  PetscCall(DMGlobalToLocalBegin(ms->cda, cg, INSERT_VALUES, cl));
+  PetscCall(DMGlobalToLocalEnd(ms->cda, cg, INSERT_VALUES, cl));
+  PetscCall(VecGetArray(cl, &c));
+  for (PetscInt m = 0; m < nc; ++m)
+    for (PetscInt p = 0; p < ms->nw; ++p) ms->aw[m * ms->nw + p] = c[p * nc + m];
+  PetscCall(VecRestoreArray(cl, &c));
+  PetscCall(DMRestoreLocalVector(ms->cda, &cl));
+  PetscCall(DMRestoreGlobalVector(ms->cda, &cg));
+  for (PetscInt r = 0; r < bs; ++r) {
+    const PetscScalar *ae = &ms->aw[((ms->center * bs + r) * bs + r) * ms->nw];
+
+    for (PetscInt p = 0; p < ms->nw; ++p) ms->dw[p * bs + r] = ae[p] != 0.0 ? 1.0 / ae[p] : 0.0;
+  }
+  ms->wstate = state;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline PetscInt MatStencilWideIndex_Private(const Mat_Stencil *ms, PetscInt i, PetscInt j, PetscInt k)
+{
+  return ((k - ms->W[2]) * ms->Wn[1] + (j - ms->W[1])) * ms->Wn[0] + (i - ms->W[0]);
+}
+
+/* The values of point (i, j, k) after t sweeps; intermediate sweeps keep a window of 2 sw + 1 planes along the last axis */
+static inline PetscScalar *MatStencilSweepValues_Private(const Mat_Stencil *ms, PetscInt t, PetscScalar *x0, PetscInt i, PetscInt j, PetscInt k)
+{
+  const PetscInt a  = ms->dim - 1, q = a == 2 ? k : (a == 1 ? j : i);
+  const PetscInt P  = a == 2 ? ms->Wn[0] * ms->Wn[1] : (a == 1 ? ms->Wn[0] : 1);
+  const PetscInt nq = 2 * ms->sw + 1;
+
+  if (!t) return &x0[MatStencilWideIndex_Private(ms, i, j, k) * ms->bs];
+  return &ms->wbuf[(((t - 1) * nq + (q - ms->W[a]) % nq) * P + MatStencilWideIndex_Private(ms, i, j, k) - (q - ms->W[a]) * P) * ms->bs];
+}
+
+/* Sweep t of damped Jacobi on the points [ilo, ihi) of line (j, k), the last sweep writes into the owned array x */
+static inline void MatStencilJacobiLine_Private(const Mat_Stencil *ms, PetscInt t, PetscInt nt, PetscInt j, PetscInt k, PetscInt ilo, PetscInt ihi, PetscReal omega, const PetscScalar *bw, PetscScalar *x0, PetscScalar *x)
+{
+  const PetscInt     bs = ms->bs, nw = ms->nw, len = (ihi - ilo) * bs, p0 = MatStencilWideIndex_Private(ms, ilo, j, k);
+  const PetscScalar *xc = MatStencilSweepValues_Private(ms, t - 1, x0, ilo, j, k), *dw = &ms->dw[p0 * bs];
+  PetscScalar       *tmp = ms->wtmp, *y;
+
+  for (PetscInt i = 0; i < len; ++i) tmp[i] = bw[p0 * bs + i];
+  for (PetscInt e = 0; e < ms->ns; ++e) {
+    const PetscInt di = ms->offset[e * 3], dj = ms->offset[e * 3 + 1], dk = ms->offset[e * 3 + 2];
+    const PetscInt elo = PetscMax(ilo, ms->W[0] - di), ehi = PetscMin(ihi, ms->W[0] + ms->Wn[0] - di);
+    PetscScalar   *xe;
+
+    if (j + dj < ms->W[1] || j + dj >= ms->W[1] + ms->Wn[1] || k + dk < ms->W[2] || k + dk >= ms->W[2] + ms->Wn[2] || ehi <= elo) continue;
+    xe = MatStencilSweepValues_Private(ms, t - 1, x0, elo + di, j + dj, k + dk);
+    for (PetscInt r = 0; r < bs; ++r) {
+      for (PetscInt c = 0; c < bs; ++c) {
+        const PetscScalar *ae = &ms->aw[((e * bs + r) * bs + c) * nw + p0 + elo - ilo];
+        PetscScalar       *te = &tmp[(elo - ilo) * bs + r];
+
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < ehi - elo; ++i) te[i * bs] -= ae[i] * xe[i * bs + c];
+      }
+    }
+  }
+  if (t == nt) y = &x[(((k - ms->zs) * ms->ny + (j - ms->ys)) * ms->nx + (ilo - ms->xs)) * bs];
+  else y = MatStencilSweepValues_Private(ms, t, x0, ilo, j, k);
+  PetscPragmaSIMD
+  for (PetscInt i = 0; i < len; ++i) y[i] = xc[i] + omega * dw[i] * tmp[i];
+}
+
+/* nt sweeps of damped Jacobi starting from the values x0 on the wide box, ending in the owned array x.
+
+   Sweeps are skewed in time along the last axis: at step s, sweep t is applied to plane s - (t - 1) sw, whose neighbors
+   in sweep t - 1 were all computed at step s or earlier. So all nt sweeps stream through the operator once, with a
+   working set of nt (2 sw + 1) planes. In 3D the planes are further cut into tiles of lines; each tile recomputes the
+   points of intermediate sweeps that its neighbors also compute, in a band of width (nt - t) sw around it. */
+static PetscErrorCode MatStencilJacobiGroup_Private(Mat_Stencil *ms, PetscInt nt, PetscInt tile, PetscReal omega, const PetscScalar *bw, PetscScalar *x0, PetscScalar *x)
+{
+  const PetscInt a = ms->dim - 1, sw = ms->sw;
+  const PetscInt olo[3] = {ms->xs, ms->ys, ms->zs}, ohi[3] = {ms->xs + ms->nx, ms->ys + ms->ny, ms->zs + ms->nz};
+  PetscInt      *lo, *hi;
+
+  PetscFunctionBegin;
+  if (ms->dim < 3 || tile <= 0) tile = ms->ny;
+  PetscCall(PetscMalloc2(3 * (nt + 1), &lo, 3 * (nt + 1), &hi));
+  for (PetscInt J0 = ms->ys; J0 < ms->ys + ms->ny; J0 += tile) {
+    const PetscInt J1 = PetscMin(J0 + tile, ms->ys + ms->ny);
+
+    /* Points needed after sweep t: the owned points of the tile grown by (nt - t) sw, within the wide box */
+    for (PetscInt t = 1; t <= nt; ++t) {
+      for (PetscInt d = 0; d < 3; ++d) {
+        const PetscInt tlo = d == 1 && ms->dim == 3 ? J0 : olo[d], thi = d == 1 && ms->dim == 3 ? J1 : ohi[d];
+
+        if (d < ms->dim) {
+          lo[t * 3 + d] = PetscMax(ms->W[d], tlo - (nt - t) * sw);
+          hi[t * 3 + d] = PetscMin(ms->W[d] + ms->Wn[d], thi + (nt - t) * sw);
+        } else {
+          lo[t * 3 + d] = 0;
+          hi[t * 3 + d] = 1;
+        }
+      }
+    }
+    for (PetscInt s = lo[3 + a]; s < hi[nt * 3 + a] + (nt - 1) * sw; ++s) {
+      for (PetscInt t = 1; t <= nt; ++t) {
+        const PetscInt q = s - (t - 1) * sw;
+
+        if (q < lo[t * 3 + a] || q >= hi[t * 3 + a]) continue;
+        if (a == 2) {
+          for (PetscInt j = lo[t * 3 + 1]; j < hi[t * 3 + 1]; ++j) MatStencilJacobiLine_Private(ms, t, nt, j, q, lo[t * 3], hi[t * 3], omega, bw, x0, x);
+        } else if (a == 1) MatStencilJacobiLine_Private(ms, t, nt, q, 0, lo[t * 3], hi[t * 3], omega, bw, x0, x);
+        else MatStencilJacobiLine_Private(ms, t, nt, 0, 0, q, q + 1, omega, bw, x0, x);
+      }
+    }
+  }
+  PetscCall(PetscFree2(lo, hi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatStencilJacobi_Stencil(Mat A, Vec b, PetscReal omega, PetscInt its, PetscInt depth, PetscInt tile, PetscBool zeroguess, Vec x)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+  Vec          bl, xl;
+  PetscScalar *bw, *x0, *xx;
+
+  PetscFunctionBegin;
+  if (!ms->maxdepth) {
+    PetscInt       lmin = PETSC_MAX_INT, gmin;
+    const PetscInt nloc[3] = {ms->nx, ms->ny, ms->nz};
+
+    /* The halo of a DMDA cannot be wider than the points owned by a neighbor */
+    for (PetscInt d = 0; d < ms->dim; ++d) lmin = PetscMin(lmin, nloc[d]);
+    PetscCall(MPIU_Allreduce(&lmin, &gmin, 1, MPIU_INT, MPI_MIN, PetscObjectComm((PetscObject)A)));
+    ms->maxdepth = PetscMax(1, gmin / ms->sw);
+  }
+  if (depth <= 0) depth = its;
+  depth = PetscMin(PetscMin(depth, its), ms->maxdepth);
+  PetscCall(MatStencilSetUpWide_Private(A, depth));
+  PetscCall(DMGetLocalVector(ms->wda, &bl));
+  PetscCall(DMGetLocalVector(ms->wda, &xl));
+  PetscCall(DMGlobalToLocalBegin(ms->wda, b, INSERT_VALUES, bl));
+  PetscCall(DMGlobalToLocalEnd(ms->wda, b, INSERT_VALUES, bl));
+  PetscCall(VecGetArray(bl, &bw));
+  for (PetscInt done = 0, nt; done < its; done += nt) {
+    nt = PetscMin(depth, its - done);
+    if (!done && zeroguess) PetscCall(VecSet(xl, 0.0));
+    else {
+      PetscCall(DMGlobalToLocalBegin(ms->wda, x, INSERT_VALUES, xl));
+      PetscCall(DMGlobalToLocalEnd(ms->wda, x, INSERT_VALUES, xl));
+    }
+    PetscCall(VecGetArray(xl, &x0));
+    PetscCall(VecGetArrayWrite(x, &xx));
+    PetscCall(MatStencilJacobiGroup_Private(ms, nt, tile, omega, bw, x0, xx));
+    PetscCall(VecRestoreArrayWrite(x, &xx));
+    PetscCall(VecRestoreArray(xl, &x0));
+  }
+  PetscCall(VecRestoreArray(bl, &bw));
+  PetscCall(DMRestoreLocalVector(ms->wda, &xl));
+  PetscCall(DMRestoreLocalVector(ms->wda, &bl));
+  PetscCall(PetscLogFlops((2.0 * ms->ns * ms->bs + 3.0) * ms->bs * ms->n * its));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   MatStencilJacobi - Applies several sweeps of damped Jacobi to a `MATSTENCIL` matrix, exchanging the ghost values once per group of sweeps
+
+   Collective
+
+   Input Parameters:
++  A - the `MATSTENCIL` matrix
+.  b - the right hand side
+.  omega - the damping factor
+.  its - the number of sweeps
+.  depth - the number of sweeps fused between two ghost exchanges, or `PETSC_DETERMINE` to fuse as many as the partition allows
+.  tile - the number of grid lines in a tile for 3D grids, or `PETSC_DETERMINE` for a single tile
+.  zeroguess - `PETSC_TRUE` if the initial guess is zero
+-  x - the initial guess
+
+   Output Parameter:
+.  x - the result of the sweeps x <- x + omega D^{-1} (b - A x)
+
+   Level: advanced
+
+   Notes:
+   The ghost values are exchanged with a halo of width depth times the stencil width, which must not be larger than the
+   number of points owned by a neighbor along any direction, so depth is reduced if needed. The rows of the matrix in
+   the halo are copied once, and again only after the matrix changes.
+
+   Successive sweeps are skewed in time so that the group of sweeps streams the operator and the vectors through memory
+   once instead of once per sweep; the result is the same as the one of separate sweeps.
+
+.seealso: `MATSTENCIL`, `PCTBJACOBI`, `MatSOR()`
+@*/
+PetscErrorCode MatStencilJacobi(Mat A, Vec b, PetscReal omega, PetscInt its, PetscInt depth, PetscInt tile, PetscBool zeroguess, Vec x)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidHeaderSpecific(b, VEC_CLASSID, 2);
+  PetscValidLogicalCollectiveReal(A, omega, 3);
+  PetscValidLogicalCollectiveInt(A, its, 4);
+  PetscValidLogicalCollectiveInt(A, depth, 5);
+  PetscValidLogicalCollectiveBool(A, zeroguess, 7);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 8);
+  PetscCheck(its > 0, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps %" PetscInt_FMT " must be positive", its);
+  PetscUseMethod(A, "MatStencilJacobi_C", (Mat, Vec, PetscReal, PetscInt, PetscInt, PetscInt, PetscBool, Vec), (A, b, omega, its, depth, tile, zeroguess, x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatZeroEntries_Stencil(Mat A)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(ms->a, ms->ns * ms->bs * ms->bs * ms->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatScale_Stencil(Mat A, PetscScalar alpha)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  const PetscInt N  = ms->ns * ms->bs * ms->bs * ms->n;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < N; ++i) ms->a[i] *= alpha;
+  PetscCall(PetscLogFlops(N));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatShift_Stencil(Mat A, PetscScalar alpha)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  const PetscInt bs = ms->bs, n = ms->n;
+
+  PetscFunctionBegin;
+  for (PetscInt r = 0; r < bs; ++r) {
+    PetscScalar *ae = &ms->a[((ms->center * bs + r) * bs + r) * n];
+
+    for (PetscInt p = 0; p < n; ++p) ae[p] += alpha;
+  }
+  PetscCall(PetscLogFlops(bs * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCopy_Stencil(Mat A, Mat B, MatStructure str)
+{
+  Mat_Stencil *ma = (Mat_Stencil *)A->data, *mb = (Mat_Stencil *)B->data;
+  PetscBool    same;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)B, MATSTENCIL, &same));
+  if (!same || ma->da != mb->da) {
+    PetscCall(MatCopy_Basic(A, B, str));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscArraycpy(mb->a, ma->a, ma->ns * ma->bs * ma->bs * ma->n));
+  PetscCall(PetscObjectStateIncrease((PetscObject)B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_Stencil(Mat A, MatDuplicateOption op, Mat *B)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), B));
+  PetscCall(MatSetSizes(*B, A->rmap->n, A->cmap->n, A->rmap->N, A->cmap->N));
+  PetscCall(MatSetBlockSizesFromMats(*B, A, A));
+  PetscCall(MatSetType(*B, MATSTENCIL));
+  PetscCall(MatSetDM(*B, ms->da));
+  PetscCall(MatSetUp(*B));
+  if (A->rmap->mapping) PetscCall(MatSetLocalToGlobalMapping(*B, A->rmap->mapping, A->cmap->mapping));
+  (*B)->stencil = A->stencil;
+  if (op == MAT_COPY_VALUES) {
+    PetscCall(MatCopy_Stencil(A, *B, SAME_NONZERO_PATTERN));
+    PetscCall(MatAssemblyBegin(*B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(*B, MAT_FINAL_ASSEMBLY));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCreateSubMatrix_Stencil(Mat A, IS isrow, IS iscol, MatReuse reuse, Mat *B)
+{
+  Mat Aaij;
+
+  PetscFunctionBegin;
+  PetscCall(MatConvert(A, MATAIJ, MAT_INITIAL_MATRIX, &Aaij));
+  PetscCall(MatCreateSubMatrix(Aaij, isrow, iscol, reuse, B));
+  PetscCall(MatDestroy(&Aaij));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetInfo_Stencil(Mat A, MatInfoType flag, MatInfo *info)
+{
+  Mat_Stencil   *ms = (Mat_Stencil *)A->data;
+  PetscLogDouble isend[3], irecv[3];
+
+  PetscFunctionBegin;
+  isend[0] = isend[1] = (PetscLogDouble)ms->ns * ms->bs * ms->bs * ms->n;
+  isend[2]            = (PetscLogDouble)(isend[0] * sizeof(PetscScalar));
+  if (flag == MAT_LOCAL) {
+    irecv[0] = isend[0];
+    irecv[1] = isend[1];
+    irecv[2] = isend[2];
+  } else if (flag == MAT_GLOBAL_MAX) {
+    PetscCall(MPIU_Allreduce(isend, irecv, 3, MPIU_PETSCLOGDOUBLE, MPI_MAX, PetscObjectComm((PetscObject)A)));
+  } else {
+    PetscCall(MPIU_Allreduce(isend, irecv, 3, MPIU_PETSCLOGDOUBLE, MPI_SUM, PetscObjectComm((PetscObject)A)));
+  }
+  info->block_size        = ms->bs;
+  info->nz_allocated      = irecv[0];
+  info->nz_used           = irecv[1];
+  info->nz_unneeded       = 0;
+  info->memory            = irecv[2];
+  info->assemblies        = A->num_ass;
+  info->mallocs           = 0;
+  info->fill_ratio_given  = 0;
+  info->fill_ratio_needed = 0;
+  info->factor_mallocs    = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_Stencil(Mat A, PetscViewer viewer)
+{
+  Mat_Stencil      *ms = (Mat_Stencil *)A->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+  Mat               Aaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (iascii && (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL)) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "%" PetscInt_FMT " stencil entries of width %" PetscInt_FMT " with %" PetscInt_FMT " dof per point\n", ms->ns, ms->sw, ms->bs));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatConvert(A, MATAIJ, MAT_INITIAL_MATRIX, &Aaij));
+  PetscCall(PetscObjectSetName((PetscObject)Aaij, ((PetscObject)A)->name));
+  ((PetscObject)Aaij)->donotPetscObjectPrintClassNamePrefixType = PETSC_TRUE;
+  PetscCall(MatView(Aaij, viewer));
+  PetscCall(MatDestroy(&Aaij));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_Stencil(Mat A, MatAssemblyType mode)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSetUp_Stencil(Mat A)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+  DM           da;
+  PetscInt     w, cnt = 0;
+
+  PetscFunctionBegin;
+  /* The storage is already sized for the DMDA, A->preallocated may have been reset since */
+  if (ms->da) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetDM(A, &da));
+  PetscCheck(da, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONGSTATE, "A MATSTENCIL matrix needs a DMDA, use MatSetDM() or DMCreateMatrix()");
+  PetscCall(PetscObjectReference((PetscObject)da));
+  ms->da = da;
+  PetscCall(DMDAGetInfo(da, &ms->dim, &ms->M[0], &ms->M[1], &ms->M[2], NULL, NULL, NULL, &ms->bs, &ms->sw, &ms->bd[0], &ms->bd[1], &ms->bd[2], &ms->st));
+  PetscCall(DMDAGetCorners(da, &ms->xs, &ms->ys, &ms->zs, &ms->nx, &ms->ny, &ms->nz));
+  PetscCall(DMDAGetGhostCorners(da, &ms->gxs, &ms->gys, &ms->gzs, &ms->gnx, &ms->gny, &ms->gnz));
+  if (ms->dim < 3) {
+    ms->zs = ms->gzs = 0;
+    ms->nz = ms->gnz = 1;
+    ms->bd[2]        = DM_BOUNDARY_NONE;
+  }
+  if (ms->dim < 2) {
+    ms->ys = ms->gys = 0;
+    ms->ny = ms->gny = 1;
+    ms->bd[1]        = DM_BOUNDARY_NONE;
+  }
+  ms->n = ms->nx * ms->ny * ms->nz;
+
+  /* The stencil entries, ordered so that the columns of a row increase */
+  w = 2 * ms->sw + 1;
+  PetscCall(PetscMalloc2(3 * w * w * w, &ms->offset, w * w * w, &ms->entry));
+  for (PetscInt dk = -ms->sw; dk <= ms->sw; ++dk) {
+    for (PetscInt dj = -ms->sw; dj <= ms->sw; ++dj) {
+      for (PetscInt di = -ms->sw; di <= ms->sw; ++di) {
+        const PetscInt b = ((dk + ms->sw) * w + dj + ms->sw) * w + di + ms->sw;
+        PetscBool      in;
+
+        in = (ms->dim > 2 || !dk) && (ms->dim > 1 || !dj) ? PETSC_TRUE : PETSC_FALSE;
+        if (ms->st == DMDA_STENCIL_STAR) in = in && ((!di && !dj) || (!di && !dk) || (!dj && !dk)) ? PETSC_TRUE : PETSC_FALSE;
+        ms->entry[b] = in ? cnt : -1;
+        if (!in) continue;
+        if (!di && !dj && !dk) ms->center = cnt;
+        ms->offset[cnt * 3]     = di;
+        ms->offset[cnt * 3 + 1] = dj;
+        ms->offset[cnt * 3 + 2] = dk;
+        ++cnt;
+      }
+    }
+  }
+  ms->ns = cnt;
+  PetscCall(PetscCalloc1(ms->ns * ms->bs * ms->bs * ms->n, &ms->a));
+  PetscCall(PetscMalloc2(ms->ns * ms->bs, &ms->rowcols, ms->ns * ms->bs, &ms->rowvals));
+  PetscCall(DMGetLocalToGlobalMapping(da, &ms->ltog));
+  PetscCall(PetscObjectReference((PetscObject)ms->ltog));
+  PetscCall(ISLocalToGlobalMappingGetBlockIndices(ms->ltog, &ms->gidx));
+
+  PetscCall(PetscLayoutSetBlockSize(A->rmap, ms->bs));
+  PetscCall(PetscLayoutSetBlockSize(A->cmap, ms->bs));
+  PetscCall(PetscLayoutSetUp(A->rmap));
+  PetscCall(PetscLayoutSetUp(A->cmap));
+  PetscCheck(A->rmap->n == ms->n * ms->bs && A->cmap->n == ms->n * ms->bs, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local sizes %" PetscInt_FMT " x %" PetscInt_FMT " do not match the DMDA, %" PetscInt_FMT, A->rmap->n, A->cmap->n, ms->n * ms->bs);
+  A->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_Stencil(Mat A)
+{
+  Mat_Stencil *ms = (Mat_Stencil *)A->data;
+
+  PetscFunctionBegin;
+  if (ms->ltog) PetscCall(ISLocalToGlobalMappingRestoreBlockIndices(ms->ltog, &ms->gidx));
+  PetscCall(ISLocalToGlobalMappingDestroy(&ms->ltog));
+  PetscCall(PetscFree2(ms->offset, ms->entry));
+  PetscCall(PetscFree2(ms->rowcols, ms->rowvals));
+  PetscCall(PetscFree(ms->a));
+  PetscCall(PetscFree2(ms->aw, ms->dw));
+  PetscCall(PetscFree2(ms->wbuf, ms->wtmp));
+  PetscCall(DMDestroy(&ms->wda));
+  PetscCall(DMDestroy(&ms->cda));
+  PetscCall(DMDestroy(&ms->da));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatStencilJacobi_C", NULL));
+  PetscCall(PetscFree(A->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_Stencil(Mat B)
+{
+  Mat_Stencil *ms;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ms));
+  B->data      = (void *)ms;
+  B->assembled = PETSC_FALSE;
+
+  B->ops->setup           = MatSetUp_Stencil;
+  B->ops->destroy         = MatDestroy_Stencil;
+  B->ops->setvalues       = MatSetValues_Stencil;
+  B->ops->setvalueslocal  = MatSetValuesLocal_Stencil;
+  B->ops->assemblyend     = MatAssemblyEnd_Stencil;
+  B->ops->getrow          = MatGetRow_Stencil;
+  B->ops->restorerow      = MatRestoreRow_Stencil;
+  B->ops->mult            = MatMult_Stencil;
+  B->ops->multadd         = MatMultAdd_Stencil;
+  B->ops->getdiagonal     = MatGetDiagonal_Stencil;
+  B->ops->sor             = MatSOR_Stencil;
+  B->ops->zeroentries     = MatZeroEntries_Stencil;
+  B->ops->scale           = MatScale_Stencil;
+  B->ops->shift           = MatShift_Stencil;
+  B->ops->copy            = MatCopy_Stencil;
+  B->ops->duplicate       = MatDuplicate_Stencil;
+  B->ops->createsubmatrix = MatCreateSubMatrix_Stencil;
+  B->ops->getinfo         = MatGetInfo_Stencil;
+  B->ops->view            = MatView_Stencil;
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatStencilJacobi_C", MatStencilJacobi_Stencil));
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSTENCIL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
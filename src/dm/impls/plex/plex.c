@@ -2170,8 +2170,15 @@ PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer)
   Output Parameters:
 . globalToLocalPointSF - The `PetscSF` that pushes points in [0, N) to the associated points in the loaded plex, where N is the global number of points; NULL if unneeded
 
+  Options Database Key:
+. -dm_plex_hdf5_partition_on_load - Partition the cells with the `DMPLEX` `PetscPartitioner` while they are read in parallel, so that they are migrated only once, directly to their final owners
+
   Level: advanced
 
+  Note:
+  Partitioning on load requires an interpolated topology stored with `DMPlexStorageVersion` 3.0.0 or newer. The resulting `DM` is
+  marked so that it is not distributed again by `DMSetFromOptions()`, see `DMPlexDistributeSetDefault()`.
+
 .seealso: [](chapter_unstructured), `DM`, `DMPLEX`, `DMLoad()`, `DMPlexCoordinatesLoad()`, `DMPlexLabelsLoad()`, `DMView()`, `PetscViewerHDF5Open()`, `PetscViewerPushFormat()`,
           `PetscViewer`, `PetscSF`
 @*/
@@ -2556,6 +2563,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   PetscCall(PetscFree(mesh->children));
   PetscCall(DMDestroy(&mesh->referenceTree));
   PetscCall(PetscGridHashDestroy(&mesh->lbox));
+  PetscCall(DMPlexBVHDestroy_Internal(&mesh->bvh));
   PetscCall(PetscFree(mesh->neighbors));
   if (mesh->metricCtx) PetscCall(PetscFree(mesh->metricCtx));
   /* This was originally freed in DMDestroy(), but that prevents reference counting of backend objects */
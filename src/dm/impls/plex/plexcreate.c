@@ -29,6 +29,7 @@ PetscErrorCode DMPlexCopy_Internal(DM dmin, PetscBool copyPeriodicity, PetscBool
   PetscCall(DMPlexReorderGetDefault(dmin, &reorder));
   PetscCall(DMPlexReorderSetDefault(dmout, reorder));
   ((DM_Plex *)dmout->data)->useHashLocation = ((DM_Plex *)dmin->data)->useHashLocation;
+  ((DM_Plex *)dmout->data)->useBVHLocation  = ((DM_Plex *)dmin->data)->useBVHLocation;
   if (copyOverlap) PetscCall(DMPlexSetOverlap_Plex(dmout, dmin, 0));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -4060,6 +4061,7 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(DM dm, PetscOptionItems *Pets
   if (flg) PetscCall(DMPlexCreateBoundaryLabel_Private(dm, bdLabel));
   /* Point Location */
   PetscCall(PetscOptionsBool("-dm_plex_hash_location", "Use grid hashing for point location", "DMInterpolate", PETSC_FALSE, &mesh->useHashLocation, NULL));
+  PetscCall(PetscOptionsBool("-dm_plex_bvh_location", "Use a bounding volume hierarchy for point location", "DMLocatePoints", PETSC_FALSE, &mesh->useBVHLocation, NULL));
   /* Partitioning and distribution */
   PetscCall(PetscOptionsBool("-dm_plex_partition_balance", "Attempt to evenly divide points on partition boundary between processes", "DMPlexSetPartitionBalance", PETSC_FALSE, &mesh->partitionBalance, NULL));
   /* Generation and remeshing */
@@ -4569,6 +4571,8 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 . -dm_refine                         - Refine mesh after distribution
 . -dm_plex_hash_location             - Use grid hashing for point location
 . -dm_plex_hash_box_faces <n,m,p>    - The number of divisions in each direction of the grid hash
+. -dm_plex_bvh_location              - Use a bounding volume hierarchy over the cell bounding boxes for point location
+. -dm_plex_bvh_leaf_size <n>         - The maximum number of cells in a leaf of the bounding volume hierarchy
 . -dm_plex_partition_balance         - Attempt to evenly divide points on partition boundary between processes
 . -dm_plex_remesh_bd                 - Allow changes to the boundary on remeshing
 . -dm_plex_max_projection_height     - Maximum mesh point height used to project locally
@@ -440,6 +440,57 @@ PetscErrorCode DMPlexDistributeOwnership(DM dm, PetscSection rootSection, IS *ro
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Add one level of point donations to ovAdjByRank. Only the points donated at the previous level, which are given in frontier,
+  are propagated over the point SF and have their adjacency computed, so the cost of each level is proportional to the size
+  of the new layer instead of the whole overlap. On output, frontier holds the points donated at this level.
+*/
+static PetscErrorCode DMPlexOverlapAddLevel_Private(DM dm, DMLabel ovAdjByRank, DMLabel *frontier)
+{
+  DMLabel         next;
+  IS              rankIS, pointIS;
+  const PetscInt *ranks, *points;
+  PetscInt       *adj = NULL;
+  PetscInt        numRanks, numPoints, r, p, a;
+
+  PetscFunctionBegin;
+  /* Propagate the last donations over SF to capture remote connections */
+  PetscCall(DMPlexPartitionLabelPropagate(dm, *frontier));
+  PetscCall(DMLabelCreate(PETSC_COMM_SELF, "Overlap frontier", &next));
+  PetscCall(DMLabelGetValueIS(*frontier, &rankIS));
+  PetscCall(ISGetLocalSize(rankIS, &numRanks));
+  PetscCall(ISGetIndices(rankIS, &ranks));
+  for (r = 0; r < numRanks; ++r) {
+    const PetscInt rank = ranks[r];
+
+    PetscCall(DMLabelGetStratumIS(*frontier, rank, &pointIS));
+    PetscCall(ISGetLocalSize(pointIS, &numPoints));
+    PetscCall(ISGetIndices(pointIS, &points));
+    for (p = 0; p < numPoints; ++p) {
+      PetscInt adjSize = PETSC_DETERMINE;
+
+      PetscCall(DMLabelSetValue(ovAdjByRank, points[p], rank));
+      PetscCall(DMPlexGetAdjacency(dm, points[p], &adjSize, &adj));
+      for (a = 0; a < adjSize; ++a) {
+        PetscBool has;
+
+        PetscCall(DMLabelStratumHasPoint(ovAdjByRank, rank, adj[a], &has));
+        if (has) continue;
+        PetscCall(DMLabelSetValue(ovAdjByRank, adj[a], rank));
+        PetscCall(DMLabelSetValue(next, adj[a], rank));
+      }
+    }
+    PetscCall(ISRestoreIndices(pointIS, &points));
+    PetscCall(ISDestroy(&pointIS));
+  }
+  PetscCall(ISRestoreIndices(rankIS, &ranks));
+  PetscCall(ISDestroy(&rankIS));
+  PetscCall(PetscFree(adj));
+  PetscCall(DMLabelDestroy(frontier));
+  *frontier = next;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   DMPlexCreateOverlapLabel - Compute a label indicating what overlap points should be sent to new processes
 
@@ -532,12 +583,13 @@ PetscErrorCode DMPlexCreateOverlapLabel(DM dm, PetscInt levels, PetscSection roo
   PetscCall(PetscFree(adj));
   PetscCall(ISRestoreIndices(rootrank, &rrank));
   PetscCall(ISRestoreIndices(leafrank, &nrank));
-  /* Add additional overlap levels */
-  for (l = 1; l < levels; l++) {
-    /* Propagate point donations over SF to capture remote connections */
-    PetscCall(DMPlexPartitionLabelPropagate(dm, ovAdjByRank));
-    /* Add next level of point donations to the label */
-    PetscCall(DMPlexPartitionLabelAdjacency(dm, ovAdjByRank));
+  /* Add additional overlap levels, only expanding the points donated at the previous level */
+  if (levels > 1) {
+    DMLabel frontier;
+
+    PetscCall(DMLabelDuplicate(ovAdjByRank, &frontier));
+    for (l = 1; l < levels; l++) PetscCall(DMPlexOverlapAddLevel_Private(dm, ovAdjByRank, &frontier));
+    PetscCall(DMLabelDestroy(&frontier));
   }
   /* We require the closure in the overlap */
   PetscCall(DMPlexPartitionLabelClosure(dm, ovAdjByRank));
@@ -1869,6 +1921,345 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Label the points each process needs after rebalancing: the closure of its new cells, and of the cells within overlap levels of adjacency of them.
+  The cells within overlap levels of a cell are present on its current owner, so each process labels the neighborhood of its own cells. On output,
+  target holds the new owner of the local cells, including the overlap cells, and -1 for the other points.
+*/
+static PetscErrorCode DMPlexRebalanceCreatePartitionLabel_Private(DM dm, PetscInt overlap, PetscSection cellPartSection, IS cellPart, PetscInt target[], DMLabel lblPartition)
+{
+  PetscSF         sfPoint;
+  PetscHSetI      ht, next;
+  IS              is;
+  const PetscInt *points;
+  PetscInt       *mixed = NULL, *cells = NULL, *frontier = NULL, *closure = NULL, *adj = NULL;
+  PetscInt        pStart, pEnd, cStart, cEnd, rStart, rEnd, proc, npoints, poff, p, c, cl, clSize, a, l, f, numFrontier, numCells, numNext, off;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetPointSF(dm, &sfPoint));
+  PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCall(ISGetIndices(cellPart, &points));
+  PetscCall(PetscSectionGetChart(cellPartSection, &rStart, &rEnd));
+  for (p = pStart; p < pEnd; ++p) target[p - pStart] = -1;
+  for (proc = rStart; proc < rEnd; ++proc) {
+    PetscCall(PetscSectionGetDof(cellPartSection, proc, &npoints));
+    PetscCall(PetscSectionGetOffset(cellPartSection, proc, &poff));
+    for (c = 0; c < npoints; ++c) target[points[poff + c] - pStart] = proc;
+  }
+  PetscCall(PetscSFBcastBegin(sfPoint, MPIU_INT, target, target, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sfPoint, MPIU_INT, target, target, MPI_REPLACE));
+  if (overlap > 0) {
+    /* Points in the closure of cells with different owners, -2, are the only ones whose adjacency can reach a cell with another owner,
+       apart from the cell itself */
+    PetscCall(PetscMalloc1(pEnd - pStart, &mixed));
+    for (p = pStart; p < pEnd; ++p) mixed[p - pStart] = -1;
+    for (c = cStart; c < cEnd; ++c) {
+      PetscCall(DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure));
+      for (cl = 0; cl < clSize * 2; cl += 2) {
+        const PetscInt q = closure[cl] - pStart;
+
+        if (mixed[q] == -1) mixed[q] = target[c - pStart];
+        else if (mixed[q] != target[c - pStart]) mixed[q] = -2;
+      }
+    }
+  }
+  PetscCall(PetscHSetICreate(&ht));
+  PetscCall(PetscHSetICreate(&next));
+  for (proc = rStart; proc < rEnd; ++proc) {
+    PetscCall(PetscSectionGetDof(cellPartSection, proc, &npoints));
+    if (!npoints) continue;
+    PetscCall(PetscSectionGetOffset(cellPartSection, proc, &poff));
+    PetscCall(PetscHSetIClear(ht));
+    PetscCall(PetscMalloc1(npoints, &frontier));
+    PetscCall(PetscArraycpy(frontier, &points[poff], npoints));
+    numFrontier = npoints;
+    /* Each level adds the cells with another owner adjacent to the previous level */
+    for (l = 0; l < overlap; ++l) {
+      PetscCall(PetscHSetIClear(next));
+      for (f = 0; f < numFrontier; ++f) {
+        PetscCall(DMPlexGetTransitiveClosure(dm, frontier[f], PETSC_TRUE, &clSize, &closure));
+        for (cl = 0; cl < clSize * 2; cl += 2) {
+          const PetscInt q       = closure[cl];
+          PetscInt       adjSize = PETSC_DETERMINE;
+
+          if (!l && q != frontier[f] && mixed[q - pStart] != -2) continue;
+          PetscCall(DMPlexGetAdjacency(dm, q, &adjSize, &adj));
+          for (a = 0; a < adjSize; ++a) {
+            PetscBool missing;
+
+            if (adj[a] < cStart || adj[a] >= cEnd || target[adj[a] - pStart] == proc) continue;
+            PetscCall(PetscHSetIQueryAdd(ht, adj[a], &missing));
+            if (missing) PetscCall(PetscHSetIAdd(next, adj[a]));
+          }
+        }
+      }
+      PetscCall(PetscFree(frontier));
+      PetscCall(PetscHSetIGetSize(next, &numNext));
+      PetscCall(PetscMalloc1(numNext, &frontier));
+      off = 0;
+      PetscCall(PetscHSetIGetElems(next, &off, frontier));
+      numFrontier = numNext;
+      if (!numFrontier) break;
+    }
+    PetscCall(PetscFree(frontier));
+    PetscCall(PetscHSetIGetSize(ht, &numCells));
+    PetscCall(PetscMalloc1(npoints + numCells, &cells));
+    PetscCall(PetscArraycpy(cells, &points[poff], npoints));
+    off = npoints;
+    PetscCall(PetscHSetIGetElems(ht, &off, cells));
+    PetscCall(DMPlexClosurePoints_Private(dm, npoints + numCells, cells, &is));
+    PetscCall(DMLabelSetStratumIS(lblPartition, proc, is));
+    PetscCall(ISDestroy(&is));
+    PetscCall(PetscFree(cells));
+  }
+  PetscCall(PetscHSetIDestroy(&ht));
+  PetscCall(PetscHSetIDestroy(&next));
+  if (closure) PetscCall(DMPlexRestoreTransitiveClosure(dm, cStart, PETSC_TRUE, NULL, &closure));
+  PetscCall(PetscFree(adj));
+  PetscCall(PetscFree(mixed));
+  PetscCall(ISRestoreIndices(cellPart, &points));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Build the point SF of the rebalanced mesh. Only a process holding a point in the closure of one of its cells can own it, and the previous owner
+  keeps it if it can, so that the ownership only changes close to the cells which moved.
+*/
+static PetscErrorCode DMPlexRebalanceCreatePointSF_Private(DM dm, PetscSF migrationSF, const PetscInt target[], PetscSF *pointSF)
+{
+  MPI_Op             op;
+  MPI_Datatype       datatype;
+  Petsc3Int         *rootVote, *leafVote;
+  PetscSFNode       *rootNodes, *leafNodes, *pointRemote;
+  const PetscSFNode *roots;
+  const PetscInt    *leaves;
+  PetscInt          *leafTarget, *pointLocal, *closure = NULL;
+  PetscInt           nroots, nleaves, npointLeaves, cStart, cEnd, c, cl, clSize, p, l, idx;
+  PetscMPIInt        rank, size;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)dm), &rank));
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)dm), &size));
+  PetscCall(PetscSFGetGraph(migrationSF, &nroots, &nleaves, &leaves, &roots));
+  PetscCall(PetscMalloc5(nroots, &rootVote, nleaves, &leafVote, nleaves, &leafTarget, nroots, &rootNodes, nleaves, &leafNodes));
+  PetscCall(PetscSFBcastBegin(migrationSF, MPIU_INT, target, leafTarget, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(migrationSF, MPIU_INT, target, leafTarget, MPI_REPLACE));
+  for (p = 0; p < nleaves; ++p) {
+    leafVote[p].vote  = -1;
+    leafVote[p].rank  = rank;
+    leafVote[p].index = p;
+  }
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  for (c = cStart; c < cEnd; ++c) {
+    if (leafTarget[c] != rank) continue;
+    PetscCall(DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure));
+    for (cl = 0; cl < clSize * 2; cl += 2) leafVote[closure[cl]].vote = rank;
+  }
+  if (closure) PetscCall(DMPlexRestoreTransitiveClosure(dm, cStart, PETSC_TRUE, NULL, &closure));
+  /* The roots of the migration are on the previous owners */
+  for (l = 0; l < nleaves; ++l) {
+    p = leaves ? leaves[l] : l;
+    if (roots[l].rank == rank && leafVote[p].vote >= 0) leafVote[p].vote = size;
+  }
+  for (p = 0; p < nroots; ++p) {
+    rootVote[p].vote  = -3;
+    rootVote[p].rank  = -3;
+    rootVote[p].index = -3;
+  }
+  PetscCallMPI(MPI_Type_contiguous(3, MPIU_INT, &datatype));
+  PetscCallMPI(MPI_Type_commit(&datatype));
+  PetscCallMPI(MPI_Op_create(&MaxLocCarry, 1, &op));
+  PetscCall(PetscSFReduceBegin(migrationSF, datatype, leafVote, rootVote, op));
+  PetscCall(PetscSFReduceEnd(migrationSF, datatype, leafVote, rootVote, op));
+  PetscCallMPI(MPI_Op_free(&op));
+  PetscCallMPI(MPI_Type_free(&datatype));
+  for (p = 0; p < nroots; ++p) {
+    rootNodes[p].rank  = rootVote[p].rank;
+    rootNodes[p].index = rootVote[p].index;
+  }
+  PetscCall(PetscSFBcastBegin(migrationSF, MPIU_2INT, rootNodes, leafNodes, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(migrationSF, MPIU_2INT, rootNodes, leafNodes, MPI_REPLACE));
+  for (npointLeaves = 0, p = 0; p < nleaves; ++p)
+    if (leafNodes[p].rank != rank) ++npointLeaves;
+  PetscCall(PetscMalloc1(npointLeaves, &pointLocal));
+  PetscCall(PetscMalloc1(npointLeaves, &pointRemote));
+  for (idx = 0, p = 0; p < nleaves; ++p) {
+    if (leafNodes[p].rank != rank) {
+      pointLocal[idx]  = p;
+      pointRemote[idx] = leafNodes[p];
+      ++idx;
+    }
+  }
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), pointSF));
+  PetscCall(PetscSFSetFromOptions(*pointSF));
+  PetscCall(PetscSFSetGraph(*pointSF, nleaves, npointLeaves, pointLocal, PETSC_OWN_POINTER, pointRemote, PETSC_OWN_POINTER));
+  PetscCall(PetscFree5(rootVote, leafVote, leafTarget, rootNodes, leafNodes));
+  if (PetscDefined(USE_DEBUG)) PetscCall(DMPlexCheckPointSF(dm, *pointSF, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  DMPlexRebalance - Rebalance the cells of a distributed mesh in place, moving only the cells that change owner
+
+  Collective on dm
+
+  Input Parameters:
++ dm  - The distributed DMPlex object
+- tol - The tolerated load imbalance, max_p(load_p) / avg_p(load_p) - 1, below which nothing is done
+
+  Output Parameter:
+. sf - The PetscSF migrating the points of the previous distribution to the new one, or NULL if not needed. It is NULL if the mesh was already balanced.
+
+  Options Database Keys:
++ -rebalance_petscpartitioner_type <type> - The partitioner computing the new distribution, `PETSCPARTITIONERDIFFUSION` by default
+. -rebalance_petscpartitioner_diffusion_max_it <int> - Maximum number of diffusion iterations
+- -rebalance_petscpartitioner_diffusion_rtol <value> - Relative tolerance on the load excess of each process
+
+  Notes:
+  The load of each process is its number of owned cells. The default partitioner diffuses the load excess to neighboring processes, so that only cells
+  close to process interfaces change owner. The new owners, and the overlap cells each process needs, are determined on the current distribution, and a
+  single migration sends the moved cells and the new overlap cells with their closure, while the other points stay in place. The overlap of dm is kept,
+  without a separate `DMPlexDistributeOverlap()`. A shared point keeps its owner if the owner still has it in the closure of one of its cells, so that the
+  point SF only changes close to the moved cells. The options prefix of dm is prepended to the keys above.
+
+  The mesh of dm is replaced, keeping its discretization, partitioner and adjacency. Sections, vectors and matrices obtained from dm before the call
+  describe the previous distribution. A field can be carried over with `DMPlexDistributeField()`, the returned sf and a local section obtained before the call.
+
+  Level: intermediate
+
+.seealso: `DMPlexDistribute()`, `PETSCPARTITIONERDIFFUSION`, `DMPlexRebalanceSharedPoints()`, `DMPlexGetOverlap()`, `DMPlexDistributeField()`
+@*/
+PetscErrorCode DMPlexRebalance(DM dm, PetscReal tol, PetscSF *sf)
+{
+  MPI_Comm         comm;
+  PetscPartitioner part;
+  PetscSection     cellPartSection;
+  IS               cellNumbering, cellPart;
+  DM               dmNew, dmCoord;
+  DMLabel          lblPartition, lblMigration;
+  PetscSF          sfMigration, sfStratified, sfPoint;
+  const PetscInt  *cells;
+  const char      *prefix, *name;
+  PetscInt        *target;
+  PetscInt         overlap, pStart, pEnd, n, c, loads[2] = {0, 0};
+  PetscMPIInt      size;
+  PetscBool        balance, useAnchors;
+  PetscErrorCode (*adjFunc)(DM, PetscInt, PetscInt *, PetscInt[], void *);
+  void *adjCtx;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(dm, tol, 2);
+  if (sf) PetscValidPointer(sf, 3);
+
+  if (sf) *sf = NULL;
+  PetscCall(PetscObjectGetComm((PetscObject)dm, &comm));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (size == 1) PetscFunctionReturn(PETSC_SUCCESS);
+  /* Measure the current imbalance */
+  PetscCall(DMPlexGetCellNumbering(dm, &cellNumbering));
+  PetscCall(ISGetLocalSize(cellNumbering, &n));
+  PetscCall(ISGetIndices(cellNumbering, &cells));
+  for (c = 0; c < n; ++c)
+    if (cells[c] >= 0) ++loads[0];
+  PetscCall(ISRestoreIndices(cellNumbering, &cells));
+  loads[1] = loads[0];
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &loads[0], 1, MPIU_INT, MPI_MAX, comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &loads[1], 1, MPIU_INT, MPI_SUM, comm));
+  if (!loads[1]) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscInfo(dm, "Load imbalance %g, tolerance %g\n", (double)((PetscReal)loads[0] * size / loads[1] - 1.0), (double)tol));
+  if ((PetscReal)loads[0] * size / loads[1] - 1.0 <= tol) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscLogEventBegin(DMPLEX_Distribute, dm, 0, 0, 0));
+  /* Partition the owned cells, starting from the current distribution */
+  PetscCall(PetscLogEventBegin(DMPLEX_Partition, dm, 0, 0, 0));
+  PetscCall(PetscPartitionerCreate(comm, &part));
+  PetscCall(PetscPartitionerSetType(part, PETSCPARTITIONERDIFFUSION));
+  PetscCall(PetscObjectGetOptionsPrefix((PetscObject)dm, &prefix));
+  PetscCall(PetscObjectSetOptionsPrefix((PetscObject)part, prefix));
+  PetscCall(PetscObjectAppendOptionsPrefix((PetscObject)part, "rebalance_"));
+  PetscCall(PetscPartitionerSetFromOptions(part));
+  PetscCall(PetscSectionCreate(comm, &cellPartSection));
+  PetscCall(PetscPartitionerDMPlexPartition(part, dm, NULL, cellPartSection, &cellPart));
+  PetscCall(PetscPartitionerDestroy(&part));
+  /* Label the points each process needs, including its new overlap */
+  PetscCall(DMPlexGetOverlap(dm, &overlap));
+  PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
+  PetscCall(PetscMalloc1(pEnd - pStart, &target));
+  PetscCall(DMLabelCreate(PETSC_COMM_SELF, "Point Partition", &lblPartition));
+  PetscCall(DMPlexRebalanceCreatePartitionLabel_Private(dm, overlap, cellPartSection, cellPart, target, lblPartition));
+  PetscCall(DMLabelCreate(PETSC_COMM_SELF, "Point migration", &lblMigration));
+  PetscCall(DMPlexPartitionLabelInvert(dm, lblPartition, NULL, lblMigration));
+  PetscCall(DMPlexPartitionLabelCreateSF(dm, lblMigration, &sfMigration));
+  PetscCall(DMPlexStratifyMigrationSF(dm, sfMigration, &sfStratified));
+  PetscCall(PetscSFDestroy(&sfMigration));
+  sfMigration = sfStratified;
+  PetscCall(PetscSFSetUp(sfMigration));
+  PetscCall(DMLabelDestroy(&lblPartition));
+  PetscCall(DMLabelDestroy(&lblMigration));
+  PetscCall(PetscSectionDestroy(&cellPartSection));
+  PetscCall(ISDestroy(&cellPart));
+  PetscCall(PetscLogEventEnd(DMPLEX_Partition, dm, 0, 0, 0));
+
+  /* Migrate the points, which stay in place unless their cells moved, and update the point SF */
+  PetscCall(DMPlexCreate(comm, &dmNew));
+  PetscCall(DMPlexMigrate(dm, sfMigration, dmNew));
+  PetscCall(DMPlexCopy_Internal(dm, PETSC_TRUE, PETSC_TRUE, dmNew));
+  PetscCall(DMPlexRebalanceCreatePointSF_Private(dmNew, sfMigration, target, &sfPoint));
+  PetscCall(PetscFree(target));
+  PetscCall(DMSetPointSF(dmNew, sfPoint));
+  PetscCall(DMPlexMigrateIsoperiodicFaceSF_Internal(dm, dmNew, sfMigration));
+  PetscCall(DMGetCoordinateDM(dmNew, &dmCoord));
+  if (dmCoord) PetscCall(DMSetPointSF(dmCoord, sfPoint));
+  PetscCall(DMGetCellCoordinateDM(dmNew, &dmCoord));
+  if (dmCoord) PetscCall(DMSetPointSF(dmCoord, sfPoint));
+  PetscCall(PetscSFDestroy(&sfPoint));
+  PetscCall(DMPlexGetPartitioner(dm, &part));
+  PetscCall(DMPlexSetPartitioner(dmNew, part));
+  PetscCall(DMPlexGetPartitionBalance(dm, &balance));
+  PetscCall(DMPlexSetPartitionBalance(dmNew, balance));
+  PetscCall(DMPlexGetAdjacencyUseAnchors(dm, &useAnchors));
+  PetscCall(DMPlexSetAdjacencyUseAnchors(dmNew, useAnchors));
+  PetscCall(DMPlexGetAdjacencyUser(dm, &adjFunc, &adjCtx));
+  PetscCall(DMPlexSetAdjacencyUser(dmNew, adjFunc, adjCtx));
+  PetscCall(DMPlexDistributionGetName(dm, &name));
+  PetscCall(DMPlexDistributionSetName(dmNew, name));
+  if (dm->useNatural) {
+    PetscSection section;
+    PetscSF      sfNatural, sfNaturalPoint;
+
+    /* Compose with the previous natural SF, as in DMPlexDistribute() */
+    PetscCall(DMCopyDisc(dm, dmNew));
+    PetscCall(DMGetLocalSection(dm, &section));
+    PetscCall(DMPlexCreateGlobalToNaturalSF(dmNew, section, sfMigration, &sfNatural));
+    if (dm->sfNatural) {
+      PetscSF natSF = sfNatural;
+
+      PetscCall(PetscSFCompose(dm->sfNatural, natSF, &sfNatural));
+      PetscCall(PetscSFDestroy(&natSF));
+    }
+    PetscCall(PetscSFDestroy(&dm->sfNatural));
+    dm->sfNatural = sfNatural;
+    if (dm->sfMigration) {
+      PetscCall(PetscSFCompose(dm->sfMigration, sfMigration, &sfNaturalPoint));
+      PetscCall(DMPlexSetMigrationSF(dm, sfNaturalPoint));
+      PetscCall(PetscSFDestroy(&sfNaturalPoint));
+    }
+  }
+  PetscCall(DMPlexReplace_Internal(dm, &dmNew));
+  /* The sections and work vectors of dm describe the previous distribution */
+  PetscCall(DMSetLocalSection(dm, NULL));
+  PetscCall(PetscSFDestroy(&dm->sectionSF));
+  PetscCall(ISLocalToGlobalMappingDestroy(&dm->ltogmap));
+  PetscCall(DMClearGlobalVectors(dm));
+  PetscCall(DMClearLocalVectors(dm));
+  if (sf) *sf = sfMigration;
+  else PetscCall(PetscSFDestroy(&sfMigration));
+  PetscCall(PetscLogEventEnd(DMPLEX_Distribute, dm, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   DMPlexDistributeOverlap - Add partition overlap to a distributed non-overlapping DM.
 
@@ -46,45 +46,6 @@ static PetscErrorCode DMPlexConvertPlex(DM dm, DM *plex, PetscBool copy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PetscContainerUserDestroy_PetscFEGeom(void *ctx)
-{
-  PetscFEGeom *geom = (PetscFEGeom *)ctx;
-
-  PetscFunctionBegin;
-  PetscCall(PetscFEGeomDestroy(&geom));
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
-
-static PetscErrorCode DMPlexGetFEGeom(DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
-{
-  char           composeStr[33] = {0};
-  PetscObjectId  id;
-  PetscContainer container;
-
-  PetscFunctionBegin;
-  PetscCall(PetscObjectGetId((PetscObject)quad, &id));
-  PetscCall(PetscSNPrintf(composeStr, 32, "DMPlexGetFEGeom_%" PetscInt64_FMT "\n", id));
-  PetscCall(PetscObjectQuery((PetscObject)pointIS, composeStr, (PetscObject *)&container));
-  if (container) {
-    PetscCall(PetscContainerGetPointer(container, (void **)geom));
-  } else {
-    PetscCall(DMFieldCreateFEGeom(coordField, pointIS, quad, faceData, geom));
-    PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
-    PetscCall(PetscContainerSetPointer(container, (void *)*geom));
-    PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroy_PetscFEGeom));
-    PetscCall(PetscObjectCompose((PetscObject)pointIS, composeStr, (PetscObject)container));
-    PetscCall(PetscContainerDestroy(&container));
-  }
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
-
-static PetscErrorCode DMPlexRestoreFEGeom(DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
-{
-  PetscFunctionBegin;
-  *geom = NULL;
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
-
 /*@
   DMPlexGetScale - Get the scale for the specified fundamental unit
 
@@ -2371,7 +2332,7 @@ static PetscErrorCode DMPlexComputeBdIntegral_Internal(DM dm, Vec locX, IS point
         PetscCall(PetscObjectReference((PetscObject)qGeom));
       }
       PetscCall(PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL));
-      PetscCall(DMPlexGetFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+      PetscCall(DMSNESGetFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
       for (face = 0; face < numFaces; ++face) {
         const PetscInt point = points[face], *support;
         PetscScalar   *x     = NULL;
@@ -2417,7 +2378,7 @@ static PetscErrorCode DMPlexComputeBdIntegral_Internal(DM dm, Vec locX, IS point
       PetscCall(PetscFEIntegrateBd(prob, field, func, Nr, chunkGeom, &u[offset * totDim], probAux, a ? &a[offset * totDimAux] : NULL, &fintegral[offset * Nf]));
       PetscCall(PetscFEGeomRestoreChunk(fgeom, offset, numFaces, &chunkGeom));
       /* Cleanup data arrays */
-      PetscCall(DMPlexRestoreFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+      PetscCall(DMSNESRestoreFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
       PetscCall(PetscQuadratureDestroy(&qGeom));
       PetscCall(PetscFree2(u, a));
       PetscCall(ISRestoreIndices(pointIS, &points));
@@ -3794,30 +3755,87 @@ PetscErrorCode DMPlexRestoreFaceGeometry(DM dm, PetscInt fStart, PetscInt fEnd,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode DMSNESGetFEGeom(DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
+typedef struct {
+  PetscFEGeom     *geom;
+  PetscObjectId    fieldId;       /* The coordinate field used to compute geom */
+  PetscObjectId    coordId[2];    /* The local vertex and cell coordinates used to compute geom */
+  PetscObjectState coordState[2]; /* The state of these coordinates when geom was computed */
+} DMPlexFEGeomCache;
+
+static PetscErrorCode PetscContainerUserDestroy_PetscFEGeom(void *ctx)
+{
+  DMPlexFEGeomCache *cache = (DMPlexFEGeomCache *)ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFEGeomDestroy(&cache->geom));
+  PetscCall(PetscFree(cache));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Identify the coordinates the geometry is computed from, so that a cached geometry is never used after the mesh moves */
+static PetscErrorCode DMPlexFEGeomCacheGetKey_Private(DM dm, DMField coordField, PetscObjectId *fieldId, PetscObjectId coordId[], PetscObjectState coordState[])
 {
-  char           composeStr[33] = {0};
-  PetscObjectId  id;
-  PetscContainer container;
+  PetscInt c;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetId((PetscObject)coordField, fieldId));
+  for (c = 0; c < 2; ++c) {
+    Vec coords = dm->coordinates[c].xl;
+
+    coordId[c]    = 0;
+    coordState[c] = 0;
+    if (!coords) continue;
+    PetscCall(PetscObjectGetId((PetscObject)coords, &coordId[c]));
+    PetscCall(PetscObjectStateGet((PetscObject)coords, &coordState[c]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMSNESGetFEGeom - Get the geometry of the points in pointIS at the points of quad
+
+  The geometry is cached on pointIS for each quadrature, so that the residual, Jacobian, boundary and projection loops over a
+  given set of points share it. It is recomputed only when the coordinate field or the local coordinates of dm change.
+*/
+PetscErrorCode DMSNESGetFEGeom(DM dm, DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
+{
+  char               composeStr[33] = {0};
+  PetscObjectId      id, fieldId, coordId[2];
+  PetscObjectState   coordState[2];
+  PetscContainer     container;
+  DMPlexFEGeomCache *cache;
 
   PetscFunctionBegin;
   PetscCall(PetscObjectGetId((PetscObject)quad, &id));
-  PetscCall(PetscSNPrintf(composeStr, 32, "DMSNESGetFEGeom_%" PetscInt64_FMT "\n", id));
+  PetscCall(PetscSNPrintf(composeStr, 32, "DMSNESGetFEGeom_%" PetscInt64_FMT "_%d\n", id, (int)faceData));
+  PetscCall(DMPlexFEGeomCacheGetKey_Private(dm, coordField, &fieldId, coordId, coordState));
   PetscCall(PetscObjectQuery((PetscObject)pointIS, composeStr, (PetscObject *)&container));
   if (container) {
-    PetscCall(PetscContainerGetPointer(container, (void **)geom));
+    PetscCall(PetscContainerGetPointer(container, (void **)&cache));
+    if (cache->fieldId != fieldId || cache->coordId[0] != coordId[0] || cache->coordId[1] != coordId[1] || cache->coordState[0] != coordState[0] || cache->coordState[1] != coordState[1]) {
+      PetscCall(PetscInfo(dm, "Coordinates changed, recomputing cached FE geometry\n"));
+      PetscCall(PetscFEGeomDestroy(&cache->geom));
+      PetscCall(DMFieldCreateFEGeom(coordField, pointIS, quad, faceData, &cache->geom));
+    }
   } else {
-    PetscCall(DMFieldCreateFEGeom(coordField, pointIS, quad, faceData, geom));
+    PetscCall(PetscNew(&cache));
+    PetscCall(DMFieldCreateFEGeom(coordField, pointIS, quad, faceData, &cache->geom));
     PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
-    PetscCall(PetscContainerSetPointer(container, (void *)*geom));
+    PetscCall(PetscContainerSetPointer(container, (void *)cache));
     PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroy_PetscFEGeom));
     PetscCall(PetscObjectCompose((PetscObject)pointIS, composeStr, (PetscObject)container));
     PetscCall(PetscContainerDestroy(&container));
   }
+  cache->fieldId       = fieldId;
+  cache->coordId[0]    = coordId[0];
+  cache->coordId[1]    = coordId[1];
+  cache->coordState[0] = coordState[0];
+  cache->coordState[1] = coordState[1];
+  *geom                = cache->geom;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode DMSNESRestoreFEGeom(DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
+PetscErrorCode DMSNESRestoreFEGeom(DM dm, DMField coordField, IS pointIS, PetscQuadrature quad, PetscBool faceData, PetscFEGeom **geom)
 {
   PetscFunctionBegin;
   *geom = NULL;
@@ -3878,7 +3896,7 @@ PetscErrorCode DMPlexComputeResidual_Patch_Internal(DM dm, PetscSection section,
     PetscCall(DMFieldGetDegree(coordField, cellIS, NULL, &maxDegree));
     if (maxDegree <= 1) {
       PetscCall(DMFieldCreateDefaultQuadrature(coordField, cellIS, &affineQuad));
-      if (affineQuad) PetscCall(DMSNESGetFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+      if (affineQuad) PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
     } else {
       PetscCall(PetscCalloc2(Nf, &quads, Nf, &geoms));
       for (f = 0; f < Nf; ++f) {
@@ -3895,7 +3913,7 @@ PetscErrorCode DMPlexComputeResidual_Patch_Internal(DM dm, PetscSection section,
 
           PetscCall(PetscFEGetQuadrature(fe, &quads[f]));
           PetscCall(PetscObjectReference((PetscObject)quads[f]));
-          PetscCall(DMSNESGetFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+          PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
         }
       }
     }
@@ -4033,11 +4051,11 @@ PetscErrorCode DMPlexComputeResidual_Patch_Internal(DM dm, PetscSection section,
   /* TODO Could include boundary residual here (see DMPlexComputeResidual_Internal) */
   if (useFEM) {
     if (maxDegree <= 1) {
-      PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+      PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
       PetscCall(PetscQuadratureDestroy(&affineQuad));
     } else {
       for (f = 0; f < Nf; ++f) {
-        PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+        PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
         PetscCall(PetscQuadratureDestroy(&quads[f]));
       }
       PetscCall(PetscFree2(quads, geoms));
@@ -4148,7 +4166,7 @@ PetscErrorCode DMPlexComputeJacobian_Patch_Internal(DM dm, PetscSection section,
     PetscCall(PetscFEGetQuadrature(fe, &qGeom));
     PetscCall(PetscObjectReference((PetscObject)qGeom));
   }
-  PetscCall(DMSNESGetFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+  PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
   /* Compute volume integrals */
   if (assembleJac) PetscCall(MatZeroEntries(J));
   PetscCall(MatZeroEntries(JP));
@@ -4223,7 +4241,7 @@ PetscErrorCode DMPlexComputeJacobian_Patch_Internal(DM dm, PetscSection section,
     }
   }
   /* Cleanup */
-  PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+  PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
   PetscCall(PetscQuadratureDestroy(&qGeom));
   if (hasFV) PetscCall(MatSetOption(JacP, MAT_IGNORE_ZERO_ENTRIES, PETSC_FALSE));
   PetscCall(DMRestoreWorkArray(dm, Nf, MPIU_BOOL, &isFE));
@@ -4389,7 +4407,7 @@ static PetscErrorCode DMPlexComputeBdResidual_Single_Internal(DM dm, PetscReal t
       PetscCall(PetscObjectReference((PetscObject)qGeom));
     }
     PetscCall(PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL));
-    PetscCall(DMSNESGetFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+    PetscCall(DMSNESGetFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
     for (face = 0; face < numFaces; ++face) {
       const PetscInt point = points[face], *support;
       PetscScalar   *x     = NULL;
@@ -4448,7 +4466,7 @@ static PetscErrorCode DMPlexComputeBdResidual_Single_Internal(DM dm, PetscReal t
       PetscCall(DMPlexGetSupport(plex, point, &support));
       PetscCall(DMPlexVecSetClosure(plex, NULL, locF, support[0], &elemVec[face * totDim], ADD_ALL_VALUES));
     }
-    PetscCall(DMSNESRestoreFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
     PetscCall(PetscQuadratureDestroy(&qGeom));
     PetscCall(ISRestoreIndices(pointIS, &points));
     PetscCall(ISDestroy(&pointIS));
@@ -4599,7 +4617,7 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
     PetscCall(DMFieldGetDegree(coordField, cellIS, NULL, &maxDegree));
     if (maxDegree <= 1) {
       PetscCall(DMFieldCreateDefaultQuadrature(coordField, cellIS, &affineQuad));
-      if (affineQuad) PetscCall(DMSNESGetFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+      if (affineQuad) PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
     } else {
       PetscCall(PetscCalloc2(Nf, &quads, Nf, &geoms));
       for (f = 0; f < Nf; ++f) {
@@ -4616,7 +4634,7 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
 
           PetscCall(PetscFEGetQuadrature(fe, &quads[f]));
           PetscCall(PetscObjectReference((PetscObject)quads[f]));
-          PetscCall(DMSNESGetFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+          PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
         }
       }
     }
@@ -4827,11 +4845,11 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
     PetscCall(DMPlexComputeBdResidual_Internal(dm, locX, locX_t, t, locF, user));
 
     if (maxDegree <= 1) {
-      PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+      PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
       PetscCall(PetscQuadratureDestroy(&affineQuad));
     } else {
       for (f = 0; f < Nf; ++f) {
-        PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+        PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
         PetscCall(PetscQuadratureDestroy(&quads[f]));
       }
       PetscCall(PetscFree2(quads, geoms));
@@ -5016,10 +5034,10 @@ PetscErrorCode DMPlexComputeResidual_Hybrid_Internal(DM dm, PetscFormKey key[],
     /* Get geometric data */
     if (maxDegree <= 1) {
       if (!affineQuad) PetscCall(DMFieldCreateDefaultQuadrature(coordField, chunkIS, &affineQuad));
-      if (affineQuad) PetscCall(DMSNESGetFEGeom(coordField, chunkIS, affineQuad, PETSC_TRUE, &affineGeom));
+      if (affineQuad) PetscCall(DMSNESGetFEGeom(dm, coordField, chunkIS, affineQuad, PETSC_TRUE, &affineGeom));
     } else {
       for (f = 0; f < Nf; ++f) {
-        if (quads[f]) PetscCall(DMSNESGetFEGeom(coordField, chunkIS, quads[f], PETSC_TRUE, &geoms[f]));
+        if (quads[f]) PetscCall(DMSNESGetFEGeom(dm, coordField, chunkIS, quads[f], PETSC_TRUE, &geoms[f]));
       }
     }
     /* Loop over fields */
@@ -5081,11 +5099,11 @@ PetscErrorCode DMPlexComputeResidual_Hybrid_Internal(DM dm, PetscFormKey key[],
   PetscCall(ISDestroy(&chunkIS));
   PetscCall(ISRestorePointRange(cellIS, &cStart, &cEnd, &cells));
   if (maxDegree <= 1) {
-    PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
     PetscCall(PetscQuadratureDestroy(&affineQuad));
   } else {
     for (f = 0; f < Nf; ++f) {
-      if (geoms) PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+      if (geoms) PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
       if (quads) PetscCall(PetscQuadratureDestroy(&quads[f]));
     }
     PetscCall(PetscFree2(quads, geoms));
@@ -5180,7 +5198,7 @@ PetscErrorCode DMPlexComputeBdJacobian_Single_Internal(DM dm, PetscReal t, Petsc
       PetscCall(PetscObjectReference((PetscObject)qGeom));
     }
     PetscCall(PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL));
-    PetscCall(DMSNESGetFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+    PetscCall(DMSNESGetFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
     for (face = 0; face < numFaces; ++face) {
       const PetscInt point = points[face], *support;
       PetscScalar   *x     = NULL;
@@ -5244,7 +5262,7 @@ PetscErrorCode DMPlexComputeBdJacobian_Single_Internal(DM dm, PetscReal t, Petsc
       if (mesh->printFEM > 1) PetscCall(DMPrintCellMatrix(point, "BdJacobian", totDim, totDim, &elemMat[face * totDim * totDim]));
       PetscCall(DMPlexMatSetClosure(plex, section, globalSection, JacP, support[0], &elemMat[face * totDim * totDim], ADD_VALUES));
     }
-    PetscCall(DMSNESRestoreFEGeom(coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, pointIS, qGeom, PETSC_TRUE, &fgeom));
     PetscCall(PetscQuadratureDestroy(&qGeom));
     PetscCall(ISRestoreIndices(pointIS, &points));
     PetscCall(ISDestroy(&pointIS));
@@ -5408,7 +5426,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
       PetscCall(PetscObjectReference((PetscObject)qGeom));
     }
     PetscCall(PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL));
-    PetscCall(DMSNESGetFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
     blockSize = Nb;
     batchSize = numBlocks * blockSize;
     PetscCall(PetscFESetTileSizes(fe, blockSize, numBlocks, batchSize, numBatches));
@@ -5435,7 +5453,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
     }
     PetscCall(PetscFEGeomRestoreChunk(cgeomFEM, offset, numCells, &remGeom));
     PetscCall(PetscFEGeomRestoreChunk(cgeomFEM, 0, offset, &chunkGeom));
-    PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
     PetscCall(PetscQuadratureDestroy(&qGeom));
   }
   /*   Add contribution from X_t */
@@ -5637,11 +5655,11 @@ PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM dm, PetscFormKey key[],
     PetscCall(ISGeneralSetIndices(chunkIS, 1 * cellChunkSize, faces, PETSC_USE_POINTER));
     if (maxDegree <= 1) {
       if (!affineQuad) PetscCall(DMFieldCreateDefaultQuadrature(coordField, chunkIS, &affineQuad));
-      if (affineQuad) PetscCall(DMSNESGetFEGeom(coordField, chunkIS, affineQuad, PETSC_TRUE, &affineGeom));
+      if (affineQuad) PetscCall(DMSNESGetFEGeom(dm, coordField, chunkIS, affineQuad, PETSC_TRUE, &affineGeom));
     } else {
       PetscInt f;
       for (f = 0; f < Nf; ++f) {
-        if (quads[f]) PetscCall(DMSNESGetFEGeom(coordField, chunkIS, quads[f], PETSC_TRUE, &geoms[f]));
+        if (quads[f]) PetscCall(DMSNESGetFEGeom(dm, coordField, chunkIS, quads[f], PETSC_TRUE, &geoms[f]));
       }
     }
 
@@ -5726,12 +5744,12 @@ PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM dm, PetscFormKey key[],
   PetscCall(ISDestroy(&chunkIS));
   PetscCall(ISRestorePointRange(cellIS, &cStart, &cEnd, &cells));
   if (maxDegree <= 1) {
-    PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, affineQuad, PETSC_FALSE, &affineGeom));
     PetscCall(PetscQuadratureDestroy(&affineQuad));
   } else {
     PetscInt f;
     for (f = 0; f < Nf; ++f) {
-      if (geoms) PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
+      if (geoms) PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, quads[f], PETSC_FALSE, &geoms[f]));
       if (quads) PetscCall(PetscQuadratureDestroy(&quads[f]));
     }
     PetscCall(PetscFree2(quads, geoms));
@@ -5863,7 +5881,7 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
       PetscCall(PetscObjectReference((PetscObject)qGeom));
     }
     PetscCall(PetscQuadratureGetData(qGeom, NULL, NULL, &Nq, NULL, NULL));
-    PetscCall(DMSNESGetFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(DMSNESGetFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
     blockSize = Nb;
     batchSize = numBlocks * blockSize;
     PetscCall(PetscFESetTileSizes(fe, blockSize, numBlocks, batchSize, numBatches));
@@ -5884,7 +5902,7 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     }
     PetscCall(PetscFEGeomRestoreChunk(cgeomFEM, offset, numCells, &remGeom));
     PetscCall(PetscFEGeomRestoreChunk(cgeomFEM, 0, offset, &chunkGeom));
-    PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(DMSNESRestoreFEGeom(dm, coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
     PetscCall(PetscQuadratureDestroy(&qGeom));
   }
   if (hasDyn) {
@@ -796,11 +796,198 @@ PetscErrorCode DMPlexComputeGridHash_Internal(DM dm, PetscGridHash *localBox)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode DMPlexBVHDestroy_Internal(DMPlexBVH *bvh)
+{
+  PetscFunctionBegin;
+  if (*bvh) PetscCall(PetscFree5((*bvh)->box, (*bvh)->child, (*bvh)->start, (*bvh)->size, (*bvh)->cells));
+  PetscCall(PetscFree(*bvh));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The identity and state of the vertex and cellwise coordinates, used to detect that a hierarchy is out of date */
+static PetscErrorCode DMPlexBVHGetCoordinateState_Private(DM dm, PetscObjectId id[], PetscObjectState state[])
+{
+  Vec coordinates;
+
+  PetscFunctionBegin;
+  id[0] = id[1] = 0;
+  state[0] = state[1] = 0;
+  PetscCall(DMGetCoordinatesLocalNoncollective(dm, &coordinates));
+  if (coordinates) {
+    PetscCall(PetscObjectGetId((PetscObject)coordinates, &id[0]));
+    PetscCall(PetscObjectStateGet((PetscObject)coordinates, &state[0]));
+  }
+  PetscCall(DMGetCellCoordinatesLocalNoncollective(dm, &coordinates));
+  if (coordinates) {
+    PetscCall(PetscObjectGetId((PetscObject)coordinates, &id[1]));
+    PetscCall(PetscObjectStateGet((PetscObject)coordinates, &state[1]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Computes the box of a node from the boxes of its cells, and splits it at the median of the cell centers along the longest axis */
+static PetscErrorCode DMPlexBVHBuild_Private(DMPlexBVH bvh, const PetscReal cbox[], PetscInt perm[], PetscReal key[], PetscInt leafSize, PetscInt node)
+{
+  const PetscInt dim = bvh->dim, start = bvh->start[node], n = bvh->size[node];
+  PetscReal     *box = &bvh->box[node * 2 * dim], clower[3], cupper[3];
+  PetscInt       axis = 0, child;
+
+  PetscFunctionBegin;
+  for (PetscInt d = 0; d < dim; ++d) {
+    box[d] = clower[d] = PETSC_MAX_REAL;
+    box[dim + d] = cupper[d] = PETSC_MIN_REAL;
+  }
+  for (PetscInt i = start; i < start + n; ++i) {
+    const PetscReal *b = &cbox[perm[i] * 2 * dim];
+
+    for (PetscInt d = 0; d < dim; ++d) {
+      const PetscReal mid = 0.5 * (b[d] + b[dim + d]);
+
+      box[d]       = PetscMin(box[d], b[d]);
+      box[dim + d] = PetscMax(box[dim + d], b[dim + d]);
+      clower[d]    = PetscMin(clower[d], mid);
+      cupper[d]    = PetscMax(cupper[d], mid);
+    }
+  }
+  bvh->child[node] = -1;
+  if (n <= leafSize) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt d = 1; d < dim; ++d)
+    if (cupper[d] - clower[d] > cupper[axis] - clower[axis]) axis = d;
+  if (cupper[axis] <= clower[axis]) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt i = 0; i < n; ++i) key[i] = cbox[perm[start + i] * 2 * dim + axis] + cbox[perm[start + i] * 2 * dim + dim + axis];
+  PetscCall(PetscSortRealWithArrayInt(n, key, &perm[start]));
+  child = bvh->numNodes;
+  bvh->numNodes += 2;
+  bvh->child[node]      = child;
+  bvh->start[child]     = start;
+  bvh->size[child]      = n / 2;
+  bvh->start[child + 1] = start + n / 2;
+  bvh->size[child + 1]  = n - n / 2;
+  PetscCall(DMPlexBVHBuild_Private(bvh, cbox, perm, key, leafSize, child));
+  PetscCall(DMPlexBVHBuild_Private(bvh, cbox, perm, key, leafSize, child + 1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexComputeBVH_Internal - Create a bounding volume hierarchy over the bounding boxes of the local cells of the Plex
+
+  Not collective
+
+  Input Parameter:
+. dm - The Plex
+
+  Output Parameter:
+. bvh - The hierarchy
+
+  Note:
+  The cells of each leaf are ordered along the splitting axes, and the tree is balanced since each node is split at the median,
+  so that its depth is the logarithm of the number of cells whatever the grading of the mesh. As for the grid hash, the cells
+  which are leaves of the point SF are not included.
+
+  Level: developer
+
+.seealso: `DMPlexComputeGridHash_Internal()`, `DMLocatePoints()`
+*/
+static PetscErrorCode DMPlexComputeBVH_Internal(DM dm, DMPlexBVH *bvh)
+{
+  DMPlexBVH       b;
+  PetscSF         sf;
+  const PetscInt *leaves;
+  PetscReal      *cbox, *key, tol, extent = 0.0;
+  PetscInt       *perm, *cells, dim, Nl = 0, cStart, cEnd, numCells = 0, leafSize = 1, maxNodes;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&b));
+  PetscCall(DMGetCoordinateDim(dm, &dim));
+  PetscCall(DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd));
+  PetscCall(DMGetPointSF(dm, &sf));
+  if (sf) PetscCall(PetscSFGetGraph(sf, NULL, &Nl, &leaves, NULL));
+  Nl = PetscMax(Nl, 0);
+  PetscCall(PetscOptionsGetInt(NULL, ((PetscObject)dm)->prefix, "-dm_plex_bvh_leaf_size", &leafSize, NULL));
+  PetscCheck(leafSize > 0, PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Leaf size %" PetscInt_FMT " must be positive", leafSize);
+  PetscCall(PetscMalloc4(cEnd - cStart, &cells, (cEnd - cStart) * 2 * dim, &cbox, cEnd - cStart, &perm, cEnd - cStart, &key));
+  for (PetscInt c = cStart; c < cEnd; ++c) {
+    const PetscScalar *array;
+    PetscScalar       *coords = NULL;
+    PetscReal         *box    = &cbox[numCells * 2 * dim];
+    PetscInt           Nc, idx = -1;
+    PetscBool          isDG;
+
+    if (Nl) PetscCall(PetscFindInt(c, Nl, leaves, &idx));
+    if (idx >= 0) continue;
+    for (PetscInt d = 0; d < dim; ++d) {
+      box[d]       = PETSC_MAX_REAL;
+      box[dim + d] = PETSC_MIN_REAL;
+    }
+    PetscCall(DMPlexGetCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+    for (PetscInt i = 0; i < Nc; i += dim) {
+      for (PetscInt d = 0; d < dim; ++d) {
+        box[d]       = PetscMin(box[d], PetscRealPart(coords[i + d]));
+        box[dim + d] = PetscMax(box[dim + d], PetscRealPart(coords[i + d]));
+      }
+    }
+    PetscCall(DMPlexRestoreCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+    for (PetscInt d = 0; d < dim; ++d) extent = PetscMax(extent, box[dim + d] - box[d]);
+    perm[numCells]    = numCells;
+    cells[numCells++] = c;
+  }
+  /* enlarge the cell boxes slightly, so that points on the boundary of a cell are still tested against it */
+  tol = PETSC_SQRT_MACHINE_EPSILON * extent;
+  for (PetscInt i = 0; i < numCells; ++i) {
+    for (PetscInt d = 0; d < dim; ++d) {
+      cbox[i * 2 * dim + d] -= tol;
+      cbox[i * 2 * dim + dim + d] += tol;
+    }
+  }
+  maxNodes = PetscMax(2 * numCells - 1, 1);
+  b->dim   = dim;
+  PetscCall(PetscMalloc5(maxNodes * 2 * dim, &b->box, maxNodes, &b->child, maxNodes, &b->start, maxNodes, &b->size, numCells, &b->cells));
+  b->numNodes = 1;
+  b->start[0] = 0;
+  b->size[0]  = numCells;
+  PetscCall(DMPlexBVHBuild_Private(b, cbox, perm, key, leafSize, 0));
+  for (PetscInt i = 0; i < numCells; ++i) b->cells[i] = cells[perm[i]];
+  PetscCall(PetscFree4(cells, cbox, perm, key));
+  PetscCall(DMPlexBVHGetCoordinateState_Private(dm, b->coordId, b->coordState));
+  *bvh = b;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Descends the hierarchy through the nodes whose box contains the point, and tests the cells of the leaves reached */
+static PetscErrorCode DMPlexBVHLocatePoint_Private(DM dm, DMPlexBVH bvh, const PetscScalar point[], PetscInt *cell)
+{
+  const PetscInt dim = bvh->dim;
+  PetscInt       stack[128], top = 0;
+
+  PetscFunctionBegin;
+  *cell        = DMLOCATEPOINT_POINT_NOT_FOUND;
+  stack[top++] = 0;
+  while (top) {
+    const PetscInt   node = stack[--top];
+    const PetscReal *box  = &bvh->box[node * 2 * dim];
+    PetscBool        in   = PETSC_TRUE;
+
+    for (PetscInt d = 0; d < dim; ++d) in = (PetscBool)(in && PetscRealPart(point[d]) >= box[d] && PetscRealPart(point[d]) <= box[dim + d]);
+    if (!in) continue;
+    if (bvh->child[node] < 0) {
+      for (PetscInt c = bvh->start[node]; c < bvh->start[node] + bvh->size[node]; ++c) {
+        PetscCall(DMPlexLocatePoint_Internal(dm, dim, point, bvh->cells[c], cell));
+        if (*cell >= 0) PetscFunctionReturn(PETSC_SUCCESS);
+      }
+    } else {
+      /* the tree is balanced, so the stack holds at most one node per level plus one */
+      stack[top++] = bvh->child[node] + 1;
+      stack[top++] = bvh->child[node];
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, PetscSF cellSF)
 {
   PetscInt        debug = ((DM_Plex *)dm->data)->printLocate;
   DM_Plex        *mesh  = (DM_Plex *)dm->data;
-  PetscBool       hash = mesh->useHashLocation, reuse = PETSC_FALSE;
+  PetscBool       hash = mesh->useHashLocation, bvh = (PetscBool)(mesh->useBVHLocation && !mesh->useHashLocation), reuse = PETSC_FALSE;
   PetscInt        bs, numPoints, p, numFound, *found = NULL;
   PetscInt        dim, Nl = 0, cStart, cEnd, numCells, c, d;
   PetscSF         sf;
@@ -860,6 +1047,18 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
     /*   Should we bin points before doing search? */
     PetscCall(ISGetIndices(mesh->lbox->cells, &boxCells));
   }
+  if (bvh) {
+    PetscObjectId    id[2];
+    PetscObjectState state[2];
+
+    /* the hierarchy is kept on the mesh until the coordinates change */
+    PetscCall(DMPlexBVHGetCoordinateState_Private(dm, id, state));
+    if (mesh->bvh && (id[0] != mesh->bvh->coordId[0] || id[1] != mesh->bvh->coordId[1] || state[0] != mesh->bvh->coordState[0] || state[1] != mesh->bvh->coordState[1])) PetscCall(DMPlexBVHDestroy_Internal(&mesh->bvh));
+    if (!mesh->bvh) {
+      PetscCall(PetscInfo(dm, "Initializing bounding volume hierarchy\n"));
+      PetscCall(DMPlexComputeBVH_Internal(dm, &mesh->bvh));
+    }
+  }
   for (p = 0, numFound = 0; p < numPoints; ++p) {
     const PetscScalar *point   = &a[p * bs];
     PetscInt           dbin[3] = {-1, -1, -1}, bin, cell = -1, cellOffset;
@@ -923,6 +1122,14 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
           }
         }
       }
+    } else if (bvh) {
+      PetscCall(DMPlexBVHLocatePoint_Private(dm, mesh->bvh, point, &cell));
+      if (cell >= 0) {
+        cells[p].rank  = 0;
+        cells[p].index = cell;
+        numFound++;
+        terminating_query_type[2]++;
+      }
     } else {
       for (c = cStart; c < cEnd; ++c) {
         PetscInt idx;
@@ -986,6 +1193,8 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   PetscCall(PetscTime(&t1));
   if (hash) {
     PetscCall(PetscInfo(dm, "[DMLocatePoints_Plex] terminating_query_type : %" PetscInt_FMT " [outside domain] : %" PetscInt_FMT " [inside initial cell] : %" PetscInt_FMT " [hash]\n", terminating_query_type[0], terminating_query_type[1], terminating_query_type[2]));
+  } else if (bvh) {
+    PetscCall(PetscInfo(dm, "[DMLocatePoints_Plex] terminating_query_type : %" PetscInt_FMT " [outside domain] : %" PetscInt_FMT " [inside initial cell] : %" PetscInt_FMT " [bvh]\n", terminating_query_type[0], terminating_query_type[1], terminating_query_type[2]));
   } else {
     PetscCall(PetscInfo(dm, "[DMLocatePoints_Plex] terminating_query_type : %" PetscInt_FMT " [outside domain] : %" PetscInt_FMT " [inside initial cell] : %" PetscInt_FMT " [brute-force]\n", terminating_query_type[0], terminating_query_type[1], terminating_query_type[2]));
   }
@@ -2983,6 +3192,45 @@ PetscErrorCode DMPlexGetDataFVM(DM dm, PetscFV fv, Vec *cellgeom, Vec *facegeom,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Number of points whose Newton iterations are carried out together in DMPlexCoordinatesToReference() */
+#define DMPLEX_C2R_BATCH 64
+
+/* Inverse of the square Jacobian J of dimension dimR <= 3 */
+static inline void DMPlexCoordinatesToReference_Invert(PetscInt dimR, const PetscScalar J[], PetscScalar invJ[])
+{
+  PetscScalar det, idet;
+
+  switch (dimR) {
+  case 1:
+    invJ[0] = 1. / J[0];
+    break;
+  case 2:
+    det     = J[0] * J[3] - J[1] * J[2];
+    idet    = 1. / det;
+    invJ[0] = J[3] * idet;
+    invJ[1] = -J[1] * idet;
+    invJ[2] = -J[2] * idet;
+    invJ[3] = J[0] * idet;
+    break;
+  case 3: {
+    invJ[0] = J[4] * J[8] - J[5] * J[7];
+    invJ[1] = J[2] * J[7] - J[1] * J[8];
+    invJ[2] = J[1] * J[5] - J[2] * J[4];
+    det     = invJ[0] * J[0] + invJ[1] * J[3] + invJ[2] * J[6];
+    idet    = 1. / det;
+    invJ[0] *= idet;
+    invJ[1] *= idet;
+    invJ[2] *= idet;
+    invJ[3] = idet * (J[5] * J[6] - J[3] * J[8]);
+    invJ[4] = idet * (J[0] * J[8] - J[2] * J[6]);
+    invJ[5] = idet * (J[2] * J[3] - J[0] * J[5]);
+    invJ[6] = idet * (J[3] * J[7] - J[4] * J[6]);
+    invJ[7] = idet * (J[1] * J[6] - J[0] * J[7]);
+    invJ[8] = idet * (J[0] * J[4] - J[1] * J[3]);
+  } break;
+  }
+}
+
 static PetscErrorCode DMPlexCoordinatesToReference_NewtonUpdate(PetscInt dimC, PetscInt dimR, PetscScalar *J, PetscScalar *invJ, PetscScalar *work, PetscReal *resNeg, PetscReal *guess)
 {
   PetscInt l, m;
@@ -2990,37 +3238,7 @@ static PetscErrorCode DMPlexCoordinatesToReference_NewtonUpdate(PetscInt dimC, P
   PetscFunctionBeginHot;
   if (dimC == dimR && dimR <= 3) {
     /* invert Jacobian, multiply */
-    PetscScalar det, idet;
-
-    switch (dimR) {
-    case 1:
-      invJ[0] = 1. / J[0];
-      break;
-    case 2:
-      det     = J[0] * J[3] - J[1] * J[2];
-      idet    = 1. / det;
-      invJ[0] = J[3] * idet;
-      invJ[1] = -J[1] * idet;
-      invJ[2] = -J[2] * idet;
-      invJ[3] = J[0] * idet;
-      break;
-    case 3: {
-      invJ[0] = J[4] * J[8] - J[5] * J[7];
-      invJ[1] = J[2] * J[7] - J[1] * J[8];
-      invJ[2] = J[1] * J[5] - J[2] * J[4];
-      det     = invJ[0] * J[0] + invJ[1] * J[3] + invJ[2] * J[6];
-      idet    = 1. / det;
-      invJ[0] *= idet;
-      invJ[1] *= idet;
-      invJ[2] *= idet;
-      invJ[3] = idet * (J[5] * J[6] - J[3] * J[8]);
-      invJ[4] = idet * (J[0] * J[8] - J[2] * J[6]);
-      invJ[5] = idet * (J[2] * J[3] - J[0] * J[5]);
-      invJ[6] = idet * (J[3] * J[7] - J[4] * J[6]);
-      invJ[7] = idet * (J[1] * J[6] - J[0] * J[7]);
-      invJ[8] = idet * (J[0] * J[4] - J[1] * J[3]);
-    } break;
-    }
+    DMPlexCoordinatesToReference_Invert(dimR, J, invJ);
     for (l = 0; l < dimR; l++) {
       for (m = 0; m < dimC; m++) guess[l] += PetscRealPart(invJ[l * dimC + m]) * resNeg[m];
     }
@@ -3045,25 +3263,48 @@ static PetscErrorCode DMPlexCoordinatesToReference_NewtonUpdate(PetscInt dimC, P
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Newton updates of a batch of points, given the negative residuals and Jacobians of the active points. The points whose
+  update is below the tolerance are removed from the active set.
+*/
+static PetscErrorCode DMPlexCoordinatesToReference_BatchUpdate(PetscInt dimC, PetscInt dimR, PetscInt *numActive, PetscInt active[], PetscScalar J[], PetscReal resNeg[], PetscScalar *invJ, PetscScalar *work, PetscReal refCoords[])
+{
+  const PetscReal tol = PETSC_SMALL;
+  PetscInt        n   = 0;
+
+  PetscFunctionBeginHot;
+  for (PetscInt a = 0; a < *numActive; ++a) {
+    PetscReal *guess = &refCoords[dimR * active[a]], old[3], delta = 0.;
+
+    for (PetscInt l = 0; l < dimR; ++l) old[l] = guess[l];
+    PetscCall(DMPlexCoordinatesToReference_NewtonUpdate(dimC, dimR, &J[a * dimC * dimR], invJ, work, &resNeg[a * dimC], guess));
+    for (PetscInt l = 0; l < dimR; ++l) delta = PetscMax(delta, PetscAbsReal(guess[l] - old[l]));
+    if (delta > tol) active[n++] = active[a];
+  }
+  *numActive = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DMPlexCoordinatesToReference_Tensor(DM dm, PetscInt cell, PetscInt numPoints, const PetscReal realCoords[], PetscReal refCoords[], Vec coords, PetscInt dimC, PetscInt dimR)
 {
-  PetscInt     coordSize, i, j, k, l, m, maxIts = 7, numV = (1 << dimR);
+  PetscInt     coordSize, i, j, k, l, m, maxIts = 7, numV = (1 << dimR), *active;
   PetscScalar *coordsScalar = NULL;
-  PetscReal   *cellData, *cellCoords, *cellCoeffs, *extJ, *resNeg;
-  PetscScalar *J, *invJ, *work;
+  PetscReal   *cellData, *cellCoords, *cellCoeffs, *resNeg;
+  PetscScalar *J, *invJ, *work, *Jb;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscCall(DMPlexVecGetClosure(dm, NULL, coords, cell, &coordSize, &coordsScalar));
   PetscCheck(coordSize >= dimC * numV, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Expecting at least %" PetscInt_FMT " coordinates, got %" PetscInt_FMT, dimC * (1 << dimR), coordSize);
-  PetscCall(DMGetWorkArray(dm, 2 * coordSize + dimR + dimC, MPIU_REAL, &cellData));
-  PetscCall(DMGetWorkArray(dm, 3 * dimR * dimC, MPIU_SCALAR, &J));
+  PetscCall(DMGetWorkArray(dm, 2 * coordSize + DMPLEX_C2R_BATCH * dimC, MPIU_REAL, &cellData));
+  PetscCall(DMGetWorkArray(dm, (3 + DMPLEX_C2R_BATCH) * dimR * dimC, MPIU_SCALAR, &J));
+  PetscCall(DMGetWorkArray(dm, DMPLEX_C2R_BATCH, MPIU_INT, &active));
   cellCoords = &cellData[0];
   cellCoeffs = &cellData[coordSize];
-  extJ       = &cellData[2 * coordSize];
-  resNeg     = &cellData[2 * coordSize + dimR];
+  resNeg     = &cellData[2 * coordSize];
   invJ       = &J[dimR * dimC];
   work       = &J[2 * dimR * dimC];
+  Jb         = &J[3 * dimR * dimC];
   if (dimR == 2) {
     const PetscInt zToPlex[4] = {0, 1, 3, 2};
 
@@ -3101,49 +3342,74 @@ static PetscErrorCode DMPlexCoordinatesToReference_Tensor(DM dm, PetscInt cell,
     }
   }
   PetscCall(PetscArrayzero(refCoords, numPoints * dimR));
-  for (j = 0; j < numPoints; j++) {
-    for (i = 0; i < maxIts; i++) {
-      PetscReal *guess = &refCoords[dimR * j];
+  /* The map is affine when the coefficients of all multilinear terms vanish, it is then inverted once for all points */
+  if (dimC == dimR) {
+    PetscReal scale = 0., nonlinear = 0.;
 
-      /* compute -residual and Jacobian */
-      for (k = 0; k < dimC; k++) resNeg[k] = realCoords[dimC * j + k];
-      for (k = 0; k < dimC * dimR; k++) J[k] = 0.;
-      for (k = 0; k < numV; k++) {
-        PetscReal extCoord = 1.;
+    for (k = 1; k < numV; k++) {
+      for (l = 0; l < dimC; l++) {
+        if (k & (k - 1)) nonlinear = PetscMax(nonlinear, PetscAbsReal(cellCoeffs[dimC * k + l]));
+        else scale = PetscMax(scale, PetscAbsReal(cellCoeffs[dimC * k + l]));
+      }
+    }
+    if (nonlinear <= 100. * PETSC_MACHINE_EPSILON * scale) {
+      for (l = 0; l < dimC; l++) {
+        for (m = 0; m < dimR; m++) J[dimR * l + m] = cellCoeffs[dimC * (1 << m) + l];
+      }
+      DMPlexCoordinatesToReference_Invert(dimR, J, invJ);
+      for (j = 0; j < numPoints; j++) {
         for (l = 0; l < dimR; l++) {
-          PetscReal coord = guess[l];
-          PetscInt  dep   = (k & (1 << l)) >> l;
+          for (m = 0; m < dimC; m++) refCoords[dimR * j + l] += PetscRealPart(invJ[l * dimC + m]) * (realCoords[dimC * j + m] - cellCoeffs[m]);
+        }
+      }
+      numPoints = 0;
+    }
+  }
+  /* Newton iterations on batches of points, the converged points leave the batch */
+  for (PetscInt b = 0; b < numPoints; b += DMPLEX_C2R_BATCH) {
+    PetscInt numActive = PetscMin(DMPLEX_C2R_BATCH, numPoints - b);
 
-          extCoord *= dep * coord + !dep;
-          extJ[l] = dep;
+    for (j = 0; j < numActive; j++) active[j] = b + j;
+    for (i = 0; i < maxIts && numActive; i++) {
+      /* compute -residual and Jacobian of the active points */
+      for (j = 0; j < numActive; j++) {
+        for (k = 0; k < dimC; k++) resNeg[j * dimC + k] = realCoords[dimC * active[j] + k];
+      }
+      for (k = 0; k < numActive * dimC * dimR; k++) Jb[k] = 0.;
+      for (k = 0; k < numV; k++) {
+        for (j = 0; j < numActive; j++) {
+          const PetscReal *guess    = &refCoords[dimR * active[j]];
+          PetscReal        extCoord = 1., extJ[3];
+
+          for (l = 0; l < dimR; l++) {
+            PetscReal coord = guess[l];
+            PetscInt  dep   = (k & (1 << l)) >> l;
+
+            extCoord *= dep * coord + !dep;
+            extJ[l] = dep;
 
-          for (m = 0; m < dimR; m++) {
-            PetscReal coord = guess[m];
-            PetscInt  dep   = ((k & (1 << m)) >> m) && (m != l);
-            PetscReal mult  = dep * coord + !dep;
+            for (m = 0; m < dimR; m++) {
+              PetscReal coord = guess[m];
+              PetscInt  dep   = ((k & (1 << m)) >> m) && (m != l);
+              PetscReal mult  = dep * coord + !dep;
 
-            extJ[l] *= mult;
+              extJ[l] *= mult;
+            }
           }
-        }
-        for (l = 0; l < dimC; l++) {
-          PetscReal coeff = cellCoeffs[dimC * k + l];
+          for (l = 0; l < dimC; l++) {
+            PetscReal coeff = cellCoeffs[dimC * k + l];
 
-          resNeg[l] -= coeff * extCoord;
-          for (m = 0; m < dimR; m++) J[dimR * l + m] += coeff * extJ[m];
+            resNeg[j * dimC + l] -= coeff * extCoord;
+            for (m = 0; m < dimR; m++) Jb[(j * dimC + l) * dimR + m] += coeff * extJ[m];
+          }
         }
       }
-      if (0 && PetscDefined(USE_DEBUG)) {
-        PetscReal maxAbs = 0.;
-
-        for (l = 0; l < dimC; l++) maxAbs = PetscMax(maxAbs, PetscAbsReal(resNeg[l]));
-        PetscCall(PetscInfo(dm, "cell %" PetscInt_FMT ", point %" PetscInt_FMT ", iter %" PetscInt_FMT ": res %g\n", cell, j, i, (double)maxAbs));
-      }
-
-      PetscCall(DMPlexCoordinatesToReference_NewtonUpdate(dimC, dimR, J, invJ, work, resNeg, guess));
+      PetscCall(DMPlexCoordinatesToReference_BatchUpdate(dimC, dimR, &numActive, active, Jb, resNeg, invJ, work, refCoords));
     }
   }
-  PetscCall(DMRestoreWorkArray(dm, 3 * dimR * dimC, MPIU_SCALAR, &J));
-  PetscCall(DMRestoreWorkArray(dm, 2 * coordSize + dimR + dimC, MPIU_REAL, &cellData));
+  PetscCall(DMRestoreWorkArray(dm, DMPLEX_C2R_BATCH, MPIU_INT, &active));
+  PetscCall(DMRestoreWorkArray(dm, (3 + DMPLEX_C2R_BATCH) * dimR * dimC, MPIU_SCALAR, &J));
+  PetscCall(DMRestoreWorkArray(dm, 2 * coordSize + DMPLEX_C2R_BATCH * dimC, MPIU_REAL, &cellData));
   PetscCall(DMPlexVecRestoreClosure(dm, NULL, coords, cell, &coordSize, &coordsScalar));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -3225,10 +3491,10 @@ static PetscErrorCode DMPlexReferenceToCoordinates_Tensor(DM dm, PetscInt cell,
 /* TODO: TOBY please fix this for Nc > 1 */
 static PetscErrorCode DMPlexCoordinatesToReference_FE(DM dm, PetscFE fe, PetscInt cell, PetscInt numPoints, const PetscReal realCoords[], PetscReal refCoords[], Vec coords, PetscInt Nc, PetscInt dimR)
 {
-  PetscInt     numComp, pdim, i, j, k, l, m, maxIter = 7, coordSize;
+  PetscInt     numComp, pdim, i, j, k, l, m, b, maxIter = 7, coordSize, *active;
   PetscScalar *nodes = NULL;
   PetscReal   *invV, *modes;
-  PetscReal   *B, *D, *resNeg;
+  PetscReal   *B, *D, *resNeg, *guess;
   PetscScalar *J, *invJ, *work;
 
   PetscFunctionBegin;
@@ -3243,36 +3509,45 @@ static PetscErrorCode DMPlexCoordinatesToReference_FE(DM dm, PetscFE fe, PetscIn
     modes[i] = 0.;
     for (j = 0; j < pdim; ++j) modes[i] += invV[i * pdim + j] * PetscRealPart(nodes[j]);
   }
-  PetscCall(DMGetWorkArray(dm, pdim * Nc + pdim * Nc * dimR + Nc, MPIU_REAL, &B));
-  D      = &B[pdim * Nc];
-  resNeg = &D[pdim * Nc * dimR];
-  PetscCall(DMGetWorkArray(dm, 3 * Nc * dimR, MPIU_SCALAR, &J));
-  invJ = &J[Nc * dimR];
+  PetscCall(DMGetWorkArray(dm, DMPLEX_C2R_BATCH * (pdim * Nc + pdim * Nc * dimR + Nc + dimR), MPIU_REAL, &B));
+  D      = &B[DMPLEX_C2R_BATCH * pdim * Nc];
+  resNeg = &D[DMPLEX_C2R_BATCH * pdim * Nc * dimR];
+  guess  = &resNeg[DMPLEX_C2R_BATCH * Nc];
+  PetscCall(DMGetWorkArray(dm, (2 + DMPLEX_C2R_BATCH) * Nc * dimR, MPIU_SCALAR, &invJ));
   work = &invJ[Nc * dimR];
+  J    = &work[Nc * dimR];
+  PetscCall(DMGetWorkArray(dm, DMPLEX_C2R_BATCH, MPIU_INT, &active));
   for (i = 0; i < numPoints * dimR; i++) refCoords[i] = 0.;
-  for (j = 0; j < numPoints; j++) {
-    for (i = 0; i < maxIter; i++) { /* we could batch this so that we're not making big B and D arrays all the time */
-      PetscReal *guess = &refCoords[j * dimR];
-      PetscCall(PetscSpaceEvaluate(fe->basisSpace, 1, guess, B, D, NULL));
-      for (k = 0; k < Nc; k++) resNeg[k] = realCoords[j * Nc + k];
-      for (k = 0; k < Nc * dimR; k++) J[k] = 0.;
-      for (k = 0; k < pdim; k++) {
-        for (l = 0; l < Nc; l++) {
-          resNeg[l] -= modes[k] * B[k * Nc + l];
-          for (m = 0; m < dimR; m++) J[l * dimR + m] += modes[k] * D[(k * Nc + l) * dimR + m];
-        }
+  /* Newton iterations on batches of points, the basis is tabulated at all active points at once and the converged points leave the batch */
+  for (b = 0; b < numPoints; b += DMPLEX_C2R_BATCH) {
+    PetscInt numActive = PetscMin(DMPLEX_C2R_BATCH, numPoints - b);
+
+    for (j = 0; j < numActive; j++) active[j] = b + j;
+    for (i = 0; i < maxIter && numActive; i++) {
+      for (j = 0; j < numActive; j++) {
+        for (l = 0; l < dimR; l++) guess[j * dimR + l] = refCoords[active[j] * dimR + l];
       }
-      if (0 && PetscDefined(USE_DEBUG)) {
-        PetscReal maxAbs = 0.;
-
-        for (l = 0; l < Nc; l++) maxAbs = PetscMax(maxAbs, PetscAbsReal(resNeg[l]));
-        PetscCall(PetscInfo(dm, "cell %" PetscInt_FMT ", point %" PetscInt_FMT ", iter %" PetscInt_FMT ": res %g\n", cell, j, i, (double)maxAbs));
+      PetscCall(PetscSpaceEvaluate(fe->basisSpace, numActive, guess, B, D, NULL));
+      for (j = 0; j < numActive; j++) {
+        const PetscReal *Bj = &B[j * pdim * Nc], *Dj = &D[j * pdim * Nc * dimR];
+        PetscReal       *res = &resNeg[j * Nc];
+        PetscScalar     *Jj  = &J[j * Nc * dimR];
+
+        for (k = 0; k < Nc; k++) res[k] = realCoords[active[j] * Nc + k];
+        for (k = 0; k < Nc * dimR; k++) Jj[k] = 0.;
+        for (k = 0; k < pdim; k++) {
+          for (l = 0; l < Nc; l++) {
+            res[l] -= modes[k] * Bj[k * Nc + l];
+            for (m = 0; m < dimR; m++) Jj[l * dimR + m] += modes[k] * Dj[(k * Nc + l) * dimR + m];
+          }
+        }
       }
-      PetscCall(DMPlexCoordinatesToReference_NewtonUpdate(Nc, dimR, J, invJ, work, resNeg, guess));
+      PetscCall(DMPlexCoordinatesToReference_BatchUpdate(Nc, dimR, &numActive, active, J, resNeg, invJ, work, refCoords));
     }
   }
-  PetscCall(DMRestoreWorkArray(dm, 3 * Nc * dimR, MPIU_SCALAR, &J));
-  PetscCall(DMRestoreWorkArray(dm, pdim * Nc + pdim * Nc * dimR + Nc, MPIU_REAL, &B));
+  PetscCall(DMRestoreWorkArray(dm, DMPLEX_C2R_BATCH, MPIU_INT, &active));
+  PetscCall(DMRestoreWorkArray(dm, (2 + DMPLEX_C2R_BATCH) * Nc * dimR, MPIU_SCALAR, &invJ));
+  PetscCall(DMRestoreWorkArray(dm, DMPLEX_C2R_BATCH * (pdim * Nc + pdim * Nc * dimR + Nc + dimR), MPIU_REAL, &B));
   PetscCall(DMRestoreWorkArray(dm, pdim, MPIU_REAL, &modes));
   PetscCall(DMPlexVecRestoreClosure(dm, NULL, coords, cell, &coordSize, &nodes));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1373,6 +1373,603 @@ static PetscErrorCode GmshCreateFE(MPI_Comm comm, const char prefix[], PetscBool
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MPIIO)
+/* Location of a block of nodes or elements in a Gmsh 4.1 binary file */
+typedef struct {
+  PetscInt64 offset;   /* File offset of the first node tag or element record */
+  PetscInt64 count;    /* Number of nodes or elements in the block */
+  PetscInt64 dim;      /* Entity dimension */
+  PetscInt64 cellType; /* Gmsh element type, unused for nodes */
+  PetscInt64 tag;      /* First physical tag of the entity, or -1 */
+} GmshBlock;
+
+/*
+  Read the periodic section, returning the 0-based tags of the corresponding nodes in increasing order and, for each, the tag
+  of its primary node. A primary node that is itself the corresponding node of another link is replaced by the end of the chain.
+*/
+static PetscErrorCode GmshReadPeriodicNodes_Private(GmshFile *gmsh, PetscInt *numPeriodic, PetscInt **corresponding, PetscInt **primary)
+{
+  int       info[3];
+  double    dbuf[16];
+  PetscInt  numPeriodicLinks, numAffine, numCorrespondingNodes, *nodeTags = NULL, link, node, N = 0, size = 0, loc, k;
+  PetscInt *corr = NULL, *prim = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(GmshReadSize(gmsh, &numPeriodicLinks, 1));
+  for (link = 0; link < numPeriodicLinks; ++link) {
+    PetscCall(GmshReadInt(gmsh, info, 3));
+    PetscCall(GmshReadSize(gmsh, &numAffine, 1));
+    PetscCall(GmshReadDouble(gmsh, dbuf, numAffine));
+    PetscCall(GmshReadSize(gmsh, &numCorrespondingNodes, 1));
+    if (N + numCorrespondingNodes > size) {
+      size = PetscMax(2 * size, N + numCorrespondingNodes);
+      PetscCall(PetscRealloc(size * sizeof(PetscInt), &corr));
+      PetscCall(PetscRealloc(size * sizeof(PetscInt), &prim));
+    }
+    PetscCall(GmshBufferGet(gmsh, numCorrespondingNodes * 2, sizeof(PetscInt), &nodeTags));
+    PetscCall(GmshReadSize(gmsh, nodeTags, numCorrespondingNodes * 2));
+    for (node = 0; node < numCorrespondingNodes; ++node, ++N) {
+      corr[N] = nodeTags[node * 2 + 0] - 1;
+      prim[N] = nodeTags[node * 2 + 1] - 1;
+    }
+  }
+  PetscCall(PetscSortIntWithArray(N, corr, prim));
+  for (node = 0; node < N; ++node) {
+    for (k = 0; k < N; ++k) {
+      PetscCall(PetscFindInt(prim[node], N, corr, &loc));
+      if (loc < 0 || prim[loc] == prim[node]) break;
+      prim[node] = prim[loc];
+    }
+  }
+  *numPeriodic   = N;
+  *corresponding = corr;
+  *primary       = prim;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Scan the headers of a Gmsh 4.1 binary file on a single process, recording where each node and element block starts.
+  The block data is skipped with seeks, so the cost is proportional to the number of entity blocks only. The periodic
+  section, which only lists boundary nodes, is read entirely.
+*/
+static PetscErrorCode GmshScanBlocks_Private(const char filename[], GmshFile *gmsh, GmshMesh *mesh, PetscBool periodic, PetscInt *maxNodeTag, PetscInt *numNodeBlocks, GmshBlock **nodeBlocks, PetscInt *numElemBlocks, GmshBlock **elemBlocks, PetscInt *numPeriodic, PetscInt **corresponding, PetscInt **primary)
+{
+  GmshEntity *entity;
+  char        line[PETSC_MAX_PATH_LEN];
+  int         fd, info[3];
+  off_t       off, end;
+  PetscInt    sizes[4], b, n;
+  PetscBool   match;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerCreate(PETSC_COMM_SELF, &gmsh->viewer));
+  PetscCall(PetscViewerSetType(gmsh->viewer, PETSCVIEWERBINARY));
+  PetscCall(PetscViewerBinarySetSkipInfo(gmsh->viewer, PETSC_TRUE));
+  PetscCall(PetscViewerFileSetMode(gmsh->viewer, FILE_MODE_READ));
+  PetscCall(PetscViewerFileSetName(gmsh->viewer, filename));
+  PetscCall(PetscViewerBinaryGetDescriptor(gmsh->viewer, &fd));
+
+  PetscCall(GmshReadSection(gmsh, line));
+  PetscCall(GmshExpect(gmsh, "$MeshFormat", line));
+  PetscCall(GmshReadMeshFormat(gmsh));
+  PetscCall(GmshReadEndSection(gmsh, "$EndMeshFormat", line));
+  PetscCheck(gmsh->fileFormat == 41, PETSC_COMM_SELF, PETSC_ERR_SUP, "Parallel Gmsh reader requires file version 4.1, not %d.%d", gmsh->fileFormat / 10, gmsh->fileFormat % 10);
+
+  PetscCall(GmshReadSection(gmsh, line));
+  PetscCall(GmshMatch(gmsh, "$PhysicalNames", line, &match));
+  if (match) {
+    PetscCall(GmshReadPhysicalNames(gmsh, mesh));
+    PetscCall(GmshReadEndSection(gmsh, "$EndPhysicalNames", line));
+    PetscCall(GmshReadSection(gmsh, line));
+  }
+  PetscCall(GmshExpect(gmsh, "$Entities", line));
+  PetscCall(GmshReadEntities(gmsh, mesh));
+  PetscCall(GmshReadEndSection(gmsh, "$EndEntities", line));
+
+  PetscCall(GmshReadSection(gmsh, line));
+  PetscCall(GmshExpect(gmsh, "$Nodes", line));
+  PetscCall(GmshReadSize(gmsh, sizes, 4));
+  /* the vertex layout is indexed by node tag */
+  PetscCheck(!sizes[1] || (sizes[2] == 1 && sizes[3] == sizes[1]), PETSC_COMM_SELF, PETSC_ERR_SUP, "Parallel Gmsh reader requires node tags numbered from 1 to the number of nodes %" PetscInt_FMT ", not from %" PetscInt_FMT " to %" PetscInt_FMT ", renumber the nodes in Gmsh", sizes[1], sizes[2], sizes[3]);
+  *maxNodeTag    = sizes[3];
+  *numNodeBlocks = sizes[0];
+  PetscCall(PetscMalloc1(sizes[0], nodeBlocks));
+  for (b = 0; b < *numNodeBlocks; ++b) {
+    GmshBlock *block = &(*nodeBlocks)[b];
+
+    PetscCall(GmshReadInt(gmsh, info, 3));
+    PetscCheck(!info[2], PETSC_COMM_SELF, PETSC_ERR_SUP, "Parametric coordinates not supported");
+    PetscCall(GmshReadSize(gmsh, &n, 1));
+    PetscCall(PetscBinarySeek(fd, 0, PETSC_BINARY_SEEK_CUR, &off));
+    block->offset   = (PetscInt64)off;
+    block->count    = n;
+    block->dim      = info[0];
+    block->cellType = -1;
+    block->tag      = -1;
+    PetscCall(PetscBinarySeek(fd, (off_t)(n * gmsh->dataSize + n * 3 * sizeof(double)), PETSC_BINARY_SEEK_CUR, &off));
+  }
+  PetscCall(GmshReadEndSection(gmsh, "$EndNodes", line));
+
+  PetscCall(GmshReadSection(gmsh, line));
+  PetscCall(GmshExpect(gmsh, "$Elements", line));
+  PetscCall(GmshReadSize(gmsh, sizes, 4));
+  *numElemBlocks = sizes[0];
+  PetscCall(PetscMalloc1(sizes[0], elemBlocks));
+  for (b = 0; b < *numElemBlocks; ++b) {
+    GmshBlock *block = &(*elemBlocks)[b];
+
+    PetscCall(GmshReadInt(gmsh, info, 3));
+    PetscCall(GmshEntitiesGet(mesh->entities, info[0], info[1], &entity));
+    PetscCall(GmshCellTypeCheck(info[2]));
+    PetscCall(GmshReadSize(gmsh, &n, 1));
+    PetscCall(PetscBinarySeek(fd, 0, PETSC_BINARY_SEEK_CUR, &off));
+    block->offset   = (PetscInt64)off;
+    block->count    = n;
+    block->dim      = info[0];
+    block->cellType = info[2];
+    block->tag      = entity->numTags > 0 ? entity->tags[0] : -1;
+    PetscCall(PetscBinarySeek(fd, (off_t)(n * (1 + GmshCellMap[info[2]].numNodes) * gmsh->dataSize), PETSC_BINARY_SEEK_CUR, &off));
+  }
+  PetscCall(GmshReadEndSection(gmsh, "$EndElements", line));
+
+  /* the periodic section is optional and the file may end with the elements */
+  *numPeriodic = 0;
+  if (periodic) {
+    PetscCall(PetscBinarySeek(fd, 0, PETSC_BINARY_SEEK_CUR, &off));
+    PetscCall(PetscBinarySeek(fd, 0, PETSC_BINARY_SEEK_END, &end));
+    PetscCall(PetscBinarySeek(fd, off, PETSC_BINARY_SEEK_SET, &off));
+    match = PETSC_FALSE;
+    if (off < end) {
+      PetscCall(GmshReadSection(gmsh, line));
+      PetscCall(GmshMatch(gmsh, "$Periodic", line, &match));
+    }
+    if (match) {
+      PetscCall(GmshReadPeriodicNodes_Private(gmsh, numPeriodic, corresponding, primary));
+      PetscCall(GmshReadEndSection(gmsh, "$EndPeriodic", line));
+    }
+  }
+  PetscCall(PetscViewerDestroy(&gmsh->viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Read count sizes starting at file offset off, converting them to PetscInt */
+static PetscErrorCode GmshReadSizeAt_Private(GmshFile *gmsh, MPI_File fh, MPI_Offset off, PetscInt *buf, PetscInt count)
+{
+  PetscMPIInt cnt;
+  MPI_Status  status;
+  PetscInt    i;
+
+  PetscFunctionBegin;
+  if (!count) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMPIIntCast(count, &cnt));
+  if (gmsh->dataSize == sizeof(PetscInt64)) {
+    PetscInt64 *ibuf = NULL;
+
+    PetscCall(GmshBufferSizeGet(gmsh, count, &ibuf));
+    PetscCall(MPIU_File_read_at(fh, off, ibuf, cnt, MPIU_INT64, &status));
+    if (gmsh->byteSwap) PetscCall(PetscByteSwap(ibuf, PETSC_INT64, count));
+    for (i = 0; i < count; ++i) buf[i] = (PetscInt)ibuf[i];
+  } else {
+    int *ibuf = NULL;
+
+    PetscCall(GmshBufferSizeGet(gmsh, count, &ibuf));
+    PetscCall(MPIU_File_read_at(fh, off, ibuf, cnt, MPI_INT, &status));
+    if (gmsh->byteSwap) PetscCall(PetscByteSwap(ibuf, PETSC_ENUM, count));
+    for (i = 0; i < count; ++i) buf[i] = (PetscInt)ibuf[i];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Count the items in the blocks of dimension dim; the items with global numbers [start, end) are read by this process */
+static PetscErrorCode GmshBlocksGetRange_Private(MPI_Comm comm, PetscInt numBlocks, const GmshBlock blocks[], PetscInt dim, PetscInt *start, PetscInt *end)
+{
+  PetscInt b, N = 0, n = PETSC_DECIDE;
+
+  PetscFunctionBegin;
+  for (b = 0; b < numBlocks; ++b)
+    if (dim < 0 || blocks[b].dim == dim) N += (PetscInt)blocks[b].count;
+  PetscCall(PetscSplitOwnership(comm, &n, &N));
+  PetscCallMPI(MPI_Scan(&n, end, 1, MPIU_INT, MPI_SUM, comm));
+  *start = *end - n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Read the elements of dimension dim with global numbers [start, end), storing the vertices of each as 0-based global
+  vertex numbers in Plex order, padded with -1 up to the width w, and the physical tag of its entity in tags
+*/
+static PetscErrorCode GmshReadElementRange_Private(GmshFile *gmsh, MPI_File fh, PetscInt numBlocks, const GmshBlock blocks[], PetscInt dim, PetscInt start, PetscInt end, PetscInt w, PetscInt elems[], PetscInt tags[])
+{
+  PetscInt b, gStart = 0, *ibuf = NULL;
+
+  PetscFunctionBegin;
+  for (b = 0; b < numBlocks; ++b) {
+    const GmshBlock     *block = &blocks[b];
+    const PetscInt       Nn    = GmshCellMap[block->cellType].numNodes;
+    const PetscInt       Nv    = GmshCellMap[block->cellType].numVerts;
+    const DMPolytopeType ct    = DMPolytopeTypeFromGmsh(block->cellType);
+    PetscInt             lo, hi, e, v;
+
+    if (block->dim != dim) continue;
+    lo = PetscMax(start, gStart);
+    hi = PetscMin(end, gStart + (PetscInt)block->count);
+    if (lo < hi) {
+      PetscCall(PetscMalloc1((hi - lo) * (1 + Nn), &ibuf));
+      PetscCall(GmshReadSizeAt_Private(gmsh, fh, (MPI_Offset)(block->offset + (lo - gStart) * (1 + Nn) * gmsh->dataSize), ibuf, (hi - lo) * (1 + Nn)));
+      for (e = lo; e < hi; ++e) {
+        const PetscInt *nodes = &ibuf[(e - lo) * (1 + Nn) + 1];
+        PetscInt       *elem  = &elems[(e - start) * w];
+
+        for (v = 0; v < w; ++v) elem[v] = v < Nv ? nodes[v] - 1 : -1;
+        PetscCall(DMPlexInvertCell(ct, elem));
+        if (tags) tags[e - start] = (PetscInt)block->tag;
+      }
+      PetscCall(PetscFree(ibuf));
+    }
+    gStart += (PetscInt)block->count;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Mark the facets given by Gmsh elements of dimension dim-1. Each element is sent to the owner of its first vertex in the
+  vertex layout, and from there to every process sharing that vertex, which looks for the facet with a vertex join.
+*/
+static PetscErrorCode GmshCreateFaceSets_Private(DM dm, PetscSF vertexSF, PetscInt numVerticesAdj, const PetscInt verticesAdj[], PetscInt numFaces, const PetscInt faces[], const PetscInt faceTags[], PetscBool *hasFaceSets)
+{
+  enum {
+    w = 6
+  }; /* Tag and vertex count followed by at most 4 vertices */
+  PetscSF            faceSF, recvSF;
+  PetscLayout        layout;
+  MPI_Datatype       facetype;
+  DMLabel            faceSets = NULL;
+  const PetscInt    *degree;
+  const PetscSFNode *iremote;
+  PetscSFNode       *remote;
+  PetscInt          *send, *multi, *rootInfo, *leafInfo, *recv, *first;
+  PetscInt           nroots, nleaves, nmulti = 0, nrecv = 0, vStart, f, r, l, k;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexGetDepthStratum(dm, 0, &vStart, NULL));
+  PetscCall(PetscSFGetGraph(vertexSF, &nroots, &nleaves, NULL, &iremote));
+  PetscCallMPI(MPI_Type_contiguous(w, MPIU_INT, &facetype));
+  PetscCallMPI(MPI_Type_commit(&facetype));
+  /* Send each face to the owner of its first vertex */
+  PetscCall(PetscMalloc2(numFaces * w, &send, numFaces, &first));
+  for (f = 0; f < numFaces; ++f) {
+    send[f * w + 0] = faceTags[f];
+    send[f * w + 1] = 0;
+    for (k = 0; k < w - 2; ++k) {
+      send[f * w + 2 + k] = faces[f * (w - 2) + k];
+      if (faces[f * (w - 2) + k] >= 0) ++send[f * w + 1];
+    }
+    first[f] = faces[f * (w - 2)];
+  }
+  PetscCall(PetscSFGetGraphLayout(vertexSF, &layout, NULL, NULL, NULL));
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &faceSF));
+  PetscCall(PetscSFSetGraphLayout(faceSF, layout, numFaces, NULL, PETSC_OWN_POINTER, first));
+  PetscCall(PetscLayoutDestroy(&layout));
+  PetscCall(PetscSFComputeDegreeBegin(faceSF, &degree));
+  PetscCall(PetscSFComputeDegreeEnd(faceSF, &degree));
+  for (r = 0; r < nroots; ++r) nmulti += degree[r];
+  PetscCall(PetscMalloc1(nmulti * w, &multi));
+  PetscCall(PetscSFGatherBegin(faceSF, facetype, send, multi));
+  PetscCall(PetscSFGatherEnd(faceSF, facetype, send, multi));
+  /* Tell every process sharing a vertex where its faces are stored */
+  PetscCall(PetscMalloc2(nroots * 2, &rootInfo, nleaves * 2, &leafInfo));
+  for (r = 0, k = 0; r < nroots; k += degree[r], ++r) {
+    rootInfo[r * 2 + 0] = k;
+    rootInfo[r * 2 + 1] = degree[r];
+  }
+  PetscCall(PetscSFBcastBegin(vertexSF, MPIU_2INT, rootInfo, leafInfo, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(vertexSF, MPIU_2INT, rootInfo, leafInfo, MPI_REPLACE));
+  for (l = 0; l < nleaves; ++l) nrecv += leafInfo[l * 2 + 1];
+  PetscCall(PetscMalloc1(nrecv, &remote));
+  for (l = 0, f = 0; l < nleaves; ++l) {
+    for (k = 0; k < leafInfo[l * 2 + 1]; ++k, ++f) {
+      remote[f].rank  = iremote[l].rank;
+      remote[f].index = leafInfo[l * 2 + 0] + k;
+    }
+  }
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &recvSF));
+  PetscCall(PetscSFSetGraph(recvSF, nmulti, nrecv, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER));
+  PetscCall(PetscMalloc1(nrecv * w, &recv));
+  PetscCall(PetscSFBcastBegin(recvSF, facetype, multi, recv, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(recvSF, facetype, multi, recv, MPI_REPLACE));
+  /* Find the local facets */
+  for (f = 0; f < nrecv; ++f) {
+    const PetscInt *face = &recv[f * w];
+    const PetscInt *join = NULL;
+    PetscInt        cone[w - 2], joinSize, lv;
+
+    for (k = 0; k < face[1]; ++k) {
+      PetscCall(PetscFindInt(face[2 + k], numVerticesAdj, verticesAdj, &lv));
+      if (lv < 0) break;
+      cone[k] = vStart + lv;
+    }
+    if (k < face[1]) continue;
+    PetscCall(DMPlexGetFullJoin(dm, face[1], cone, &joinSize, &join));
+    if (joinSize == 1 && face[0] >= 0) PetscCall(DMSetLabelValue_Fast(dm, &faceSets, "Face Sets", join[0], face[0]));
+    PetscCall(DMPlexRestoreJoin(dm, face[1], cone, &joinSize, &join));
+  }
+  *hasFaceSets = faceSets ? PETSC_TRUE : PETSC_FALSE;
+  PetscCallMPI(MPI_Type_free(&facetype));
+  PetscCall(PetscSFDestroy(&faceSF));
+  PetscCall(PetscSFDestroy(&recvSF));
+  PetscCall(PetscFree2(send, first));
+  PetscCall(PetscFree(multi));
+  PetscCall(PetscFree2(rootInfo, leafInfo));
+  PetscCall(PetscFree(recv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Replace the corresponding nodes of the periodic links by their primary nodes, negative entries are padding */
+static PetscErrorCode GmshMapPeriodicNodes_Private(PetscInt numPeriodic, const PetscInt corresponding[], const PetscInt primary[], PetscInt n, PetscInt nodes[])
+{
+  PetscInt i, loc;
+
+  PetscFunctionBegin;
+  for (i = 0; i < n; ++i) {
+    if (nodes[i] < 0) continue;
+    PetscCall(PetscFindInt(nodes[i], numPeriodic, corresponding, &loc));
+    if (loc >= 0) nodes[i] = primary[loc];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Give cellwise coordinates to the cells with a node on a periodic boundary, as the sequential reader does. The coordinates
+  are those of the nodes the cell was read with, origCells, fetched from the owners in the vertex layout, while cells holds
+  the nodes after the identification of the periodic links.
+*/
+static PetscErrorCode GmshLocalizeCoordinates_Private(DM dm, PetscLayout vertexLayout, const PetscReal coords[], PetscInt numVerticesAdj, const PetscInt verticesAdj[], PetscInt numCells, PetscInt Nv, const PetscInt cells[], const PetscInt origCells[], PetscInt numPeriodic, const PetscInt corresponding[], const PetscInt primary[])
+{
+  DM           cdm, cdmCell;
+  PetscSF      sf;
+  PetscSection csCell;
+  Vec          coordinatesCell;
+  MPI_Datatype xyztype;
+  PetscReal   *cellXYZ;
+  PetscScalar *cellCoords;
+  PetscInt    *primaries, numPrimaries = numPeriodic, coordDim, vStart, c, k, d, loc;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetCoordinateDim(dm, &coordDim));
+  PetscCall(DMPlexGetDepthStratum(dm, 0, &vStart, NULL));
+  PetscCall(PetscMalloc1(numCells * Nv * 3, &cellXYZ));
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &sf));
+  PetscCall(PetscSFSetGraphLayout(sf, vertexLayout, numCells * Nv, NULL, PETSC_COPY_VALUES, origCells));
+  PetscCallMPI(MPI_Type_contiguous(3, MPIU_REAL, &xyztype));
+  PetscCallMPI(MPI_Type_commit(&xyztype));
+  PetscCall(PetscSFBcastBegin(sf, xyztype, coords, cellXYZ, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, xyztype, coords, cellXYZ, MPI_REPLACE));
+  PetscCallMPI(MPI_Type_free(&xyztype));
+  PetscCall(PetscSFDestroy(&sf));
+  /* the cells touching either side of a periodic link are localized */
+  PetscCall(PetscMalloc1(numPeriodic, &primaries));
+  PetscCall(PetscArraycpy(primaries, primary, numPeriodic));
+  PetscCall(PetscSortRemoveDupsInt(&numPrimaries, primaries));
+
+  PetscCall(DMGetCoordinateDM(dm, &cdm));
+  PetscCall(DMClone(cdm, &cdmCell));
+  PetscCall(DMSetCellCoordinateDM(dm, cdmCell));
+  PetscCall(PetscSectionCreate(PetscObjectComm((PetscObject)cdmCell), &csCell));
+  PetscCall(PetscSectionSetNumFields(csCell, 1));
+  PetscCall(PetscSectionSetFieldComponents(csCell, 0, coordDim));
+  PetscCall(PetscSectionSetChart(csCell, 0, numCells));
+  for (c = 0; c < numCells; ++c) {
+    for (k = 0; k < Nv; ++k) {
+      PetscCall(PetscFindInt(origCells[c * Nv + k], numPeriodic, corresponding, &loc));
+      if (loc < 0) PetscCall(PetscFindInt(origCells[c * Nv + k], numPrimaries, primaries, &loc));
+      if (loc >= 0) break;
+    }
+    if (k == Nv) continue;
+    PetscCall(PetscSectionSetDof(csCell, c, Nv * coordDim));
+    PetscCall(PetscSectionSetFieldDof(csCell, c, 0, Nv * coordDim));
+  }
+  PetscCall(PetscSectionSetUp(csCell));
+  PetscCall(DMSetCellCoordinateSection(dm, PETSC_DETERMINE, csCell));
+  PetscCall(DMCreateLocalVector(cdmCell, &coordinatesCell));
+  PetscCall(VecGetArray(coordinatesCell, &cellCoords));
+  for (c = 0; c < numCells; ++c) {
+    PetscInt *closure = NULL, Ncl, cl, dof, off;
+
+    PetscCall(PetscSectionGetDof(csCell, c, &dof));
+    if (!dof) continue;
+    PetscCall(PetscSectionGetOffset(csCell, c, &off));
+    PetscCall(DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &Ncl, &closure));
+    for (cl = 0; cl < Ncl * 2; cl += 2) {
+      const PetscInt lv = closure[cl] - vStart;
+
+      if (lv < 0 || lv >= numVerticesAdj) continue;
+      for (k = 0; k < Nv; ++k)
+        if (cells[c * Nv + k] == verticesAdj[lv]) break;
+      PetscCheck(k < Nv, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Could not find vertex %" PetscInt_FMT " in Gmsh cell %" PetscInt_FMT, verticesAdj[lv], c);
+      for (d = 0; d < coordDim; ++d) cellCoords[off++] = cellXYZ[(c * Nv + k) * 3 + d];
+    }
+    PetscCall(DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &Ncl, &closure));
+  }
+  PetscCall(VecRestoreArray(coordinatesCell, &cellCoords));
+  PetscCall(VecSetBlockSize(coordinatesCell, coordDim));
+  PetscCall(DMSetCellCoordinatesLocal(dm, coordinatesCell));
+  PetscCall(VecDestroy(&coordinatesCell));
+  PetscCall(PetscSectionDestroy(&csCell));
+  PetscCall(DMDestroy(&cdmCell));
+  PetscCall(PetscFree(primaries));
+  PetscCall(PetscFree(cellXYZ));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Read a Gmsh 4.1 binary file with MPI-IO. Rank 0 only scans the section and block headers, then every process reads
+  an even slice of the nodes and elements directly from the file. The resulting mesh is distributed in file order.
+*/
+static PetscErrorCode DMPlexCreateGmsh_Parallel(MPI_Comm comm, const char filename[], PetscBool interpolate, PetscBool periodic, PetscInt coordDim, DM *dm)
+{
+  GmshFile     gmsh[1];
+  GmshBlock   *nodeBlocks = NULL, *elemBlocks = NULL;
+  MPI_File     fh;
+  MPI_Datatype xyztype;
+  PetscSF      nodeSF, vertexSF;
+  PetscLayout  vertexLayout;
+  DMLabel      cellSets = NULL;
+  PetscInt     hdr[7]   = {0, 0, 0, 0, 0, 0, 0}, numNodeBlocks, numElemBlocks, maxNodeTag, dim = 0, cellType = -1, Nv, b;
+  PetscInt     nStart, nEnd, cStart, cEnd, fStart, fEnd, numVertices, numVerticesAdj, *verticesAdj = NULL;
+  PetscInt    *nodeTags, *cells, *cellTags, *origCells = NULL, *faces = NULL, *faceTags = NULL, c, n, d;
+  PetscInt     numPeriodic = 0, *corresponding = NULL, *primary = NULL;
+  PetscReal   *nodeCoords, *vertexCoords, *coords;
+  PetscBool    flg[2];
+  PetscMPIInt  rank;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscArrayzero(gmsh, 1));
+  gmsh->binary = PETSC_TRUE;
+  if (rank == 0) {
+    GmshMesh *mesh = NULL;
+
+    /* An error in the scan is only known on rank 0, so it is broadcast with the header and raised on all processes */
+    PetscCall(GmshMeshCreate(&mesh));
+    hdr[5] = (PetscInt)GmshScanBlocks_Private(filename, gmsh, mesh, periodic, &maxNodeTag, &numNodeBlocks, &nodeBlocks, &numElemBlocks, &elemBlocks, &numPeriodic, &corresponding, &primary);
+    PetscCall(GmshMeshDestroy(&mesh));
+    if (!hdr[5]) {
+      hdr[0] = gmsh->dataSize;
+      hdr[1] = gmsh->byteSwap;
+      hdr[2] = maxNodeTag;
+      hdr[3] = numNodeBlocks;
+      hdr[4] = numElemBlocks;
+      hdr[6] = numPeriodic;
+    } else {
+      PetscCall(PetscViewerDestroy(&gmsh->viewer));
+      PetscCall(PetscFree(gmsh->wbuf));
+      PetscCall(PetscFree(gmsh->sbuf));
+      PetscCall(PetscFree(nodeBlocks));
+      PetscCall(PetscFree(elemBlocks));
+      PetscCall(PetscFree(corresponding));
+      PetscCall(PetscFree(primary));
+    }
+  }
+  PetscCallMPI(MPI_Bcast(hdr, 7, MPIU_INT, 0, comm));
+  PetscCheck(!hdr[5], comm, (PetscErrorCode)hdr[5], "Could not read the headers of Gmsh file %s", filename);
+  gmsh->dataSize = (int)hdr[0];
+  gmsh->byteSwap = hdr[1] ? PETSC_TRUE : PETSC_FALSE;
+  maxNodeTag     = hdr[2];
+  numNodeBlocks  = hdr[3];
+  numElemBlocks  = hdr[4];
+  numPeriodic    = hdr[6];
+  if (numPeriodic) {
+    if (rank) PetscCall(PetscMalloc1(numPeriodic, &corresponding));
+    if (rank) PetscCall(PetscMalloc1(numPeriodic, &primary));
+    PetscCallMPI(MPI_Bcast(corresponding, (PetscMPIInt)numPeriodic, MPIU_INT, 0, comm));
+    PetscCallMPI(MPI_Bcast(primary, (PetscMPIInt)numPeriodic, MPIU_INT, 0, comm));
+  }
+  if (rank) PetscCall(PetscMalloc2(numNodeBlocks, &nodeBlocks, numElemBlocks, &elemBlocks));
+  else {
+    GmshBlock *nb = nodeBlocks, *eb = elemBlocks;
+
+    PetscCall(PetscMalloc2(numNodeBlocks, &nodeBlocks, numElemBlocks, &elemBlocks));
+    PetscCall(PetscArraycpy(nodeBlocks, nb, numNodeBlocks));
+    PetscCall(PetscArraycpy(elemBlocks, eb, numElemBlocks));
+    PetscCall(PetscFree(nb));
+    PetscCall(PetscFree(eb));
+  }
+  PetscCallMPI(MPI_Bcast(nodeBlocks, (PetscMPIInt)(numNodeBlocks * 5), MPIU_INT64, 0, comm));
+  PetscCallMPI(MPI_Bcast(elemBlocks, (PetscMPIInt)(numElemBlocks * 5), MPIU_INT64, 0, comm));
+  for (b = 0; b < numElemBlocks; ++b) dim = PetscMax(dim, (PetscInt)elemBlocks[b].dim);
+  for (b = 0; b < numElemBlocks; ++b) {
+    if (elemBlocks[b].dim != dim) continue;
+    if (cellType < 0) cellType = (PetscInt)elemBlocks[b].cellType;
+    PetscCheck(GmshCellMap[elemBlocks[b].cellType].polytope == GmshCellMap[cellType].polytope, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support meshes with mixed cell types");
+  }
+  PetscCheck(cellType >= 0, comm, PETSC_ERR_FILE_UNEXPECTED, "Gmsh file has no elements");
+  Nv = GmshCellMap[cellType].numVerts;
+  if (coordDim < 0) coordDim = dim;
+
+  PetscCallMPI(MPI_File_open(comm, filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh));
+  /* Read a slice of the nodes and send the coordinates to the owners in the vertex layout */
+  PetscCall(GmshBlocksGetRange_Private(comm, numNodeBlocks, nodeBlocks, -1, &nStart, &nEnd));
+  PetscCall(PetscMalloc2(nEnd - nStart, &nodeTags, (nEnd - nStart) * 3, &nodeCoords));
+  for (b = 0, n = 0; b < numNodeBlocks; n += (PetscInt)nodeBlocks[b].count, ++b) {
+    const GmshBlock *block = &nodeBlocks[b];
+    const PetscInt   lo = PetscMax(nStart, n), hi = PetscMin(nEnd, n + (PetscInt)block->count);
+    double          *xyz = NULL;
+    PetscMPIInt      cnt;
+    MPI_Status       status;
+    PetscInt         i;
+
+    if (lo >= hi) continue;
+    PetscCall(GmshReadSizeAt_Private(gmsh, fh, (MPI_Offset)(block->offset + (lo - n) * gmsh->dataSize), &nodeTags[lo - nStart], hi - lo));
+    PetscCall(GmshBufferGet(gmsh, (hi - lo) * 3, sizeof(double), &xyz));
+    PetscCall(PetscMPIIntCast((hi - lo) * 3, &cnt));
+    PetscCall(MPIU_File_read_at(fh, (MPI_Offset)(block->offset + block->count * gmsh->dataSize + (lo - n) * 3 * sizeof(double)), xyz, cnt, MPI_DOUBLE, &status));
+    if (gmsh->byteSwap) PetscCall(PetscByteSwap(xyz, PETSC_DOUBLE, cnt));
+    for (i = lo; i < hi; ++i) {
+      nodeTags[i - nStart] -= 1;
+      for (d = 0; d < 3; ++d) nodeCoords[(i - nStart) * 3 + d] = (PetscReal)xyz[(i - lo) * 3 + d];
+    }
+  }
+  PetscCall(PetscLayoutCreateFromSizes(comm, PETSC_DECIDE, maxNodeTag, 1, &vertexLayout));
+  PetscCall(PetscLayoutGetLocalSize(vertexLayout, &numVertices));
+  PetscCall(PetscMalloc2(numVertices * 3, &coords, numVertices * coordDim, &vertexCoords));
+  PetscCall(PetscSFCreate(comm, &nodeSF));
+  PetscCall(PetscSFSetGraphLayout(nodeSF, vertexLayout, nEnd - nStart, NULL, PETSC_OWN_POINTER, nodeTags));
+  PetscCallMPI(MPI_Type_contiguous(3, MPIU_REAL, &xyztype));
+  PetscCallMPI(MPI_Type_commit(&xyztype));
+  PetscCall(PetscSFReduceBegin(nodeSF, xyztype, nodeCoords, coords, MPI_REPLACE));
+  PetscCall(PetscSFReduceEnd(nodeSF, xyztype, nodeCoords, coords, MPI_REPLACE));
+  PetscCallMPI(MPI_Type_free(&xyztype));
+  PetscCall(PetscSFDestroy(&nodeSF));
+  PetscCall(PetscFree2(nodeTags, nodeCoords));
+  for (n = 0; n < numVertices; ++n)
+    for (d = 0; d < coordDim; ++d) vertexCoords[n * coordDim + d] = coords[n * 3 + d];
+  /* Read a slice of the cells and faces */
+  PetscCall(GmshBlocksGetRange_Private(comm, numElemBlocks, elemBlocks, dim, &cStart, &cEnd));
+  PetscCall(PetscMalloc2((cEnd - cStart) * Nv, &cells, cEnd - cStart, &cellTags));
+  PetscCall(GmshReadElementRange_Private(gmsh, fh, numElemBlocks, elemBlocks, dim, cStart, cEnd, Nv, cells, cellTags));
+  if (numPeriodic) {
+    PetscCall(PetscMalloc1((cEnd - cStart) * Nv, &origCells));
+    PetscCall(PetscArraycpy(origCells, cells, (cEnd - cStart) * Nv));
+    PetscCall(GmshMapPeriodicNodes_Private(numPeriodic, corresponding, primary, (cEnd - cStart) * Nv, cells));
+  }
+  if (interpolate && dim > 1) {
+    PetscCall(GmshBlocksGetRange_Private(comm, numElemBlocks, elemBlocks, dim - 1, &fStart, &fEnd));
+    PetscCall(PetscMalloc2((fEnd - fStart) * 4, &faces, fEnd - fStart, &faceTags));
+    PetscCall(GmshReadElementRange_Private(gmsh, fh, numElemBlocks, elemBlocks, dim - 1, fStart, fEnd, 4, faces, faceTags));
+    if (numPeriodic) PetscCall(GmshMapPeriodicNodes_Private(numPeriodic, corresponding, primary, (fEnd - fStart) * 4, faces));
+  }
+  PetscCallMPI(MPI_File_close(&fh));
+  PetscCall(PetscFree(gmsh->wbuf));
+  PetscCall(PetscFree(gmsh->sbuf));
+
+  /* The array of local vertices is filled in, but not allocated, by DMPlexBuildFromCellListParallel() */
+  PetscCall(PetscMalloc1((cEnd - cStart) * Nv, &verticesAdj));
+  PetscCall(DMPlexCreateFromCellListParallelPetsc(comm, dim, cEnd - cStart, numVertices, maxNodeTag, Nv, interpolate, cells, coordDim, vertexCoords, &vertexSF, &verticesAdj, dm));
+  PetscCall(PetscSFGetGraph(vertexSF, NULL, &numVerticesAdj, NULL, NULL));
+  if (numPeriodic) PetscCall(GmshLocalizeCoordinates_Private(*dm, vertexLayout, coords, numVerticesAdj, verticesAdj, cEnd - cStart, Nv, cells, origCells, numPeriodic, corresponding, primary));
+  PetscCall(PetscLayoutDestroy(&vertexLayout));
+  for (c = 0; c < cEnd - cStart; ++c)
+    if (cellTags[c] >= 0) PetscCall(DMSetLabelValue_Fast(*dm, &cellSets, "Cell Sets", c, cellTags[c]));
+  flg[0] = cellSets ? PETSC_TRUE : PETSC_FALSE;
+  flg[1] = PETSC_FALSE;
+  if (faces) PetscCall(GmshCreateFaceSets_Private(*dm, vertexSF, numVerticesAdj, verticesAdj, fEnd - fStart, faces, faceTags, &flg[1]));
+  PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, flg, 2, MPIU_BOOL, MPI_LOR, comm));
+  if (flg[0]) PetscCall(DMCreateLabel(*dm, "Cell Sets"));
+  if (flg[1]) PetscCall(DMCreateLabel(*dm, "Face Sets"));
+
+  PetscCall(PetscSFDestroy(&vertexSF));
+  PetscCall(PetscFree(verticesAdj));
+  PetscCall(PetscFree2(cells, cellTags));
+  PetscCall(PetscFree2(faces, faceTags));
+  PetscCall(PetscFree2(coords, vertexCoords));
+  PetscCall(PetscFree2(nodeBlocks, elemBlocks));
+  PetscCall(PetscFree(origCells));
+  PetscCall(PetscFree(corresponding));
+  PetscCall(PetscFree(primary));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 /*@C
   DMPlexCreateGmshFromFile - Create a `DMPLEX` mesh from a Gmsh file
 
@@ -1456,13 +2053,17 @@ PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], Pe
 . -dm_plex_gmsh_use_regions   - Generate labels with region names
 . -dm_plex_gmsh_mark_vertices - Add vertices to generated labels
 . -dm_plex_gmsh_multiple_tags - Allow multiple tags for default labels
-- -dm_plex_gmsh_spacedim <d>  - Embedding space dimension, if different from topological dimension
+. -dm_plex_gmsh_spacedim <d>  - Embedding space dimension, if different from topological dimension
+- -dm_plex_gmsh_parallel      - Read a binary Gmsh 4.1 file in parallel using MPI-IO
 
-  Note:
+  Notes:
   The Gmsh file format is described in http://gmsh.info/doc/texinfo/gmsh.html#MSH-file-format
 
   By default, the "Cell Sets", "Face Sets", and "Vertex Sets" labels are created, and only insert the first tag on a point. By using -dm_plex_gmsh_multiple_tags, all tags can be inserted. Instead, -dm_plex_gmsh_use_regions creates labels based on the region names from the PhysicalNames section, and all tags are used.
 
+  With -dm_plex_gmsh_parallel, rank 0 only scans the section and block headers, and each process reads a contiguous slice of the nodes and elements directly from the file, so the mesh is never assembled on a single process.
+  The resulting mesh is distributed in file order and can be repartitioned with `DMPlexDistribute()`. This path supports meshes with a single linear cell type, creates only the "Cell Sets" and "Face Sets" labels, and requires node tags numbered continuously from 1. Periodic files are handled as in the sequential reader, with cellwise coordinates for the cells on a periodic boundary.
+
   Level: beginner
 
 .seealso: [](chapter_unstructured), `DM`, `DMPLEX`, `DMCreate()`
@@ -1481,7 +2082,7 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
   PetscInt     numNodes = 0, numElems = 0, numVerts = 0, numCells = 0, vStart, vEnd;
   PetscInt     cell, cone[8], e, n, v, d;
   PetscBool    binary, useregions = PETSC_FALSE, markvertices = PETSC_FALSE, multipleTags = PETSC_FALSE;
-  PetscBool    hybrid = interpolate, periodic = PETSC_TRUE;
+  PetscBool    hybrid = interpolate, periodic = PETSC_TRUE, parallel = PETSC_FALSE;
   PetscBool    highOrder = PETSC_TRUE, highOrderSet, project = PETSC_FALSE;
   PetscBool    isSimplex = PETSC_FALSE, isHybrid = PETSC_FALSE, hasTetra = PETSC_FALSE;
   PetscMPIInt  rank;
@@ -1499,17 +2100,34 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
   PetscCall(PetscOptionsBool("-dm_plex_gmsh_multiple_tags", "Allow multiple tags for default labels", "DMPlexCreateGmsh", multipleTags, &multipleTags, NULL));
   PetscCall(PetscOptionsBoundedInt("-dm_plex_gmsh_spacedim", "Embedding space dimension", "DMPlexCreateGmsh", coordDim, &coordDim, NULL, PETSC_DECIDE));
   PetscCall(PetscOptionsBoundedInt("-dm_localize_height", "Localize edges and faces in addition to cells", "", maxHeight, &maxHeight, NULL, 0));
+  PetscCall(PetscOptionsBool("-dm_plex_gmsh_parallel", "Read binary Gmsh 4.1 files in parallel with MPI-IO", "DMPlexCreateGmsh", parallel, &parallel, NULL));
   PetscOptionsHeadEnd();
   PetscOptionsEnd();
 
   PetscCall(GmshCellInfoSetUp());
 
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERBINARY, &binary));
+  if (parallel && !binary) PetscCall(PetscInfo(viewer, "Parallel Gmsh reader requires a binary viewer, reading on rank 0\n"));
+  if (parallel && binary) {
+#if defined(PETSC_HAVE_MPIIO)
+    const char *filename;
+
+    PetscCheck(!useregions && !markvertices && !multipleTags, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support -dm_plex_gmsh_use_regions, -dm_plex_gmsh_mark_vertices, or -dm_plex_gmsh_multiple_tags");
+    PetscCheck(!highOrderSet || !highOrder, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support high-order coordinates");
+    PetscCall(PetscViewerFileGetName(viewer, &filename));
+    PetscCall(PetscLogEventBegin(DMPLEX_CreateGmsh, NULL, NULL, NULL, NULL));
+    PetscCall(DMPlexCreateGmsh_Parallel(comm, filename, interpolate, periodic, coordDim, dm));
+    PetscCall(PetscLogEventEnd(DMPLEX_CreateGmsh, NULL, NULL, NULL, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+#else
+    SETERRQ(comm, PETSC_ERR_SUP_SYS, "Parallel Gmsh reader requires MPI-IO");
+#endif
+  }
+
   PetscCall(DMCreate(comm, dm));
   PetscCall(DMSetType(*dm, DMPLEX));
   PetscCall(PetscLogEventBegin(DMPLEX_CreateGmsh, *dm, NULL, NULL, NULL));
 
-  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERBINARY, &binary));
-
   /* Binary viewers read on all ranks, get subviewer to read only in rank 0 */
   if (binary) {
     parentviewer = viewer;
@@ -2166,6 +2166,143 @@ static PetscErrorCode PlexLayerCreateSFs_Private(PlexLayer layer, PetscSF *verte
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Partition the cell layer, loaded in contiguous chunks, directly on its distributed dual graph and move the cells to their final owners.
+  Two cells are connected if they share a face, so this requires the lower layer to consist of faces (interpolated mesh).
+  The returned SF maps the new local cells to the cells in the file (chunk) layout.
+*/
+static PetscErrorCode PlexLayerPartition_Private(PlexLayer layer, PetscPartitioner part, PetscSF *cellLocalToGlobalSF)
+{
+  PetscSection    coneSection = layer->coneSizesSection;
+  PetscSection    partSection;
+  PetscLayout     cellLayout, newCellLayout;
+  PetscSF         faceSF, sendSF;
+  IS              partition, targetRanksIS, newNumberingIS;
+  const PetscInt *cones, *degree, *partArr, *newNumbering;
+  PetscInt       *leafCells, *leafNeighbors, *rootCells, *start, *adjacency, *targetRanks, *newCounts, *oldCells, *origin;
+  PetscInt        nCells, nCones, nFaces, nMulti, nNewCells, c, f, i;
+  PetscMPIInt     rank, size, r;
+  MPI_Comm        comm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)coneSection, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscSectionGetChart(coneSection, NULL, &nCells));
+  PetscCall(PetscSectionGetStorageSize(coneSection, &nCones));
+  PetscCall(PetscLayoutCreateFromSizes(comm, nCells, PETSC_DECIDE, 1, &cellLayout));
+
+  /* Connect each cone entry with the rank owning its face in the file layout */
+  PetscCall(ISGetIndices(layer->conesIS, &cones));
+  PetscCall(PetscSFCreate(comm, &faceSF));
+  PetscCall(PetscSFSetGraphLayout(faceSF, layer->vertexLayout, nCones, NULL, PETSC_OWN_POINTER, cones));
+  PetscCall(ISRestoreIndices(layer->conesIS, &cones));
+  PetscCall(PetscMalloc2(nCones, &leafCells, nCones, &leafNeighbors));
+  for (c = 0; c < nCells; ++c) {
+    PetscInt dof, off;
+
+    PetscCall(PetscSectionGetDof(coneSection, c, &dof));
+    PetscCall(PetscSectionGetOffset(coneSection, c, &off));
+    for (i = 0; i < dof; ++i) leafCells[off + i] = cellLayout->rstart + c;
+  }
+
+  /* Gather the cells sharing each face; on a manifold mesh there are at most two, so swapping them gives each cone entry its neighbor */
+  PetscCall(PetscSFComputeDegreeBegin(faceSF, &degree));
+  PetscCall(PetscSFComputeDegreeEnd(faceSF, &degree));
+  PetscCall(PetscSFGetGraph(faceSF, &nFaces, NULL, NULL, NULL));
+  for (f = 0, nMulti = 0; f < nFaces; ++f) nMulti += degree[f];
+  PetscCall(PetscMalloc1(nMulti, &rootCells));
+  PetscCall(PetscSFGatherBegin(faceSF, MPIU_INT, leafCells, rootCells));
+  PetscCall(PetscSFGatherEnd(faceSF, MPIU_INT, leafCells, rootCells));
+  for (f = 0, i = 0; f < nFaces; i += degree[f], ++f) {
+    if (degree[f] == 2) {
+      const PetscInt tmp = rootCells[i];
+
+      rootCells[i]     = rootCells[i + 1];
+      rootCells[i + 1] = tmp;
+    } else {
+      PetscInt k;
+
+      for (k = 0; k < degree[f]; ++k) rootCells[i + k] = -1;
+    }
+  }
+  PetscCall(PetscSFScatterBegin(faceSF, MPIU_INT, rootCells, leafNeighbors));
+  PetscCall(PetscSFScatterEnd(faceSF, MPIU_INT, rootCells, leafNeighbors));
+  PetscCall(PetscFree(rootCells));
+  PetscCall(PetscSFDestroy(&faceSF));
+
+  /* Build the local part of the dual graph in global cell numbering */
+  PetscCall(PetscCalloc1(nCells + 1, &start));
+  for (c = 0; c < nCells; ++c) {
+    PetscInt dof, off;
+
+    PetscCall(PetscSectionGetDof(coneSection, c, &dof));
+    PetscCall(PetscSectionGetOffset(coneSection, c, &off));
+    start[c + 1] = start[c];
+    for (i = 0; i < dof; ++i)
+      if (leafNeighbors[off + i] >= 0) ++start[c + 1];
+  }
+  PetscCall(PetscMalloc1(start[nCells], &adjacency));
+  for (c = 0, f = 0; c < nCells; ++c) {
+    PetscInt dof, off;
+
+    PetscCall(PetscSectionGetDof(coneSection, c, &dof));
+    PetscCall(PetscSectionGetOffset(coneSection, c, &off));
+    for (i = 0; i < dof; ++i)
+      if (leafNeighbors[off + i] >= 0) adjacency[f++] = leafNeighbors[off + i];
+  }
+  PetscCall(PetscFree2(leafCells, leafNeighbors));
+
+  /* Partition the graph and compute the new global numbering of the cells */
+  PetscCall(PetscSectionCreate(comm, &partSection));
+  PetscCall(PetscPartitionerPartition(part, size, nCells, start, adjacency, NULL, NULL, partSection, &partition));
+  PetscCall(PetscFree(start));
+  PetscCall(PetscFree(adjacency));
+  PetscCall(PetscMalloc1(nCells, &targetRanks));
+  PetscCall(ISGetIndices(partition, &partArr));
+  for (r = 0; r < size; ++r) {
+    PetscInt dof, off;
+
+    PetscCall(PetscSectionGetDof(partSection, r, &dof));
+    PetscCall(PetscSectionGetOffset(partSection, r, &off));
+    for (i = off; i < off + dof; ++i) targetRanks[partArr[i]] = r;
+  }
+  PetscCall(ISRestoreIndices(partition, &partArr));
+  PetscCall(ISDestroy(&partition));
+  PetscCall(PetscSectionDestroy(&partSection));
+  PetscCall(ISCreateGeneral(comm, nCells, targetRanks, PETSC_OWN_POINTER, &targetRanksIS));
+  PetscCall(ISPartitioningToNumbering(targetRanksIS, &newNumberingIS));
+  PetscCall(PetscMalloc1(size, &newCounts));
+  PetscCall(ISPartitioningCount(targetRanksIS, size, newCounts));
+  nNewCells = newCounts[rank];
+  PetscCall(PetscFree(newCounts));
+  PetscCall(ISDestroy(&targetRanksIS));
+
+  /* Let each new owner know which cells of the file layout it receives */
+  PetscCall(PetscLayoutCreateFromSizes(comm, nNewCells, PETSC_DECIDE, 1, &newCellLayout));
+  PetscCall(ISGetIndices(newNumberingIS, &newNumbering));
+  PetscCall(PetscSFCreate(comm, &sendSF));
+  PetscCall(PetscSFSetGraphLayout(sendSF, newCellLayout, nCells, NULL, PETSC_OWN_POINTER, newNumbering));
+  PetscCall(ISRestoreIndices(newNumberingIS, &newNumbering));
+  PetscCall(ISDestroy(&newNumberingIS));
+  PetscCall(PetscMalloc2(nCells, &oldCells, nNewCells, &origin));
+  for (c = 0; c < nCells; ++c) oldCells[c] = cellLayout->rstart + c;
+  PetscCall(PetscSFReduceBegin(sendSF, MPIU_INT, oldCells, origin, MPI_REPLACE));
+  PetscCall(PetscSFReduceEnd(sendSF, MPIU_INT, oldCells, origin, MPI_REPLACE));
+  PetscCall(PetscSFDestroy(&sendSF));
+
+  /* Migrate the cell layer once, directly to its final owners */
+  PetscCall(PetscSFCreate(comm, cellLocalToGlobalSF));
+  PetscCall(PetscSFSetGraphLayout(*cellLocalToGlobalSF, cellLayout, nNewCells, NULL, PETSC_OWN_POINTER, origin));
+  PetscCall(PetscSFSetUp(*cellLocalToGlobalSF));
+  PetscCall(PetscObjectSetName((PetscObject)*cellLocalToGlobalSF, "localToGlobalSF"));
+  PetscCall(PetscFree2(oldCells, origin));
+  PetscCall(PetscLayoutDestroy(&newCellLayout));
+  PetscCall(PetscLayoutDestroy(&cellLayout));
+  PetscCall(PlexLayerDistribute_Private(layer, *cellLocalToGlobalSF));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PlexLayerCreateCellSFs_Private(PlexLayer layer, PetscSF *cellOverlapSF, PetscSF *cellLocalToGlobalSF)
 {
   PetscSection coneSection = layer->coneSizesSection;
@@ -2184,8 +2321,8 @@ static PetscErrorCode PlexLayerCreateCellSFs_Private(PlexLayer layer, PetscSF *c
   PetscCall(PetscSFCreate(comm, cellOverlapSF));
   PetscCall(PetscSFSetGraph(*cellOverlapSF, nCells, 0, NULL, PETSC_USE_POINTER, NULL, PETSC_USE_POINTER));
   PetscCall(PetscSFSetUp(*cellOverlapSF));
-  /* Create localToGlobalSF as identity mapping */
-  {
+  /* Create localToGlobalSF as identity mapping, unless the cells have been partitioned */
+  if (cellLocalToGlobalSF) {
     PetscLayout map;
 
     PetscCall(PetscLayoutCreateFromSizes(comm, nCells, PETSC_DECIDE, 1, &map));
@@ -2335,19 +2472,25 @@ static PetscErrorCode DMPlexTopologyLoad_HDF5_Private(DM dm, PetscViewer viewer,
   PlexLayer  *layers;
   IS          strataPermutation;
   PetscLayout pointsLayout;
-  PetscInt    depth;
+  PetscInt    depth, dim;
   PetscInt    d;
+  PetscBool   partition = PETSC_FALSE;
+  PetscMPIInt size;
   MPI_Comm    comm;
 
   PetscFunctionBegin;
-  {
-    PetscInt dim;
-
-    PetscCall(PetscViewerHDF5ReadAttribute(viewer, NULL, "depth", PETSC_INT, NULL, &depth));
-    PetscCall(PetscViewerHDF5ReadAttribute(viewer, NULL, "cell_dim", PETSC_INT, NULL, &dim));
-    PetscCall(DMSetDimension(dm, dim));
-  }
+  PetscCall(PetscViewerHDF5ReadAttribute(viewer, NULL, "depth", PETSC_INT, NULL, &depth));
+  PetscCall(PetscViewerHDF5ReadAttribute(viewer, NULL, "cell_dim", PETSC_INT, NULL, &dim));
+  PetscCall(DMSetDimension(dm, dim));
   PetscCall(PetscObjectGetComm((PetscObject)dm, &comm));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscOptionsBegin(comm, ((PetscObject)dm)->prefix, "DMPlex HDF5 Loader Options", "PetscViewer");
+  PetscCall(PetscOptionsBool("-dm_plex_hdf5_partition_on_load", "Partition the cells in parallel while loading the topology", "DMPlexTopologyLoad", partition, &partition, NULL));
+  PetscOptionsEnd();
+  if (partition && (size == 1 || depth != dim || dim < 1)) {
+    PetscCall(PetscInfo(dm, "Not partitioning on load: %s\n", size == 1 ? "single process" : "the stored topology is not interpolated"));
+    partition = PETSC_FALSE;
+  }
 
   {
     IS spOnComm;
@@ -2370,6 +2513,15 @@ static PetscErrorCode DMPlexTopologyLoad_HDF5_Private(DM dm, PetscViewer viewer,
   }
   PetscCall(PetscViewerHDF5PopGroup(viewer)); /* strata */
 
+  /* Partition the cells in parallel and move them to their final owners before the lower strata are distributed */
+  if (partition) {
+    PetscPartitioner part;
+
+    PetscCall(DMPlexGetPartitioner(dm, &part));
+    PetscCall(PetscPartitionerSetFromOptions(part));
+    PetscCall(PlexLayerPartition_Private(layers[depth], part, &layers[depth]->l2gSF));
+  }
+
   for (d = depth; d >= 0; d--) {
     /* Redistribute cells and vertices for each applicable layer */
     if (d < depth) PetscCall(PlexLayerDistribute_Private(layers[d], layers[d]->l2gSF));
@@ -2377,7 +2529,7 @@ static PetscErrorCode DMPlexTopologyLoad_HDF5_Private(DM dm, PetscViewer viewer,
     if (d > 0) PetscCall(PlexLayerCreateSFs_Private(layers[d], &layers[d - 1]->overlapSF, &layers[d - 1]->l2gSF));
   }
   /* Build trivial SFs for the cell layer as well */
-  PetscCall(PlexLayerCreateCellSFs_Private(layers[depth], &layers[depth]->overlapSF, &layers[depth]->l2gSF));
+  PetscCall(PlexLayerCreateCellSFs_Private(layers[depth], &layers[depth]->overlapSF, layers[depth]->l2gSF ? NULL : &layers[depth]->l2gSF));
 
   /* Build DMPlex topology from the layers */
   PetscCall(DMPlexTopologyBuildFromLayers_Private(dm, depth, layers, strataPermutation));
@@ -2394,6 +2546,8 @@ static PetscErrorCode DMPlexTopologyLoad_HDF5_Private(DM dm, PetscViewer viewer,
   for (d = depth; d >= 0; d--) PetscCall(PlexLayerDestroy(&layers[d]));
   PetscCall(PetscFree(layers));
   PetscCall(ISDestroy(&strataPermutation));
+  /* Do not auto-distribute again */
+  if (partition) PetscCall(DMPlexDistributeSetDefault(dm, PETSC_FALSE));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -599,6 +599,12 @@ int main(int argc, char **argv)
       suffix: gmsh_3d_binary_v41_64_np2_mpiio
       requires: defined(PETSC_HAVE_MPIIO)
       args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/gmsh-3d-binary-64.msh -viewer_binary_mpiio
+  test: # 64bit mesh, parallel MPI-IO reader
+    suffix: gmsh_3d_binary_v41_64_parallel
+    requires: defined(PETSC_HAVE_MPIIO)
+    nsize: 2
+    args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/gmsh-3d-binary-64.msh -dm_plex_gmsh_parallel \
+          -dm_coord_space 0 -dist_dm_distribute -petscpartitioner_type simple -dm_view -dm_plex_check_all
 
   # Fluent mesh reader tests
   # TODO: Geometry checks fail
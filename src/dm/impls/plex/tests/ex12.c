@@ -35,7 +35,10 @@ typedef struct {
   PetscInt      overlap;          /* The cell overlap to use during partitioning */
   PetscBool     testPartition;    /* Use a fixed partitioning for testing */
   PetscBool     testRedundant;    /* Use a redundant partitioning for testing */
+  PetscBool     testSkewed;       /* Use a partition with load growing with the rank */
   PetscBool     loadBalance;      /* Load balance via a second distribute step */
+  PetscBool     rebalance;        /* Load balance in place with DMPlexRebalance() */
+  PetscReal     rebalanceTol;     /* Tolerated load imbalance for DMPlexRebalance() */
   PetscBool     partitionBalance; /* Balance shared point partition */
   PetscLogStage stages[4];
 } AppCtx;
@@ -46,14 +49,20 @@ PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->overlap          = 0;
   options->testPartition    = PETSC_FALSE;
   options->testRedundant    = PETSC_FALSE;
+  options->testSkewed       = PETSC_FALSE;
   options->loadBalance      = PETSC_FALSE;
+  options->rebalance        = PETSC_FALSE;
+  options->rebalanceTol     = 0.05;
   options->partitionBalance = PETSC_FALSE;
 
   PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");
   PetscCall(PetscOptionsBoundedInt("-overlap", "The cell overlap for partitioning", "ex12.c", options->overlap, &options->overlap, NULL, 0));
   PetscCall(PetscOptionsBool("-test_partition", "Use a fixed partition for testing", "ex12.c", options->testPartition, &options->testPartition, NULL));
   PetscCall(PetscOptionsBool("-test_redundant", "Use a redundant partition for testing", "ex12.c", options->testRedundant, &options->testRedundant, NULL));
+  PetscCall(PetscOptionsBool("-test_skewed_partition", "Use a partition with load growing with the rank for testing", "ex12.c", options->testSkewed, &options->testSkewed, NULL));
   PetscCall(PetscOptionsBool("-load_balance", "Perform parallel load balancing in a second distribution step", "ex12.c", options->loadBalance, &options->loadBalance, NULL));
+  PetscCall(PetscOptionsBool("-rebalance", "Use in place rebalancing for the load balancing step", "ex12.c", options->rebalance, &options->rebalance, NULL));
+  PetscCall(PetscOptionsReal("-rebalance_tol", "Tolerated load imbalance for in place rebalancing", "ex12.c", options->rebalanceTol, &options->rebalanceTol, NULL));
   PetscCall(PetscOptionsBool("-partition_balance", "Balance the ownership of shared points", "ex12.c", options->partitionBalance, &options->partitionBalance, NULL));
   PetscOptionsEnd();
 
@@ -125,6 +134,18 @@ PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
       }
       PetscCall(PetscPartitionerSetType(part, PETSCPARTITIONERSHELL));
       PetscCall(PetscPartitionerShellSetPartition(part, size, sizes, points));
+    } else if (user->testSkewed) {
+      PetscInt *sizes, *points, cStart, cEnd, c, p;
+
+      /* Rank p receives a contiguous block of cells proportional to p + 1 */
+      PetscCall(DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd));
+      if (rank) cStart = cEnd = 0;
+      PetscCall(PetscMalloc2(size, &sizes, cEnd - cStart, &points));
+      for (p = 0; p < size; ++p) sizes[p] = (cEnd - cStart) * (p + 1) * (p + 2) / (size * (size + 1)) - (cEnd - cStart) * p * (p + 1) / (size * (size + 1));
+      for (c = cStart; c < cEnd; ++c) points[c - cStart] = c;
+      PetscCall(PetscPartitionerSetType(part, PETSCPARTITIONERSHELL));
+      PetscCall(PetscPartitionerShellSetPartition(part, size, sizes, points));
+      PetscCall(PetscFree2(sizes, points));
     }
     PetscCall(DMPlexDistribute(*dm, overlap, NULL, &pdm));
   } else {
@@ -169,10 +190,13 @@ PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
       PetscCall(PetscPartitionerShellSetPartition(part, size, reSizes_n2, rePoints_n2));
     }
     PetscCall(DMPlexSetPartitionBalance(*dm, user->partitionBalance));
-    PetscCall(DMPlexDistribute(*dm, overlap, NULL, &pdm));
-    if (pdm) {
-      PetscCall(DMDestroy(dm));
-      *dm = pdm;
+    if (user->rebalance) PetscCall(DMPlexRebalance(*dm, user->rebalanceTol, NULL));
+    else {
+      PetscCall(DMPlexDistribute(*dm, overlap, NULL, &pdm));
+      if (pdm) {
+        PetscCall(DMDestroy(dm));
+        *dm = pdm;
+      }
     }
     PetscCall(PetscLogStagePop());
   }
@@ -284,6 +308,11 @@ int main(int argc, char **argv)
     requires: triangle
     nsize: 8
     args: -dm_coord_space 0 -test_partition -overlap 2 -dm_view ascii::ascii_info_detail -partition_balance
+  # Parallel, multi-level overlap on quadrilaterals
+  test:
+    suffix: quad_overlap
+    nsize: 4
+    args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 6,7 -petscpartitioner_type simple -overlap {{2 3}separate output} -dm_view ascii::ascii_info
   # Parallel load balancing, test 6-7
   test:
     suffix: 15
@@ -306,4 +335,21 @@ int main(int argc, char **argv)
     requires: parmetis
     nsize: 4
     args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 4,4 -petscpartitioner_type shell -petscpartitioner_shell_random -lb_petscpartitioner_type parmetis -load_balance -lb_petscpartitioner_view -partition_balance -prelb_dm_view ::load_balance -dm_view ::load_balance
+  # Load balancing with a diffusive repartition of the current distribution
+  test:
+    suffix: rebalance_0
+    nsize: 4
+    args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 4,20 -test_skewed_partition -overlap {{0 1}}
+    args: -load_balance -lb_petscpartitioner_type diffusion -lb_petscpartitioner_view -prelb_dm_view ::load_balance -dm_view ::load_balance
+  # In place load balancing, the overlap is kept from the current distribution
+  test:
+    suffix: rebalance_1
+    nsize: 4
+    args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 4,20 -test_skewed_partition -overlap {{0 1 2}}
+    args: -load_balance -rebalance -lb_rebalance_petscpartitioner_view -prelb_dm_view ::load_balance -lb_dm_view ::load_balance
+  test:
+    suffix: rebalance_2
+    nsize: 3
+    args: -dm_coord_space 0 -dm_plex_dim 3 -dm_plex_simplex 0 -dm_plex_box_faces 4,4,12 -test_skewed_partition -overlap {{0 1}}
+    args: -load_balance -rebalance -prelb_dm_view ::load_balance -lb_dm_view ::load_balance
 TEST*/
@@ -6,6 +6,7 @@ static char help[] = "Tests for point location\n\n";
 typedef struct {
   PetscBool centroids;
   PetscBool custom;
+  PetscBool grade; /* Grade the mesh towards the origin and locate the centroids again */
 } AppCtx;
 
 static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
@@ -13,10 +14,12 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscFunctionBeginUser;
   options->centroids = PETSC_TRUE;
   options->custom    = PETSC_FALSE;
+  options->grade     = PETSC_FALSE;
 
   PetscOptionsBegin(comm, "", "Point Location Options", "DMPLEX");
   PetscCall(PetscOptionsBool("-centroids", "Locate cell centroids", "ex17.c", options->centroids, &options->centroids, NULL));
   PetscCall(PetscOptionsBool("-custom", "Locate user-defined points", "ex17.c", options->custom, &options->custom, NULL));
+  PetscCall(PetscOptionsBool("-grade", "Grade the mesh and locate the centroids again", "ex17.c", options->grade, &options->grade, NULL));
   PetscOptionsEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -128,6 +131,24 @@ static PetscErrorCode TestCustomLocation(DM dm, AppCtx *user)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Map each coordinate x to x^3, which packs the cells near the origin like a boundary layer */
+static PetscErrorCode GradeMesh(DM dm, AppCtx *user)
+{
+  Vec          coordinates;
+  PetscScalar *a;
+  PetscInt     n;
+
+  PetscFunctionBeginUser;
+  if (!user->grade) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(DMGetCoordinates(dm, &coordinates));
+  PetscCall(VecGetLocalSize(coordinates, &n));
+  PetscCall(VecGetArray(coordinates, &a));
+  for (PetscInt i = 0; i < n; ++i) a[i] = a[i] * a[i] * a[i];
+  PetscCall(VecRestoreArray(coordinates, &a));
+  PetscCall(DMSetCoordinates(dm, coordinates));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 int main(int argc, char **argv)
 {
   DM     dm;
@@ -139,6 +160,10 @@ int main(int argc, char **argv)
   PetscCall(CreateMesh(PETSC_COMM_WORLD, &dm));
   PetscCall(TestCentroidLocation(dm, &user));
   PetscCall(TestCustomLocation(dm, &user));
+  if (user.grade) {
+    PetscCall(GradeMesh(dm, &user));
+    PetscCall(TestCentroidLocation(dm, &user));
+  }
   PetscCall(DMDestroy(&dm));
   PetscCall(PetscFinalize());
   return 0;
@@ -156,6 +181,11 @@ int main(int argc, char **argv)
       suffix: seg_hash
       args: -dm_refine 2 -dm_plex_hash_location
 
+    test:
+      suffix: seg_bvh
+      args: -dm_refine 2 -dm_plex_bvh_location -grade
+      output_file: output/ex17_seg.out
+
   testset:
     args: -dm_plex_box_faces 5,5
 
@@ -176,6 +206,11 @@ int main(int argc, char **argv)
       suffix: quad_hash
       args: -dm_plex_simplex 0 -dm_refine 2 -dm_plex_hash_location
 
+    test:
+      suffix: quad_bvh
+      args: -dm_plex_simplex 0 -dm_refine 2 -dm_plex_bvh_location -dm_plex_bvh_leaf_size {{1 4}} -grade
+      output_file: output/ex17_quad.out
+
   testset:
     args: -dm_plex_dim 3 -dm_plex_box_faces 3,3,3
 
@@ -196,6 +231,11 @@ int main(int argc, char **argv)
       suffix: hex_hash
       args: -dm_plex_simplex 0 -dm_refine 1 -dm_plex_hash_location
 
+    test:
+      suffix: hex_bvh
+      args: -dm_plex_simplex 0 -dm_refine 1 -dm_plex_bvh_location -grade
+      output_file: output/ex17_hex.out
+
   testset:
     args: -centroids 0 -custom \
           -dm_plex_simplex 0 -dm_plex_box_faces 21,21 -dm_distribute_overlap 4 -petscpartitioner_type simple
@@ -205,4 +245,9 @@ int main(int argc, char **argv)
       suffix: quad_overlap
       args: -dm_plex_hash_location {{0 1}}
 
+    test:
+      suffix: quad_overlap_bvh
+      args: -dm_plex_bvh_location
+      output_file: output/ex17_quad_overlap.out
+
 TEST*/
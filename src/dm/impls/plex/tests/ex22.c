@@ -111,6 +111,7 @@ int main(int argc, char **argv)
   PetscRandom randCtx;
   PetscInt    dim, dimC, isSimplex, isFE, numTests = 10;
   PetscReal   perturb = 0.1, tol = 10. * PETSC_SMALL;
+  PetscBool   embed   = PETSC_TRUE;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &argv, NULL, help));
@@ -120,9 +121,10 @@ int main(int argc, char **argv)
   PetscOptionsBegin(PETSC_COMM_WORLD, NULL, "ex21", NULL);
   PetscCall(PetscOptionsReal("-vertex_perturbation", "scale of random vertex distortion", NULL, perturb, &perturb, NULL));
   PetscCall(PetscOptionsBoundedInt("-num_test_points", "number of points to test", NULL, numTests, &numTests, NULL, 0));
+  PetscCall(PetscOptionsBool("-embed", "also test meshes embedded in a higher dimension", NULL, embed, &embed, NULL));
   PetscOptionsEnd();
   for (dim = 1; dim <= 3; dim++) {
-    for (dimC = dim; dimC <= PetscMin(3, dim + 1); dimC++) {
+    for (dimC = dim; dimC <= (embed ? PetscMin(3, dim + 1) : dim); dimC++) {
       for (isSimplex = 0; isSimplex < 2; isSimplex++) {
         for (isFE = 0; isFE < 2; isFE++) {
           DM           dm;
@@ -235,4 +237,14 @@ int main(int argc, char **argv)
     suffix: 0
     args: -petscspace_degree 2 -tensor_petscspace_degree 2
 
+  test:
+    suffix: batch
+    args: -petscspace_degree 2 -tensor_petscspace_degree 2 -num_test_points 150
+    output_file: output/ex22_0.out
+
+  test:
+    suffix: affine
+    args: -vertex_perturbation 0 -embed 0 -num_test_points 150
+    output_file: output/ex22_0.out
+
 TEST*/
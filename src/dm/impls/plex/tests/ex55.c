@@ -7,6 +7,7 @@ static char help[] = "Load and save the mesh and fields to HDF5 and ExodusII\n\n
 typedef struct {
   PetscBool         compare;                      /* Compare the meshes using DMPlexEqual() */
   PetscBool         compare_labels;               /* Compare labels in the meshes using DMCompareLabels() */
+  PetscBool         check_partition;              /* Check that the partition of the loaded mesh covers the saved mesh */
   PetscBool         distribute;                   /* Distribute the mesh */
   PetscBool         interpolate;                  /* Generate intermediate mesh elements */
   char              fname[PETSC_MAX_PATH_LEN];    /* Mesh filename */
@@ -22,6 +23,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscFunctionBeginUser;
   options->compare                 = PETSC_FALSE;
   options->compare_labels          = PETSC_FALSE;
+  options->check_partition         = PETSC_FALSE;
   options->distribute              = PETSC_TRUE;
   options->interpolate             = PETSC_FALSE;
   options->fname[0]                = '\0';
@@ -34,6 +36,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");
   PetscCall(PetscOptionsBool("-compare", "Compare the meshes using DMPlexEqual()", "ex55.c", options->compare, &options->compare, NULL));
   PetscCall(PetscOptionsBool("-compare_labels", "Compare labels in the meshes using DMCompareLabels()", "ex55.c", options->compare_labels, &options->compare_labels, NULL));
+  PetscCall(PetscOptionsBool("-check_partition", "Check that the partition of the loaded mesh covers the saved mesh", "ex55.c", options->check_partition, &options->check_partition, NULL));
   PetscCall(PetscOptionsBool("-distribute", "Distribute the mesh", "ex55.c", options->distribute, &options->distribute, NULL));
   PetscCall(PetscOptionsBool("-interpolate", "Generate intermediate mesh elements", "ex55.c", options->interpolate, &options->interpolate, NULL));
   PetscCall(PetscOptionsString("-filename", "The mesh file", "ex55.c", options->fname, options->fname, sizeof(options->fname), NULL));
@@ -107,6 +110,56 @@ static PetscErrorCode CheckDistributedInterpolated(DM dm, PetscViewer v, AppCtx
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Counts the owned cells and vertices and sums the owned vertex coordinates */
+static PetscErrorCode GetPartitionChecksum(DM dm, PetscInt *cells, PetscInt *vertices, PetscScalar *coordsum)
+{
+  IS              numbering;
+  Vec             coordinates;
+  const PetscInt *idx;
+  PetscInt        n, i, owned[2] = {0, 0};
+
+  PetscFunctionBeginUser;
+  PetscCall(DMPlexGetCellNumbering(dm, &numbering));
+  PetscCall(ISGetLocalSize(numbering, &n));
+  PetscCall(ISGetIndices(numbering, &idx));
+  for (i = 0; i < n; ++i)
+    if (idx[i] >= 0) ++owned[0];
+  PetscCall(ISRestoreIndices(numbering, &idx));
+  PetscCall(DMPlexGetVertexNumbering(dm, &numbering));
+  PetscCall(ISGetLocalSize(numbering, &n));
+  PetscCall(ISGetIndices(numbering, &idx));
+  for (i = 0; i < n; ++i)
+    if (idx[i] >= 0) ++owned[1];
+  PetscCall(ISRestoreIndices(numbering, &idx));
+  *cells    = owned[0];
+  *vertices = owned[1];
+  PetscCall(DMGetCoordinates(dm, &coordinates));
+  PetscCall(VecSum(coordinates, coordsum));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Checks that the loaded mesh has the cells, vertices and coordinates of the saved one and that every rank owns cells */
+static PetscErrorCode CheckPartition(DM dm, DM dmnew)
+{
+  MPI_Comm    comm = PetscObjectComm((PetscObject)dm);
+  PetscInt    counts[2], countsnew[2], minnew;
+  PetscScalar sum, sumnew;
+  PetscBool   match, nonempty;
+
+  PetscFunctionBeginUser;
+  PetscCall(GetPartitionChecksum(dm, &counts[0], &counts[1], &sum));
+  PetscCall(GetPartitionChecksum(dmnew, &countsnew[0], &countsnew[1], &sumnew));
+  PetscCallMPI(MPI_Allreduce(&countsnew[0], &minnew, 1, MPIU_INT, MPI_MIN, comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, counts, 2, MPIU_INT, MPI_SUM, comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, countsnew, 2, MPIU_INT, MPI_SUM, comm));
+  match    = (PetscBool)(counts[0] == countsnew[0] && counts[1] == countsnew[1] && PetscAbsScalar(sum - sumnew) <= 1e-10 * PetscMax(1.0, PetscAbsScalar(sum)));
+  nonempty = (PetscBool)(minnew > 0);
+  PetscCall(PetscPrintf(comm, "Loaded partition covers the cells, vertices and coordinates of the saved mesh: %s\n", match ? "yes" : "no"));
+  if (!match) PetscCall(PetscPrintf(comm, "  saved: %" PetscInt_FMT " cells, %" PetscInt_FMT " vertices, coordinate sum %g; loaded: %" PetscInt_FMT " cells, %" PetscInt_FMT " vertices, coordinate sum %g\n", counts[0], counts[1], (double)PetscRealPart(sum), countsnew[0], countsnew[1], (double)PetscRealPart(sumnew)));
+  PetscCall(PetscPrintf(comm, "Every rank owns cells of the loaded mesh: %s\n", nonempty ? "yes" : "no"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DMPlexWriteAndReadHDF5(DM dm, const char filename[], const char prefix[], AppCtx *user, DM *dm_new)
 {
   DM          dmnew;
@@ -204,6 +257,7 @@ int main(int argc, char **argv)
     PetscCall(DMCompareLabels(dmnew, dm, NULL, NULL));
     PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMLabels equal\n"));
   }
+  if (user.check_partition) PetscCall(CheckPartition(dm, dmnew));
 
   PetscCall(DMDestroy(&dm));
   PetscCall(DMDestroy(&dmnew));
@@ -324,6 +378,17 @@ int main(int argc, char **argv)
       args: -distribute -petscpartitioner_type parmetis
       args: -interpolate 0
 
+  # parallel partitioning while loading the topology, the DM is checked to be distributed and interpolated,
+  # and its partition to cover the saved mesh
+  test:
+    suffix: 9_hdf5_partload
+    requires: hdf5 !complex datafilespath parmetis
+    nsize: {{2 4}}
+    args: -filename ${DATAFILESPATH}/meshes/cube-hexahedra-refined.h5 -dm_plex_create_from_hdf5_xdmf -dm_plex_hdf5_topology_path /cells -dm_plex_hdf5_geometry_path /coordinates
+    args: -format hdf5_petsc -second_write_read -interpolate 1 -distribute
+    args: -dm_plex_view_hdf5_storage_version 3.0.0
+    args: -petscpartitioner_type parmetis -new_dm_plex_hdf5_partition_on_load -check_partition
+
   # reproduce PetscSFView() crash - fixed, left as regression test
   test:
     suffix: new_dm_view
@@ -0,0 +1,339 @@
+/* Matrix-free operators defined by constant stencils on a DMStag */
+
+#include <petsc/private/dmstagimpl.h> /*I "petscdmstag.h" I*/
+
+/* The stencil of the rows of one (canonical location, component) pair, stored as offsets in the local representation */
+typedef struct {
+  DMStagStencilLocation loc;
+  PetscInt              c, slot;
+  PetscBool             center[DMSTAG_MAX_DIM]; /* Row point is the center of the element in this direction */
+  PetscInt              n;
+  PetscInt             *delta;   /* Offset from the row entry to the entry of each column in the local vector */
+  PetscInt             *shift;   /* Element offset of each column after canonicalization, DMSTAG_MAX_DIM per column */
+  PetscBool            *ccenter; /* Column point is the center of the element, DMSTAG_MAX_DIM per column */
+  PetscScalar          *val;
+  PetscScalar           diag;
+} DMStagStencilOpRow;
+
+typedef struct {
+  DM                  dm;
+  PetscInt            nrows, maxrows;
+  DMStagStencilOpRow *rows;
+  PetscInt            lo[DMSTAG_MAX_DIM], hi[DMSTAG_MAX_DIM]; /* Elements whose columns are all in the domain */
+} DMStagStencilOp;
+
+/* Side of each direction for a location: 0 lower, 1 center, 2 upper */
+static inline void DMStagLocationGetSides_Private(DMStagStencilLocation loc, PetscInt side[])
+{
+  const PetscInt q = (PetscInt)loc - 1;
+
+  side[0] = q % 3;
+  side[1] = (q / 3) % 3;
+  side[2] = q / 9;
+}
+
+static PetscErrorCode MatDestroy_DMStagStencilOp(void *ctx)
+{
+  DMStagStencilOp *op = (DMStagStencilOp *)ctx;
+
+  PetscFunctionBegin;
+  for (PetscInt r = 0; r < op->nrows; ++r) PetscCall(PetscFree4(op->rows[r].delta, op->rows[r].shift, op->rows[r].ccenter, op->rows[r].val));
+  PetscCall(PetscFree(op->rows));
+  PetscCall(DMDestroy(&op->dm));
+  PetscCall(PetscFree(op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Applies the stencils to a local vector, over the owned elements and the extra ones on the upper boundaries */
+static PetscErrorCode DMStagStencilOpApply_Private(DMStagStencilOp *op, const PetscScalar *xa, PetscScalar *ya)
+{
+  DM_Stag *const stag = (DM_Stag *)op->dm->data;
+  PetscInt       dim, start[DMSTAG_MAX_DIM], end[DMSTAG_MAX_DIM], sg[DMSTAG_MAX_DIM], ng[DMSTAG_MAX_DIM], N[DMSTAG_MAX_DIM], nExtra[DMSTAG_MAX_DIM];
+  PetscBool      periodic[DMSTAG_MAX_DIM];
+  PetscLogDouble nnz = 0;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetDimension(op->dm, &dim));
+  PetscCall(DMStagGetCorners(op->dm, &start[0], &start[1], &start[2], &end[0], &end[1], &end[2], &nExtra[0], &nExtra[1], &nExtra[2]));
+  for (PetscInt d = 0; d < DMSTAG_MAX_DIM; ++d) {
+    if (d < dim) {
+      end[d] += start[d] + nExtra[d];
+      sg[d]       = stag->startGhost[d];
+      ng[d]       = stag->nGhost[d];
+      N[d]        = stag->N[d];
+      periodic[d] = stag->boundaryType[d] == DM_BOUNDARY_PERIODIC ? PETSC_TRUE : PETSC_FALSE;
+    } else {
+      start[d]    = 0;
+      end[d]      = 1;
+      sg[d]       = 0;
+      ng[d]       = 1;
+      N[d]        = 1;
+      periodic[d] = PETSC_TRUE;
+    }
+  }
+  for (PetscInt k = start[2]; k < end[2]; ++k) {
+    for (PetscInt j = start[1]; j < end[1]; ++j) {
+      const PetscBool interiorjk = (PetscBool)(j >= op->lo[1] && j < op->hi[1] && k >= op->lo[2] && k < op->hi[2]);
+      PetscInt        e          = (((k - sg[2]) * ng[1] + (j - sg[1])) * ng[0] + (start[0] - sg[0])) * stag->entriesPerElement;
+
+      for (PetscInt i = start[0]; i < end[0]; ++i, e += stag->entriesPerElement) {
+        const PetscBool interior = (PetscBool)(interiorjk && i >= op->lo[0] && i < op->hi[0]);
+
+        for (PetscInt r = 0; r < op->nrows; ++r) {
+          const DMStagStencilOpRow *row = &op->rows[r];
+          const PetscScalar        *x   = &xa[e + row->slot];
+          PetscScalar               sum = 0.0;
+
+          if (interior) {
+            /* The hot loop: no checks, one offset and one coefficient per column */
+            for (PetscInt q = 0; q < row->n; ++q) sum += row->val[q] * x[row->delta[q]];
+          } else {
+            const PetscInt ijk[]  = {i, j, k};
+            PetscBool      exists = PETSC_TRUE;
+
+            for (PetscInt d = 0; d < dim; ++d)
+              if (row->center[d] && !periodic[d] && ijk[d] >= N[d]) exists = PETSC_FALSE;
+            if (!exists) continue;
+            for (PetscInt q = 0; q < row->n; ++q) {
+              PetscBool in = PETSC_TRUE;
+
+              for (PetscInt d = 0; d < dim; ++d) {
+                const PetscInt t = ijk[d] + row->shift[q * DMSTAG_MAX_DIM + d];
+
+                if (!periodic[d] && (t < 0 || t > N[d] || (t == N[d] && row->ccenter[q * DMSTAG_MAX_DIM + d]))) in = PETSC_FALSE;
+              }
+              if (in) sum += row->val[q] * x[row->delta[q]];
+            }
+          }
+          ya[e + row->slot] = sum;
+        }
+      }
+    }
+  }
+  for (PetscInt r = 0; r < op->nrows; ++r) nnz += op->rows[r].n;
+  PetscCall(PetscLogFlops(2.0 * nnz * (end[0] - start[0]) * (end[1] - start[1]) * (end[2] - start[2])));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_DMStagStencilOp(Mat A, Vec x, Vec y)
+{
+  DMStagStencilOp   *op;
+  Vec                xl, yl;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &op));
+  PetscCall(DMGetLocalVector(op->dm, &xl));
+  PetscCall(DMGetLocalVector(op->dm, &yl));
+  PetscCall(DMGlobalToLocal(op->dm, x, INSERT_VALUES, xl));
+  PetscCall(VecZeroEntries(yl));
+  if (op->nrows) {
+    PetscCall(VecGetArrayRead(xl, &xa));
+    PetscCall(VecGetArray(yl, &ya));
+    PetscCall(DMStagStencilOpApply_Private(op, xa, ya));
+    PetscCall(VecRestoreArray(yl, &ya));
+    PetscCall(VecRestoreArrayRead(xl, &xa));
+  }
+  PetscCall(DMLocalToGlobal(op->dm, yl, INSERT_VALUES, y));
+  PetscCall(DMRestoreLocalVector(op->dm, &yl));
+  PetscCall(DMRestoreLocalVector(op->dm, &xl));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetDiagonal_DMStagStencilOp(Mat A, Vec v)
+{
+  DMStagStencilOp *op;
+  Vec              vl;
+  PetscScalar     *va;
+  PetscInt         epe, nlocal;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &op));
+  PetscCall(DMStagGetEntriesPerElement(op->dm, &epe));
+  PetscCall(DMGetLocalVector(op->dm, &vl));
+  PetscCall(VecGetLocalSize(vl, &nlocal));
+  /* The diagonal entry of a row never leaves the domain, so it is the same everywhere */
+  PetscCall(VecGetArray(vl, &va));
+  for (PetscInt e = 0; e < nlocal; e += epe) {
+    for (PetscInt s = 0; s < epe; ++s) va[e + s] = 0.0;
+    for (PetscInt r = 0; r < op->nrows; ++r) va[e + op->rows[r].slot] = op->rows[r].diag;
+  }
+  PetscCall(VecRestoreArray(vl, &va));
+  PetscCall(DMLocalToGlobal(op->dm, vl, INSERT_VALUES, v));
+  PetscCall(DMRestoreLocalVector(op->dm, &vl));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMStagCreateStencilOperator - Create a matrix-free operator on a `DMSTAG` whose rows are given by stencils which are the same at every point of a location
+
+  Collective
+
+  Input Parameter:
+. dm - the `DMSTAG` object
+
+  Output Parameter:
+. A - the `MATSHELL` operator, acting on global vectors of `dm`
+
+  Notes:
+  The operator is zero until stencils are given with `DMStagStencilOperatorSetStencil()`, for each location and component with nonzero rows.
+  Applying it only reads the coefficients and the vector, without any index storage, so it is much cheaper in memory bandwidth than the
+  equivalent `MATAIJ` matrix assembled with `DMStagMatSetValuesStencil()`.
+
+  The operator supports `MatMult()` and `MatGetDiagonal()`, as well as the shifts and scalings of `MATSHELL`. It can thus be used with
+  Krylov methods and point Jacobi or Chebyshev smoothers, for instance on the levels of `PCMG`, but not with preconditioners requiring
+  the matrix entries.
+
+  Columns outside of the domain are dropped, for non-periodic boundaries.
+
+  Level: intermediate
+
+.seealso: [](chapter_stag), `DMSTAG`, `DMStagStencilOperatorSetStencil()`, `DMStagMatSetValuesStencil()`, `MatCreateShell()`
+@*/
+PetscErrorCode DMStagCreateStencilOperator(DM dm, Mat *A)
+{
+  DMStagStencilOp *op;
+  PetscInt         dim, entries;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm, DM_CLASSID, 1, DMSTAG);
+  PetscValidPointer(A, 2);
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMStagGetEntries(dm, &entries));
+  PetscCall(PetscNew(&op));
+  PetscCall(PetscObjectReference((PetscObject)dm));
+  op->dm = dm;
+  for (PetscInt d = 0; d < DMSTAG_MAX_DIM; ++d) {
+    op->lo[d] = PETSC_MIN_INT;
+    op->hi[d] = PETSC_MAX_INT;
+  }
+  PetscCall(MatCreateShell(PetscObjectComm((PetscObject)dm), entries, entries, PETSC_DETERMINE, PETSC_DETERMINE, op, A));
+  PetscCall(MatShellSetContextDestroy(*A, MatDestroy_DMStagStencilOp));
+  PetscCall(MatShellSetOperation(*A, MATOP_MULT, (void (*)(void))MatMult_DMStagStencilOp));
+  PetscCall(MatShellSetOperation(*A, MATOP_GET_DIAGONAL, (void (*)(void))MatGetDiagonal_DMStagStencilOp));
+  PetscCall(MatSetDM(*A, dm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  DMStagStencilOperatorSetStencil - Set the stencil of all rows of a location and component of an operator created with `DMStagCreateStencilOperator()`
+
+  Logically Collective
+
+  Input Parameters:
++ A - the operator
+. loc - the location of the rows, one of the canonical ones (`DMSTAG_ELEMENT`, `DMSTAG_LEFT`, `DMSTAG_DOWN`, `DMSTAG_DOWN_LEFT`, `DMSTAG_BACK`, ...)
+. c - the component of the rows
+. n - the number of columns
+. col - the columns, with their `i`, `j`, `k` fields holding element offsets relative to the row
+- val - the coefficient of each column
+
+  Notes:
+  Any location can be used for the columns, so that for instance the divergence of a face field on the element of a 2D grid is given
+  with columns at `DMSTAG_LEFT`, `DMSTAG_RIGHT`, `DMSTAG_DOWN` and `DMSTAG_UP` of the element offset (0, 0).
+
+  The columns must lie within the stencil width of the `DMSTAG`, and in a single direction for `DMSTAG_STENCIL_STAR`.
+
+  Setting the stencil of a location and component again replaces it.
+
+  Level: intermediate
+
+.seealso: [](chapter_stag), `DMSTAG`, `DMStagCreateStencilOperator()`, `DMStagStencil`, `DMStagMatSetValuesStencil()`
+@*/
+PetscErrorCode DMStagStencilOperatorSetStencil(Mat A, DMStagStencilLocation loc, PetscInt c, PetscInt n, const DMStagStencil col[], const PetscScalar val[])
+{
+  DMStagStencilOp      *op;
+  DM_Stag              *stag;
+  DMStagStencilOpRow   *row = NULL;
+  DMStagStencilLocation locCanonical;
+  DMStagStencilType     stencilType;
+  PetscInt              dim, dof, side[DMSTAG_MAX_DIM], stride[DMSTAG_MAX_DIM], stencilWidth;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  if (n) PetscValidPointer(col, 5);
+  if (n) PetscValidScalarPointer(val, 6);
+  PetscCall(MatShellGetContext(A, &op));
+  PetscCheck(op && op->dm, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONG, "Matrix was not created with DMStagCreateStencilOperator()");
+  stag = (DM_Stag *)op->dm->data;
+  PetscCall(DMGetDimension(op->dm, &dim));
+  PetscCall(DMStagGetStencilType(op->dm, &stencilType));
+  PetscCall(DMStagGetStencilWidth(op->dm, &stencilWidth));
+  PetscCall(DMStagStencilLocationCanonicalize(loc, &locCanonical));
+  PetscCheck(loc == locCanonical, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONG, "Rows must be given at a canonical location, %s instead of %s", DMStagStencilLocations[locCanonical], DMStagStencilLocations[loc]);
+  PetscCall(DMStagGetLocationDOF(op->dm, loc, &dof));
+  PetscCheck(c >= 0 && c < dof, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_OUTOFRANGE, "Component %" PetscInt_FMT " not in [0, %" PetscInt_FMT ") for location %s", c, dof, DMStagStencilLocations[loc]);
+  stride[0] = stag->entriesPerElement;
+  stride[1] = stride[0] * (dim > 1 ? stag->nGhost[0] : 1);
+  stride[2] = stride[1] * (dim > 2 ? stag->nGhost[1] : 1);
+
+  for (PetscInt r = 0; r < op->nrows; ++r)
+    if (op->rows[r].loc == loc && op->rows[r].c == c) {
+      row = &op->rows[r];
+      PetscCall(PetscFree4(row->delta, row->shift, row->ccenter, row->val));
+    }
+  if (!row) {
+    if (op->nrows == op->maxrows) {
+      op->maxrows = PetscMax(2 * op->maxrows, 4);
+      PetscCall(PetscRealloc(op->maxrows * sizeof(DMStagStencilOpRow), &op->rows));
+    }
+    row = &op->rows[op->nrows++];
+    PetscCall(PetscMemzero(row, sizeof(DMStagStencilOpRow)));
+  }
+  row->loc = loc;
+  row->c   = c;
+  row->n   = n;
+  PetscCall(DMStagGetLocationSlot(op->dm, loc, c, &row->slot));
+  DMStagLocationGetSides_Private(loc, side);
+  for (PetscInt d = 0; d < DMSTAG_MAX_DIM; ++d) row->center[d] = side[d] == 1 ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(PetscMalloc4(n, &row->delta, n * DMSTAG_MAX_DIM, &row->shift, n * DMSTAG_MAX_DIM, &row->ccenter, n, &row->val));
+  row->diag = 0.0;
+  for (PetscInt q = 0; q < n; ++q) {
+    const PetscInt        offset[] = {col[q].i, col[q].j, col[q].k};
+    DMStagStencilLocation colCanonical;
+    PetscInt              colSide[DMSTAG_MAX_DIM], colDof, colSlot, ndir = 0;
+
+    PetscCall(DMStagStencilLocationCanonicalize(col[q].loc, &colCanonical));
+    PetscCall(DMStagGetLocationDOF(op->dm, colCanonical, &colDof));
+    PetscCheck(col[q].c >= 0 && col[q].c < colDof, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_OUTOFRANGE, "Column %" PetscInt_FMT ": component %" PetscInt_FMT " not in [0, %" PetscInt_FMT ") for location %s", q, col[q].c, colDof, DMStagStencilLocations[col[q].loc]);
+    PetscCall(DMStagGetLocationSlot(op->dm, colCanonical, col[q].c, &colSlot));
+    DMStagLocationGetSides_Private(col[q].loc, colSide);
+    row->delta[q] = colSlot - row->slot;
+    for (PetscInt d = 0; d < DMSTAG_MAX_DIM; ++d) {
+      const PetscInt shift = d < dim ? offset[d] + (colSide[d] == 2 ? 1 : 0) : 0;
+
+      PetscCheck(d < dim || colSide[d] == 1, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONG, "Column %" PetscInt_FMT ": location %s does not exist in dimension %" PetscInt_FMT, q, DMStagStencilLocations[col[q].loc], dim);
+      PetscCheck(PetscAbsInt(shift) <= stencilWidth, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_OUTOFRANGE, "Column %" PetscInt_FMT " is %" PetscInt_FMT " elements away in direction %" PetscInt_FMT ", beyond the stencil width %" PetscInt_FMT, q, PetscAbsInt(shift), d, stencilWidth);
+      row->shift[q * DMSTAG_MAX_DIM + d]   = shift;
+      row->ccenter[q * DMSTAG_MAX_DIM + d] = colSide[d] == 1 ? PETSC_TRUE : PETSC_FALSE;
+      row->delta[q] += shift * stride[d];
+      if (shift) ++ndir;
+    }
+    PetscCheck(stencilType != DMSTAG_STENCIL_STAR || ndir <= 1, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONG, "Column %" PetscInt_FMT " is diagonal to the row, which requires DMSTAG_STENCIL_BOX", q);
+    row->val[q] = val[q];
+    if (!row->delta[q]) row->diag += val[q];
+  }
+
+  /* Elements where no column of any stencil needs to be checked against the domain boundary */
+  for (PetscInt d = 0; d < DMSTAG_MAX_DIM; ++d) {
+    PetscInt minShift = 0, maxShift = 0;
+
+    if (d >= dim || stag->boundaryType[d] == DM_BOUNDARY_PERIODIC) {
+      op->lo[d] = PETSC_MIN_INT;
+      op->hi[d] = PETSC_MAX_INT;
+      continue;
+    }
+    for (PetscInt r = 0; r < op->nrows; ++r) {
+      for (PetscInt q = 0; q < op->rows[r].n; ++q) {
+        minShift = PetscMin(minShift, op->rows[r].shift[q * DMSTAG_MAX_DIM + d]);
+        maxShift = PetscMax(maxShift, op->rows[r].shift[q * DMSTAG_MAX_DIM + d]);
+      }
+    }
+    /* Rows at the center are missing on the upper boundary, which is only checked on the boundary path */
+    op->lo[d] = -minShift;
+    op->hi[d] = stag->N[d] - maxShift;
+  }
+  PetscCall(PetscObjectStateIncrease((PetscObject)A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
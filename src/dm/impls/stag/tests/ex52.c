@@ -0,0 +1,216 @@
+static char help[] = "Test matrix-free stencil operators on DMStag against assembled AIJ matrices\n\n";
+
+#include <petscdm.h>
+#include <petscdmstag.h>
+#include <petscksp.h>
+
+/* The columns of the rows at a canonical location and component: a Laplacian-like stencil on the same points, and couplings
+   to all the other points of the element, from both of their sides */
+static PetscErrorCode GetStencil(DM dm, DMStagStencilLocation loc, PetscInt c, PetscInt *n, DMStagStencil col[], PetscScalar val[])
+{
+  PetscInt          dim, width;
+  DMStagStencilType type;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMStagGetStencilType(dm, &type));
+  PetscCall(DMStagGetStencilWidth(dm, &width));
+  *n = 0;
+  col[*n].loc = loc;
+  col[*n].c   = c;
+  col[*n].i = col[*n].j = col[*n].k = 0;
+  val[(*n)++]                       = 2 * dim + 1 + c;
+  for (PetscInt d = 0; d < dim; ++d) {
+    for (PetscInt s = -width; s <= width; s += 2 * width) {
+      col[*n]     = col[0];
+      if (d == 0) col[*n].i = s;
+      if (d == 1) col[*n].j = s;
+      if (d == 2) col[*n].k = s;
+      val[(*n)++] = -1.0 / width;
+    }
+  }
+  if (dim > 1 && type == DMSTAG_STENCIL_BOX) {
+    col[*n]     = col[0];
+    col[*n].i   = 1;
+    col[*n].j   = -1;
+    val[(*n)++] = 0.01;
+  }
+  for (PetscInt s = 0; s < (1 << dim); ++s) {
+    const PetscInt        side[3] = {s & 1, dim > 1 ? (s >> 1) & 1 : 1, dim > 2 ? (s >> 2) & 1 : 1};
+    DMStagStencilLocation other   = (DMStagStencilLocation)(1 + side[0] + 3 * side[1] + 9 * side[2]);
+    PetscInt              dof;
+
+    PetscCall(DMStagGetLocationDOF(dm, other, &dof));
+    for (PetscInt oc = 0; oc < dof; ++oc) {
+      if (other == loc && oc == c) continue;
+      col[*n].loc = other;
+      col[*n].c   = oc;
+      col[*n].i = col[*n].j = col[*n].k = 0;
+      val[(*n)++]                       = 0.1 * (1 + c + oc);
+      for (PetscInt d = 0; d < dim; ++d) {
+        if (side[d]) continue;
+        col[*n]     = col[*n - 1];
+        col[*n].loc = (DMStagStencilLocation)(other + (d == 0 ? 2 : d == 1 ? 6 : 18));
+        val[(*n)++] = -0.05 * (d + 1);
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm;
+  Mat            A, B;
+  Vec            x, y, z, b;
+  KSP            ksp;
+  PetscInt       dim = 2, start[3], m[3], nExtra[3], N[3];
+  DMBoundaryType bt[3];
+  PetscReal      nrm, err;
+  DMStagStencil  col[256], row;
+  PetscScalar    val[256];
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dim", &dim, NULL));
+  switch (dim) {
+  case 1:
+    PetscCall(DMStagCreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, 8, 1, 2, DMSTAG_STENCIL_BOX, 1, NULL, &dm));
+    break;
+  case 2:
+    PetscCall(DMStagCreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, 6, 5, PETSC_DECIDE, PETSC_DECIDE, 1, 2, 1, DMSTAG_STENCIL_BOX, 1, NULL, NULL, &dm));
+    break;
+  case 3:
+    PetscCall(DMStagCreate3d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, 4, 5, 3, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, 1, 1, 1, 1, DMSTAG_STENCIL_BOX, 1, NULL, NULL, NULL, &dm));
+    break;
+  default:
+    SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "Unsupported dimension %" PetscInt_FMT, dim);
+  }
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(DMSetUp(dm));
+  PetscCall(DMStagGetCorners(dm, &start[0], &start[1], &start[2], &m[0], &m[1], &m[2], &nExtra[0], &nExtra[1], &nExtra[2]));
+  PetscCall(DMStagGetGlobalSizes(dm, &N[0], &N[1], &N[2]));
+  PetscCall(DMStagGetBoundaryTypes(dm, &bt[0], &bt[1], &bt[2]));
+  for (PetscInt d = dim; d < 3; ++d) {
+    start[d]  = 0;
+    m[d]      = 1;
+    nExtra[d] = 0;
+  }
+
+  /* The same operator, matrix-free and assembled */
+  PetscCall(DMStagCreateStencilOperator(dm, &A));
+  PetscCall(DMCreateMatrix(dm, &B));
+  PetscCall(MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  for (PetscInt s = 0; s < (1 << dim); ++s) {
+    const PetscInt        side[3] = {s & 1, dim > 1 ? (s >> 1) & 1 : 1, dim > 2 ? (s >> 2) & 1 : 1};
+    DMStagStencilLocation loc     = (DMStagStencilLocation)(1 + side[0] + 3 * side[1] + 9 * side[2]);
+    PetscInt              dof, n;
+
+    PetscCall(DMStagGetLocationDOF(dm, loc, &dof));
+    for (PetscInt c = 0; c < dof; ++c) {
+      PetscCall(GetStencil(dm, loc, c, &n, col, val));
+      PetscCall(DMStagStencilOperatorSetStencil(A, loc, c, n, col, val));
+      for (PetscInt k = start[2]; k < start[2] + m[2] + nExtra[2]; ++k) {
+        for (PetscInt j = start[1]; j < start[1] + m[1] + nExtra[1]; ++j) {
+          for (PetscInt i = start[0]; i < start[0] + m[0] + nExtra[0]; ++i) {
+            const PetscInt ijk[3] = {i, j, k};
+            DMStagStencil  acol[256];
+            PetscScalar    aval[256];
+            PetscInt       an = 0;
+
+            /* Rows and columns on the dummy points past the upper boundaries are ignored by DMStagMatSetValuesStencil() */
+            row.loc = loc;
+            row.c   = c;
+            row.i   = i;
+            row.j   = j;
+            row.k   = k;
+            for (PetscInt q = 0; q < n; ++q) {
+              const PetscInt off[3] = {col[q].i, col[q].j, col[q].k};
+              const PetscInt q1     = (PetscInt)col[q].loc - 1;
+              const PetscInt cside[3] = {q1 % 3, (q1 / 3) % 3, q1 / 9};
+              PetscBool      in       = PETSC_TRUE;
+
+              for (PetscInt d = 0; d < dim; ++d) {
+                const PetscInt t = ijk[d] + off[d] + (cside[d] == 2 ? 1 : 0);
+
+                if (bt[d] != DM_BOUNDARY_PERIODIC && (t < 0 || t > N[d])) in = PETSC_FALSE;
+              }
+              if (!in) continue;
+              acol[an]   = col[q];
+              acol[an].i = i + col[q].i;
+              acol[an].j = j + col[q].j;
+              acol[an].k = k + col[q].k;
+              aval[an++] = val[q];
+            }
+            PetscCall(DMStagMatSetValuesStencil(dm, B, 1, &row, an, acol, aval, ADD_VALUES));
+          }
+        }
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(DMCreateGlobalVector(dm, &x));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicate(x, &z));
+  PetscCall(VecDuplicate(x, &b));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(B, x, z));
+  PetscCall(VecNorm(z, NORM_2, &nrm));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_2, &err));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMult() matches AIJ: %s\n", err <= 1e-12 * nrm ? "yes" : "no"));
+  PetscCall(MatGetDiagonal(A, y));
+  PetscCall(MatGetDiagonal(B, z));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_2, &err));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatGetDiagonal() matches AIJ: %s\n", err <= 1e-12 * nrm ? "yes" : "no"));
+
+  /* Solve with the matrix-free operator and a point Jacobi preconditioner */
+  PetscCall(MatMult(B, x, b));
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetType(ksp, KSPGMRES));
+  PetscCall(KSPSetTolerances(ksp, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSolve(ksp, b, y));
+  PetscCall(VecAXPY(y, -1.0, x));
+  PetscCall(VecNorm(y, NORM_2, &err));
+  PetscCall(VecNorm(x, NORM_2, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "KSPSolve() with the matrix-free operator recovers the solution: %s\n", err <= 1e-6 * nrm ? "yes" : "no"));
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&A));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1d
+      nsize: {{1 3}}
+      args: -dim 1 -stag_boundary_type_x {{none periodic ghosted}} -stag_stencil_width {{1 2}} -pc_type jacobi
+      output_file: output/ex52_1.out
+
+   test:
+      suffix: 2d
+      nsize: {{1 4}}
+      args: -dim 2 -stag_boundary_type_x {{none periodic}} -stag_boundary_type_y {{none periodic}} -stag_stencil_type {{star box}} -pc_type jacobi
+      output_file: output/ex52_1.out
+
+   test:
+      suffix: 3d
+      nsize: {{1 4}}
+      args: -dim 3 -stag_boundary_type_x periodic -stag_stencil_type {{star box}} -pc_type jacobi
+      output_file: output/ex52_1.out
+
+TEST*/
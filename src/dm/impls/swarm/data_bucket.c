@@ -450,6 +450,30 @@ PetscErrorCode DMSwarmDataFieldInsertPoint(const DMSwarmDataField field, const P
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Reorders the points of all fields so that point p takes the values of point perm[p] */
+PetscErrorCode DMSwarmDataBucketPermute(DMSwarmDataBucket db, const PetscInt perm[])
+{
+  size_t    maxsize = 0;
+  char     *buffer;
+  PetscBool any_active_fields;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketQueryForActiveFields(db, &any_active_fields));
+  PetscCheck(!any_active_fields, PETSC_COMM_SELF, PETSC_ERR_USER, "Cannot safely reorder points as at least one DMSwarmDataField is currently being accessed");
+  for (PetscInt f = 0; f < db->nfields; ++f) maxsize = PetscMax(maxsize, db->field[f]->atomic_size);
+  PetscCall(PetscMalloc(maxsize * db->L, &buffer));
+  for (PetscInt f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField field = db->field[f];
+    const size_t     size  = field->atomic_size;
+    const char      *data  = (const char *)field->data;
+
+    for (PetscInt p = 0; p < db->L; ++p) PetscCall(PetscMemcpy(buffer + p * size, data + perm[p] * size, size));
+    PetscCall(PetscMemcpy(field->data, buffer, db->L * size));
+  }
+  PetscCall(PetscFree(buffer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* remove data at index - replace with last point */
 PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket db, const PetscInt index)
 {
@@ -482,6 +506,40 @@ PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket db, c
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* remove all points flagged in mask[] - the remaining points are compacted, keeping their relative order */
+PetscErrorCode DMSwarmDataBucketRemovePointsWithMask(DMSwarmDataBucket db, const PetscBool mask[])
+{
+  PetscInt  p, nkeep = 0;
+  PetscBool any_active_fields;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketQueryForActiveFields(db, &any_active_fields));
+  PetscCheck(!any_active_fields, PETSC_COMM_SELF, PETSC_ERR_USER, "Cannot safely remove points as at least one DMSwarmDataField is currently being accessed");
+  for (p = 0; p < db->L && !mask[p]; ++p) nkeep++;
+  if (nkeep == db->L) PetscFunctionReturn(PETSC_SUCCESS);
+  /* move each run of kept points down in a single copy per field */
+  while (p < db->L) {
+    PetscInt start, end;
+
+    for (start = p; start < db->L && mask[start]; ++start)
+      ;
+    for (end = start; end < db->L && !mask[end]; ++end)
+      ;
+    if (end > start) {
+      for (PetscInt f = 0; f < db->nfields; ++f) {
+        DMSwarmDataField field = db->field[f];
+        const size_t     size  = field->atomic_size;
+
+        PetscCall(PetscMemmove((char *)field->data + nkeep * size, (char *)field->data + start * size, (end - start) * size));
+      }
+      nkeep += end - start;
+    }
+    p = end;
+  }
+  PetscCall(DMSwarmDataBucketSetSizes(db, nkeep, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* copy x into y */
 PetscErrorCode DMSwarmDataFieldCopyPoint(const PetscInt pid_x, const DMSwarmDataField field_x, const PetscInt pid_y, const DMSwarmDataField field_y)
 {
@@ -679,7 +737,6 @@ PetscErrorCode DMSwarmDataBucketCreatePackedArray(DMSwarmDataBucket db, size_t *
 {
   PetscInt f;
   size_t   sizeof_marker_contents;
-  void    *buffer;
 
   PetscFunctionBegin;
   sizeof_marker_contents = 0;
@@ -687,10 +744,8 @@ PetscErrorCode DMSwarmDataBucketCreatePackedArray(DMSwarmDataBucket db, size_t *
     DMSwarmDataField df = db->field[f];
     sizeof_marker_contents += df->atomic_size;
   }
-  PetscCall(PetscMalloc(sizeof_marker_contents, &buffer));
-  PetscCall(PetscMemzero(buffer, sizeof_marker_contents));
   if (bytes) *bytes = sizeof_marker_contents;
-  if (buf) *buf = buffer;
+  if (buf) PetscCall(PetscCalloc(sizeof_marker_contents, buf));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -724,6 +779,43 @@ PetscErrorCode DMSwarmDataBucketFillPackedArray(DMSwarmDataBucket db, const Pets
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* pack the points list[0..n-1] into buf, one field at a time, using the same layout as DMSwarmDataBucketFillPackedArray() */
+PetscErrorCode DMSwarmDataBucketFillPackedArrays(DMSwarmDataBucket db, const PetscInt n, const PetscInt list[], void *buf)
+{
+  size_t unit = 0, offset = 0;
+
+  PetscFunctionBegin;
+  for (PetscInt f = 0; f < db->nfields; ++f) unit += db->field[f]->atomic_size;
+  for (PetscInt f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    const char      *data  = (const char *)df->data;
+
+    for (PetscInt p = 0; p < n; ++p) PetscCall(PetscMemcpy((char *)buf + p * unit + offset, data + list[p] * asize, asize));
+    offset += asize;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* unpack n packed points from data into the locations idx, ..., idx+n-1 */
+PetscErrorCode DMSwarmDataBucketInsertPackedArrays(DMSwarmDataBucket db, const PetscInt idx, const PetscInt n, const void *data)
+{
+  size_t unit = 0, offset = 0;
+
+  PetscFunctionBegin;
+  PetscCheck(idx >= 0 && idx + n <= db->L, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Points [%" PetscInt_FMT ", %" PetscInt_FMT ") are not in the list of length %" PetscInt_FMT, idx, idx + n, db->L);
+  for (PetscInt f = 0; f < db->nfields; ++f) unit += db->field[f]->atomic_size;
+  for (PetscInt f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    char            *dest  = (char *)df->data + idx * asize;
+
+    for (PetscInt p = 0; p < n; ++p) PetscCall(PetscMemcpy(dest + p * asize, (const char *)data + p * unit + offset, asize));
+    offset += asize;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMSwarmDataBucketInsertPackedArray(DMSwarmDataBucket db, const PetscInt idx, void *data)
 {
   PetscInt f;
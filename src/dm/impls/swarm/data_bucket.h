@@ -85,6 +85,8 @@ PETSC_INTERN PetscErrorCode DMSwarmDataBucketView(MPI_Comm, DMSwarmDataBucket, c
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketAddPoint(DMSwarmDataBucket);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePoint(DMSwarmDataBucket);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket, const PetscInt);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketPermute(DMSwarmDataBucket, const PetscInt[]);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePointsWithMask(DMSwarmDataBucket, const PetscBool[]);
 
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketDuplicateFields(DMSwarmDataBucket, DMSwarmDataBucket *);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertValues(DMSwarmDataBucket, DMSwarmDataBucket);
@@ -94,5 +96,7 @@ PETSC_INTERN PetscErrorCode DMSwarmDataBucketCreatePackedArray(DMSwarmDataBucket
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketDestroyPackedArray(DMSwarmDataBucket, void **);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketFillPackedArray(DMSwarmDataBucket, const PetscInt, void *);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertPackedArray(DMSwarmDataBucket, const PetscInt, void *);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketFillPackedArrays(DMSwarmDataBucket, const PetscInt, const PetscInt[], void *);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertPackedArrays(DMSwarmDataBucket, const PetscInt, const PetscInt, const void *);
 
 #endif // PETSC_DMSWARM_DATA_BUCKET_H
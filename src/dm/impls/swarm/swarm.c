@@ -15,7 +15,7 @@ PetscLogEvent DMSWARM_DataExchangerTopologySetup, DMSWARM_DataExchangerBegin, DM
 PetscLogEvent DMSWARM_DataExchangerSendCount, DMSWARM_DataExchangerPack;
 
 const char *DMSwarmTypeNames[]          = {"basic", "pic", NULL};
-const char *DMSwarmMigrateTypeNames[]   = {"basic", "dmcellnscatter", "dmcellexact", "user", NULL};
+const char *DMSwarmMigrateTypeNames[]   = {"basic", "dmcellnscatter", "dmcellexact", "user", "dmplexneighbor", "DMSwarmMigrateType", "DMSWARM_MIGRATE_", NULL};
 const char *DMSwarmCollectTypeNames[]   = {"basic", "boundingbox", "general", "user", NULL};
 const char *DMSwarmPICLayoutTypeNames[] = {"regular", "gauss", "subdivision", NULL};
 
@@ -1201,7 +1201,7 @@ PetscErrorCode DMSwarmRemovePoint(DM dm)
 
    Level: beginner
 
-.seealso: `DMSwarmRemovePoint()`
+.seealso: `DMSwarmRemovePoint()`, `DMSwarmRemovePoints()`
 @*/
 PetscErrorCode DMSwarmRemovePointAtIndex(DM dm, PetscInt idx)
 {
@@ -1214,6 +1214,77 @@ PetscErrorCode DMSwarmRemovePointAtIndex(DM dm, PetscInt idx)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   DMSwarmRemovePoints - Removes a set of points from the DMSwarm
+
+   Not collective
+
+   Input parameters:
++  dm - a DMSwarm
+.  n - number of points to remove
+-  idx - indices of the points to remove, may be unsorted and contain duplicates
+
+   Level: intermediate
+
+   Notes:
+   All fields are compacted in a single pass and the remaining points keep their relative order, unlike repeated calls
+   to `DMSwarmRemovePointAtIndex()` which move the last point into the hole. The cell sort context no longer matches the
+   points and is invalidated, `DMSwarmSortGetAccess()` must be called again before it is used.
+
+.seealso: `DMSwarmRemovePointsWithMask()`, `DMSwarmRemovePointAtIndex()`, `DMSwarmAddNPoints()`
+@*/
+PetscErrorCode DMSwarmRemovePoints(DM dm, PetscInt n, const PetscInt idx[])
+{
+  DM_Swarm  *swarm = (DM_Swarm *)dm->data;
+  PetscInt   nlocal;
+  PetscBool *mask;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (n) PetscValidIntPointer(idx, 3);
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &nlocal, NULL, NULL));
+  PetscCall(PetscCalloc1(nlocal, &mask));
+  for (PetscInt p = 0; p < n; ++p) {
+    PetscCheck(idx[p] >= 0 && idx[p] < nlocal, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Point index %" PetscInt_FMT " not in [0, %" PetscInt_FMT ")", idx[p], nlocal);
+    mask[idx[p]] = PETSC_TRUE;
+  }
+  PetscCall(PetscLogEventBegin(DMSWARM_RemovePoints, 0, 0, 0, 0));
+  PetscCall(DMSwarmDataBucketRemovePointsWithMask(swarm->db, mask));
+  if (swarm->sort_context) swarm->sort_context->isvalid = PETSC_FALSE;
+  PetscCall(PetscLogEventEnd(DMSWARM_RemovePoints, 0, 0, 0, 0));
+  PetscCall(PetscFree(mask));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   DMSwarmRemovePointsWithMask - Removes all points of the DMSwarm flagged in a mask
+
+   Not collective
+
+   Input parameters:
++  dm - a DMSwarm
+-  mask - array of length the local size of the swarm, the points p with mask[p] = `PETSC_TRUE` are removed
+
+   Level: intermediate
+
+   Notes:
+   The remaining points keep their relative order and the cell sort context is invalidated, see `DMSwarmRemovePoints()`.
+
+.seealso: `DMSwarmRemovePoints()`, `DMSwarmRemovePointAtIndex()`, `DMSwarmAddNPoints()`
+@*/
+PetscErrorCode DMSwarmRemovePointsWithMask(DM dm, const PetscBool mask[])
+{
+  DM_Swarm *swarm = (DM_Swarm *)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscCall(PetscLogEventBegin(DMSWARM_RemovePoints, 0, 0, 0, 0));
+  PetscCall(DMSwarmDataBucketRemovePointsWithMask(swarm->db, mask));
+  if (swarm->sort_context) swarm->sort_context->isvalid = PETSC_FALSE;
+  PetscCall(PetscLogEventEnd(DMSWARM_RemovePoints, 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    DMSwarmCopyPoint - Copy point pj to point pi in the DMSwarm
 
@@ -1280,6 +1351,9 @@ PetscErrorCode DMSwarmMigrate(DM dm, PetscBool remove_sent_points)
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE_DMCELLEXACT not implemented");
   case DMSWARM_MIGRATE_USER:
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE_USER not implemented");
+  case DMSWARM_MIGRATE_DMPLEXNEIGHBOR:
+    PetscCall(DMSwarmMigrate_DMPlexNeighbor(dm, remove_sent_points));
+    break;
   default:
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE type unknown");
   }
@@ -1485,7 +1559,14 @@ PetscErrorCode DMSetup_Swarm(DM dm)
     /* check dmcell exists */
     PetscCheck(swarm->dmcell, PetscObjectComm((PetscObject)dm), PETSC_ERR_USER, "DMSWARM_PIC requires you call DMSwarmSetCellDM");
 
-    if (swarm->dmcell->ops->locatepointssubdomain) {
+    if (swarm->migrate_type == DMSWARM_MIGRATE_DMPLEXNEIGHBOR) {
+      PetscBool isplex;
+
+      /* keep the migration requested with DMSwarmSetMigrateType() */
+      PetscCall(PetscObjectTypeCompare((PetscObject)swarm->dmcell, DMPLEX, &isplex));
+      PetscCheck(isplex, PetscObjectComm((PetscObject)dm), PETSC_ERR_USER, "DMSWARM_MIGRATE_DMPLEXNEIGHBOR requires a DMPLEX cell DM");
+      PetscCall(PetscInfo(dm, "DMSWARM_PIC: Using Plex neighbor migration\n"));
+    } else if (swarm->dmcell->ops->locatepointssubdomain) {
       /* check methods exists for exact ownership identificiation */
       PetscCall(PetscInfo(dm, "DMSWARM_PIC: Using method CellDM->ops->LocatePointsSubdomain\n"));
       swarm->migrate_type = DMSWARM_MIGRATE_DMCELLEXACT;
@@ -1,10 +1,83 @@
 #include <petscsf.h>
 #include <petscdmswarm.h>
 #include <petscdmda.h>
+#include <petscdmplex.h>
+#include <petsc/private/dmpleximpl.h>
 #include <petsc/private/dmswarmimpl.h> /*I   "petscdmswarm.h"   I*/
 #include "../src/dm/impls/swarm/data_bucket.h"
 #include "../src/dm/impls/swarm/data_ex.h"
 
+/*
+ Packs the points list[0..n-1] once, using a single pass over each field, and queues them for each of the ranks[]
+*/
+static PetscErrorCode DMSwarmMigrate_PackPoints_Private(DMSwarmDataBucket db, DMSwarmDataEx de, size_t sizeof_dmswarm_point, PetscInt nranks, const PetscMPIInt ranks[], PetscInt n, const PetscInt list[])
+{
+  void *buffer;
+
+  PetscFunctionBegin;
+  if (!n || !nranks) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc(n * sizeof_dmswarm_point, &buffer));
+  PetscCall(DMSwarmDataBucketFillPackedArrays(db, n, list, buffer));
+  for (PetscInt r = 0; r < nranks; ++r) PetscCall(DMSwarmDataExPackData(de, ranks[r], n, buffer));
+  PetscCall(PetscFree(buffer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Groups the points list[0..n-1] by destination, keeping the local order in each group, and packs each group in one go
+*/
+static PetscErrorCode DMSwarmMigrate_PackPointsByRank_Private(DMSwarmDataBucket db, DMSwarmDataEx de, size_t sizeof_dmswarm_point, PetscInt n, PetscMPIInt ranks[], PetscInt list[])
+{
+  PetscInt s, e;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSortMPIIntWithIntArray((PetscMPIInt)n, ranks, list));
+  for (s = 0; s < n; s = e) {
+    for (e = s + 1; e < n && ranks[e] == ranks[s]; ++e)
+      ;
+    PetscCall(PetscSortInt(e - s, &list[s]));
+    PetscCall(DMSwarmMigrate_PackPoints_Private(db, de, sizeof_dmswarm_point, 1, &ranks[s], e - s, &list[s]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Appends all received points at the end of the local list
+*/
+static PetscErrorCode DMSwarmMigrate_UnpackPoints_Private(DMSwarmDataBucket db, DMSwarmDataEx de)
+{
+  PetscInt npoints, n_points_recv;
+  void    *recv_points;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
+  PetscCall(DMSwarmDataBucketGetSizes(db, &npoints, NULL, NULL));
+  PetscCall(DMSwarmDataBucketSetSizes(db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
+  PetscCall(DMSwarmDataBucketInsertPackedArrays(db, npoints, n_points_recv, recv_points));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Removes all points from index start onwards which were not located
+*/
+static PetscErrorCode DMSwarmMigrate_RemoveNotFound_Private(DMSwarmDataBucket db, PetscInt start)
+{
+  DMSwarmDataField PField;
+  PetscInt         p, npoints, *rankval;
+  PetscBool       *mask;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketGetSizes(db, &npoints, NULL, NULL));
+  PetscCall(PetscMalloc1(npoints, &mask));
+  PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(db, DMSwarmField_rank, &PField));
+  PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));
+  for (p = 0; p < npoints; p++) mask[p] = (p >= start && rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(DMSwarmDataFieldRestoreEntries(PField, (void **)&rankval));
+  PetscCall(DMSwarmDataBucketRemovePointsWithMask(db, mask));
+  PetscCall(PetscFree(mask));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
  User loads desired location (MPI rank) into field DMSwarm_rank
 */
@@ -12,9 +85,9 @@ PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm, PetscBool remove_sent_points)
 {
   DM_Swarm     *swarm = (DM_Swarm *)dm->data;
   DMSwarmDataEx de;
-  PetscInt      p, npoints, *rankval, n_points_recv;
-  PetscMPIInt   rank, nrank;
-  void         *point_buffer, *recv_points;
+  PetscInt      p, npoints, *rankval, nsend = 0, *sendlist;
+  PetscMPIInt   rank, nrank, *sendrank;
+  PetscBool    *mask;
   size_t        sizeof_dmswarm_point;
   PetscBool     debug = PETSC_FALSE;
 
@@ -36,58 +109,29 @@ PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm, PetscBool remove_sent_points)
     if (nrank != rank) PetscCall(DMSwarmDataExAddToSendCount(de, nrank, 1));
   }
   PetscCall(DMSwarmDataExFinalizeSendCount(de));
-  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, &point_buffer));
-  PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
+  /* collect the outgoing points and their destination */
+  PetscCall(PetscMalloc3(npoints, &sendlist, npoints, &sendrank, npoints, &mask));
   for (p = 0; p < npoints; p++) {
-    nrank = rankval[p];
-    if (nrank != rank) {
-      /* copy point into buffer */
-      PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, point_buffer));
-      /* insert point buffer into DMSwarmDataExchanger */
-      PetscCall(DMSwarmDataExPackData(de, nrank, 1, point_buffer));
+    mask[p] = (rankval[p] != rank) ? PETSC_TRUE : PETSC_FALSE;
+    if (mask[p]) {
+      sendlist[nsend] = p;
+      sendrank[nsend] = (PetscMPIInt)rankval[p];
+      nsend++;
     }
   }
-  PetscCall(DMSwarmDataExPackFinalize(de));
   PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
+  PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
+  PetscCall(DMSwarmMigrate_PackPointsByRank_Private(swarm->db, de, sizeof_dmswarm_point, nsend, sendrank, sendlist));
+  PetscCall(DMSwarmDataExPackFinalize(de));
 
-  if (remove_sent_points) {
-    DMSwarmDataField gfield;
-
-    PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db, DMSwarmField_rank, &gfield));
-    PetscCall(DMSwarmDataFieldGetAccess(gfield));
-    PetscCall(DMSwarmDataFieldGetEntries(gfield, (void **)&rankval));
-
-    /* remove points which left processor */
-    PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-    for (p = 0; p < npoints; p++) {
-      nrank = rankval[p];
-      if (nrank != rank) {
-        /* kill point */
-        PetscCall(DMSwarmDataFieldRestoreAccess(gfield));
-
-        PetscCall(DMSwarmDataBucketRemovePointAtIndex(swarm->db, p));
-
-        PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL)); /* you need to update npoints as the list size decreases! */
-        PetscCall(DMSwarmDataFieldGetAccess(gfield));
-        PetscCall(DMSwarmDataFieldGetEntries(gfield, (void **)&rankval));
-        p--; /* check replacement point */
-      }
-    }
-    PetscCall(DMSwarmDataFieldRestoreEntries(gfield, (void **)&rankval));
-    PetscCall(DMSwarmDataFieldRestoreAccess(gfield));
-  }
+  /* remove points which left processor */
+  if (remove_sent_points) PetscCall(DMSwarmDataBucketRemovePointsWithMask(swarm->db, mask));
+  PetscCall(PetscFree3(sendlist, sendrank, mask));
   PetscCall(DMSwarmDataExBegin(de));
   PetscCall(DMSwarmDataExEnd(de));
-  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
-  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
-  for (p = 0; p < n_points_recv; p++) {
-    void *data_p = (void *)((char *)recv_points + p * sizeof_dmswarm_point);
-
-    PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, data_p));
-  }
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
   if (debug) PetscCall(DMSwarmDataExView(de));
-  PetscCall(DMSwarmDataBucketDestroyPackedArray(swarm->db, &point_buffer));
   PetscCall(DMSwarmDataExDestroy(de));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -96,10 +140,9 @@ PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm, DM dmcell, PetscBool remo
 {
   DM_Swarm          *swarm = (DM_Swarm *)dm->data;
   DMSwarmDataEx      de;
-  PetscInt           r, p, npoints, *rankval, n_points_recv;
+  PetscInt           r, p, npoints, *rankval, nlost = 0, *lostlist;
   PetscMPIInt        rank, _rank;
   const PetscMPIInt *neighbourranks;
-  void              *point_buffer, *recv_points;
   size_t             sizeof_dmswarm_point;
   PetscInt           nneighbors;
   PetscMPIInt        mynneigh, *myneigh;
@@ -117,60 +160,26 @@ PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm, DM dmcell, PetscBool remo
   }
   PetscCall(DMSwarmDataExTopologyFinalize(de));
   PetscCall(DMSwarmDataExTopologyGetNeighbours(de, &mynneigh, &myneigh));
-  PetscCall(DMSwarmDataExInitializeSendCount(de));
+  /* every point which was not located is sent to all neighbours */
+  PetscCall(PetscMalloc1(npoints, &lostlist));
   for (p = 0; p < npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r = 0; r < mynneigh; r++) {
-        _rank = myneigh[r];
-        PetscCall(DMSwarmDataExAddToSendCount(de, _rank, 1));
-      }
-    }
+    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) lostlist[nlost++] = p;
   }
+  PetscCall(DMSwarmDataExInitializeSendCount(de));
+  for (r = 0; r < mynneigh; r++) PetscCall(DMSwarmDataExAddToSendCount(de, myneigh[r], nlost));
   PetscCall(DMSwarmDataExFinalizeSendCount(de));
-  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, &point_buffer));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
   PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
-  for (p = 0; p < npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r = 0; r < mynneigh; r++) {
-        _rank = myneigh[r];
-        /* copy point into buffer */
-        PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, point_buffer));
-        /* insert point buffer into DMSwarmDataExchanger */
-        PetscCall(DMSwarmDataExPackData(de, _rank, 1, point_buffer));
-      }
-    }
-  }
+  PetscCall(DMSwarmMigrate_PackPoints_Private(swarm->db, de, sizeof_dmswarm_point, mynneigh, myneigh, nlost, lostlist));
   PetscCall(DMSwarmDataExPackFinalize(de));
+  PetscCall(PetscFree(lostlist));
   PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
-  if (remove_sent_points) {
-    DMSwarmDataField PField;
-
-    PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db, DMSwarmField_rank, &PField));
-    PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));
-    /* remove points which left processor */
-    PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-    for (p = 0; p < npoints; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        PetscCall(DMSwarmDataBucketRemovePointAtIndex(swarm->db, p));
-        PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL)); /* you need to update npoints as the list size decreases! */
-        PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));      /* update date point increase realloc performed */
-        p--;                                                                   /* check replacement point */
-      }
-    }
-  }
+  /* remove points which left processor */
+  if (remove_sent_points) PetscCall(DMSwarmMigrate_RemoveNotFound_Private(swarm->db, 0));
   PetscCall(DMSwarmDataBucketGetSizes(swarm->db, npoints_prior_migration, NULL, NULL));
   PetscCall(DMSwarmDataExBegin(de));
   PetscCall(DMSwarmDataExEnd(de));
-  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
-  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
-  for (p = 0; p < n_points_recv; p++) {
-    void *data_p = (void *)((char *)recv_points + p * sizeof_dmswarm_point);
-
-    PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, data_p));
-  }
-  PetscCall(DMSwarmDataBucketDestroyPackedArray(swarm->db, &point_buffer));
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
   PetscCall(DMSwarmDataExDestroy(de));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -233,23 +242,8 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm, PetscBool remove_sent_points)
   if (size > 1) {
     PetscCall(DMSwarmMigrate_DMNeighborScatter(dm, dmcell, remove_sent_points, &npoints_prior_migration));
   } else {
-    DMSwarmDataField PField;
-    PetscInt         npoints_curr;
-
-    /* remove points which the domain */
-    PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db, DMSwarmField_rank, &PField));
-    PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));
-
-    PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints_curr, NULL, NULL));
-    for (p = 0; p < npoints_curr; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        PetscCall(DMSwarmDataBucketRemovePointAtIndex(swarm->db, p));
-        PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints_curr, NULL, NULL)); /* you need to update npoints as the list size decreases! */
-        PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));           /* update date point increase realloc performed */
-        p--;                                                                        /* check replacement point */
-      }
-    }
+    /* remove points which left the domain */
+    PetscCall(DMSwarmMigrate_RemoveNotFound_Private(swarm->db, 0));
     PetscCall(DMSwarmGetSize(dm, &npoints_prior_migration));
   }
 
@@ -295,9 +289,8 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm, PetscBool remove_sent_points)
 #endif
 
   { /* perform two point locations: (i) on the initial points set prior to communication; and (ii) on the new (received) points */
-    PetscScalar     *LA_coor;
-    PetscInt         npoints_from_neighbours, bs;
-    DMSwarmDataField PField;
+    PetscScalar *LA_coor;
+    PetscInt     npoints_from_neighbours, bs;
 
     npoints_from_neighbours = npoints2 - npoints_prior_migration;
 
@@ -316,19 +309,7 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm, PetscBool remove_sent_points)
     PetscCall(PetscSFDestroy(&sfcell));
 
     /* remove points which left processor */
-    PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db, DMSwarmField_rank, &PField));
-    PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));
-
-    PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints2, NULL, NULL));
-    for (p = npoints_prior_migration; p < npoints2; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        PetscCall(DMSwarmDataBucketRemovePointAtIndex(swarm->db, p));
-        PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints2, NULL, NULL)); /* you need to update npoints as the list size decreases! */
-        PetscCall(DMSwarmDataFieldGetEntries(PField, (void **)&rankval));       /* update date point increase realloc performed */
-        p--;                                                                    /* check replacement point */
-      }
-    }
+    PetscCall(DMSwarmMigrate_RemoveNotFound_Private(swarm->db, npoints_prior_migration));
   }
 
   {
@@ -350,6 +331,347 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm, PetscBool remove_sent_points)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+ For each point of a Plex, the other ranks having it in their local mesh, and the owner of each ghost point (-1 if
+ owned). The owner sends the full list of ranks to each leaf, since a leaf only knows the owner from the point SF.
+*/
+static PetscErrorCode DMSwarmPlexGetSharingRanks_Private(DM plex, PetscSection *sharing, PetscMPIInt *ranks[], PetscMPIInt *owner[])
+{
+  MPI_Comm           comm;
+  PetscSF            sf;
+  MPI_Datatype       unit;
+  PetscMPIInt        rank, *list;
+  PetscInt           pStart, pEnd, nroots, nleaves, niranks, p, l, i, k, n, m = 0;
+  const PetscInt    *ilocal, *ioffset, *irootloc, *degree;
+  const PetscSFNode *iremote;
+  const PetscMPIInt *iranks;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)plex, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(DMPlexGetChart(plex, &pStart, &pEnd));
+  PetscCall(PetscMalloc1(pEnd - pStart, owner));
+  for (p = pStart; p < pEnd; ++p) (*owner)[p - pStart] = -1;
+  PetscCall(DMGetPointSF(plex, &sf));
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote));
+  PetscCall(PetscSFComputeDegreeBegin(sf, &degree));
+  PetscCall(PetscSFComputeDegreeEnd(sf, &degree));
+  for (p = 0; p < nroots; ++p) m = PetscMax(m, degree[p]);
+  m++;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &m, 1, MPIU_INT, MPI_MAX, comm));
+  /* the owner and the leaf ranks of each root, in blocks of m ranks padded with -1 */
+  PetscCall(PetscMalloc1((pEnd - pStart) * m, &list));
+  for (p = 0; p < (pEnd - pStart) * m; ++p) list[p] = -1;
+  PetscCall(PetscSFGetLeafRanks(sf, &niranks, &iranks, &ioffset, &irootloc));
+  for (i = 0; i < niranks; ++i) {
+    for (k = ioffset[i]; k < ioffset[i + 1]; ++k) {
+      PetscMPIInt *r = &list[(irootloc[k] - pStart) * m];
+
+      r[0] = rank;
+      for (l = 1; r[l] >= 0; ++l)
+        ;
+      r[l] = iranks[i];
+    }
+  }
+  PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)m, MPI_INT, &unit));
+  PetscCallMPI(MPI_Type_commit(&unit));
+  PetscCall(PetscSFBcastBegin(sf, unit, list, list, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, unit, list, list, MPI_REPLACE));
+  PetscCallMPI(MPI_Type_free(&unit));
+  for (l = 0; l < nleaves; ++l) {
+    p                    = ilocal ? ilocal[l] : l;
+    (*owner)[p - pStart] = (PetscMPIInt)iremote[l].rank;
+  }
+  PetscCall(PetscSectionCreate(PETSC_COMM_SELF, sharing));
+  PetscCall(PetscSectionSetChart(*sharing, pStart, pEnd));
+  for (p = 0; p < pEnd - pStart; ++p)
+    for (l = 0; l < m && list[p * m + l] >= 0; ++l)
+      if (list[p * m + l] != rank) PetscCall(PetscSectionAddDof(*sharing, p + pStart, 1));
+  PetscCall(PetscSectionSetUp(*sharing));
+  PetscCall(PetscSectionGetStorageSize(*sharing, &n));
+  PetscCall(PetscMalloc1(n, ranks));
+  for (p = 0, n = 0; p < pEnd - pStart; ++p)
+    for (l = 0; l < m && list[p * m + l] >= 0; ++l)
+      if (list[p * m + l] != rank) (*ranks)[n++] = list[p * m + l];
+  PetscCall(PetscFree(list));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ The ranks sharing the closure of a face, so that a point crossing the face near a corner also reaches the ranks
+ only sharing that corner. The buffer ranks[] must be large enough for all the neighbours of this rank.
+*/
+static PetscErrorCode DMSwarmPlexGetFaceRanks_Private(DM plex, PetscSection sharing, const PetscMPIInt sharingRanks[], PetscInt face, PetscInt *n, PetscMPIInt ranks[])
+{
+  PetscInt *closure = NULL, clSize;
+
+  PetscFunctionBegin;
+  *n = 0;
+  PetscCall(DMPlexGetTransitiveClosure(plex, face, PETSC_TRUE, &clSize, &closure));
+  for (PetscInt cl = 0; cl < clSize * 2; cl += 2) {
+    PetscInt ns, off;
+
+    PetscCall(PetscSectionGetDof(sharing, closure[cl], &ns));
+    PetscCall(PetscSectionGetOffset(sharing, closure[cl], &off));
+    for (PetscInt r = 0; r < ns; ++r) {
+      PetscInt k;
+
+      for (k = 0; k < *n; ++k)
+        if (ranks[k] == sharingRanks[off + r]) break;
+      if (k == *n) ranks[(*n)++] = sharingRanks[off + r];
+    }
+  }
+  PetscCall(DMPlexRestoreTransitiveClosure(plex, face, PETSC_TRUE, &clSize, &closure));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Walks from cell c towards x, each step crossing the face which x lies furthest beyond. On return cell is the cell
+ containing x, or -1 in which case face is the boundary face of the local mesh where the walk stopped, or -1 if the
+ walk did not end on the boundary
+*/
+static PetscErrorCode DMSwarmPlexWalk_Private(DM plex, PetscInt dim, const PetscScalar x[], PetscInt c, PetscInt maxSteps, PetscInt *cell, PetscInt *face)
+{
+  PetscFunctionBegin;
+  *cell = -1;
+  *face = -1;
+  for (PetscInt step = 0; step < maxSteps; ++step) {
+    const PetscInt *cone, *support;
+    PetscInt        coneSize, supportSize, fbest = -1;
+    PetscReal       cc[3], smax = 0.0;
+
+    PetscCall(DMPlexLocatePoint_Internal(plex, dim, x, c, cell));
+    if (*cell >= 0) break;
+    PetscCall(DMPlexComputeCellGeometryFVM(plex, c, NULL, cc, NULL));
+    PetscCall(DMPlexGetConeSize(plex, c, &coneSize));
+    PetscCall(DMPlexGetCone(plex, c, &cone));
+    for (PetscInt f = 0; f < coneSize; ++f) {
+      PetscReal fc[3], n[3], out = 0.0, dist = 0.0;
+
+      PetscCall(DMPlexComputeCellGeometryFVM(plex, cone[f], NULL, fc, n));
+      for (PetscInt d = 0; d < dim; ++d) {
+        out += n[d] * (fc[d] - cc[d]);
+        dist += n[d] * (PetscRealPart(x[d]) - fc[d]);
+      }
+      if (out < 0.0) dist = -dist;
+      if (dist > smax) {
+        smax  = dist;
+        fbest = cone[f];
+      }
+    }
+    if (fbest < 0) break;
+    PetscCall(DMPlexGetSupportSize(plex, fbest, &supportSize));
+    PetscCall(DMPlexGetSupport(plex, fbest, &support));
+    if (supportSize < 2) {
+      *face = fbest;
+      break;
+    }
+    c = support[0] == c ? support[1] : support[0];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Locates the points list[0..n-1], or the first n points if list is NULL, with DMLocatePoints(), storing the cell, or DMLOCATEPOINT_POINT_NOT_FOUND, in cell[] */
+static PetscErrorCode DMSwarmPlexLocate_Private(DM dmcell, PetscInt dim, const PetscReal coor[], PetscInt n, const PetscInt list[], PetscInt cell[])
+{
+  Vec                pos;
+  PetscSF            sfcell = NULL;
+  PetscScalar       *a;
+  const PetscSFNode *LA_sfcell;
+
+  PetscFunctionBegin;
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, n * dim, &pos));
+  PetscCall(VecSetBlockSize(pos, dim));
+  PetscCall(VecGetArrayWrite(pos, &a));
+  for (PetscInt p = 0; p < n; ++p)
+    for (PetscInt d = 0; d < dim; ++d) a[p * dim + d] = coor[(list ? list[p] : p) * dim + d];
+  PetscCall(VecRestoreArrayWrite(pos, &a));
+  PetscCall(DMLocatePoints(dmcell, pos, DM_POINTLOCATION_NONE, &sfcell));
+  PetscCall(PetscSFGetGraph(sfcell, NULL, NULL, NULL, &LA_sfcell));
+  for (PetscInt p = 0; p < n; ++p) cell[p] = LA_sfcell[p].index;
+  PetscCall(PetscSFDestroy(&sfcell));
+  PetscCall(VecDestroy(&pos));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Migration for Plex cell DMs which exploits that points move little between two migrations. Each point is first
+ searched by walking from its previous cell through the face neighbours. A point leaving the local mesh through a
+ face shared with other ranks is only sent to the ranks sharing the closure of this face, unless it is found in the
+ local mesh. The points for which the walk fails are located over the whole local mesh, and sent to all the
+ neighbouring ranks if they are not found.
+ Points moving by more than a cell across a rank may be lost, like points moving beyond the neighbouring ranks in
+ DMSwarmMigrate_CellDMScatter().
+*/
+PetscErrorCode DMSwarmMigrate_DMPlexNeighbor(DM dm, PetscBool remove_sent_points)
+{
+  DM_Swarm          *swarm = (DM_Swarm *)dm->data;
+  DM                 dmcell;
+  DMSwarmDataEx      de;
+  DMPlexInterpolatedFlag interpolated;
+  PetscSection       sharing = NULL;
+  PetscMPIInt       *sharingRanks = NULL, *owner = NULL, *neighbours = NULL, *faceRanks, *sendrank, rank, size;
+  PetscInt           nneighbours = 0, dim, cStart, cEnd, pStart, p, npoints, npointsg = 0, npoints2g, nprior, n2, noutlier = 0, nsend = 0;
+  PetscInt          *target, *cell, *outlier, *outliercell, *sendlist, *rankval, *p_cellid;
+  PetscReal         *coor;
+  PetscBool         *mask, isplex, error_check = swarm->migrate_error_on_missing_point;
+  size_t             sizeof_dmswarm_point;
+  const PetscInt     maxSteps = 8; /* the walk is meant for points which moved by a few cells at most */
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmGetCellDM(dm, &dmcell));
+  PetscCheck(dmcell, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Only valid if cell DM provided");
+  PetscCall(PetscObjectTypeCompare((PetscObject)dmcell, DMPLEX, &isplex));
+  PetscCheck(isplex, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Only valid for a DMPLEX cell DM");
+  PetscCall(DMPlexIsInterpolatedCollective(dmcell, &interpolated));
+  PetscCheck(interpolated == DMPLEX_INTERPOLATED_FULL, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Requires a fully interpolated cell DM");
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)dm), &size));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)dm), &rank));
+  PetscCall(DMGetCoordinateDim(dmcell, &dim));
+  PetscCall(DMGetCoordinatesLocalSetUp(dmcell));
+  PetscCall(DMPlexGetHeightStratum(dmcell, 0, &cStart, &cEnd));
+  PetscCall(DMPlexGetChart(dmcell, &pStart, NULL));
+  if (size > 1) {
+    PetscCall(DMSwarmPlexGetSharingRanks_Private(dmcell, &sharing, &sharingRanks, &owner));
+    PetscCall(PetscSectionGetStorageSize(sharing, &nneighbours));
+    PetscCall(PetscMalloc1(nneighbours, &neighbours));
+    PetscCall(PetscArraycpy(neighbours, sharingRanks, nneighbours));
+    PetscCall(PetscSortRemoveDupsMPIInt(&nneighbours, neighbours));
+  }
+  PetscCall(PetscMalloc1(nneighbours, &faceRanks));
+  if (error_check) PetscCall(DMSwarmGetSize(dm, &npointsg));
+
+  /* find the cell of each point, or where to send it: target is a rank, -1 for all neighbours, or -2 - f to send it to the ranks sharing the face f */
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
+  PetscCall(PetscMalloc5(npoints, &target, npoints, &cell, npoints, &outlier, npoints, &outliercell, npoints, &mask));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&p_cellid));
+  for (p = 0; p < npoints; ++p) {
+    PetscScalar x[3];
+    PetscInt    face = -1;
+
+    for (PetscInt d = 0; d < dim; ++d) x[d] = coor[p * dim + d];
+    cell[p]   = DMLOCATEPOINT_POINT_NOT_FOUND;
+    target[p] = rank;
+    if (p_cellid[p] >= cStart && p_cellid[p] < cEnd) PetscCall(DMSwarmPlexWalk_Private(dmcell, dim, x, p_cellid[p], maxSteps, &cell[p], &face));
+    if (cell[p] >= 0) {
+      if (owner && owner[cell[p] - pStart] >= 0) target[p] = owner[cell[p] - pStart];
+    } else if (face >= 0 && sharing) {
+      const PetscInt *support;
+      PetscInt        ns;
+
+      /* only trust the faces of owned cells, beyond the overlap the sharing ranks may not have the point. The point is
+         still searched locally, since the walk may leave a non-convex partition while the point is in a local cell */
+      PetscCall(DMPlexGetSupport(dmcell, face, &support));
+      PetscCall(DMSwarmPlexGetFaceRanks_Private(dmcell, sharing, sharingRanks, face, &ns, faceRanks));
+      if (ns && owner[support[0] - pStart] < 0) target[p] = -2 - face;
+      outlier[noutlier++] = p;
+    } else outlier[noutlier++] = p;
+  }
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&p_cellid));
+  PetscCall(DMSwarmPlexLocate_Private(dmcell, dim, coor, noutlier, outlier, outliercell));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  for (PetscInt o = 0; o < noutlier; ++o) {
+    p       = outlier[o];
+    cell[p] = outliercell[o];
+    if (cell[p] >= 0) target[p] = owner && owner[cell[p] - pStart] >= 0 ? owner[cell[p] - pStart] : rank;
+    else if (target[p] >= 0) target[p] = -1;
+  }
+  PetscCall(PetscInfo(dm, "%" PetscInt_FMT " of %" PetscInt_FMT " points located from scratch\n", noutlier, npoints));
+
+  /* send the points which left */
+  for (p = 0; p < npoints; ++p) {
+    if (target[p] >= 0) nsend += target[p] != rank ? 1 : 0;
+    else if (target[p] == -1) nsend += nneighbours;
+    else {
+      PetscInt ns;
+
+      PetscCall(DMSwarmPlexGetFaceRanks_Private(dmcell, sharing, sharingRanks, -2 - target[p], &ns, faceRanks));
+      nsend += ns;
+    }
+  }
+  PetscCall(PetscMalloc2(nsend, &sendlist, nsend, &sendrank));
+  nsend = 0;
+  for (p = 0; p < npoints; ++p) {
+    mask[p] = target[p] != rank ? PETSC_TRUE : PETSC_FALSE;
+    if (target[p] >= 0) {
+      if (target[p] != rank) {
+        sendlist[nsend]   = p;
+        sendrank[nsend++] = (PetscMPIInt)target[p];
+      }
+    } else if (target[p] == -1) {
+      for (PetscInt r = 0; r < nneighbours; ++r) {
+        sendlist[nsend]   = p;
+        sendrank[nsend++] = neighbours[r];
+      }
+    } else {
+      PetscInt ns;
+
+      PetscCall(DMSwarmPlexGetFaceRanks_Private(dmcell, sharing, sharingRanks, -2 - target[p], &ns, faceRanks));
+      for (PetscInt r = 0; r < ns; ++r) {
+        sendlist[nsend]   = p;
+        sendrank[nsend++] = faceRanks[r];
+      }
+    }
+  }
+  PetscCall(DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  for (p = 0; p < npoints; ++p) rankval[p] = cell[p] >= 0 && target[p] == rank ? cell[p] : DMLOCATEPOINT_POINT_NOT_FOUND;
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmDataExCreate(PetscObjectComm((PetscObject)dm), 0, &de));
+  PetscCall(DMSwarmDataExTopologyInitialize(de));
+  for (p = 0; p < nsend; ++p) PetscCall(DMSwarmDataExTopologyAddNeighbour(de, sendrank[p]));
+  PetscCall(DMSwarmDataExTopologyFinalize(de));
+  PetscCall(DMSwarmDataExInitializeSendCount(de));
+  for (p = 0; p < nsend; ++p) PetscCall(DMSwarmDataExAddToSendCount(de, sendrank[p], 1));
+  PetscCall(DMSwarmDataExFinalizeSendCount(de));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
+  PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
+  PetscCall(DMSwarmMigrate_PackPointsByRank_Private(swarm->db, de, sizeof_dmswarm_point, nsend, sendrank, sendlist));
+  PetscCall(DMSwarmDataExPackFinalize(de));
+  PetscCall(PetscFree2(sendlist, sendrank));
+  /* points which were not found are always removed on a single rank, as in DMSwarmMigrate_CellDMScatter() */
+  if (remove_sent_points || size == 1) PetscCall(DMSwarmDataBucketRemovePointsWithMask(swarm->db, mask));
+  PetscCall(PetscFree5(target, cell, outlier, outliercell, mask));
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &nprior, NULL, NULL));
+  PetscCall(DMSwarmDataExBegin(de));
+  PetscCall(DMSwarmDataExEnd(de));
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
+  PetscCall(DMSwarmDataExDestroy(de));
+
+  /* locate the received points, and drop the ones which are not in an owned cell: a point sent to several ranks is
+     also received by the ranks having its cell in their overlap, only its owner keeps it */
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &n2, NULL, NULL));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmPlexLocate_Private(dmcell, dim, &coor[nprior * dim], n2 - nprior, NULL, &rankval[nprior]));
+  if (owner)
+    for (p = nprior; p < n2; ++p)
+      if (rankval[p] >= 0 && owner[rankval[p] - pStart] >= 0) rankval[p] = DMLOCATEPOINT_POINT_NOT_FOUND;
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmMigrate_RemoveNotFound_Private(swarm->db, nprior));
+
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &n2, NULL, NULL));
+  PetscCall(DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&p_cellid));
+  for (p = 0; p < n2; p++) p_cellid[p] = rankval[p];
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&p_cellid));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(PetscSectionDestroy(&sharing));
+  PetscCall(PetscFree(sharingRanks));
+  PetscCall(PetscFree(owner));
+  PetscCall(PetscFree(neighbours));
+  PetscCall(PetscFree(faceRanks));
+
+  /* check for error on removed points */
+  if (error_check) {
+    PetscCall(DMSwarmGetSize(dm, &npoints2g));
+    PetscCheck(npointsg == npoints2g, PetscObjectComm((PetscObject)dm), PETSC_ERR_USER, "Points from the DMSwarm must remain constant during migration (initial %" PetscInt_FMT " - final %" PetscInt_FMT ")", npointsg, npoints2g);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMSwarmMigrate_CellDMExact(DM dm, PetscBool remove_sent_points)
 {
   PetscFunctionBegin;
@@ -363,9 +685,8 @@ PetscErrorCode DMSwarmMigrate_GlobalToLocal_Basic(DM dm, PetscInt *globalsize)
 {
   DM_Swarm     *swarm = (DM_Swarm *)dm->data;
   DMSwarmDataEx de;
-  PetscInt      p, npoints, *rankval, n_points_recv;
-  PetscMPIInt   rank, nrank, negrank;
-  void         *point_buffer, *recv_points;
+  PetscInt      p, npoints, *rankval, nsend = 0, *sendlist;
+  PetscMPIInt   rank, nrank, negrank, *sendrank;
   size_t        sizeof_dmswarm_point;
 
   PetscFunctionBegin;
@@ -392,34 +713,28 @@ PetscErrorCode DMSwarmMigrate_GlobalToLocal_Basic(DM dm, PetscInt *globalsize)
     }
   }
   PetscCall(DMSwarmDataExFinalizeSendCount(de));
-  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, &point_buffer));
+  PetscCall(PetscMalloc2(npoints, &sendlist, npoints, &sendrank));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
   PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
   for (p = 0; p < npoints; p++) {
     negrank = rankval[p];
     if (negrank < 0) {
-      nrank      = -negrank - 1;
-      rankval[p] = nrank;
-      /* copy point into buffer */
-      PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, point_buffer));
-      /* insert point buffer into DMSwarmDataExchanger */
-      PetscCall(DMSwarmDataExPackData(de, nrank, 1, point_buffer));
-      rankval[p] = negrank;
+      sendlist[nsend] = p;
+      sendrank[nsend] = -negrank - 1;
+      nsend++;
     }
   }
+  /* the points are sent with their destination rank, not the negated one */
+  for (p = 0; p < nsend; p++) rankval[sendlist[p]] = sendrank[p];
+  PetscCall(DMSwarmMigrate_PackPointsByRank_Private(swarm->db, de, sizeof_dmswarm_point, nsend, sendrank, sendlist));
+  for (p = 0; p < nsend; p++) rankval[sendlist[p]] = -sendrank[p] - 1;
+  PetscCall(PetscFree2(sendlist, sendrank));
   PetscCall(DMSwarmDataExPackFinalize(de));
   PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
   PetscCall(DMSwarmDataExBegin(de));
   PetscCall(DMSwarmDataExEnd(de));
-  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
-  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
-  for (p = 0; p < n_points_recv; p++) {
-    void *data_p = (void *)((char *)recv_points + p * sizeof_dmswarm_point);
-
-    PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, data_p));
-  }
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
   PetscCall(DMSwarmDataExView(de));
-  PetscCall(DMSwarmDataBucketDestroyPackedArray(swarm->db, &point_buffer));
   PetscCall(DMSwarmDataExDestroy(de));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -433,9 +748,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_DMDABoundingBox(DM dm, PetscInt *glob
 {
   DM_Swarm          *swarm = (DM_Swarm *)dm->data;
   DMSwarmDataEx      de;
-  PetscInt           p, pk, npoints, *rankval, n_points_recv, n_bbox_recv, dim, neighbour_cells;
+  PetscInt           p, pk, npoints, *rankval, n_bbox_recv, dim, neighbour_cells, *sendlist;
   PetscMPIInt        rank, nrank;
-  void              *point_buffer, *recv_points;
   size_t             sizeof_dmswarm_point, sizeof_bbox_ctx;
   PetscBool          isdmda;
   CollectBBox       *bbox, *recv_bbox;
@@ -533,39 +847,30 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_DMDABoundingBox(DM dm, PetscInt *glob
     PetscCall(DMSwarmRestoreField(dm, "coorx", NULL, NULL, (void **)&array_x));
   }
   PetscCall(DMSwarmDataExFinalizeSendCount(de));
-  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, &point_buffer));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
   PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
+  PetscCall(PetscMalloc1(npoints, &sendlist));
   for (pk = 0; pk < n_bbox_recv; pk++) {
     PetscReal *array_x, *array_y;
+    PetscInt   nsend = 0;
 
     PetscCall(DMSwarmGetField(dm, "coorx", NULL, NULL, (void **)&array_x));
     PetscCall(DMSwarmGetField(dm, "coory", NULL, NULL, (void **)&array_y));
     for (p = 0; p < npoints; p++) {
       if ((array_x[p] >= recv_bbox[pk].min[0]) && (array_x[p] <= recv_bbox[pk].max[0])) {
-        if ((array_y[p] >= recv_bbox[pk].min[1]) && (array_y[p] <= recv_bbox[pk].max[1])) {
-          /* copy point into buffer */
-          PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, point_buffer));
-          /* insert point buffer into DMSwarmDataExchanger */
-          PetscCall(DMSwarmDataExPackData(de, recv_bbox[pk].owner_rank, 1, point_buffer));
-        }
+        if ((array_y[p] >= recv_bbox[pk].min[1]) && (array_y[p] <= recv_bbox[pk].max[1])) sendlist[nsend++] = p;
       }
     }
     PetscCall(DMSwarmRestoreField(dm, "coory", NULL, NULL, (void **)&array_y));
     PetscCall(DMSwarmRestoreField(dm, "coorx", NULL, NULL, (void **)&array_x));
+    PetscCall(DMSwarmMigrate_PackPoints_Private(swarm->db, de, sizeof_dmswarm_point, 1, &recv_bbox[pk].owner_rank, nsend, sendlist));
   }
+  PetscCall(PetscFree(sendlist));
   PetscCall(DMSwarmDataExPackFinalize(de));
   PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
   PetscCall(DMSwarmDataExBegin(de));
   PetscCall(DMSwarmDataExEnd(de));
-  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
-  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
-  for (p = 0; p < n_points_recv; p++) {
-    void *data_p = (void *)((char *)recv_points + p * sizeof_dmswarm_point);
-
-    PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, data_p));
-  }
-  PetscCall(DMSwarmDataBucketDestroyPackedArray(swarm->db, &point_buffer));
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
   PetscCall(PetscFree(bbox));
   PetscCall(DMSwarmDataExView(de));
   PetscCall(DMSwarmDataExDestroy(de));
@@ -585,9 +890,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_General(DM dm, PetscErrorCode (*colle
 {
   DM_Swarm     *swarm = (DM_Swarm *)dm->data;
   DMSwarmDataEx de;
-  PetscInt      p, r, npoints, n_points_recv;
+  PetscInt      r, npoints;
   PetscMPIInt   size, rank;
-  void         *point_buffer, *recv_points;
   void         *ctxlist;
   PetscInt     *n2collect, **collectlist;
   size_t        sizeof_dmswarm_point;
@@ -630,28 +934,19 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_General(DM dm, PetscErrorCode (*colle
   }
   PetscCall(DMSwarmDataExFinalizeSendCount(de));
   /* Pack data */
-  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, &point_buffer));
+  PetscCall(DMSwarmDataBucketCreatePackedArray(swarm->db, &sizeof_dmswarm_point, NULL));
   PetscCall(DMSwarmDataExPackInitialize(de, sizeof_dmswarm_point));
   for (r = 0; r < size; r++) {
-    for (p = 0; p < n2collect[r]; p++) {
-      PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, collectlist[r][p], point_buffer));
-      /* insert point buffer into the data exchanger */
-      PetscCall(DMSwarmDataExPackData(de, r, 1, point_buffer));
-    }
+    PetscMPIInt _rank = (PetscMPIInt)r;
+
+    PetscCall(DMSwarmMigrate_PackPoints_Private(swarm->db, de, sizeof_dmswarm_point, 1, &_rank, n2collect[r], collectlist[r]));
   }
   PetscCall(DMSwarmDataExPackFinalize(de));
   /* Scatter */
   PetscCall(DMSwarmDataExBegin(de));
   PetscCall(DMSwarmDataExEnd(de));
   /* Collect data in DMSwarm container */
-  PetscCall(DMSwarmDataExGetRecvData(de, &n_points_recv, (void **)&recv_points));
-  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
-  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + n_points_recv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
-  for (p = 0; p < n_points_recv; p++) {
-    void *data_p = (void *)((char *)recv_points + p * sizeof_dmswarm_point);
-
-    PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, data_p));
-  }
+  PetscCall(DMSwarmMigrate_UnpackPoints_Private(swarm->db, de));
   /* Release memory */
   for (r = 0; r < size; r++) {
     if (collectlist[r]) PetscCall(PetscFree(collectlist[r]));
@@ -659,7 +954,6 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_General(DM dm, PetscErrorCode (*colle
   PetscCall(PetscFree(collectlist));
   PetscCall(PetscFree(n2collect));
   PetscCall(PetscFree(ctxlist));
-  PetscCall(DMSwarmDataBucketDestroyPackedArray(swarm->db, &point_buffer));
   PetscCall(DMSwarmDataExView(de));
   PetscCall(DMSwarmDataExDestroy(de));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -698,6 +992,10 @@ PetscErrorCode DMSwarmGetMigrateType(DM dm, DMSwarmMigrateType *mtype)
 + dm    - the DMSwarm
 - mtype - The migration type
 
+  Note:
+  `DMSWARM_MIGRATE_DMPLEXNEIGHBOR` requires a `DMPLEX` cell DM, and assumes that the points move by less than a cell between two migrations.
+  The points are then only searched around their previous cell and only exchanged with the neighbouring ranks.
+
   Level: intermediate
 
 .seealso: `DMSwarmGetMigrateType()`, `DMSwarmMigrateType`, `DMSwarmMigrate()`
@@ -424,6 +424,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmSetPointCoordinatesCellwise(DM dm, PetscInt n
 /* Field projection API */
 extern PetscErrorCode private_DMSwarmProjectFields_DA(DM swarm, DM celldm, PetscInt project_type, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[]);
 extern PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm, DM celldm, PetscInt project_type, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[]);
+extern PetscErrorCode private_DMSwarmInterpolateFields_PLEX(DM swarm, DM celldm, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[]);
 
 /*@C
    DMSwarmProjectFields - Project a set of swarm fields onto the cell DM
@@ -457,7 +458,11 @@ extern PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm, DM celldm, Pet
 
    The only projection methods currently only support the DA (2D) and PLEX (triangles 2D).
 
-.seealso: `DMSwarmSetType()`, `DMSwarmSetCellDM()`, `DMSwarmType`
+   For a PLEX cell DM, all fields are projected in a single pass over the points sorted by cell. The cells are colored so
+   that cells of the same color share no vertex, and the cells of one color add their contributions concurrently when
+   PETSc is configured with OpenMP.
+
+.seealso: `DMSwarmSetType()`, `DMSwarmSetCellDM()`, `DMSwarmType`, `DMSwarmInterpolateFields()`
 @*/
 PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm, PetscInt nfields, const char *fieldnames[], Vec **fields, PetscBool reuse)
 {
@@ -503,6 +508,54 @@ PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm, PetscInt nfields, const
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   DMSwarmInterpolateFields - Interpolate a set of fields of the cell DM to the points of the swarm
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+.  nfields - the number of swarm fields to set
+.  fieldnames - the textual names of the swarm fields to set
+-  fields - an array of global Vec's of the cell DM of length nfields
+
+   Level: beginner
+
+   Notes:
+   This is the transpose of the deposition performed by `DMSwarmProjectFields()`, each point p receives
+$     phi_p = \sum_i N_i(x_p) phi_i
+   from the vertex values phi_i of the cell containing it.
+
+   Only swarm fields registered with data type = PETSC_REAL and block size = 1 can be set.
+
+   Only supported for a PLEX cell DM made of triangles (2D) with one dof per vertex. The points are processed
+   cell by cell, concurrently when PETSc is configured with OpenMP.
+
+.seealso: `DMSwarmProjectFields()`, `DMSwarmSetCellDM()`, `DMSwarmSortGetAccess()`
+@*/
+PETSC_EXTERN PetscErrorCode DMSwarmInterpolateFields(DM dm, PetscInt nfields, const char *fieldnames[], Vec fields[])
+{
+  DM_Swarm         *swarm = (DM_Swarm *)dm->data;
+  DMSwarmDataField *gfield;
+  DM                celldm;
+  PetscBool         isPLEX;
+
+  PetscFunctionBegin;
+  DMSWARMPICVALID(dm);
+  PetscCall(DMSwarmGetCellDM(dm, &celldm));
+  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMPLEX, &isPLEX));
+  PetscCheck(isPLEX, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Only supported for cell DMs of type DMPLEX");
+  PetscCall(PetscMalloc1(nfields, &gfield));
+  for (PetscInt f = 0; f < nfields; f++) {
+    PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db, fieldnames[f], &gfield[f]));
+    PetscCheck(gfield[f]->petsc_type == PETSC_REAL, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Interpolation only valid for fields using a data type = PETSC_REAL");
+    PetscCheck(gfield[f]->bs == 1, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Interpolation only valid for fields with block size = 1");
+  }
+  PetscCall(private_DMSwarmInterpolateFields_PLEX(dm, celldm, nfields, gfield, fields));
+  PetscCall(PetscFree(gfield));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    DMSwarmCreatePointPerCellCount - Count the number of points within all cells in the cell DM
 
@@ -430,195 +430,292 @@ static PetscErrorCode _ComputeLocalCoordinateAffine2d(PetscReal xp[],PetscReal c
 }
 */
 
-static PetscErrorCode ComputeLocalCoordinateAffine2d(PetscReal xp[], PetscScalar coords[], PetscReal xip[], PetscReal *dJ)
+/*
+  Geometry, P1 dofs and coloring of the triangles of the cell DM used by the cell-sorted deposition and interpolation.
+  Cells of the same color share no vertex, so that the cells of one color can add into the local vectors concurrently.
+*/
+typedef struct {
+  PetscInt   ncells, ncolors;
+  PetscInt  *dofs;          /* local index of the dof of each vertex of the cell, negative if constrained */
+  PetscReal *geom;          /* first vertex, inverse Jacobian and |det J| of each cell */
+  PetscInt  *color_offsets; /* the cells of color k are cells[color_offsets[k]] to cells[color_offsets[k + 1] - 1] */
+  PetscInt  *cells;
+} PLEXCellData2D;
+
+static PetscErrorCode PLEXCellData2DCreate(DM dm, PetscBool color, PLEXCellData2D *cd)
 {
-  PetscReal x1, y1, x2, y2, x3, y3;
-  PetscReal b[2], A[2][2], inv[2][2], detJ, od;
+  PetscSection section;
+  PetscInt     cStart, cEnd, nloc, *dofcell_offsets, *dofcells, *cellcolor, *used;
 
   PetscFunctionBegin;
-  x1 = PetscRealPart(coords[2 * 0 + 0]);
-  x2 = PetscRealPart(coords[2 * 1 + 0]);
-  x3 = PetscRealPart(coords[2 * 2 + 0]);
-
-  y1 = PetscRealPart(coords[2 * 0 + 1]);
-  y2 = PetscRealPart(coords[2 * 1 + 1]);
-  y3 = PetscRealPart(coords[2 * 2 + 1]);
+  PetscCall(PetscMemzero(cd, sizeof(*cd)));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCheck(cStart == 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supported for meshes whose cells are numbered from 0");
+  PetscCall(DMGetLocalSection(dm, &section));
+  cd->ncells = cEnd;
+  PetscCall(PetscMalloc2(3 * cEnd, &cd->dofs, 7 * cEnd, &cd->geom));
+  for (PetscInt c = 0; c < cEnd; ++c) {
+    const PetscScalar *array;
+    PetscScalar       *coords;
+    PetscReal         *g = &cd->geom[7 * c], A[2][2], detJ, od;
+    PetscInt           Nc, n, *idx = NULL;
+    PetscBool          isDG;
+
+    PetscCall(DMPlexGetCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+    PetscCheck(Nc == 6, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supported for 2D triangles, cell %" PetscInt_FMT " has %" PetscInt_FMT " coordinates", c, Nc);
+    g[0]    = PetscRealPart(coords[0]);
+    g[1]    = PetscRealPart(coords[1]);
+    A[0][0] = PetscRealPart(coords[2]) - g[0];
+    A[0][1] = PetscRealPart(coords[4]) - g[0];
+    A[1][0] = PetscRealPart(coords[3]) - g[1];
+    A[1][1] = PetscRealPart(coords[5]) - g[1];
+    PetscCall(DMPlexRestoreCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+    detJ = A[0][0] * A[1][1] - A[0][1] * A[1][0];
+    od   = 1.0 / detJ;
+    g[2] = A[1][1] * od;
+    g[3] = -A[0][1] * od;
+    g[4] = -A[1][0] * od;
+    g[5] = A[0][0] * od;
+    g[6] = PetscAbsReal(detJ);
+
+    PetscCall(DMPlexGetClosureIndices(dm, section, section, c, PETSC_TRUE, &n, &idx, NULL, NULL));
+    PetscCheck(n == 3, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supported for a single field with one dof per vertex, cell %" PetscInt_FMT " has %" PetscInt_FMT " dofs", c, n);
+    for (PetscInt k = 0; k < 3; ++k) cd->dofs[3 * c + k] = idx[k];
+    PetscCall(DMPlexRestoreClosureIndices(dm, section, section, c, PETSC_TRUE, &n, &idx, NULL, NULL));
+  }
+  if (!color) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* Greedy coloring of the cells, two cells conflict when they add into the same dof */
+  PetscCall(PetscSectionGetStorageSize(section, &nloc));
+  PetscCall(PetscCalloc2(nloc + 1, &dofcell_offsets, 3 * cEnd, &dofcells));
+  for (PetscInt i = 0; i < 3 * cEnd; ++i)
+    if (cd->dofs[i] >= 0) ++dofcell_offsets[cd->dofs[i] + 1];
+  for (PetscInt d = 0; d < nloc; ++d) dofcell_offsets[d + 1] += dofcell_offsets[d];
+  for (PetscInt i = 0; i < 3 * cEnd; ++i)
+    if (cd->dofs[i] >= 0) dofcells[dofcell_offsets[cd->dofs[i]]++] = i / 3;
+  for (PetscInt d = nloc; d > 0; --d) dofcell_offsets[d] = dofcell_offsets[d - 1];
+  dofcell_offsets[0] = 0;
+  PetscCall(PetscMalloc2(cEnd, &cellcolor, cEnd + 1, &used));
+  for (PetscInt c = 0; c < cEnd; ++c) cellcolor[c] = used[c] = -1;
+  for (PetscInt c = 0; c < cEnd; ++c) {
+    PetscInt k = 0;
+
+    for (PetscInt j = 0; j < 3; ++j) {
+      const PetscInt d = cd->dofs[3 * c + j];
+
+      if (d < 0) continue;
+      for (PetscInt i = dofcell_offsets[d]; i < dofcell_offsets[d + 1]; ++i)
+        if (cellcolor[dofcells[i]] >= 0) used[cellcolor[dofcells[i]]] = c;
+    }
+    while (used[k] == c) ++k;
+    cellcolor[c] = k;
+    cd->ncolors  = PetscMax(cd->ncolors, k + 1);
+  }
+  PetscCall(PetscCalloc2(cd->ncolors + 1, &cd->color_offsets, cEnd, &cd->cells));
+  for (PetscInt c = 0; c < cEnd; ++c) ++cd->color_offsets[cellcolor[c] + 1];
+  for (PetscInt k = 0; k < cd->ncolors; ++k) cd->color_offsets[k + 1] += cd->color_offsets[k];
+  for (PetscInt c = 0; c < cEnd; ++c) cd->cells[cd->color_offsets[cellcolor[c]]++] = c;
+  for (PetscInt k = cd->ncolors; k > 0; --k) cd->color_offsets[k] = cd->color_offsets[k - 1];
+  cd->color_offsets[0] = 0;
+  PetscCall(PetscInfo(dm, "Colored %" PetscInt_FMT " cells with %" PetscInt_FMT " colors for the deposition\n", cEnd, cd->ncolors));
+  PetscCall(PetscFree2(cellcolor, used));
+  PetscCall(PetscFree2(dofcell_offsets, dofcells));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  b[0] = xp[0] - x1;
-  b[1] = xp[1] - y1;
+static PetscErrorCode PLEXCellData2DDestroy(PLEXCellData2D *cd)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(cd->dofs, cd->geom));
+  PetscCall(PetscFree2(cd->color_offsets, cd->cells));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  A[0][0] = x2 - x1;
-  A[0][1] = x3 - x1;
-  A[1][0] = y2 - y1;
-  A[1][1] = y3 - y1;
+/* Barycentric coordinates of the point xp in the cell of geometry g, returns PETSC_FALSE if the point is not in the cell */
+static inline PetscBool PLEXCellData2DBarycentric(const PetscReal g[], const PetscReal xp[], PetscReal Ni[])
+{
+  const PetscReal PLEX_C_EPS = 1.0e-8;
+  const PetscReal b0 = xp[0] - g[0], b1 = xp[1] - g[1];
+
+  Ni[1] = g[2] * b0 + g[3] * b1;
+  Ni[2] = g[4] * b0 + g[5] * b1;
+  Ni[0] = 1.0 - Ni[1] - Ni[2];
+  for (PetscInt k = 0; k < 3; ++k)
+    if (Ni[k] < -PLEX_C_EPS || Ni[k] > 1.0 + PLEX_C_EPS) return PETSC_FALSE;
+  return PETSC_TRUE;
+}
 
-  detJ = A[0][0] * A[1][1] - A[0][1] * A[1][0];
-  *dJ  = PetscAbsReal(detJ);
-  od   = 1.0 / detJ;
+/*
+  Computes the barycentric coordinates of all points, stored in the order of the sort context, and returns the
+  first point which does not lie in its cell, or -1
+*/
+static PetscErrorCode DMSwarmComputeWeights_PLEX_2D(DM swarm, PLEXCellData2D *cd, DMSwarmSort ctx, PetscReal Ni[])
+{
+  PetscReal *coor, xfail[2] = {0.0, 0.0};
+  PetscInt   fail = -1;
 
-  inv[0][0] = A[1][1] * od;
-  inv[0][1] = -A[0][1] * od;
-  inv[1][0] = -A[1][0] * od;
-  inv[1][1] = A[0][0] * od;
+  PetscFunctionBegin;
+  PetscCall(DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscPragmaOMP(parallel for reduction(max : fail))
+  for (PetscInt c = 0; c < cd->ncells; ++c) {
+    for (PetscInt q = ctx->pcell_offsets[c]; q < ctx->pcell_offsets[c + 1]; ++q) {
+      const PetscInt p = ctx->list[q].point_index;
 
-  xip[0] = inv[0][0] * b[0] + inv[0][1] * b[1];
-  xip[1] = inv[1][0] * b[0] + inv[1][1] * b[1];
+      if (!PLEXCellData2DBarycentric(&cd->geom[7 * c], &coor[2 * p], &Ni[3 * q])) fail = PetscMax(fail, p);
+    }
+  }
+  if (fail >= 0) {
+    xfail[0] = coor[2 * fail];
+    xfail[1] = coor[2 * fail + 1];
+  }
+  PetscCall(DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCheck(fail < 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "Failed to locate point %" PetscInt_FMT " (%1.8e,%1.8e) in its cell of the local mesh", fail, (double)xfail[0], (double)xfail[1]);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode DMSwarmProjectField_ApproxP1_PLEX_2D(DM swarm, PetscReal *swarm_field, DM dm, Vec v_field)
+/*
+  Projects all fields at once with
+    phi_i = \sum_p N_i(x_p) phi_p dJ / \sum_p N_i(x_p) dJ
+  The points are visited cell by cell through the sort context. The contributions of the points of a cell are summed
+  into an element vector which is added to the local vector, and the cells of one color are processed by all threads.
+*/
+static PetscErrorCode DMSwarmProjectFields_ApproxP1_PLEX_2D(DM swarm, DM dm, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[])
 {
-  const PetscReal PLEX_C_EPS = 1.0e-8;
-  Vec             v_field_l, denom_l, coor_l, denom;
-  PetscInt        k, p, e, npoints;
-  PetscInt       *mpfield_cell;
-  PetscReal      *mpfield_coor;
-  PetscReal       xi_p[2];
-  PetscScalar     Ni[3];
-  PetscSection    coordSection;
-  PetscScalar    *elcoor = NULL;
+  DM_Swarm      *sw = (DM_Swarm *)swarm->data;
+  PLEXCellData2D cd;
+  DMSwarmSort    ctx;
+  Vec            denom, denom_l, *vecs_l;
+  PetscScalar  **larray, *ldenom;
+  PetscReal    **swarm_field, *Ni;
+  PetscInt       npoints;
+  PetscBool      isvalid;
 
   PetscFunctionBegin;
-  PetscCall(VecZeroEntries(v_field));
+  PetscCall(PLEXCellData2DCreate(dm, PETSC_TRUE, &cd));
+  PetscCall(DMSwarmSortGetIsValid(swarm, &isvalid));
+  if (!isvalid) PetscCall(DMSwarmSortGetAccess(swarm));
+  ctx = sw->sort_context;
+  PetscCall(DMSwarmGetLocalSize(swarm, &npoints));
+  PetscCall(PetscMalloc4(nfields, &vecs_l, nfields, &larray, nfields, &swarm_field, 3 * npoints, &Ni));
+  PetscCall(DMSwarmComputeWeights_PLEX_2D(swarm, &cd, ctx, Ni));
+
+  for (PetscInt f = 0; f < nfields; ++f) {
+    PetscCall(DMGetLocalVector(dm, &vecs_l[f]));
+    PetscCall(VecZeroEntries(vecs_l[f]));
+    PetscCall(VecGetArray(vecs_l[f], &larray[f]));
+    PetscCall(DMSwarmDataFieldGetEntries(dfield[f], (void **)&swarm_field[f]));
+  }
+  PetscCall(DMGetLocalVector(dm, &denom_l));
+  PetscCall(VecZeroEntries(denom_l));
+  PetscCall(VecGetArray(denom_l, &ldenom));
+  for (PetscInt k = 0; k < cd.ncolors; ++k) {
+    PetscPragmaOMP(parallel for)
+    for (PetscInt i = cd.color_offsets[k]; i < cd.color_offsets[k + 1]; ++i) {
+      const PetscInt  c = cd.cells[i], *dofs = &cd.dofs[3 * c], qs = ctx->pcell_offsets[c], qe = ctx->pcell_offsets[c + 1];
+      const PetscReal dJ = cd.geom[7 * c + 6];
+      PetscReal       el[3] = {0.0, 0.0, 0.0};
+
+      for (PetscInt q = qs; q < qe; ++q)
+        for (PetscInt j = 0; j < 3; ++j) el[j] += Ni[3 * q + j];
+      for (PetscInt j = 0; j < 3; ++j)
+        if (dofs[j] >= 0) ldenom[dofs[j]] += el[j] * dJ;
+      for (PetscInt f = 0; f < nfields; ++f) {
+        el[0] = el[1] = el[2] = 0.0;
+        for (PetscInt q = qs; q < qe; ++q) {
+          const PetscReal phi = swarm_field[f][ctx->list[q].point_index];
+
+          for (PetscInt j = 0; j < 3; ++j) el[j] += Ni[3 * q + j] * phi;
+        }
+        for (PetscInt j = 0; j < 3; ++j)
+          if (dofs[j] >= 0) larray[f][dofs[j]] += el[j] * dJ;
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(denom_l, &ldenom));
+  if (!isvalid) PetscCall(DMSwarmSortRestoreAccess(swarm));
 
-  PetscCall(DMGetLocalVector(dm, &v_field_l));
   PetscCall(DMGetGlobalVector(dm, &denom));
-  PetscCall(DMGetLocalVector(dm, &denom_l));
-  PetscCall(VecZeroEntries(v_field_l));
   PetscCall(VecZeroEntries(denom));
-  PetscCall(VecZeroEntries(denom_l));
+  PetscCall(DMLocalToGlobalBegin(dm, denom_l, ADD_VALUES, denom));
+  PetscCall(DMLocalToGlobalEnd(dm, denom_l, ADD_VALUES, denom));
+  for (PetscInt f = 0; f < nfields; ++f) {
+    PetscCall(VecRestoreArray(vecs_l[f], &larray[f]));
+    PetscCall(VecZeroEntries(vecs[f]));
+    PetscCall(DMLocalToGlobalBegin(dm, vecs_l[f], ADD_VALUES, vecs[f]));
+    PetscCall(DMLocalToGlobalEnd(dm, vecs_l[f], ADD_VALUES, vecs[f]));
+    PetscCall(VecPointwiseDivide(vecs[f], vecs[f], denom));
+    PetscCall(DMRestoreLocalVector(dm, &vecs_l[f]));
+  }
+  PetscCall(DMRestoreGlobalVector(dm, &denom));
+  PetscCall(DMRestoreLocalVector(dm, &denom_l));
+  PetscCall(PetscFree4(vecs_l, larray, swarm_field, Ni));
+  PetscCall(PLEXCellData2DDestroy(&cd));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  PetscCall(DMGetCoordinatesLocal(dm, &coor_l));
-  PetscCall(DMGetCoordinateSection(dm, &coordSection));
+/* Evaluates the P1 fields at the points, each point only reads the dofs of its cell so that all cells are processed concurrently */
+static PetscErrorCode DMSwarmInterpolateFields_ApproxP1_PLEX_2D(DM swarm, DM dm, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[])
+{
+  DM_Swarm            *sw = (DM_Swarm *)swarm->data;
+  PLEXCellData2D       cd;
+  DMSwarmSort          ctx;
+  Vec                 *vecs_l;
+  const PetscScalar  **larray;
+  PetscReal          **swarm_field, *Ni;
+  PetscInt             npoints;
+  PetscBool            isvalid;
 
+  PetscFunctionBegin;
+  PetscCall(PLEXCellData2DCreate(dm, PETSC_FALSE, &cd));
+  PetscCall(DMSwarmSortGetIsValid(swarm, &isvalid));
+  if (!isvalid) PetscCall(DMSwarmSortGetAccess(swarm));
+  ctx = sw->sort_context;
   PetscCall(DMSwarmGetLocalSize(swarm, &npoints));
-  PetscCall(DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&mpfield_coor));
-  PetscCall(DMSwarmGetField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void **)&mpfield_cell));
-
-  for (p = 0; p < npoints; p++) {
-    PetscReal  *coor_p, dJ;
-    PetscScalar elfield[3];
-    PetscBool   point_located;
-
-    e      = mpfield_cell[p];
-    coor_p = &mpfield_coor[2 * p];
-
-    PetscCall(DMPlexVecGetClosure(dm, coordSection, coor_l, e, NULL, &elcoor));
-
-    /*
-    while (!point_located && (failed_counter < 25)) {
-      PetscCall(PointInTriangle(point, coords[0], coords[1], coords[2], &point_located));
-      point.x = coor_p[0];
-      point.y = coor_p[1];
-      point.x += 1.0e-10 * (2.0 * rand()/((double)RAND_MAX)-1.0);
-      point.y += 1.0e-10 * (2.0 * rand()/((double)RAND_MAX)-1.0);
-      failed_counter++;
-    }
-
-    if (!point_located) {
-        PetscPrintf(PETSC_COMM_SELF,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ") with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e) in %" PetscInt_FMT " iterations\n",point.x,point.y,e,coords[0].x,coords[0].y,coords[1].x,coords[1].y,coords[2].x,coords[2].y,failed_counter);
-    }
-
-    PetscCheck(point_located,PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ")",point.x,point.y,e);
-    else {
-      PetscCall(_ComputeLocalCoordinateAffine2d(coor_p,elcoor,xi_p,&dJ));
-      xi_p[0] = 0.5*(xi_p[0] + 1.0);
-      xi_p[1] = 0.5*(xi_p[1] + 1.0);
+  PetscCall(PetscMalloc4(nfields, &vecs_l, nfields, &larray, nfields, &swarm_field, 3 * npoints, &Ni));
+  PetscCall(DMSwarmComputeWeights_PLEX_2D(swarm, &cd, ctx, Ni));
+
+  for (PetscInt f = 0; f < nfields; ++f) {
+    PetscCall(DMGetLocalVector(dm, &vecs_l[f]));
+    PetscCall(DMGlobalToLocalBegin(dm, vecs[f], INSERT_VALUES, vecs_l[f]));
+    PetscCall(DMGlobalToLocalEnd(dm, vecs[f], INSERT_VALUES, vecs_l[f]));
+    PetscCall(VecGetArrayRead(vecs_l[f], &larray[f]));
+    PetscCall(DMSwarmDataFieldGetEntries(dfield[f], (void **)&swarm_field[f]));
+  }
+  PetscPragmaOMP(parallel for)
+  for (PetscInt c = 0; c < cd.ncells; ++c) {
+    PetscInt dofs[3];
 
-      PetscPrintf(PETSC_COMM_SELF,"[p=%" PetscInt_FMT "] x(%+1.4e,%+1.4e) -> mapped to element %" PetscInt_FMT " xi(%+1.4e,%+1.4e)\n",p,point.x,point.y,e,xi_p[0],xi_p[1]);
+    for (PetscInt j = 0; j < 3; ++j) dofs[j] = cd.dofs[3 * c + j] < 0 ? -(cd.dofs[3 * c + j] + 1) : cd.dofs[3 * c + j];
+    for (PetscInt q = ctx->pcell_offsets[c]; q < ctx->pcell_offsets[c + 1]; ++q) {
+      const PetscInt p = ctx->list[q].point_index;
 
-    }
-*/
+      for (PetscInt f = 0; f < nfields; ++f) {
+        PetscReal val = 0.0;
 
-    PetscCall(ComputeLocalCoordinateAffine2d(coor_p, elcoor, xi_p, &dJ));
-    /*
-    PetscPrintf(PETSC_COMM_SELF,"[p=%" PetscInt_FMT "] x(%+1.4e,%+1.4e) -> mapped to element %" PetscInt_FMT " xi(%+1.4e,%+1.4e)\n",p,point.x,point.y,e,xi_p[0],xi_p[1]);
-    */
-    /*
-     point_located = PETSC_TRUE;
-    if (xi_p[0] < 0.0) {
-      if (xi_p[0] > -PLEX_C_EPS) {
-        xi_p[0] = 0.0;
-      } else {
-        point_located = PETSC_FALSE;
+        for (PetscInt j = 0; j < 3; ++j) val += Ni[3 * q + j] * PetscRealPart(larray[f][dofs[j]]);
+        swarm_field[f][p] = val;
       }
     }
-    if (xi_p[1] < 0.0) {
-      if (xi_p[1] > -PLEX_C_EPS) {
-        xi_p[1] = 0.0;
-      } else {
-        point_located = PETSC_FALSE;
-      }
-    }
-    if (xi_p[1] > (1.0-xi_p[0])) {
-      if ((xi_p[1] - 1.0 + xi_p[0]) < PLEX_C_EPS) {
-        xi_p[1] = 1.0 - xi_p[0];
-      } else {
-        point_located = PETSC_FALSE;
-      }
-    }
-    if (!point_located) {
-      PetscPrintf(PETSC_COMM_SELF,"[Error] xi,eta = %+1.8e, %+1.8e\n",xi_p[0],xi_p[1]);
-      PetscPrintf(PETSC_COMM_SELF,"[Error] Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ") with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e)\n",coor_p[0],coor_p[1],e,elcoor[0],elcoor[1],elcoor[2],elcoor[3],elcoor[4],elcoor[5]);
-    }
-    PetscCheck(point_located,PETSC_COMM_SELF,PETSC_ERR_SUP,"Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ")",coor_p[0],coor_p[1],e);
-    */
-
-    Ni[0] = 1.0 - xi_p[0] - xi_p[1];
-    Ni[1] = xi_p[0];
-    Ni[2] = xi_p[1];
-
-    point_located = PETSC_TRUE;
-    for (k = 0; k < 3; k++) {
-      if (PetscRealPart(Ni[k]) < -PLEX_C_EPS) point_located = PETSC_FALSE;
-      if (PetscRealPart(Ni[k]) > (1.0 + PLEX_C_EPS)) point_located = PETSC_FALSE;
-    }
-    if (!point_located) {
-      PetscCall(PetscPrintf(PETSC_COMM_SELF, "[Error] xi,eta = %+1.8e, %+1.8e\n", (double)xi_p[0], (double)xi_p[1]));
-      PetscCall(PetscPrintf(PETSC_COMM_SELF, "[Error] Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ") with triangle coords (%1.8e,%1.8e) : (%1.8e,%1.8e) : (%1.8e,%1.8e)\n", (double)coor_p[0], (double)coor_p[1], e, (double)PetscRealPart(elcoor[0]), (double)PetscRealPart(elcoor[1]), (double)PetscRealPart(elcoor[2]), (double)PetscRealPart(elcoor[3]), (double)PetscRealPart(elcoor[4]), (double)PetscRealPart(elcoor[5])));
-    }
-    PetscCheck(point_located, PETSC_COMM_SELF, PETSC_ERR_SUP, "Failed to locate point (%1.8e,%1.8e) in local mesh (cell %" PetscInt_FMT ")", (double)coor_p[0], (double)coor_p[1], e);
-
-    for (k = 0; k < 3; k++) {
-      Ni[k]      = Ni[k] * dJ;
-      elfield[k] = Ni[k] * swarm_field[p];
-    }
-    PetscCall(DMPlexVecRestoreClosure(dm, coordSection, coor_l, e, NULL, &elcoor));
-
-    PetscCall(DMPlexVecSetClosure(dm, NULL, v_field_l, e, elfield, ADD_VALUES));
-    PetscCall(DMPlexVecSetClosure(dm, NULL, denom_l, e, Ni, ADD_VALUES));
   }
-
-  PetscCall(DMSwarmRestoreField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void **)&mpfield_cell));
-  PetscCall(DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&mpfield_coor));
-
-  PetscCall(DMLocalToGlobalBegin(dm, v_field_l, ADD_VALUES, v_field));
-  PetscCall(DMLocalToGlobalEnd(dm, v_field_l, ADD_VALUES, v_field));
-  PetscCall(DMLocalToGlobalBegin(dm, denom_l, ADD_VALUES, denom));
-  PetscCall(DMLocalToGlobalEnd(dm, denom_l, ADD_VALUES, denom));
-
-  PetscCall(VecPointwiseDivide(v_field, v_field, denom));
-
-  PetscCall(DMRestoreLocalVector(dm, &v_field_l));
-  PetscCall(DMRestoreLocalVector(dm, &denom_l));
-  PetscCall(DMRestoreGlobalVector(dm, &denom));
+  for (PetscInt f = 0; f < nfields; ++f) {
+    PetscCall(VecRestoreArrayRead(vecs_l[f], &larray[f]));
+    PetscCall(DMRestoreLocalVector(dm, &vecs_l[f]));
+  }
+  if (!isvalid) PetscCall(DMSwarmSortRestoreAccess(swarm));
+  PetscCall(PetscFree4(vecs_l, larray, swarm_field, Ni));
+  PetscCall(PLEXCellData2DDestroy(&cd));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm, DM celldm, PetscInt project_type, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[])
 {
-  PetscInt f, dim;
+  PetscInt dim;
 
   PetscFunctionBegin;
   PetscCall(DMGetDimension(swarm, &dim));
   switch (dim) {
   case 2:
-    for (f = 0; f < nfields; f++) {
-      PetscReal *swarm_field;
-
-      PetscCall(DMSwarmDataFieldGetEntries(dfield[f], (void **)&swarm_field));
-      PetscCall(DMSwarmProjectField_ApproxP1_PLEX_2D(swarm, swarm_field, celldm, vecs[f]));
-    }
+    PetscCall(DMSwarmProjectFields_ApproxP1_PLEX_2D(swarm, celldm, nfields, dfield, vecs));
     break;
   case 3:
     SETERRQ(PetscObjectComm((PetscObject)swarm), PETSC_ERR_SUP, "No support for 3D");
@@ -628,6 +725,17 @@ PetscErrorCode private_DMSwarmProjectFields_PLEX(DM swarm, DM celldm, PetscInt p
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode private_DMSwarmInterpolateFields_PLEX(DM swarm, DM celldm, PetscInt nfields, DMSwarmDataField dfield[], Vec vecs[])
+{
+  PetscInt dim;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetDimension(swarm, &dim));
+  PetscCheck(dim == 2, PetscObjectComm((PetscObject)swarm), PETSC_ERR_SUP, "Only supported in 2D");
+  PetscCall(DMSwarmInterpolateFields_ApproxP1_PLEX_2D(swarm, celldm, nfields, dfield, vecs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode private_DMSwarmSetPointCoordinatesCellwise_PLEX(DM dm, DM dmc, PetscInt npoints, PetscReal xi[])
 {
   PetscBool       is_simplex, is_tensorcell;
@@ -3,27 +3,7 @@
 #include <petscdmplex.h>
 #include <petscdmswarm.h>
 #include <petsc/private/dmswarmimpl.h>
-
-int sort_CompareSwarmPoint(const void *dataA, const void *dataB)
-{
-  SwarmPoint *pointA = (SwarmPoint *)dataA;
-  SwarmPoint *pointB = (SwarmPoint *)dataB;
-
-  if (pointA->cell_index < pointB->cell_index) {
-    return -1;
-  } else if (pointA->cell_index > pointB->cell_index) {
-    return 1;
-  } else {
-    return 0;
-  }
-}
-
-PetscErrorCode DMSwarmSortApplyCellIndexSort(DMSwarmSort ctx)
-{
-  PetscFunctionBegin;
-  qsort(ctx->list, ctx->npoints, sizeof(SwarmPoint), sort_CompareSwarmPoint);
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
+#include "../src/dm/impls/swarm/data_bucket.h"
 
 PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
 {
@@ -43,8 +23,8 @@ PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
 PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx, DM dm, PetscInt ncells)
 {
   PetscInt *swarm_cellid;
-  PetscInt  p, npoints;
-  PetscInt  tmp, c, count;
+  PetscInt  p, npoints, pbad = -1, cbad = -1;
+  PetscInt  c, count;
 
   PetscFunctionBegin;
   if (!ctx) PetscFunctionReturn(PETSC_SUCCESS);
@@ -64,27 +44,29 @@ PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx, DM dm, PetscInt ncells)
     PetscCall(PetscRealloc(sizeof(SwarmPoint) * npoints, &ctx->list));
     ctx->npoints = npoints;
   }
-  PetscCall(PetscArrayzero(ctx->list, npoints));
 
+  /* counting sort by cell, stable so that points in a cell stay in storage order */
   PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
   for (p = 0; p < ctx->npoints; p++) {
-    ctx->list[p].point_index = p;
-    ctx->list[p].cell_index  = swarm_cellid[p];
+    if (swarm_cellid[p] < 0 || swarm_cellid[p] >= ctx->ncells) {
+      pbad = p;
+      cbad = swarm_cellid[p];
+      break;
+    }
+    ctx->pcell_offsets[swarm_cellid[p] + 1]++;
   }
-  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
-  PetscCall(DMSwarmSortApplyCellIndexSort(ctx));
-
-  /* sum points per cell */
-  for (p = 0; p < ctx->npoints; p++) ctx->pcell_offsets[ctx->list[p].cell_index]++;
-
-  /* create offset list */
-  count = 0;
-  for (c = 0; c < ctx->ncells; c++) {
-    tmp                   = ctx->pcell_offsets[c];
-    ctx->pcell_offsets[c] = count;
-    count                 = count + tmp;
+  if (pbad >= 0) PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+  PetscCheck(pbad < 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Point %" PetscInt_FMT " has cell index %" PetscInt_FMT " not in [0, %" PetscInt_FMT ")", pbad, cbad, ctx->ncells);
+  for (c = 0; c < ctx->ncells; c++) ctx->pcell_offsets[c + 1] += ctx->pcell_offsets[c];
+  for (p = 0; p < ctx->npoints; p++) {
+    count                        = ctx->pcell_offsets[swarm_cellid[p]]++;
+    ctx->list[count].point_index = p;
+    ctx->list[count].cell_index  = swarm_cellid[p];
   }
-  ctx->pcell_offsets[c] = count;
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+  /* the fill shifted each offset to the start of the next cell */
+  for (c = ctx->ncells; c > 0; c--) ctx->pcell_offsets[c] = ctx->pcell_offsets[c - 1];
+  ctx->pcell_offsets[0] = 0;
 
   ctx->isvalid = PETSC_TRUE;
   PetscCall(PetscLogEventEnd(DMSWARM_Sort, 0, 0, 0, 0));
@@ -194,7 +176,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm, PetscInt e, Petsc
 
    Calling DMSwarmSortGetAccess() creates a list which enables easy identification of all points contained in a
    given cell. This method does not explicitly sort the data within the DMSwarm based on the cell index associated
-   with a DMSwarm point.
+   with a DMSwarm point, use DMSwarmSortPoints() for that.
 
    The sort context is valid only for the DMSwarm points defined at the time when DMSwarmSortGetAccess() was called.
    For example, suppose the swarm contained NP points when DMSwarmSortGetAccess() was called. If the user subsequently
@@ -221,7 +203,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm, PetscInt e, Petsc
 
    Level: advanced
 
-.seealso: `DMSwarmSetType()`, `DMSwarmSortRestoreAccess()`
+.seealso: `DMSwarmSetType()`, `DMSwarmSortRestoreAccess()`, `DMSwarmSortPoints()`
 @*/
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetAccess(DM dm)
 {
@@ -350,3 +332,49 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM dm, PetscInt *ncells, PetscIn
   if (npoints) *npoints = swarm->sort_context->npoints;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@C
+   DMSwarmSortPoints - Reorders the points of a DMSwarm in memory so that the points within a cell are contiguous
+
+   Not collective
+
+   Input parameter:
+.  dm - a DMSwarm object
+
+   Level: advanced
+
+   Notes:
+   All the fields of the swarm are permuted, in increasing order of the cell index and keeping the current order of
+   the points within a cell. Afterwards the points of cell e are those between the offsets of cells e and e+1 of the
+   sort context, so that DMSwarmSortGetPointsPerCell() returns consecutive indices and loops over the points of a
+   cell access the fields with unit stride.
+
+   If the sort context is valid when DMSwarmSortPoints() is called, it is updated for the new order and stays valid;
+   otherwise it is left invalid. No field may be accessed with DMSwarmGetField() during the call. Indices of points
+   saved before the call refer to other points afterwards.
+
+.seealso: `DMSwarmSortGetAccess()`, `DMSwarmSortGetPointsPerCell()`, `DMSwarmGetField()`
+@*/
+PETSC_EXTERN PetscErrorCode DMSwarmSortPoints(DM dm)
+{
+  DM_Swarm   *swarm = (DM_Swarm *)dm->data;
+  DMSwarmSort ctx;
+  PetscBool   isvalid;
+  PetscInt   *perm, npoints;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmSortGetIsValid(dm, &isvalid));
+  if (!isvalid) PetscCall(DMSwarmSortGetAccess(dm));
+  ctx = swarm->sort_context;
+  PetscCall(DMSwarmGetLocalSize(dm, &npoints));
+  PetscCheck(ctx->npoints == npoints, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "The sort context has %" PetscInt_FMT " points but the swarm has %" PetscInt_FMT ", call DMSwarmSortRestoreAccess() first", ctx->npoints, npoints);
+  PetscCall(PetscLogEventBegin(DMSWARM_Sort, 0, 0, 0, 0));
+  PetscCall(PetscMalloc1(npoints, &perm));
+  for (PetscInt p = 0; p < npoints; ++p) perm[p] = ctx->list[p].point_index;
+  PetscCall(DMSwarmDataBucketPermute(swarm->db, perm));
+  for (PetscInt p = 0; p < npoints; ++p) ctx->list[p].point_index = p;
+  PetscCall(PetscFree(perm));
+  PetscCall(PetscLogEventEnd(DMSWARM_Sort, 0, 0, 0, 0));
+  if (!isvalid) PetscCall(DMSwarmSortRestoreAccess(dm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
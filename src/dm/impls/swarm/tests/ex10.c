@@ -0,0 +1,114 @@
+static char help[] = "Tests DMSwarmSortPoints() on a swarm located in a DMPlex mesh\n\n";
+
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+
+int main(int argc, char **argv)
+{
+  DM           dm, sw;
+  PetscRandom  rnd;
+  PetscReal   *coords, *w;
+  PetscInt    *cellid, *id, *pidx, dim, Np = 100, Npc, npoints, cStart, cEnd, cnt[5] = {0, 0, 0, 0, 0};
+  PetscMPIInt  rank, size;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-num_particles", &Np, NULL));
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
+  PetscCall(DMSetType(dm, DMPLEX));
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCall(DMGetCoordinatesLocalSetUp(dm));
+
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &sw));
+  PetscCall(DMSetType(sw, DMSWARM));
+  PetscCall(DMSetDimension(sw, dim));
+  PetscCall(DMSwarmSetType(sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(sw, dm));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "id", 1, PETSC_INT));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "w", 2, PETSC_REAL));
+  PetscCall(DMSwarmFinalizeFieldRegister(sw));
+  PetscCall(DMSwarmSetLocalSizes(sw, Np, 0));
+
+  /* Points scattered over the local cells in random order, tagged with a global id and values derived from it */
+  PetscCall(PetscRandomCreate(PETSC_COMM_SELF, &rnd));
+  PetscCall(PetscRandomSetInterval(rnd, -0.05, 0.05));
+  PetscCall(PetscRandomSetSeed(rnd, 17 + rank));
+  PetscCall(PetscRandomSeed(rnd));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmGetField(sw, "w", NULL, NULL, (void **)&w));
+  for (PetscInt p = 0; p < Np; ++p) {
+    PetscReal centroid[3], r;
+
+    PetscCall(PetscRandomGetValueReal(rnd, &r));
+    PetscCall(DMPlexComputeCellGeometryFVM(dm, cStart + (PetscInt)((r + 0.05) * 10 * (cEnd - cStart)) % (cEnd - cStart), NULL, centroid, NULL));
+    for (PetscInt d = 0; d < dim; ++d) {
+      PetscCall(PetscRandomGetValueReal(rnd, &r));
+      coords[p * dim + d] = centroid[d] + r;
+    }
+    id[p]        = rank * Np + p;
+    w[p * 2]     = id[p];
+    w[p * 2 + 1] = coords[p * dim];
+  }
+  PetscCall(DMSwarmRestoreField(sw, "w", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+
+  PetscCall(DMSwarmSortGetAccess(sw));
+  PetscCall(DMSwarmSortPoints(sw));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmGetField(sw, "w", NULL, NULL, (void **)&w));
+  for (PetscInt p = 0; p < npoints; ++p) {
+    if (p && cellid[p] < cellid[p - 1]) ++cnt[0];
+    if (w[p * 2] != (PetscReal)id[p] || w[p * 2 + 1] != coords[p * dim]) ++cnt[1];
+    cnt[3] += id[p];
+  }
+  for (PetscInt c = cStart, start = 0; c < cEnd; ++c) {
+    PetscCall(DMSwarmSortGetPointsPerCell(sw, c, &Npc, &pidx));
+    for (PetscInt q = 0; q < Npc; ++q)
+      if (pidx[q] != start + q || cellid[pidx[q]] != c) ++cnt[2];
+    start += Npc;
+    PetscCall(PetscFree(pidx));
+  }
+  cnt[4] = npoints;
+  PetscCall(DMSwarmRestoreField(sw, "w", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(DMSwarmSortRestoreAccess(sw));
+
+  /* The counts are only printed when a check fails, so that the output does not depend on the number of processes */
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, cnt, 5, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  if (!cnt[0]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Points ordered by cell: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Points ordered by cell: no, %" PetscInt_FMT " points with a smaller cell than their predecessor\n", cnt[0]));
+  if (!cnt[1]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Fields permuted together: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Fields permuted together: no, %" PetscInt_FMT " points with wrong fields\n", cnt[1]));
+  if (!cnt[2]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Cells have contiguous points: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Cells have contiguous points: no, %" PetscInt_FMT " points out of the range of their cell\n", cnt[2]));
+  if (cnt[4] == size * Np && cnt[3] == size * Np * (size * Np - 1) / 2) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "All points kept: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "All points kept: no, %" PetscInt_FMT " points lost, error in the sum of the ids %" PetscInt_FMT "\n", size * Np - cnt[4], size * Np * (size * Np - 1) / 2 - cnt[3]));
+
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: {{1 3}}
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 4,4 -petscpartitioner_type simple
+    output_file: output/ex10_0.out
+
+TEST*/
@@ -0,0 +1,147 @@
+static char help[] = "Tests the bulk point removal of DMSwarm and its use in the basic migration\n\n";
+
+#include <petscdmswarm.h>
+
+/* Counts over all processes the points out of id order and the points whose fields are inconsistent with their id or which should not be here, and
+   the number and sum of ids */
+static PetscErrorCode CheckPoints(DM sw, PetscBool (*keep)(PetscInt, PetscMPIInt, PetscMPIInt), PetscInt cnt[])
+{
+  PetscInt   *id, npoints;
+  PetscReal  *w;
+  PetscMPIInt rank, size;
+
+  PetscFunctionBeginUser;
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmGetField(sw, "w", NULL, NULL, (void **)&w));
+  cnt[0] = 0;
+  cnt[1] = 0;
+  cnt[2] = npoints;
+  cnt[3] = 0;
+  for (PetscInt p = 0; p < npoints; ++p) {
+    if (p && id[p] <= id[p - 1]) ++cnt[0];
+    if (!keep(id[p], rank, size) || w[p * 3] != (PetscReal)id[p] || w[p * 3 + 1] != (PetscReal)(2 * id[p]) || w[p * 3 + 2] != (PetscReal)(-id[p])) ++cnt[1];
+    cnt[3] += id[p];
+  }
+  PetscCall(DMSwarmRestoreField(sw, "w", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, cnt, 4, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscBool KeepAll(PetscInt id, PetscMPIInt rank, PetscMPIInt size)
+{
+  return PETSC_TRUE;
+}
+
+static PetscBool KeepNotMultipleOf3(PetscInt id, PetscMPIInt rank, PetscMPIInt size)
+{
+  return (id % 3) ? PETSC_TRUE : PETSC_FALSE;
+}
+
+static PetscBool KeepOwned(PetscInt id, PetscMPIInt rank, PetscMPIInt size)
+{
+  return (id % 3 && id % size == rank) ? PETSC_TRUE : PETSC_FALSE;
+}
+
+int main(int argc, char **argv)
+{
+  DM          sw;
+  PetscInt   *id, *rankval, Np = 30, npoints, cnt[4], ntotal, idsum;
+  PetscReal  *w;
+  PetscBool  *mask;
+  PetscMPIInt rank, size;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-num_particles", &Np, NULL));
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &sw));
+  PetscCall(DMSetType(sw, DMSWARM));
+  PetscCall(DMSetDimension(sw, 1));
+  PetscCall(DMSwarmSetType(sw, DMSWARM_BASIC));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "id", 1, PETSC_INT));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "w", 3, PETSC_REAL));
+  PetscCall(DMSwarmFinalizeFieldRegister(sw));
+  PetscCall(DMSwarmSetLocalSizes(sw, Np, 4));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmGetField(sw, "w", NULL, NULL, (void **)&w));
+  for (PetscInt p = 0; p < Np; ++p) {
+    id[p]        = rank * Np + p;
+    w[p * 3]     = id[p];
+    w[p * 3 + 1] = 2 * id[p];
+    w[p * 3 + 2] = -id[p];
+  }
+  PetscCall(DMSwarmRestoreField(sw, "w", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  ntotal = size * Np;
+  idsum  = ntotal * (ntotal - 1) / 2;
+
+  /* Remove the points whose id is a multiple of 3, given as an unsorted list with duplicates */
+  {
+    PetscInt idx[64], n = 0;
+
+    PetscCheck(Np <= 60, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Too many particles for this test");
+    for (PetscInt p = Np - 1; p >= 0; --p)
+      if (!((rank * Np + p) % 3)) idx[n++] = p;
+    if (n) idx[n++] = idx[0];
+    PetscCall(DMSwarmRemovePoints(sw, n, idx));
+  }
+  /* Add back the removed ids, so that the counts do not depend on the number of processes, they are only printed when a check fails */
+  PetscCall(CheckPoints(sw, KeepNotMultipleOf3, cnt));
+  for (PetscInt i = 0; i < ntotal; i += 3) {
+    cnt[2]++;
+    cnt[3] += i;
+  }
+  if (!cnt[0]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePoints() keeps order: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePoints() keeps order: no, %" PetscInt_FMT " points out of order\n", cnt[0]));
+  if (!cnt[1] && cnt[2] == ntotal && cnt[3] == idsum) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePoints() removes the listed points: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePoints() removes the listed points: no, %" PetscInt_FMT " points with wrong fields, %" PetscInt_FMT " points and %" PetscInt_FMT " in the sum of ids missing\n", cnt[1], ntotal - cnt[2], idsum - cnt[3]));
+
+  /* Remove nothing with a mask, then send each point to the rank id % size and remove the sent ones */
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(PetscCalloc1(npoints, &mask));
+  PetscCall(DMSwarmRemovePointsWithMask(sw, mask));
+  PetscCall(PetscFree(mask));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmGetField(sw, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  for (PetscInt p = 0; p < npoints; ++p) rankval[p] = id[p] % size;
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+  PetscCall(CheckPoints(sw, KeepOwned, cnt));
+  for (PetscInt i = 0; i < ntotal; i += 3) {
+    cnt[2]++;
+    cnt[3] += i;
+  }
+  if (!cnt[1]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmMigrate() sends the points to their rank: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmMigrate() sends the points to their rank: no, %" PetscInt_FMT " points on the wrong rank or with wrong fields\n", cnt[1]));
+  if (cnt[2] == ntotal && cnt[3] == idsum) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmMigrate() keeps all points: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmMigrate() keeps all points: no, %" PetscInt_FMT " points and %" PetscInt_FMT " in the sum of ids missing\n", ntotal - cnt[2], idsum - cnt[3]));
+
+  /* Remove everything */
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(PetscMalloc1(npoints, &mask));
+  for (PetscInt p = 0; p < npoints; ++p) mask[p] = PETSC_TRUE;
+  PetscCall(DMSwarmRemovePointsWithMask(sw, mask));
+  PetscCall(PetscFree(mask));
+  PetscCall(CheckPoints(sw, KeepAll, cnt));
+  if (!cnt[2]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePointsWithMask() removes all points: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "DMSwarmRemovePointsWithMask() removes all points: no, %" PetscInt_FMT " points left\n", cnt[2]));
+
+  PetscCall(DMDestroy(&sw));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: {{1 3}}
+    output_file: output/ex11_0.out
+
+TEST*/
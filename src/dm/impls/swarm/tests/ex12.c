@@ -0,0 +1,177 @@
+static char help[] = "Tests the migration of a DMSwarm whose points move by less than a cell on a DMPlex mesh\n\n";
+
+#include <petscsf.h>
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+
+/* Accumulates the number of points not lying in the cell recorded for them, and the maximum number of ids in [0, n) lost or held by several points */
+static PetscErrorCode CheckPoints(DM sw, DM dm, PetscInt n, PetscInt *nbad, PetscInt nmax[])
+{
+  Vec                pos;
+  PetscSF            sfcell = NULL;
+  const PetscSFNode *cells;
+  PetscInt          *cellid, *id, *count, npoints, nlost = 0, ndup = 0;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmCreateLocalVectorFromField(sw, DMSwarmPICField_coor, &pos));
+  PetscCall(DMLocatePoints(dm, pos, DM_POINTLOCATION_NONE, &sfcell));
+  PetscCall(DMSwarmDestroyLocalVectorFromField(sw, DMSwarmPICField_coor, &pos));
+  PetscCall(PetscSFGetGraph(sfcell, NULL, NULL, NULL, &cells));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(PetscCalloc1(n, &count));
+  for (PetscInt p = 0; p < npoints; ++p) {
+    if (cells[p].index != cellid[p]) ++*nbad;
+    ++count[id[p]];
+  }
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(PetscSFDestroy(&sfcell));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, count, n, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  for (PetscInt i = 0; i < n; ++i) {
+    if (!count[i]) ++nlost;
+    if (count[i] > 1) ndup += count[i] - 1;
+  }
+  PetscCall(PetscFree(count));
+  nmax[0] = PetscMax(nmax[0], nlost);
+  nmax[1] = PetscMax(nmax[1], ndup);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM                 dm, sw;
+  DMSwarmMigrateType mtype = DMSWARM_MIGRATE_DMCELLNSCATTER;
+  PetscReal         *coords, theta = 0.05;
+  PetscInt          *cellid, *id, dim, cStart, cEnd, npoints = 0, offset = 0, ntotal, nsteps = 10, nbad = 0, nmax[2] = {0, 0};
+  PetscBool          reflect = PETSC_FALSE, *inside;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetEnum(NULL, NULL, "-migrate_type", DMSwarmMigrateTypeNames, (PetscEnum *)&mtype, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-steps", &nsteps, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-theta", &theta, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-reflect", &reflect, NULL));
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
+  PetscCall(DMSetType(dm, DMPLEX));
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCall(DMGetCoordinatesLocalSetUp(dm));
+
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &sw));
+  PetscCall(DMSetType(sw, DMSWARM));
+  PetscCall(DMSetDimension(sw, dim));
+  PetscCall(DMSwarmSetType(sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(sw, dm));
+  PetscCall(DMSwarmSetMigrateType(sw, mtype));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "id", 1, PETSC_INT));
+  PetscCall(DMSwarmFinalizeFieldRegister(sw));
+
+  /* One point close to the centroid of each owned cell lying in the disk of radius 0.45 around the center of the unit square */
+  PetscCall(PetscCalloc1(cEnd - cStart, &inside));
+  {
+    PetscSF         sf;
+    PetscInt        nleaves;
+    const PetscInt *leaves;
+
+    PetscCall(DMGetPointSF(dm, &sf));
+    PetscCall(PetscSFGetGraph(sf, NULL, &nleaves, &leaves, NULL));
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+      PetscReal centroid[3];
+      PetscInt  loc = -1;
+
+      if (nleaves > 0 && leaves) PetscCall(PetscFindInt(c, nleaves, leaves, &loc));
+      if (loc >= 0) continue;
+      PetscCall(DMPlexComputeCellGeometryFVM(dm, c, NULL, centroid, NULL));
+      if (PetscSqr(centroid[0] - 0.5) + PetscSqr(centroid[1] - 0.5) < PetscSqr(0.45)) {
+        inside[c - cStart] = PETSC_TRUE;
+        ++npoints;
+      }
+    }
+  }
+  PetscCallMPI(MPI_Exscan(&npoints, &offset, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(MPIU_Allreduce(&npoints, &ntotal, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(DMSwarmSetLocalSizes(sw, npoints, 0));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  for (PetscInt c = cStart, p = 0; c < cEnd; ++c) {
+    PetscReal centroid[3];
+
+    if (!inside[c - cStart]) continue;
+    PetscCall(DMPlexComputeCellGeometryFVM(dm, c, NULL, centroid, NULL));
+    for (PetscInt d = 0; d < dim; ++d) coords[p * dim + d] = centroid[d] + 0.01 * (d + 1);
+    cellid[p] = c;
+    id[p]     = offset + p;
+    ++p;
+  }
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+  PetscCall(PetscFree(inside));
+  PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+  PetscCall(CheckPoints(sw, dm, ntotal, &nbad, nmax));
+
+  /* Rotate the points around the center by a small angle, so that they move by less than a cell at each step. The
+     reflection through the center moves them far beyond their cell, so that they are sent to all the neighbours */
+  for (PetscInt step = reflect ? -1 : 0; step < nsteps; ++step) {
+    PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+    PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+    for (PetscInt p = 0; p < npoints; ++p) {
+      const PetscReal x = coords[p * dim] - 0.5, y = coords[p * dim + 1] - 0.5;
+
+      coords[p * dim]     = step < 0 ? 0.5 - x : 0.5 + PetscCosReal(theta) * x - PetscSinReal(theta) * y;
+      coords[p * dim + 1] = step < 0 ? 0.5 - y : 0.5 + PetscSinReal(theta) * x + PetscCosReal(theta) * y;
+    }
+    PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coords));
+    PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+    PetscCall(CheckPoints(sw, dm, ntotal, &nbad, nmax));
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nbad, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Number of points: %" PetscInt_FMT "\n", ntotal));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Maximum number of points lost during a migration: %" PetscInt_FMT ", duplicated: %" PetscInt_FMT "\n", nmax[0], nmax[1]));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Points not located in their cell: %" PetscInt_FMT "\n", nbad));
+
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: {{1 4}}
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 10,10 -petscpartitioner_type simple -migrate_type {{dmcellnscatter dmplexneighbor}}
+    output_file: output/ex12_0.out
+
+  test:
+    suffix: 1
+    nsize: 3
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 10,10 -migrate_type dmplexneighbor -steps 20
+    output_file: output/ex12_0.out
+
+  test:
+    suffix: overlap
+    nsize: 4
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 10,10 -petscpartitioner_type simple -dm_distribute_overlap 1 -migrate_type dmplexneighbor
+    output_file: output/ex12_0.out
+
+  # Points near a vertex shared by several ranks, which do not all share a face
+  test:
+    suffix: random
+    nsize: 4
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 10,10 -petscpartitioner_type shell -petscpartitioner_shell_random -dm_distribute_overlap {{0 1}} -migrate_type dmplexneighbor
+    output_file: output/ex12_0.out
+
+  # Points sent to all the neighbours, some of which have their cell in the overlap
+  test:
+    suffix: reflect
+    nsize: 4
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 10,10 -petscpartitioner_type shell -petscpartitioner_shell_random -dm_distribute_overlap {{1 2}} -migrate_type dmplexneighbor -reflect
+    output_file: output/ex12_0.out
+
+TEST*/
@@ -0,0 +1,192 @@
+static char help[] = "Tests the deposition of DMSwarm fields onto a DMPlex mesh and their interpolation back to the points\n\n";
+
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+
+static PetscErrorCode linear(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = 2.0 * x[0] - x[1] + 1.0;
+  return PETSC_SUCCESS;
+}
+
+static PetscErrorCode smooth(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = PetscSinReal(3.0 * x[0]) * PetscCosReal(2.0 * x[1]) + x[0];
+  return PETSC_SUCCESS;
+}
+
+/* Unit square split into n x n squares, each cut into two triangles */
+static PetscErrorCode CreateMesh(MPI_Comm comm, PetscInt n, DM *dm)
+{
+  PetscInt    *cells = NULL, numCells = 0, numVertices = 0;
+  PetscReal   *coords = NULL;
+  PetscMPIInt  rank;
+  PetscFE      fe;
+  DM           dmDist;
+
+  PetscFunctionBeginUser;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  if (rank == 0) {
+    numCells    = 2 * n * n;
+    numVertices = (n + 1) * (n + 1);
+    PetscCall(PetscMalloc2(3 * numCells, &cells, 2 * numVertices, &coords));
+    for (PetscInt j = 0; j <= n; ++j) {
+      for (PetscInt i = 0; i <= n; ++i) {
+        coords[2 * (j * (n + 1) + i) + 0] = (PetscReal)i / n;
+        coords[2 * (j * (n + 1) + i) + 1] = (PetscReal)j / n;
+      }
+    }
+    for (PetscInt j = 0; j < n; ++j) {
+      for (PetscInt i = 0; i < n; ++i) {
+        const PetscInt v = j * (n + 1) + i, c = 2 * (j * n + i);
+
+        cells[3 * c + 0] = v;
+        cells[3 * c + 1] = v + 1;
+        cells[3 * c + 2] = v + n + 2;
+        cells[3 * c + 3] = v;
+        cells[3 * c + 4] = v + n + 2;
+        cells[3 * c + 5] = v + n + 1;
+      }
+    }
+  }
+  PetscCall(DMPlexCreateFromCellListPetsc(comm, 2, numCells, numVertices, 3, PETSC_TRUE, cells, 2, coords, dm));
+  PetscCall(PetscFree2(cells, coords));
+  PetscCall(DMSetFromOptions(*dm));
+  PetscCall(DMPlexDistribute(*dm, 0, NULL, &dmDist));
+  if (dmDist) {
+    PetscCall(DMDestroy(dm));
+    *dm = dmDist;
+  }
+  /* P1 field, one dof per vertex */
+  PetscCall(PetscFECreateLagrange(PETSC_COMM_SELF, 2, 1, PETSC_TRUE, 1, PETSC_DETERMINE, &fe));
+  PetscCall(DMAddField(*dm, NULL, (PetscObject)fe));
+  PetscCall(DMCreateDS(*dm));
+  PetscCall(PetscFEDestroy(&fe));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM         dm, sw;
+  Vec       *fields;
+  PetscReal *coor, *phi, *psi, norm[2];
+  PetscInt   n = 8, nsub = 2, npoints;
+  const char *fieldnames[] = {"phi", "psi"};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsub", &nsub, NULL));
+  PetscCall(CreateMesh(PETSC_COMM_WORLD, n, &dm));
+
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &sw));
+  PetscCall(DMSetType(sw, DMSWARM));
+  PetscCall(DMSetDimension(sw, 2));
+  PetscCall(DMSwarmSetType(sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(sw, dm));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "phi", 1, PETSC_REAL));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "psi", 1, PETSC_REAL));
+  PetscCall(DMSwarmFinalizeFieldRegister(sw));
+  /* Points at barycentric coordinates (i + 1/3, j + 1/3) / nsub inside each cell */
+  {
+    Vec          coordinates;
+    PetscSection cs;
+    PetscInt     cStart, cEnd, *cellid, np = nsub * (nsub + 1) / 2, q = 0;
+
+    PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+    PetscCall(DMGetCoordinatesLocal(dm, &coordinates));
+    PetscCall(DMGetCoordinateSection(dm, &cs));
+    PetscCall(DMSwarmSetLocalSizes(sw, (cEnd - cStart) * np, 0));
+    PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+    PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+      PetscScalar *v = NULL;
+
+      PetscCall(DMPlexVecGetClosure(dm, cs, coordinates, c, NULL, &v));
+      for (PetscInt j = 0; j < nsub; ++j) {
+        for (PetscInt i = 0; i + j < nsub; ++i, ++q) {
+          const PetscReal xi = (i + 1.0 / 3.0) / nsub, eta = (j + 1.0 / 3.0) / nsub;
+
+          for (PetscInt d = 0; d < 2; ++d) coor[2 * q + d] = PetscRealPart((1.0 - xi - eta) * v[d] + xi * v[2 + d] + eta * v[4 + d]);
+          cellid[q] = c;
+        }
+      }
+      PetscCall(DMPlexVecRestoreClosure(dm, cs, coordinates, c, NULL, &v));
+    }
+    PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+    PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  }
+
+  /* Deposit a smooth field and a constant one, which must be reproduced exactly */
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, "phi", NULL, NULL, (void **)&phi));
+  PetscCall(DMSwarmGetField(sw, "psi", NULL, NULL, (void **)&psi));
+  for (PetscInt p = 0; p < npoints; ++p) {
+    phi[p] = PetscSinReal(3.0 * coor[2 * p]) * PetscCosReal(2.0 * coor[2 * p + 1]) + coor[2 * p];
+    psi[p] = 3.0;
+  }
+  PetscCall(DMSwarmRestoreField(sw, "psi", NULL, NULL, (void **)&psi));
+  PetscCall(DMSwarmRestoreField(sw, "phi", NULL, NULL, (void **)&phi));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmProjectFields(sw, 2, fieldnames, &fields, PETSC_FALSE));
+  {
+    PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {smooth};
+    Vec u;
+
+    PetscCall(VecDuplicate(fields[0], &u));
+    PetscCall(DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, u));
+    PetscCall(VecNorm(u, NORM_2, &norm[0]));
+    PetscCall(VecAXPY(u, -1.0, fields[0]));
+    PetscCall(VecNorm(u, NORM_2, &norm[1]));
+    /* the deposition is a first order approximation of the L2 projection, the difference is a few percent on the meshes of the tests */
+    if (norm[1] < 0.1 * norm[0]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference of the deposited smooth field to its interpolant: < 0.1\n"));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference of the deposited smooth field to its interpolant: %g\n", (double)(norm[1] / norm[0])));
+    PetscCall(VecDestroy(&u));
+  }
+  PetscCall(VecShift(fields[1], -3.0));
+  PetscCall(VecNorm(fields[1], NORM_INFINITY, &norm[1]));
+  if (norm[1] < 1.0e-10) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Error of the deposited constant field: < 1.0e-10\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Error of the deposited constant field: %g\n", (double)norm[1]));
+
+  /* Interpolate a linear field to the points, which must be exact */
+  {
+    PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *) = {linear};
+    PetscReal err = 0.0;
+
+    PetscCall(DMProjectFunction(dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, fields[0]));
+    PetscCall(DMSwarmInterpolateFields(sw, 1, fieldnames, fields));
+    PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+    PetscCall(DMSwarmGetField(sw, "phi", NULL, NULL, (void **)&phi));
+    for (PetscInt p = 0; p < npoints; ++p) err = PetscMax(err, PetscAbsReal(phi[p] - (2.0 * coor[2 * p] - coor[2 * p + 1] + 1.0)));
+    PetscCall(DMSwarmRestoreField(sw, "phi", NULL, NULL, (void **)&phi));
+    PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &err, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+    if (err < 1.0e-10) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Error of the interpolated linear field: < 1.0e-10\n"));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Error of the interpolated linear field: %g\n", (double)err));
+  }
+
+  PetscCall(VecDestroy(&fields[0]));
+  PetscCall(VecDestroy(&fields[1]));
+  PetscCall(PetscFree(fields));
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: {{1 3}}
+    args: -petscpartitioner_type simple
+    output_file: output/ex13_0.out
+
+  test:
+    suffix: 1
+    nsize: 2
+    args: -n 13 -nsub 4 -dm_distribute_overlap 1
+    output_file: output/ex13_1.out
+
+TEST*/
@@ -32,6 +32,7 @@ PetscErrorCode DMFinalizePackage(void)
 PETSC_EXTERN PetscErrorCode MatCreate_HYPREStruct(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_HYPRESStruct(Mat);
 #endif
+PETSC_EXTERN PetscErrorCode MatCreate_Stencil(Mat);
 
 /*@C
   DMInitializePackage - This function initializes everything in the DM package. It is called
@@ -61,6 +62,7 @@ PetscErrorCode DMInitializePackage(void)
   PetscCall(MatRegister(MATHYPRESTRUCT, MatCreate_HYPREStruct));
   PetscCall(MatRegister(MATHYPRESSTRUCT, MatCreate_HYPRESStruct));
 #endif
+  PetscCall(MatRegister(MATSTENCIL, MatCreate_Stencil));
   PetscCall(PetscSectionSymRegister(PETSCSECTIONSYMLABEL, PetscSectionSymCreate_Label));
 
   /* Register Constructors */
@@ -0,0 +1,259 @@
+#include <petscsf.h>
+#include <petsc/private/hashseti.h>
+#include <petsc/private/partitionerimpl.h> /*I "petscpartitioner.h" I*/
+
+typedef struct {
+  PetscInt  maxIt; /* Maximum number of diffusion iterations */
+  PetscReal rtol;  /* Relative tolerance on the load excess */
+} PetscPartitioner_Diffusion;
+
+static PetscErrorCode PetscPartitionerDestroy_Diffusion(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(part->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusion_ASCII(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscPartitioner_Diffusion *p = (PetscPartitioner_Diffusion *)part->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerASCIIPushTab(viewer));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "maximum diffusion iterations %" PetscInt_FMT "\n", p->maxIt));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "relative load tolerance %g\n", (double)p->rtol));
+  PetscCall(PetscViewerASCIIPopTab(viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusion(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) PetscCall(PetscPartitionerView_Diffusion_ASCII(part, viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerSetFromOptions_Diffusion(PetscPartitioner part, PetscOptionItems *PetscOptionsObject)
+{
+  PetscPartitioner_Diffusion *p = (PetscPartitioner_Diffusion *)part->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscPartitioner Diffusion Options");
+  PetscCall(PetscOptionsInt("-petscpartitioner_diffusion_max_it", "Maximum number of diffusion iterations", "", p->maxIt, &p->maxIt, NULL));
+  PetscCall(PetscOptionsReal("-petscpartitioner_diffusion_rtol", "Relative tolerance on the load excess", "", p->rtol, &p->rtol, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Return the rank owning global vertex g, skipping the ranks without vertices */
+static inline PetscMPIInt DiffusionGetOwner_Private(const PetscInt vtxdist[], PetscMPIInt size, PetscInt g)
+{
+  PetscMPIInt lo = 0, hi = size;
+
+  while (hi - lo > 1) {
+    const PetscMPIInt mid = lo + (hi - lo) / 2;
+
+    if (vtxdist[mid] <= g) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
+
+static PetscErrorCode PetscPartitionerPartition_Diffusion(PetscPartitioner part, PetscInt nparts, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection vertSection, PetscSection targetSection, PetscSection partSection, IS *partition)
+{
+  PetscPartitioner_Diffusion *pd = (PetscPartitioner_Diffusion *)part->data;
+  MPI_Comm                    comm;
+  PetscSF                     sf;
+  PetscSFNode                *remote;
+  PetscHSetI                  ht;
+  PetscMPIInt                 size, rank, *owner;
+  PetscInt                   *vtxdist, *neighbors, *assignment, *points, *queue, *mark, *ndeg;
+  PetscReal                  *wgt, *flow, *nexcess, *alpha;
+  PetscReal                   load, total, target, excess, tsum = 0.0, err;
+  PetscInt                    numNeighbors = 0, deg, numRemaining = numVertices, v, e, i, p, off = 0, it;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)part, &comm));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCheck(nparts == size, comm, PETSC_ERR_SUP, "PETSCPARTITIONERDIFFUSION requires the number of partitions %" PetscInt_FMT " to match the communicator size %d", nparts, size);
+  /* Calculate vertex distribution */
+  PetscCall(PetscMalloc1(size + 1, &vtxdist));
+  vtxdist[0] = 0;
+  PetscCallMPI(MPI_Allgather(&numVertices, 1, MPIU_INT, &vtxdist[1], 1, MPIU_INT, comm));
+  for (p = 2; p <= size; ++p) vtxdist[p] += vtxdist[p - 1];
+  /* Local load and target load */
+  PetscCall(PetscMalloc3(numVertices, &wgt, numVertices, &assignment, start ? start[numVertices] : 0, &owner));
+  for (v = 0, load = 0.0; v < numVertices; ++v) {
+    PetscInt w = 1;
+
+    if (vertSection) PetscCall(PetscSectionGetDof(vertSection, v, &w));
+    wgt[v] = w;
+    load += w;
+    assignment[v] = rank;
+  }
+  PetscCall(MPIU_Allreduce(&load, &total, 1, MPIU_REAL, MPIU_SUM, comm));
+  target = total / size;
+  if (targetSection) {
+    PetscInt tpd;
+
+    for (p = 0; p < size; ++p) {
+      PetscCall(PetscSectionGetDof(targetSection, p, &tpd));
+      tsum += tpd;
+    }
+    if (tsum > 0.0) {
+      PetscCall(PetscSectionGetDof(targetSection, rank, &tpd));
+      target = total * tpd / tsum;
+    }
+  }
+  /* Process graph: the ranks owning a cell adjacent to one of ours */
+  PetscCall(PetscHSetICreate(&ht));
+  for (v = 0; v < numVertices; ++v) {
+    for (e = start[v]; e < start[v + 1]; ++e) {
+      owner[e] = DiffusionGetOwner_Private(vtxdist, size, adjacency[e]);
+      if (owner[e] != rank) PetscCall(PetscHSetIAdd(ht, owner[e]));
+    }
+  }
+  PetscCall(PetscHSetIGetSize(ht, &numNeighbors));
+  PetscCall(PetscMalloc5(numNeighbors, &neighbors, numNeighbors, &ndeg, numNeighbors, &nexcess, numNeighbors, &flow, numNeighbors, &alpha));
+  PetscCall(PetscHSetIGetElems(ht, &off, neighbors));
+  PetscCall(PetscHSetIDestroy(&ht));
+  PetscCall(PetscSortInt(numNeighbors, neighbors));
+  PetscCall(PetscMalloc1(numNeighbors, &remote));
+  for (i = 0; i < numNeighbors; ++i) {
+    remote[i].rank  = neighbors[i];
+    remote[i].index = 0;
+  }
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetGraph(sf, 1, numNeighbors, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+  /* Metropolis weights make the diffusion matrix symmetric, so that flows computed on both sides of an edge agree */
+  deg = numNeighbors;
+  PetscCall(PetscSFBcastBegin(sf, MPIU_INT, &deg, ndeg, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_INT, &deg, ndeg, MPI_REPLACE));
+  for (i = 0; i < numNeighbors; ++i) {
+    alpha[i] = 1.0 / (PetscMax(numNeighbors, ndeg[i]) + 1);
+    flow[i]  = 0.0;
+  }
+  /* First order diffusion of the load excess, accumulating the flow along each edge of the process graph */
+  excess = load - target;
+  for (it = 0; it < pd->maxIt; ++it) {
+    PetscReal dx = 0.0;
+
+    err = PetscAbsReal(excess);
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &err, 1, MPIU_REAL, MPIU_MAX, comm));
+    if (err <= pd->rtol * total / size) break;
+    PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, &excess, nexcess, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, &excess, nexcess, MPI_REPLACE));
+    for (i = 0; i < numNeighbors; ++i) {
+      const PetscReal f = alpha[i] * (excess - nexcess[i]);
+
+      flow[i] += f;
+      dx += f;
+    }
+    excess -= dx;
+  }
+  PetscCall(PetscInfo(part, "Diffusion stopped after %" PetscInt_FMT " iterations\n", it));
+  PetscCall(PetscSFDestroy(&sf));
+  /* Grow the outgoing regions from the interface with each receiving neighbor */
+  PetscCall(PetscMalloc2(numVertices, &queue, numVertices, &mark));
+  for (v = 0; v < numVertices; ++v) mark[v] = -1;
+  for (i = 0; i < numNeighbors; ++i) {
+    PetscReal moved = 0.0;
+    PetscInt  qs = 0, qe = 0;
+
+    if (flow[i] <= 0.0) continue;
+    for (v = 0; v < numVertices; ++v) {
+      if (assignment[v] != rank) continue;
+      for (e = start[v]; e < start[v + 1]; ++e) {
+        if (owner[e] == neighbors[i]) {
+          mark[v]     = i;
+          queue[qe++] = v;
+          break;
+        }
+      }
+    }
+    while (qs < qe && numRemaining > 1) {
+      v = queue[qs++];
+      if (moved + 0.5 * wgt[v] > flow[i]) break;
+      assignment[v] = neighbors[i];
+      moved += wgt[v];
+      --numRemaining;
+      for (e = start[v]; e < start[v + 1]; ++e) {
+        const PetscInt u = adjacency[e] - vtxdist[rank];
+
+        if (owner[e] != rank || assignment[u] != rank || mark[u] == i) continue;
+        mark[u]     = i;
+        queue[qe++] = u;
+      }
+    }
+  }
+  /* Convert to PetscSection+IS */
+  for (v = 0; v < numVertices; ++v) PetscCall(PetscSectionAddDof(partSection, assignment[v], 1));
+  PetscCall(PetscMalloc1(numVertices, &points));
+  for (p = 0, i = 0; p < nparts; ++p) {
+    for (v = 0; v < numVertices; ++v) {
+      if (assignment[v] == p) points[i++] = v;
+    }
+  }
+  PetscCheck(i == numVertices, comm, PETSC_ERR_PLIB, "Number of points %" PetscInt_FMT " should be %" PetscInt_FMT, i, numVertices);
+  PetscCall(ISCreateGeneral(comm, numVertices, points, PETSC_OWN_POINTER, partition));
+  PetscCall(PetscFree2(queue, mark));
+  PetscCall(PetscFree5(neighbors, ndeg, nexcess, flow, alpha));
+  PetscCall(PetscFree3(wgt, assignment, owner));
+  PetscCall(PetscFree(vtxdist));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerInitialize_Diffusion(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  part->noGraph             = PETSC_FALSE;
+  part->ops->view           = PetscPartitionerView_Diffusion;
+  part->ops->setfromoptions = PetscPartitionerSetFromOptions_Diffusion;
+  part->ops->destroy        = PetscPartitionerDestroy_Diffusion;
+  part->ops->partition      = PetscPartitionerPartition_Diffusion;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+  PETSCPARTITIONERDIFFUSION = "diffusion" - A PetscPartitioner object that repartitions an already distributed graph by diffusing the load between neighboring processes
+
+  Level: intermediate
+
+  Options Database Keys:
++  -petscpartitioner_diffusion_max_it <int> - Maximum number of diffusion iterations
+-  -petscpartitioner_diffusion_rtol <value> - Stop once the load excess of every process is below this fraction of the average load
+
+  Notes:
+  The number of partitions must equal the communicator size, and the current distribution of the graph is taken as the starting partition.
+  The load of each process (the sum of the vertex weights) is diffused over the process graph, where two processes are connected if they own adjacent vertices.
+  The accumulated flow along each edge is then realized by moving the vertices closest to the interface with the receiving process, so that only a
+  thin layer of vertices changes owner and the communication pattern of the current distribution is preserved. Processes without vertices cannot receive load.
+
+  `DMPlexRebalance()` uses this partitioner to rebalance a distributed mesh in place, keeping its overlap and moving only the cells that change owner.
+  Used with `DMPlexDistribute()` on a distributed mesh, only the cells that change owner are sent to other processes, but a new DM is built.
+
+.seealso: `PetscPartitionerType`, `PetscPartitionerCreate()`, `PetscPartitionerSetType()`, `DMPlexRebalance()`, `DMPlexDistribute()`
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Diffusion(PetscPartitioner part)
+{
+  PetscPartitioner_Diffusion *p;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscCall(PetscNew(&p));
+  part->data = p;
+
+  p->maxIt = 1000;
+  p->rtol  = 0.01;
+
+  PetscCall(PetscPartitionerInitialize_Diffusion(part));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -51,6 +51,7 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Shell(PetscPartitioner);
 PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Simple(PetscPartitioner);
 PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Gather(PetscPartitioner);
 PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_MatPartitioning(PetscPartitioner);
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Diffusion(PetscPartitioner);
 
 /*@C
   PetscPartitionerRegisterAll - Registers all of the PetscPartitioner components in the DM package.
@@ -77,6 +78,7 @@ PetscErrorCode PetscPartitionerRegisterAll(void)
   PetscCall(PetscPartitionerRegister(PETSCPARTITIONERSHELL, PetscPartitionerCreate_Shell));
   PetscCall(PetscPartitionerRegister(PETSCPARTITIONERGATHER, PetscPartitionerCreate_Gather));
   PetscCall(PetscPartitionerRegister(PETSCPARTITIONERMATPARTITIONING, PetscPartitionerCreate_MatPartitioning));
+  PetscCall(PetscPartitionerRegister(PETSCPARTITIONERDIFFUSION, PetscPartitionerCreate_Diffusion));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -0,0 +1,197 @@
+static char help[] = "Tests MATSTENCIL against MATAIJ for operators on a DMDA, command line options :\n\
+dim - dimension of the grid (1,2,3)\n\
+dof - number of degrees of freedom per grid point\n\
+sw - stencil width\n\
+box - use a box stencil instead of a star stencil\n\
+periodic - use periodic boundaries\n\
+depth - number of Jacobi sweeps between two ghost exchanges\n\
+tile - number of grid lines in a tile for the Jacobi sweeps\n";
+
+#include <petscdmda.h>
+#include <petscksp.h>
+
+/* Diagonally dominant coefficient coupling component r of (i,j,k) to component c of its neighbor (i,j,k) + (di,dj,dk) */
+static PetscScalar Coefficient(PetscInt i, PetscInt j, PetscInt k, PetscInt r, PetscInt c, PetscInt di, PetscInt dj, PetscInt dk, PetscInt ns)
+{
+  if (!di && !dj && !dk && r == c) return 2.0 * ns;
+  return -1.0 / (1.0 + PetscAbsInt(i + 2 * j + 3 * k + 5 * r + 7 * c + 11 * di + 13 * dj + 17 * dk) % 5);
+}
+
+static PetscErrorCode CheckNorm(const char name[], Vec a, Vec b, PetscReal tol)
+{
+  PetscReal norm, diff;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecNorm(a, NORM_2, &norm));
+  PetscCall(VecAXPY(b, -1.0, a));
+  PetscCall(VecNorm(b, NORM_2, &diff));
+  if (!(diff <= tol * norm)) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: difference %g\n", name, (double)diff));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: OK\n", name));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM             da;
+  Mat            A, S, B;
+  Vec            x, y, z, d, r;
+  KSP            ksp;
+  PetscRandom    rand;
+  PetscInt       dim = 3, dof = 1, sw = 1, depth = PETSC_DETERMINE, tile = PETSC_DETERMINE, M, N, P, xs, ys, zs, xm, ym, zm, ns;
+  PetscBool      box = PETSC_FALSE, periodic = PETSC_FALSE;
+  DMBoundaryType bd;
+  PetscReal      norm, rnorm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dim", &dim, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dof", &dof, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-sw", &sw, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-box", &box, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-periodic", &periodic, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-depth", &depth, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-tile", &tile, NULL));
+  bd = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+
+  PetscCall(DMDACreate(PETSC_COMM_WORLD, &da));
+  PetscCall(DMSetDimension(da, dim));
+  PetscCall(DMDASetSizes(da, 9, dim > 1 ? 8 : 1, dim > 2 ? 7 : 1));
+  PetscCall(DMDASetBoundaryType(da, bd, bd, bd));
+  PetscCall(DMDASetDof(da, dof));
+  PetscCall(DMDASetStencilWidth(da, sw));
+  PetscCall(DMDASetStencilType(da, box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR));
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMSetMatType(da, MATAIJ));
+  PetscCall(DMCreateMatrix(da, &A));
+  PetscCall(DMSetMatType(da, MATSTENCIL));
+  PetscCall(DMCreateMatrix(da, &S));
+
+  /* Assemble the same operator into both matrices */
+  ns = box ? (dim == 3 ? (2 * sw + 1) * (2 * sw + 1) * (2 * sw + 1) : (dim == 2 ? (2 * sw + 1) * (2 * sw + 1) : 2 * sw + 1)) : 2 * dim * sw + 1;
+  PetscCall(DMDAGetInfo(da, NULL, &M, &N, &P, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm));
+  for (PetscInt k = zs; k < zs + zm; ++k) {
+    for (PetscInt j = ys; j < ys + ym; ++j) {
+      for (PetscInt i = xs; i < xs + xm; ++i) {
+        for (PetscInt r = 0; r < dof; ++r) {
+          const PetscInt kw = dim > 2 ? sw : 0, jw = dim > 1 ? sw : 0;
+          MatStencil     row = {k, j, i, r}, col;
+          PetscScalar    v;
+
+          for (PetscInt dk = -kw; dk <= kw; ++dk) {
+            for (PetscInt dj = -jw; dj <= jw; ++dj) {
+              for (PetscInt di = -sw; di <= sw; ++di) {
+                if (!box && ((di && dj) || (di && dk) || (dj && dk))) continue;
+                if (!periodic && (i + di < 0 || i + di >= M || j + dj < 0 || j + dj >= N || k + dk < 0 || k + dk >= P)) continue;
+                for (PetscInt c = 0; c < dof; ++c) {
+                  col.k = k + dk;
+                  col.j = j + dj;
+                  col.i = i + di;
+                  col.c = c;
+                  v     = Coefficient(i, j, k, r, c, di, dj, dk, ns * dof);
+                  PetscCall(MatSetValuesStencil(A, 1, &row, 1, &col, &v, INSERT_VALUES));
+                  PetscCall(MatSetValuesStencil(S, 1, &row, 1, &col, &v, INSERT_VALUES));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(S, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(S, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(DMCreateGlobalVector(da, &x));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicate(x, &z));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(PetscRandomSetFromOptions(rand));
+  PetscCall(VecSetRandom(x, rand));
+
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(S, x, z));
+  PetscCall(CheckNorm("MatMult", y, z, 100 * PETSC_MACHINE_EPSILON));
+  PetscCall(MatMultAdd(A, x, x, y));
+  PetscCall(MatMultAdd(S, x, x, z));
+  PetscCall(CheckNorm("MatMultAdd", y, z, 100 * PETSC_MACHINE_EPSILON));
+  PetscCall(MatGetDiagonal(A, y));
+  PetscCall(MatGetDiagonal(S, z));
+  PetscCall(CheckNorm("MatGetDiagonal", y, z, 100 * PETSC_MACHINE_EPSILON));
+  PetscCall(MatSOR(A, x, 1.1, (MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.0, 2, 1, y));
+  PetscCall(MatSOR(S, x, 1.1, (MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.0, 2, 1, z));
+  PetscCall(CheckNorm("MatSOR", y, z, 100 * PETSC_MACHINE_EPSILON));
+
+  /* Damped Jacobi sweeps y <- y + omega D^{-1} (x - A y), one at a time with the assembled matrix */
+  PetscCall(VecDuplicate(x, &d));
+  PetscCall(VecDuplicate(x, &r));
+  PetscCall(MatGetDiagonal(A, d));
+  PetscCall(VecReciprocal(d));
+  PetscCall(VecSet(y, 0.0));
+  for (PetscInt it = 0; it < 5; ++it) {
+    PetscCall(MatMult(A, y, r));
+    PetscCall(VecAYPX(r, -1.0, x));
+    PetscCall(VecPointwiseMult(r, r, d));
+    PetscCall(VecAXPY(y, 0.8, r));
+  }
+  PetscCall(MatStencilJacobi(S, x, 0.8, 2, depth, tile, PETSC_TRUE, z));
+  PetscCall(MatStencilJacobi(S, x, 0.8, 3, depth, tile, PETSC_FALSE, z));
+  PetscCall(CheckNorm("MatStencilJacobi", y, z, 100 * PETSC_MACHINE_EPSILON));
+  PetscCall(VecDestroy(&d));
+  PetscCall(VecDestroy(&r));
+
+  /* The converted matrix must be the assembled one */
+  PetscCall(MatConvert(S, MATAIJ, MAT_INITIAL_MATRIX, &B));
+  PetscCall(MatAXPY(B, -1.0, A, DIFFERENT_NONZERO_PATTERN));
+  PetscCall(MatNorm(B, NORM_FROBENIUS, &norm));
+  PetscCall(MatNorm(A, NORM_FROBENIUS, &rnorm));
+  if (!(norm <= 100 * PETSC_MACHINE_EPSILON * rnorm)) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatConvert: difference %g\n", (double)norm));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatConvert: OK\n"));
+  PetscCall(MatDestroy(&B));
+
+  /* Solve with the stencil matrix, relaxation uses its own MatSOR() */
+  PetscCall(MatMult(A, x, y));
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, S, S));
+  PetscCall(KSPSetTolerances(ksp, 1.e-10, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSolve(ksp, y, z));
+  PetscCall(CheckNorm("KSPSolve", x, z, 1.e-6));
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&S));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    args: -dim {{1 2 3}} -dof {{1 2}} -box {{0 1}} -periodic {{0 1}} -ksp_type gmres -pc_type sor
+
+  test:
+    suffix: 1
+    nsize: 4
+    args: -dim {{2 3}} -dof {{1 3}} -box {{0 1}} -periodic {{0 1}} -ksp_type gmres -pc_type sor
+
+  test:
+    suffix: 2
+    nsize: 2
+    args: -dim 2 -sw 2 -box -ksp_type gmres -pc_type jacobi
+
+  test:
+    suffix: tbjacobi
+    nsize: {{1 4}}
+    args: -dim {{1 2 3}} -dof {{1 2}} -box -periodic {{0 1}} -depth {{1 3}} -tile 2 -ksp_type richardson -ksp_max_it 100 -pc_type tbjacobi -pc_tbjacobi_omega 0.8
+
+TEST*/
@@ -0,0 +1,101 @@
+static char help[] = "Tests the compact representation of MATLMVMBFGS against the recursive formulas.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **args)
+{
+  Mat                        B, Bref;
+  Vec                        x, f, d, u, z, zref, w;
+  PetscInt                   n = 20, m = 5, nup = 12;
+  PetscReal                  errmult = 0.0, errsolve = 0.0, errinv = 0.0, norm, err;
+  PetscRandom                rand;
+  MatLMVMSymBroydenScaleType stype = MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nup", &nup, NULL));
+  PetscCall(PetscOptionsGetEnum(NULL, NULL, "-scale_type", MatLMVMSymBroydenScaleTypes, (PetscEnum *)&stype, NULL));
+  PetscCall(KSPInitializePackage());
+
+  /* the same approximation, with and without the compact representation */
+  PetscCall(PetscOptionsSetValue(NULL, "-ref_mat_lmvm_compact", "0"));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &Bref));
+  PetscCall(MatSetOptionsPrefix(Bref, "ref_"));
+  for (PetscInt i = 0; i < 2; i++) {
+    Mat A = i ? Bref : B;
+
+    PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, n, n));
+    PetscCall(MatSetType(A, MATLMVMBFGS));
+    PetscCall(MatLMVMSetHistorySize(A, m));
+    PetscCall(MatSetFromOptions(A));
+    PetscCall(MatLMVMSymBroydenSetScaleType(A, stype));
+    PetscCall(MatSetUp(A));
+  }
+
+  /* updates from the gradient f = D x of a quadratic with an ill conditioned diagonal Hessian D */
+  PetscCall(MatCreateVecs(B, &x, &f));
+  PetscCall(VecDuplicate(x, &d));
+  PetscCall(VecDuplicate(x, &u));
+  PetscCall(VecDuplicate(x, &z));
+  PetscCall(VecDuplicate(x, &zref));
+  PetscCall(VecDuplicate(x, &w));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(PetscRandomSetInterval(rand, 1.0, 100.0));
+  PetscCall(VecSetRandom(d, rand));
+  PetscCall(PetscRandomSetInterval(rand, -1.0, 1.0));
+  PetscCall(VecSetRandom(u, rand));
+  for (PetscInt i = 0; i < nup; i++) {
+    PetscCall(VecSetRandom(x, rand));
+    PetscCall(VecPointwiseMult(f, d, x));
+    PetscCall(MatLMVMUpdate(B, x, f));
+    PetscCall(MatLMVMUpdate(Bref, x, f));
+
+    PetscCall(MatMult(B, u, z));
+    PetscCall(MatMult(Bref, u, zref));
+    PetscCall(VecNorm(zref, NORM_2, &norm));
+    PetscCall(VecAXPY(zref, -1.0, z));
+    PetscCall(VecNorm(zref, NORM_2, &err));
+    errmult = PetscMax(errmult, err / norm);
+
+    PetscCall(MatSolve(B, z, w));
+    PetscCall(MatSolve(Bref, z, zref));
+    PetscCall(VecNorm(zref, NORM_2, &norm));
+    PetscCall(VecAXPY(zref, -1.0, w));
+    PetscCall(VecNorm(zref, NORM_2, &err));
+    errsolve = PetscMax(errsolve, err / norm);
+
+    PetscCall(VecAXPY(w, -1.0, u));
+    PetscCall(VecNorm(w, NORM_2, &err));
+    PetscCall(VecNorm(u, NORM_2, &norm));
+    errinv = PetscMax(errinv, err / norm);
+  }
+  /* largest relative differences over all the updates, only printed when they exceed the tolerances */
+  if (errmult < 1e-10 && errsolve < 1e-10 && errinv < 1e-8) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Compact representation matches the recursive formulas: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Compact representation matches the recursive formulas: no, mult %g solve %g inverse %g\n", (double)errmult, (double)errsolve, (double)errinv));
+
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&f));
+  PetscCall(VecDestroy(&d));
+  PetscCall(VecDestroy(&u));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&zref));
+  PetscCall(VecDestroy(&w));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&Bref));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      requires: !single
+      args: -scale_type {{none scalar diagonal}}
+      output_file: output/ex84_1.out
+
+TEST*/
@@ -1,5 +1,6 @@
 #include <../src/ksp/ksp/utils/lmvm/symbrdn/symbrdn.h> /*I "petscksp.h" I*/
 #include <../src/ksp/ksp/utils/lmvm/diagbrdn/diagbrdn.h>
+#include <petscblaslapack.h>
 
 /*
   Limited-memory Broyden-Fletcher-Goldfarb-Shano method for approximating both
@@ -8,6 +9,331 @@
 
 /*------------------------------------------------------------*/
 
+/*
+  The compact representation of Byrd, Nocedal and Schnabel "Representations of
+  quasi-Newton matrices and their use in limited memory methods", Mathematical
+  Programming 63 (1994) (https://doi.org/10.1007/BF01582063), equations (2.17)
+  and (3.1), with R the upper triangle, L the strictly lower triangle and D the
+  diagonal of S^T Y:
+
+    B = B0 - [B0*S  Y] [ S^T B0 S   L ]^{-1} [ S^T B0 ]
+                       [ L^T       -D ]      [ Y^T    ]
+
+    H = H0 + [S  H0*Y] [ R^{-T} (D + Y^T H0 Y) R^{-1}   -R^{-T} ] [ S^T    ]
+                       [ -R^{-1}                          0     ] [ Y^T H0 ]
+
+  S^T Y, Y^T Y and S^T S are updated incrementally when an update is accepted and
+  the small dense factors are rebuilt lazily. With the identity or the scalar J0
+  every product reads S and Y together, once with VecMDot() and once with VecMAXPY().
+  With the diagonal J0 they are read in two passes since H0 sits between them, and
+  Y^T H0 Y and S^T B0 S only gain the columns of the new updates while the diagonal
+  is unchanged. This requires J0 to be the identity, the scalar or the diagonal scaling.
+*/
+static PetscErrorCode MatLMVMBFGSUseCompact_Private(Mat B, PetscBool *flg)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  if (!lbfgs->compact || lmvm->J0 || lmvm->user_pc || lmvm->user_ksp || lmvm->user_scale) PetscFunctionReturn(PETSC_SUCCESS);
+  switch (lbfgs->scale_type) {
+  case MAT_LMVM_SYMBROYDEN_SCALE_NONE:
+  case MAT_LMVM_SYMBROYDEN_SCALE_SCALAR:
+  case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
+    *flg = PETSC_TRUE;
+    break;
+  default:
+    break;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Brings S^T Y, Y^T Y and S^T S up to date after the newest update was stored, shift indicates the oldest one was dropped */
+static PetscErrorCode MatLMVMBFGSCompactUpdate_Private(Mat B, PetscBool shift)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     m = lmvm->m, k = lmvm->k, i, j;
+  PetscScalar *StY = lbfgs->StY, *YtY = lbfgs->YtY, *StS = lbfgs->StS, *YtHY = lbfgs->YtHY, *StBS = lbfgs->StBS, *work = lbfgs->cwork;
+
+  PetscFunctionBegin;
+  if (lbfgs->needC) {
+    for (j = 0; j <= k; ++j) {
+      PetscCall(VecMDot(lmvm->Y[j], k + 1, lmvm->S, &StY[j * m]));
+      PetscCall(VecMDot(lmvm->Y[j], j + 1, lmvm->Y, &YtY[j * m]));
+      PetscCall(VecMDot(lmvm->S[j], j + 1, lmvm->S, &StS[j * m]));
+      for (i = 0; i < j; ++i) {
+        YtY[j + i * m] = PetscConj(YtY[i + j * m]);
+        StS[j + i * m] = PetscConj(StS[i + j * m]);
+      }
+    }
+    lbfgs->nHY   = 0;
+    lbfgs->nBS   = 0;
+    lbfgs->needC = PETSC_FALSE;
+  } else if (k >= 0) {
+    if (shift) {
+      for (j = 0; j < k; ++j) {
+        for (i = 0; i < k; ++i) {
+          StY[i + j * m]  = StY[i + 1 + (j + 1) * m];
+          YtY[i + j * m]  = YtY[i + 1 + (j + 1) * m];
+          StS[i + j * m]  = StS[i + 1 + (j + 1) * m];
+          YtHY[i + j * m] = YtHY[i + 1 + (j + 1) * m];
+          StBS[i + j * m] = StBS[i + 1 + (j + 1) * m];
+        }
+      }
+      lbfgs->nHY = PetscMax(lbfgs->nHY - 1, 0);
+      lbfgs->nBS = PetscMax(lbfgs->nBS - 1, 0);
+    }
+    PetscCall(VecMDot(lmvm->Y[k], k + 1, lmvm->S, &StY[k * m]));
+    PetscCall(VecMDot(lmvm->Y[k], k + 1, lmvm->Y, &YtY[k * m]));
+    PetscCall(VecMDot(lmvm->S[k], k + 1, lmvm->S, &StS[k * m]));
+    if (k > 0) PetscCall(VecMDot(lmvm->S[k], k, lmvm->Y, work));
+    for (j = 0; j < k; ++j) {
+      StY[k + j * m] = PetscConj(work[j]);
+      YtY[k + j * m] = PetscConj(YtY[j + k * m]);
+      StS[k + j * m] = PetscConj(StS[j + k * m]);
+    }
+    /* the newest update is in position k, so at most the first k columns of Y^T H0 Y and S^T B0 S are still current */
+    lbfgs->nHY = PetscMin(lbfgs->nHY, k);
+    lbfgs->nBS = PetscMin(lbfgs->nBS, k);
+  }
+  lbfgs->needCfwd = PETSC_TRUE;
+  lbfgs->needCinv = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Returns the state of the diagonal J0, which changes whenever its entries do */
+static PetscErrorCode MatLMVMBFGSCompactGetJ0State_Private(Mat B, PetscObjectState *state)
+{
+  Mat_LMVM     *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn  *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  Mat_LMVM     *dbase = (Mat_LMVM *)lbfgs->D->data;
+  Mat_DiagBrdn *dctx  = (Mat_DiagBrdn *)dbase->ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)dctx->invD, state));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Points SY at S[0..k] followed by Y[0..k] */
+static PetscErrorCode MatLMVMBFGSCompactGetSY_Private(Mat B)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     n = lmvm->k + 1, i;
+
+  PetscFunctionBegin;
+  for (i = 0; i < n; ++i) {
+    lbfgs->SY[i]     = lmvm->S[i];
+    lbfgs->SY[n + i] = lmvm->Y[i];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Forms D + Y^T H0 Y for the inverse application */
+static PetscErrorCode MatLMVMBFGSCompactSetUpInv_Private(Mat B)
+{
+  Mat_LMVM        *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn     *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt         m = lmvm->m, n = lmvm->k + 1, i, j;
+  PetscScalar     *C = lbfgs->Cinv, *YtHY = lbfgs->YtHY;
+  PetscReal        sigma;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  if (lbfgs->needC) PetscCall(MatLMVMBFGSCompactUpdate_Private(B, PETSC_FALSE));
+  if (!lbfgs->needCinv) PetscFunctionReturn(PETSC_SUCCESS);
+  if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL) {
+    /* only the columns of the updates added since H0 last changed are formed */
+    PetscCall(MatLMVMBFGSCompactGetJ0State_Private(B, &state));
+    if (state != lbfgs->stateHY) lbfgs->nHY = 0;
+    for (j = lbfgs->nHY; j < n; ++j) {
+      PetscCall(MatSymBrdnApplyJ0Inv(B, lmvm->Y[j], lbfgs->work));
+      PetscCall(VecMDot(lbfgs->work, j + 1, lmvm->Y, &YtHY[j * m]));
+      for (i = 0; i < j; ++i) YtHY[j + i * m] = PetscConj(YtHY[i + j * m]);
+    }
+    lbfgs->nHY     = n;
+    lbfgs->stateHY = state;
+    for (j = 0; j < n; ++j) {
+      for (i = 0; i < n; ++i) C[i + j * m] = YtHY[i + j * m];
+    }
+  } else {
+    sigma = lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR ? lbfgs->sigma : 1.0;
+    for (j = 0; j < n; ++j) {
+      for (i = 0; i < n; ++i) C[i + j * m] = sigma * lbfgs->YtY[i + j * m];
+    }
+  }
+  for (i = 0; i < n; ++i) C[i + i * m] += lbfgs->StY[i + i * m];
+  lbfgs->needCinv = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Forms and factors the 2n x 2n middle matrix of the forward product */
+static PetscErrorCode MatLMVMBFGSCompactSetUpFwd_Private(Mat B)
+{
+  Mat_LMVM        *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn     *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt         m = lmvm->m, n = lmvm->k + 1, N = 2 * n, i, j;
+  PetscScalar     *K = lbfgs->Cfwd, *StY = lbfgs->StY, *StBS = lbfgs->StBS;
+  PetscReal        sigma;
+  PetscBLASInt     bN, info;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  if (lbfgs->needC) PetscCall(MatLMVMBFGSCompactUpdate_Private(B, PETSC_FALSE));
+  if (!lbfgs->needCfwd) PetscFunctionReturn(PETSC_SUCCESS);
+  if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL) {
+    /* only the columns of the updates added since B0 last changed are formed */
+    PetscCall(MatLMVMBFGSCompactGetJ0State_Private(B, &state));
+    if (state != lbfgs->stateBS) lbfgs->nBS = 0;
+    for (j = lbfgs->nBS; j < n; ++j) {
+      PetscCall(MatSymBrdnApplyJ0Fwd(B, lmvm->S[j], lbfgs->work));
+      PetscCall(VecMDot(lbfgs->work, j + 1, lmvm->S, &StBS[j * m]));
+      for (i = 0; i < j; ++i) StBS[j + i * m] = PetscConj(StBS[i + j * m]);
+    }
+    lbfgs->nBS     = n;
+    lbfgs->stateBS = state;
+    for (j = 0; j < n; ++j) {
+      for (i = 0; i < n; ++i) K[i + j * N] = StBS[i + j * m];
+    }
+  } else {
+    sigma = lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR ? lbfgs->sigma : 1.0;
+    for (j = 0; j < n; ++j) {
+      for (i = 0; i < n; ++i) K[i + j * N] = lbfgs->StS[i + j * m] / sigma;
+    }
+  }
+  for (j = 0; j < n; ++j) PetscCall(PetscArrayzero(&K[n + j * N], n));
+  PetscCall(PetscArrayzero(&K[n * N], n * N));
+  for (j = 0; j < n; ++j) {
+    for (i = j + 1; i < n; ++i) {
+      K[i + (n + j) * N] = StY[i + j * m];
+      K[n + j + i * N]   = PetscConj(StY[i + j * m]);
+    }
+    K[n + j + (n + j) * N] = -StY[j + j * m];
+  }
+  if (n) {
+    PetscCall(PetscBLASIntCast(N, &bN));
+    PetscCallBLAS("LAPACKgetrf", LAPACKgetrf_(&bN, &bN, K, &bN, lbfgs->cpiv, &info));
+    PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in GETRF Lapack routine %d", (int)info);
+  }
+  lbfgs->needCfwd = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  a <- S^T F, b <- Y^T H0 F
+  c <- R^{-1} a
+  p <- R^{-T} ((D + Y^T H0 Y) c - b)
+  dX <- H0 * (F - Y c) + S p
+
+  With H0 = sigma I, a and b come from one VecMDot() of F with [S Y] and
+  dX <- sigma F + [S Y] [p; -sigma c] is one VecMAXPY().
+*/
+static PetscErrorCode MatSolve_LMVMBFGS_Compact(Mat B, Vec F, Vec dX)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     m = lmvm->m, n = lmvm->k + 1, i, j;
+  PetscScalar *a = lbfgs->cwork, *b = lbfgs->cwork + n, *coef = lbfgs->cwork + 2 * n, *R = lbfgs->StY, *C = lbfgs->Cinv;
+  PetscReal    sigma = lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR ? lbfgs->sigma : 1.0;
+  PetscBool    diag  = (PetscBool)(lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL);
+
+  PetscFunctionBegin;
+  PetscCall(MatLMVMBFGSCompactSetUpInv_Private(B));
+  if (!n) {
+    PetscCall(MatSymBrdnApplyJ0Inv(B, F, dX));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (diag) {
+    PetscCall(MatSymBrdnApplyJ0Inv(B, F, dX));
+    PetscCall(VecMDot(F, n, lmvm->S, a));
+    PetscCall(VecMDot(dX, n, lmvm->Y, b));
+  } else {
+    PetscCall(MatLMVMBFGSCompactGetSY_Private(B));
+    PetscCall(VecMDot(F, 2 * n, lbfgs->SY, a));
+    for (i = 0; i < n; ++i) b[i] *= sigma;
+  }
+  for (i = n - 1; i >= 0; --i) {
+    for (j = i + 1; j < n; ++j) a[i] -= R[i + j * m] * a[j];
+    a[i] /= R[i + i * m];
+  }
+  for (i = 0; i < n; ++i) {
+    b[i] = -b[i];
+    for (j = 0; j < n; ++j) b[i] += C[i + j * m] * a[j];
+  }
+  for (i = 0; i < n; ++i) {
+    for (j = 0; j < i; ++j) b[i] -= PetscConj(R[j + i * m]) * b[j];
+    b[i] /= PetscConj(R[i + i * m]);
+  }
+  if (diag) {
+    for (i = 0; i < n; ++i) a[i] = -a[i];
+    PetscCall(VecCopy(F, lbfgs->work));
+    PetscCall(VecMAXPY(lbfgs->work, n, a, lmvm->Y));
+    PetscCall(MatSymBrdnApplyJ0Inv(B, lbfgs->work, dX));
+    PetscCall(VecMAXPY(dX, n, b, lmvm->S));
+  } else {
+    for (i = 0; i < n; ++i) {
+      coef[i]     = b[i];
+      coef[n + i] = -sigma * a[i];
+    }
+    PetscCall(VecAXPBY(dX, sigma, 0.0, F));
+    PetscCall(VecMAXPY(dX, 2 * n, coef, lbfgs->SY));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  [p; q] <- [S^T B0 S, L; L^T, -D]^{-1} [S^T B0 X; Y^T X]
+  Z <- B0 * (X - S p) - Y q
+
+  With B0 = I / sigma, the right hand side comes from one VecMDot() of X with
+  [S Y] and Z <- X / sigma - [S Y] [p / sigma; q] is one VecMAXPY().
+*/
+static PetscErrorCode MatMult_LMVMBFGS_Compact(Mat B, Vec X, Vec Z)
+{
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+  PetscInt     n = lmvm->k + 1, i;
+  PetscScalar *pq = lbfgs->cwork;
+  PetscReal    sigma = lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR ? lbfgs->sigma : 1.0;
+  PetscBool    diag  = (PetscBool)(lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL);
+  PetscBLASInt bN, one = 1, info;
+
+  PetscFunctionBegin;
+  PetscCall(MatLMVMBFGSCompactSetUpFwd_Private(B));
+  if (!n) {
+    PetscCall(MatSymBrdnApplyJ0Fwd(B, X, Z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (diag) {
+    PetscCall(MatSymBrdnApplyJ0Fwd(B, X, Z));
+    PetscCall(VecMDot(Z, n, lmvm->S, pq));
+    PetscCall(VecMDot(X, n, lmvm->Y, pq + n));
+  } else {
+    PetscCall(MatLMVMBFGSCompactGetSY_Private(B));
+    PetscCall(VecMDot(X, 2 * n, lbfgs->SY, pq));
+    for (i = 0; i < n; ++i) pq[i] /= sigma;
+  }
+  PetscCall(PetscBLASIntCast(2 * n, &bN));
+  PetscCallBLAS("LAPACKgetrs", LAPACKgetrs_("N", &bN, &one, lbfgs->Cfwd, &bN, lbfgs->cpiv, pq, &bN, &info));
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in GETRS Lapack routine %d", (int)info);
+  for (i = 0; i < 2 * n; ++i) pq[i] = -pq[i];
+  if (diag) {
+    PetscCall(VecCopy(X, lbfgs->work));
+    PetscCall(VecMAXPY(lbfgs->work, n, pq, lmvm->S));
+    PetscCall(MatSymBrdnApplyJ0Fwd(B, lbfgs->work, Z));
+    PetscCall(VecMAXPY(Z, n, pq + n, lmvm->Y));
+  } else {
+    for (i = 0; i < n; ++i) pq[i] /= sigma;
+    PetscCall(VecAXPBY(Z, 1.0 / sigma, 0.0, X));
+    PetscCall(VecMAXPY(Z, 2 * n, pq, lbfgs->SY));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*------------------------------------------------------------*/
+
 /*
   The solution method (approximate inverse Jacobian application) is adapted
    from Algorithm 7.4 on page 178 of Nocedal and Wright "Numerical Optimization"
@@ -38,10 +364,16 @@ PetscErrorCode MatSolve_LMVMBFGS(Mat B, Vec F, Vec dX)
   PetscInt     i;
   PetscReal   *alpha, beta;
   PetscScalar  stf, ytx;
+  PetscBool    compact;
 
   PetscFunctionBegin;
   VecCheckSameSize(F, 2, dX, 3);
   VecCheckMatCompatible(B, dX, 3, F, 2);
+  PetscCall(MatLMVMBFGSUseCompact_Private(B, &compact));
+  if (compact) {
+    PetscCall(MatSolve_LMVMBFGS_Compact(B, F, dX));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   /* Copy the function into the work vector for the first loop */
   PetscCall(VecCopy(F, lbfgs->work));
@@ -103,10 +435,16 @@ PetscErrorCode MatMult_LMVMBFGS(Mat B, Vec X, Vec Z)
   Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
   PetscInt     i, j;
   PetscScalar  sjtpi, yjtsi, ytx, stz, stp;
+  PetscBool    compact;
 
   PetscFunctionBegin;
   VecCheckSameSize(X, 2, Z, 3);
   VecCheckMatCompatible(B, X, 2, Z, 3);
+  PetscCall(MatLMVMBFGSUseCompact_Private(B, &compact));
+  if (compact) {
+    PetscCall(MatMult_LMVMBFGS_Compact(B, X, Z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   if (lbfgs->needP) {
     /* Pre-compute (P[i] = B_i * S[i]) */
@@ -150,6 +488,7 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
   PetscInt      old_k, i;
   PetscReal     curvtol, ststmp;
   PetscScalar   curvature, ytytmp;
+  PetscBool     compact;
 
   PetscFunctionBegin;
   if (!lmvm->m) PetscFunctionReturn(PETSC_SUCCESS);
@@ -182,6 +521,10 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
       lbfgs->yts[lmvm->k] = PetscRealPart(curvature);
       lbfgs->yty[lmvm->k] = PetscRealPart(ytytmp);
       lbfgs->sts[lmvm->k] = ststmp;
+      /* Update the inner products of the compact representation */
+      PetscCall(MatLMVMBFGSUseCompact_Private(B, &compact));
+      if (compact) PetscCall(MatLMVMBFGSCompactUpdate_Private(B, (PetscBool)(old_k == lmvm->k)));
+      else lbfgs->needC = PETSC_TRUE;
       /* Compute the scalar scale if necessary */
       if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR) PetscCall(MatSymBrdnComputeJ0Scalar(B));
     } else {
@@ -209,6 +552,8 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
 
   /* Update the scaling */
   if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL) PetscCall(MatLMVMUpdate(lbfgs->D, X, F));
+  lbfgs->needCfwd = PETSC_TRUE;
+  lbfgs->needCinv = PETSC_TRUE;
 
   if (lbfgs->watchdog > lbfgs->max_seq_rejects) {
     PetscCall(MatLMVMReset(B, PETSC_FALSE));
@@ -233,7 +578,11 @@ static PetscErrorCode MatCopy_LMVMBFGS(Mat B, Mat M, MatStructure str)
   PetscInt     i;
 
   PetscFunctionBegin;
-  mctx->needP = bctx->needP;
+  mctx->needP    = bctx->needP;
+  mctx->compact  = bctx->compact;
+  mctx->needC    = PETSC_TRUE;
+  mctx->needCfwd = PETSC_TRUE;
+  mctx->needCinv = PETSC_TRUE;
   for (i = 0; i <= bdata->k; ++i) {
     mctx->stp[i] = bctx->stp[i];
     mctx->yts[i] = bctx->yts[i];
@@ -275,10 +624,14 @@ static PetscErrorCode MatReset_LMVMBFGS(Mat B, PetscBool destructive)
   PetscFunctionBegin;
   lbfgs->watchdog = 0;
   lbfgs->needP    = PETSC_TRUE;
+  lbfgs->needCfwd = PETSC_TRUE;
+  lbfgs->needCinv = PETSC_TRUE;
   if (lbfgs->allocated) {
     if (destructive) {
       PetscCall(VecDestroy(&lbfgs->work));
       PetscCall(PetscFree5(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts, lbfgs->workscalar));
+      PetscCall(PetscFree7(lbfgs->StY, lbfgs->YtY, lbfgs->StS, lbfgs->Cinv, lbfgs->Cfwd, lbfgs->cwork, lbfgs->cpiv));
+      PetscCall(PetscFree3(lbfgs->YtHY, lbfgs->StBS, lbfgs->SY));
       PetscCall(VecDestroyVecs(lmvm->m, &lbfgs->P));
       switch (lbfgs->scale_type) {
       case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -323,6 +676,9 @@ static PetscErrorCode MatAllocate_LMVMBFGS(Mat B, Vec X, Vec F)
   if (!lbfgs->allocated) {
     PetscCall(VecDuplicate(X, &lbfgs->work));
     PetscCall(PetscMalloc5(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts, lmvm->m, &lbfgs->workscalar));
+    PetscCall(PetscMalloc7(lmvm->m * lmvm->m, &lbfgs->StY, lmvm->m * lmvm->m, &lbfgs->YtY, lmvm->m * lmvm->m, &lbfgs->StS, lmvm->m * lmvm->m, &lbfgs->Cinv, 4 * lmvm->m * lmvm->m, &lbfgs->Cfwd, 4 * lmvm->m, &lbfgs->cwork, 2 * lmvm->m, &lbfgs->cpiv));
+    PetscCall(PetscMalloc3(lmvm->m * lmvm->m, &lbfgs->YtHY, lmvm->m * lmvm->m, &lbfgs->StBS, 2 * lmvm->m, &lbfgs->SY));
+    lbfgs->needC = PETSC_TRUE;
     if (lmvm->m > 0) PetscCall(VecDuplicateVecs(X, lmvm->m, &lbfgs->P));
     switch (lbfgs->scale_type) {
     case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -347,6 +703,8 @@ static PetscErrorCode MatDestroy_LMVMBFGS(Mat B)
   if (lbfgs->allocated) {
     PetscCall(VecDestroy(&lbfgs->work));
     PetscCall(PetscFree5(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts, lbfgs->workscalar));
+    PetscCall(PetscFree7(lbfgs->StY, lbfgs->YtY, lbfgs->StS, lbfgs->Cinv, lbfgs->Cfwd, lbfgs->cwork, lbfgs->cpiv));
+    PetscCall(PetscFree3(lbfgs->YtHY, lbfgs->StBS, lbfgs->SY));
     PetscCall(VecDestroyVecs(lmvm->m, &lbfgs->P));
     lbfgs->allocated = PETSC_FALSE;
   }
@@ -370,6 +728,9 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
   if (!lbfgs->allocated) {
     PetscCall(VecDuplicate(lmvm->Xprev, &lbfgs->work));
     PetscCall(PetscMalloc5(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts, lmvm->m, &lbfgs->workscalar));
+    PetscCall(PetscMalloc7(lmvm->m * lmvm->m, &lbfgs->StY, lmvm->m * lmvm->m, &lbfgs->YtY, lmvm->m * lmvm->m, &lbfgs->StS, lmvm->m * lmvm->m, &lbfgs->Cinv, 4 * lmvm->m * lmvm->m, &lbfgs->Cfwd, 4 * lmvm->m, &lbfgs->cwork, 2 * lmvm->m, &lbfgs->cpiv));
+    PetscCall(PetscMalloc3(lmvm->m * lmvm->m, &lbfgs->YtHY, lmvm->m * lmvm->m, &lbfgs->StBS, 2 * lmvm->m, &lbfgs->SY));
+    lbfgs->needC = PETSC_TRUE;
     if (lmvm->m > 0) PetscCall(VecDuplicateVecs(lmvm->Xprev, lmvm->m, &lbfgs->P));
     switch (lbfgs->scale_type) {
     case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -390,11 +751,18 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
 
 static PetscErrorCode MatSetFromOptions_LMVMBFGS(Mat B, PetscOptionItems *PetscOptionsObject)
 {
+  Mat_LMVM    *lmvm  = (Mat_LMVM *)B->data;
+  Mat_SymBrdn *lbfgs = (Mat_SymBrdn *)lmvm->ctx;
+
   PetscFunctionBegin;
   PetscCall(MatSetFromOptions_LMVM(B, PetscOptionsObject));
   PetscOptionsHeadBegin(PetscOptionsObject, "L-BFGS method for approximating SPD Jacobian actions (MATLMVMBFGS)");
   PetscCall(MatSetFromOptions_LMVMSymBrdn_Private(B, PetscOptionsObject));
+  PetscCall(PetscOptionsBool("-mat_lmvm_compact", "(developer) apply the matrix and its inverse with the compact representation", "", lbfgs->compact, &lbfgs->compact, NULL));
   PetscOptionsHeadEnd();
+  lbfgs->needC    = PETSC_TRUE;
+  lbfgs->needCfwd = PETSC_TRUE;
+  lbfgs->needCinv = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -420,9 +788,10 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
   lmvm->ops->mult     = MatMult_LMVMBFGS;
   lmvm->ops->copy     = MatCopy_LMVMBFGS;
 
-  lbfgs        = (Mat_SymBrdn *)lmvm->ctx;
-  lbfgs->needQ = PETSC_FALSE;
-  lbfgs->phi   = 0.0;
+  lbfgs          = (Mat_SymBrdn *)lmvm->ctx;
+  lbfgs->needQ   = PETSC_FALSE;
+  lbfgs->phi     = 0.0;
+  lbfgs->compact = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -455,14 +824,19 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
 .   -mat_lmvm_rho - (developer) update limiter for the J0 scaling
 .   -mat_lmvm_alpha - (developer) coefficient factor for the quadratic subproblem in J0 scaling
 .   -mat_lmvm_beta - (developer) exponential factor for the diagonal J0 scaling
--   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+.   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+-   -mat_lmvm_compact - (developer) apply the matrix and its inverse with the compact representation (default true)
 
    Level: intermediate
 
-   Note:
+   Notes:
    It is recommended that one use the `MatCreate()`, `MatSetType()` and/or `MatSetFromOptions()`
    paradigm instead of this routine directly.
 
+   Unless J0 is provided by the user, the product and the inverse application use the compact representation of
+   Byrd, Nocedal and Schnabel, which updates small dense factors with each accepted update and touches the stored
+   updates with one `VecMDot()` and one `VecMAXPY()` on each of S and Y per application, instead of the recursive formulas.
+
 .seealso: [](chapter_ksp), `MatCreate()`, `MATLMVM`, `MATLMVMBFGS`, `MatCreateLMVMDFP()`, `MatCreateLMVMSR1()`,
           `MatCreateLMVMBrdn()`, `MatCreateLMVMBadBrdn()`, `MatCreateLMVMSymBrdn()`
 @*/
@@ -19,6 +19,18 @@ typedef struct {
   PetscInt                   sigma_hist; /* length of update history to be used for scaling */
   MatLMVMSymBroydenScaleType scale_type;
   PetscInt                   watchdog, max_seq_rejects; /* tracker to reset after a certain # of consecutive rejects */
+
+  /* Compact (Byrd-Nocedal-Schnabel) representation, only used by MATLMVMBFGS */
+  PetscBool                  compact;                   /* apply the matrix and its inverse with the compact representation */
+  PetscBool                  needC, needCfwd, needCinv; /* the inner products, the forward or the inverse dense factors are out of date */
+  PetscScalar               *StY, *YtY, *StS;          /* m x m inner products of the stored updates, column major */
+  PetscScalar               *YtHY, *StBS;              /* m x m products Y^T H0 Y and S^T B0 S with the diagonal J0 */
+  PetscInt                   nHY, nBS;                  /* number of leading updates for which YtHY and StBS are current */
+  PetscObjectState           stateHY, stateBS;          /* state of the diagonal J0 that YtHY and StBS were computed with */
+  Vec                       *SY;                        /* S[0..k] followed by Y[0..k], for products that read both at once */
+  PetscScalar               *Cinv, *Cfwd;              /* dense factors of the inverse (m x m) and of the forward product (2m x 2m) */
+  PetscScalar               *cwork;                    /* work array of length 4m */
+  PetscBLASInt              *cpiv;                     /* pivots of the LU factorization in Cfwd */
 } Mat_SymBrdn;
 
 PETSC_INTERN PetscErrorCode MatSymBrdnApplyJ0Fwd(Mat, Vec, Vec);
@@ -0,0 +1,249 @@
+/*
+   Defines a temporally blocked damped Jacobi preconditioner for MATSTENCIL matrices
+*/
+#include <petsc/private/pcimpl.h> /*I "petscpc.h" I*/
+#include <petscdmda.h>
+
+typedef struct {
+  PetscInt  its;   /* number of sweeps in each application */
+  PetscInt  depth; /* number of sweeps between two ghost exchanges */
+  PetscInt  tile;  /* number of grid lines in a tile for 3D grids */
+  PetscReal omega;
+} PC_TBJacobi;
+
+static PetscErrorCode PCDestroy_TBJacobi(PC pc)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetOmega_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetIterations_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetBlocking_C", NULL));
+  PetscCall(PetscFree(pc->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_TBJacobi(PC pc)
+{
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)pc->pmat, MATSTENCIL, &flg));
+  PetscCheck(flg, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Requires a %s matrix, not %s, use -dm_mat_type %s", MATSTENCIL, ((PetscObject)pc->pmat)->type_name, MATSTENCIL);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_TBJacobi(PC pc, Vec x, Vec y)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatStencilJacobi(pc->pmat, x, jac->omega, jac->its, jac->depth, jac->tile, PETSC_TRUE, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyRichardson_TBJacobi(PC pc, Vec b, Vec y, Vec w, PetscReal rtol, PetscReal abstol, PetscReal dtol, PetscInt its, PetscBool guesszero, PetscInt *outits, PCRichardsonConvergedReason *reason)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscInfo(pc, "Warning, convergence criteria ignored, using %" PetscInt_FMT " iterations\n", its));
+  PetscCall(MatStencilJacobi(pc->pmat, b, jac->omega, its * jac->its, jac->depth, jac->tile, guesszero, y));
+  *outits = its;
+  *reason = PCRICHARDSON_CONVERGED_ITS;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_TBJacobi(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+  PetscReal    omega;
+  PetscInt     depth, tile;
+  PetscBool    flg, flg2;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Temporally blocked Jacobi options");
+  PetscCall(PetscOptionsReal("-pc_tbjacobi_omega", "damping factor", "PCTBJacobiSetOmega", jac->omega, &omega, &flg));
+  if (flg) PetscCall(PCTBJacobiSetOmega(pc, omega));
+  PetscCall(PetscOptionsInt("-pc_tbjacobi_its", "number of sweeps", "PCTBJacobiSetIterations", jac->its, &jac->its, NULL));
+  depth = jac->depth;
+  tile  = jac->tile;
+  PetscCall(PetscOptionsInt("-pc_tbjacobi_depth", "number of sweeps between two ghost exchanges", "PCTBJacobiSetBlocking", depth, &depth, &flg));
+  PetscCall(PetscOptionsInt("-pc_tbjacobi_tile", "number of grid lines in a tile for 3D grids", "PCTBJacobiSetBlocking", tile, &tile, &flg2));
+  if (flg || flg2) PetscCall(PCTBJacobiSetBlocking(pc, depth, tile));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCView_TBJacobi(PC pc, PetscViewer viewer)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+  PetscBool    iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  iterations = %" PetscInt_FMT ", omega = %g\n", jac->its, (double)jac->omega));
+    if (jac->depth > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  sweeps between ghost exchanges = %" PetscInt_FMT "\n", jac->depth));
+    else PetscCall(PetscViewerASCIIPrintf(viewer, "  sweeps between ghost exchanges = largest allowed by the partition\n"));
+    if (jac->tile > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  grid lines per tile = %" PetscInt_FMT "\n", jac->tile));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCTBJacobiSetOmega_TBJacobi(PC pc, PetscReal omega)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCheck(omega > 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Damping factor must be positive");
+  jac->omega = omega;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCTBJacobiSetIterations_TBJacobi(PC pc, PetscInt its)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCheck(its > 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps %" PetscInt_FMT " must be positive", its);
+  jac->its = its;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCTBJacobiSetBlocking_TBJacobi(PC pc, PetscInt depth, PetscInt tile)
+{
+  PC_TBJacobi *jac = (PC_TBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  jac->depth = depth;
+  jac->tile  = tile;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PCTBJacobiSetOmega - Sets the damping factor of the `PCTBJACOBI` sweeps
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+-  omega - the damping factor, 1.0 by default
+
+   Options Database Key:
+.  -pc_tbjacobi_omega <omega> - Sets omega
+
+   Level: intermediate
+
+.seealso: `PCTBJACOBI`, `PCTBJacobiSetIterations()`, `PCTBJacobiSetBlocking()`
+@*/
+PetscErrorCode PCTBJacobiSetOmega(PC pc, PetscReal omega)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(pc, omega, 2);
+  PetscTryMethod(pc, "PCTBJacobiSetOmega_C", (PC, PetscReal), (pc, omega));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PCTBJacobiSetIterations - Sets the number of sweeps in each application of `PCTBJACOBI`
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+-  its - the number of sweeps, 1 by default
+
+   Options Database Key:
+.  -pc_tbjacobi_its <its> - Sets the number of sweeps
+
+   Level: intermediate
+
+   Note:
+   With `KSPRICHARDSON` the preconditioner performs all the sweeps of the Richardson iterations at once.
+
+.seealso: `PCTBJACOBI`, `PCTBJacobiSetOmega()`, `PCTBJacobiSetBlocking()`
+@*/
+PetscErrorCode PCTBJacobiSetIterations(PC pc, PetscInt its)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, its, 2);
+  PetscTryMethod(pc, "PCTBJacobiSetIterations_C", (PC, PetscInt), (pc, its));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PCTBJacobiSetBlocking - Sets how many sweeps of `PCTBJACOBI` are fused between two ghost exchanges
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+.  depth - the number of fused sweeps, or `PETSC_DETERMINE` for as many as the partition allows
+-  tile - the number of grid lines in a tile for 3D grids, or `PETSC_DETERMINE` for a single tile
+
+   Options Database Keys:
++  -pc_tbjacobi_depth <depth> - Sets the number of fused sweeps
+-  -pc_tbjacobi_tile <tile> - Sets the number of grid lines in a tile
+
+   Level: advanced
+
+.seealso: `PCTBJACOBI`, `MatStencilJacobi()`, `PCTBJacobiSetOmega()`, `PCTBJacobiSetIterations()`
+@*/
+PetscErrorCode PCTBJacobiSetBlocking(PC pc, PetscInt depth, PetscInt tile)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, depth, 2);
+  PetscValidLogicalCollectiveInt(pc, tile, 3);
+  PetscTryMethod(pc, "PCTBJacobiSetBlocking_C", (PC, PetscInt, PetscInt), (pc, depth, tile));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+     PCTBJACOBI - Temporally blocked damped Jacobi preconditioning for `MATSTENCIL` matrices
+
+   Options Database Keys:
++  -pc_tbjacobi_omega <omega> - Sets the damping factor (default 1.0)
+.  -pc_tbjacobi_its <its> - Sets the number of sweeps (default 1)
+.  -pc_tbjacobi_depth <depth> - Sets the number of sweeps fused between two ghost exchanges (default as many as possible)
+-  -pc_tbjacobi_tile <tile> - Sets the number of grid lines in a tile for 3D grids (default a single tile)
+
+   Level: intermediate
+
+   Notes:
+   Applies the sweeps x <- x + omega D^{-1} (b - A x) with `MatStencilJacobi()`, which exchanges the ghost values through a
+   halo deep enough for several sweeps and performs them in one pass over the grid. The result is the same as
+   `PCJACOBI` with `KSPRICHARDSON`, but with fewer messages and less memory traffic, which is mostly of interest for
+   smoothers of `PCMG` on structured grids.
+
+   If used with `KSPRICHARDSON` and no monitors the convergence test is skipped, all the sweeps are fused.
+
+.seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCJACOBI`, `PCSOR`, `MATSTENCIL`, `MatStencilJacobi()`,
+          `PCTBJacobiSetOmega()`, `PCTBJacobiSetIterations()`, `PCTBJacobiSetBlocking()`
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_TBJacobi(PC pc)
+{
+  PC_TBJacobi *jac;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&jac));
+
+  pc->ops->apply           = PCApply_TBJacobi;
+  pc->ops->applyrichardson = PCApplyRichardson_TBJacobi;
+  pc->ops->setfromoptions  = PCSetFromOptions_TBJacobi;
+  pc->ops->setup           = PCSetUp_TBJacobi;
+  pc->ops->view            = PCView_TBJacobi;
+  pc->ops->destroy         = PCDestroy_TBJacobi;
+  pc->data                 = (void *)jac;
+  jac->omega               = 1.0;
+  jac->its                 = 1;
+  jac->depth               = PETSC_DETERMINE;
+  jac->tile                = PETSC_DETERMINE;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetOmega_C", PCTBJacobiSetOmega_TBJacobi));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetIterations_C", PCTBJacobiSetIterations_TBJacobi));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCTBJacobiSetBlocking_C", PCTBJacobiSetBlocking_TBJacobi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -71,6 +71,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_HPDDM(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_H2OPUS(PC);
 #endif
 PETSC_EXTERN PetscErrorCode PCCreate_MPI(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_TBJacobi(PC);
 
 /*@C
    PCRegisterAll - Registers all of the preconditioners in the PC package.
@@ -162,5 +163,6 @@ PetscErrorCode PCRegisterAll(void)
   PetscCall(PCRegister(PCH2OPUS, PCCreate_H2OPUS));
 #endif
   PetscCall(PCRegister(PCMPI, PCCreate_MPI));
+  PetscCall(PCRegister(PCTBJACOBI, PCCreate_TBJacobi));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -218,10 +218,23 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
   if (vscale) PetscCall(VecGetArray(vscale, &vscale_array));
   nz = 0;
 
-  if (coloring->bcols > 1) { /* use blocked insertion of Jentry */
+  if (coloring->bcols > 1 || coloring->fbatch) { /* use blocked insertion of Jentry, also for a batch function with one color per call */
     PetscInt     i, m = J->rmap->n, nbcols, bcols = coloring->bcols;
     PetscScalar *dy = coloring->dy, *dy_k;
 
+    if (coloring->fbatch && !coloring->w3b) { /* work vectors holding the perturbed states and function values of a block of colors */
+      PetscMPIInt size;
+
+      PetscCall(VecDuplicateVecs(x1, bcols, &coloring->w3b));
+      PetscCall(PetscMalloc1(bcols, &coloring->w2b));
+      PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)w2), &size));
+      for (i = 0; i < bcols; i++) {
+        if (size > 1) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)w2), 1, m, PETSC_DETERMINE, NULL, &coloring->w2b[i]));
+        else PetscCall(VecCreateSeqWithArray(PETSC_COMM_SELF, 1, m, NULL, &coloring->w2b[i]));
+      }
+      coloring->nbatch = bcols;
+    }
+
     nbcols = 0;
     for (k = 0; k < ncolors; k += bcols) {
       /*
@@ -234,6 +247,7 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
       for (i = 0; i < bcols; i++) {
         coloring->currentcolor = k + i;
 
+        if (coloring->fbatch) w3 = coloring->w3b[i];
         PetscCall(VecCopy(x1, w3));
         PetscCall(VecGetArray(w3, &w3_array));
         if (ctype == IS_COLORING_GLOBAL) w3_array -= cstart; /* shift pointer so global index can be used */
@@ -252,6 +266,7 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
         }
         if (ctype == IS_COLORING_GLOBAL) w3_array += cstart;
         PetscCall(VecRestoreArray(w3, &w3_array));
+        if (coloring->fbatch) continue;
 
         /*
          (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
@@ -265,6 +280,18 @@ PetscErrorCode MatFDColoringApply_AIJ(Mat J, MatFDColoring coloring, Vec x1, voi
         PetscCall(VecResetArray(w2));
         dy_k += m; /* points to dy+i*nxloc */
       }
+      if (coloring->fbatch) {
+        /* (3-2) Evaluate the function at all the perturbed states of the block with one call */
+        coloring->currentcolor = k;
+        for (i = 0; i < bcols; i++) PetscCall(VecPlaceArray(coloring->w2b[i], dy + i * m));
+        PetscCall(PetscLogEventBegin(MAT_FDColoringFunction, 0, 0, 0, 0));
+        PetscCall((*coloring->fbatch)(sctx, bcols, coloring->w3b, coloring->w2b, coloring->fbatchctx));
+        PetscCall(PetscLogEventEnd(MAT_FDColoringFunction, 0, 0, 0, 0));
+        for (i = 0; i < bcols; i++) {
+          PetscCall(VecAXPY(coloring->w2b[i], -1.0, w1));
+          PetscCall(VecResetArray(coloring->w2b[i]));
+        }
+      }
 
       /*
        (3-3) Loop over block rows of vector, putting results into Jacobian matrix
@@ -607,7 +634,7 @@ PetscErrorCode MatFDColoringSetUp_MPIXAIJ(Mat mat, ISColoring iscoloring, MatFDC
   }
   if (ctype == IS_COLORING_GLOBAL) PetscCall(PetscFree2(ncolsonproc, disp));
 
-  if (bcols > 1) { /* reorder Jentry for faster MatFDColoringApply() */
+  if (bcols > 1 || (c->fbatch && !isBAIJ)) { /* reorder Jentry for faster MatFDColoringApply(), the batch function always uses the blocked path */
     PetscCall(MatFDColoringSetUpBlocked_AIJ_Private(mat, c, nz));
   }
 
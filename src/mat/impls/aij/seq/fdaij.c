@@ -278,7 +278,7 @@ PetscErrorCode MatFDColoringSetUp_SeqXAIJ(Mat mat, ISColoring iscoloring, MatFDC
     }
   }
 
-  if (c->bcols > 1) { /* reorder Jentry for faster MatFDColoringApply() */
+  if (c->bcols > 1 || (c->fbatch && !isBAIJ)) { /* reorder Jentry for faster MatFDColoringApply(), the batch function always uses the blocked path */
     PetscCall(MatFDColoringSetUpBlocked_AIJ_Private(mat, c, nz));
   }
 
@@ -115,6 +115,7 @@ PetscErrorCode MatFDColoringView(MatFDColoring c, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Error tolerance=%g\n", (double)c->error_rel));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Umin=%g\n", (double)c->umin));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  Number of colors=%" PetscInt_FMT "\n", c->ncolors));
+    if (c->fbatch) PetscCall(PetscViewerASCIIPrintf(viewer, "  Function evaluated on batches of up to %" PetscInt_FMT " colors\n", c->bcols));
 
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO) {
@@ -231,6 +232,15 @@ PetscErrorCode MatFDColoringSetUp(Mat mat, ISColoring iscoloring, MatFDColoring
   PetscCheck(eq, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONG, "Matrix used with MatFDColoringSetUp() must be that used with MatFDColoringCreate()");
 
   PetscCall(PetscLogEventBegin(MAT_FDColoringSetUp, mat, 0, 0, 0));
+  /* the batched function is collective so every process must use the same number of colors per batch, processes without rows have
+     bcols = 1 from MatFDColoringCreate() and must not limit the others */
+  if (color->fbatch) {
+    PetscInt bcols = color->m ? color->bcols : PETSC_MAX_INT;
+
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &bcols, 1, MPIU_INT, MPI_MIN, PetscObjectComm((PetscObject)color)));
+    color->bcols = PetscMax(1, PetscMin(bcols, color->ncolors));
+    if (color->bcols == 1 && color->ncolors > 1) PetscCall(PetscInfo(color, "The batch function is called with one color at a time, use MatFDColoringSetBlockSize() to evaluate more colors per call\n"));
+  }
   PetscUseTypeMethod(mat, fdcoloringsetup, iscoloring, color);
 
   color->setupcalled = PETSC_TRUE;
@@ -288,7 +298,7 @@ PetscErrorCode MatFDColoringGetFunction(MatFDColoring matfd, PetscErrorCode (**f
     In Fortran you must call `MatFDColoringSetFunction()` for a coloring object to
   be used without `SNES` or within the `SNES` solvers.
 
-.seealso: `Mat`, `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringGetFunction()`, `MatFDColoringSetFromOptions()`
+.seealso: `Mat`, `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringGetFunction()`, `MatFDColoringSetFromOptions()`, `MatFDColoringSetBatchFunction()`
 @*/
 PetscErrorCode MatFDColoringSetFunction(MatFDColoring matfd, PetscErrorCode (*f)(void), void *fctx)
 {
@@ -299,6 +309,52 @@ PetscErrorCode MatFDColoringSetFunction(MatFDColoring matfd, PetscErrorCode (*f)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   MatFDColoringSetBatchFunction - Sets a function that evaluates the function used for computing the Jacobian
+   at several perturbed states with one call.
+
+   Logically Collective
+
+   Input Parameters:
++  coloring - the coloring context
+.  f - the function
+-  fctx - the optional user-defined function context
+
+   Calling sequence of (*f) function:
+$    PetscErrorCode f(void *sctx, PetscInt nvec, Vec X[], Vec F[], void *fctx)
++  sctx - the `SNES` (or the dummy context passed to `MatFDColoringApply()`)
+.  nvec - the number of states to evaluate, at most the number of block columns set with `MatFDColoringSetBlockSize()`
+.  X - the perturbed states
+.  F - vectors to hold the function values at the states in `X`
+-  fctx - the optional user-defined function context
+
+   Level: advanced
+
+   Notes:
+   With the `MATAIJ` and `MATSELL` formats the perturbed states of a block of colors (see `MatFDColoringSetBlockSize()`) are
+   formed together and passed to `f` in one call, instead of calling the function set with `MatFDColoringSetFunction()` once per color.
+   This allows the application to exchange the ghost values of all the states at once, for example by packing them into a single
+   vector with `nvec` degrees of freedom per point, and to amortize any other per call overhead.
+
+   The function set with `MatFDColoringSetFunction()` is still used to evaluate the unperturbed function and by the other matrix formats.
+
+   During the call `MatFDColoringGetPerturbedColumns()` returns the columns of the first color of the batch, `X[i]` is perturbed in the
+   columns of the color following it by `i`.
+
+   This must be called before `MatFDColoringSetUp()`, which makes the number of colors per batch the same on all processes.
+
+.seealso: `Mat`, `MatFDColoring`, `MatFDColoringCreate()`, `MatFDColoringSetFunction()`, `MatFDColoringSetBlockSize()`, `MatFDColoringApply()`
+@*/
+PetscErrorCode MatFDColoringSetBatchFunction(MatFDColoring matfd, PetscErrorCode (*f)(void *, PetscInt, Vec[], Vec[], void *), void *fctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(matfd, MAT_FDCOLORING_CLASSID, 1);
+  PetscCheck(!matfd->setupcalled, PetscObjectComm((PetscObject)matfd), PETSC_ERR_ARG_WRONGSTATE, "Must call MatFDColoringSetBatchFunction() before MatFDColoringSetUp()");
+  matfd->fbatch    = f;
+  matfd->fbatchctx = fctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    MatFDColoringSetFromOptions - Sets coloring finite difference parameters from
    the options database.
@@ -513,6 +569,8 @@ PetscErrorCode MatFDColoringDestroy(MatFDColoring *c)
   PetscCall(VecDestroy(&color->w1));
   PetscCall(VecDestroy(&color->w2));
   PetscCall(VecDestroy(&color->w3));
+  PetscCall(VecDestroyVecs(color->nbatch, &color->w2b));
+  PetscCall(VecDestroyVecs(color->nbatch, &color->w3b));
   PetscCall(PetscHeaderDestroy(c));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
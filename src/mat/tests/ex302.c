@@ -0,0 +1,174 @@
+static char help[] = "Tests MatFDColoringSetBatchFunction() on a DMDA discretization of the Bratu problem.\n\
+The batched function exchanges the ghost values of all the perturbed states with one scatter.\n\n";
+
+#include <petscdm.h>
+#include <petscdmda.h>
+
+typedef struct {
+  DM        da, dak; /* the DMDA of the problem and a compatible one with one degree of freedom per state of a batch */
+  PetscReal lambda;
+  PetscInt  ncalls, nstates;
+} AppCtx;
+
+static inline PetscScalar Bratu(PetscInt mx, PetscInt my, PetscReal lambda, PetscScalar uc, PetscScalar ue, PetscScalar uw, PetscScalar un, PetscScalar us)
+{
+  PetscReal hx = 1.0 / (mx - 1), hy = 1.0 / (my - 1);
+
+  return (2.0 * uc - uw - ue) * hy / hx + (2.0 * uc - un - us) * hx / hy - hx * hy * lambda * PetscExpScalar(uc);
+}
+
+static PetscErrorCode FormFunction(void *dummy, Vec X, Vec F, void *ctx)
+{
+  AppCtx       *user = (AppCtx *)ctx;
+  Vec           localX;
+  PetscScalar **x, **f;
+  PetscInt      i, j, xs, ys, xm, ym, mx, my;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMDAGetInfo(user->da, NULL, &mx, &my, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(user->da, &xs, &ys, NULL, &xm, &ym, NULL));
+  PetscCall(DMGetLocalVector(user->da, &localX));
+  PetscCall(DMGlobalToLocal(user->da, X, INSERT_VALUES, localX));
+  PetscCall(DMDAVecGetArrayRead(user->da, localX, &x));
+  PetscCall(DMDAVecGetArray(user->da, F, &f));
+  for (j = ys; j < ys + ym; j++) {
+    for (i = xs; i < xs + xm; i++) {
+      if (i == 0 || j == 0 || i == mx - 1 || j == my - 1) f[j][i] = x[j][i];
+      else f[j][i] = Bratu(mx, my, user->lambda, x[j][i], x[j][i + 1], x[j][i - 1], x[j + 1][i], x[j - 1][i]);
+    }
+  }
+  PetscCall(DMDAVecRestoreArray(user->da, F, &f));
+  PetscCall(DMDAVecRestoreArrayRead(user->da, localX, &x));
+  PetscCall(DMRestoreLocalVector(user->da, &localX));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Packs the states into one vector of dak so their ghost values are exchanged together */
+static PetscErrorCode FormFunctionBatch(void *dummy, PetscInt nvec, Vec X[], Vec F[], void *ctx)
+{
+  AppCtx        *user = (AppCtx *)ctx;
+  Vec            packed, localX;
+  PetscScalar ***xk, ***xl, **x, **f;
+  PetscInt       i, j, v, xs, ys, xm, ym, mx, my;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMDAGetInfo(user->da, NULL, &mx, &my, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCall(DMDAGetCorners(user->da, &xs, &ys, NULL, &xm, &ym, NULL));
+  PetscCall(DMGetGlobalVector(user->dak, &packed));
+  PetscCall(VecZeroEntries(packed));
+  PetscCall(DMDAVecGetArrayDOF(user->dak, packed, &xk));
+  for (v = 0; v < nvec; v++) {
+    PetscCall(DMDAVecGetArrayRead(user->da, X[v], &x));
+    for (j = ys; j < ys + ym; j++) {
+      for (i = xs; i < xs + xm; i++) xk[j][i][v] = x[j][i];
+    }
+    PetscCall(DMDAVecRestoreArrayRead(user->da, X[v], &x));
+  }
+  PetscCall(DMDAVecRestoreArrayDOF(user->dak, packed, &xk));
+  PetscCall(DMGetLocalVector(user->dak, &localX));
+  PetscCall(DMGlobalToLocal(user->dak, packed, INSERT_VALUES, localX));
+  PetscCall(DMRestoreGlobalVector(user->dak, &packed));
+  PetscCall(DMDAVecGetArrayDOFRead(user->dak, localX, &xl));
+  for (v = 0; v < nvec; v++) {
+    PetscCall(DMDAVecGetArray(user->da, F[v], &f));
+    for (j = ys; j < ys + ym; j++) {
+      for (i = xs; i < xs + xm; i++) {
+        if (i == 0 || j == 0 || i == mx - 1 || j == my - 1) f[j][i] = xl[j][i][v];
+        else f[j][i] = Bratu(mx, my, user->lambda, xl[j][i][v], xl[j][i + 1][v], xl[j][i - 1][v], xl[j + 1][i][v], xl[j - 1][i][v]);
+      }
+    }
+    PetscCall(DMDAVecRestoreArray(user->da, F[v], &f));
+  }
+  PetscCall(DMDAVecRestoreArrayDOFRead(user->dak, localX, &xl));
+  PetscCall(DMRestoreLocalVector(user->dak, &localX));
+  user->ncalls++;
+  user->nstates += nvec;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  AppCtx        user;
+  Mat           A, B;
+  Vec           x;
+  ISColoring    iscoloring;
+  MatFDColoring fd, fdbatch;
+  PetscInt      k = 4, ncolors;
+  PetscRandom   rand;
+  PetscReal     norm, diff;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.lambda  = 6.0;
+  user.ncalls  = 0;
+  user.nstates = 0;
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-k", &k, NULL));
+  PetscCall(DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_STAR, 8, 8, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &user.da));
+  PetscCall(DMSetFromOptions(user.da));
+  PetscCall(DMSetUp(user.da));
+  PetscCall(DMDACreateCompatibleDMDA(user.da, k, &user.dak));
+  PetscCall(DMCreateMatrix(user.da, &A));
+  PetscCall(DMCreateMatrix(user.da, &B));
+  PetscCall(DMCreateColoring(user.da, IS_COLORING_GLOBAL, &iscoloring));
+
+  /* one function evaluation per color */
+  PetscCall(MatFDColoringCreate(A, iscoloring, &fd));
+  PetscCall(MatFDColoringSetFunction(fd, (PetscErrorCode(*)(void))FormFunction, &user));
+  PetscCall(MatFDColoringSetFromOptions(fd));
+  PetscCall(MatFDColoringSetUp(A, iscoloring, fd));
+
+  /* k colors per function evaluation */
+  PetscCall(MatFDColoringCreate(B, iscoloring, &fdbatch));
+  PetscCall(MatFDColoringSetFunction(fdbatch, (PetscErrorCode(*)(void))FormFunction, &user));
+  PetscCall(MatFDColoringSetBatchFunction(fdbatch, FormFunctionBatch, &user));
+  PetscCall(MatFDColoringSetBlockSize(fdbatch, PETSC_DEFAULT, k));
+  PetscCall(MatFDColoringSetFromOptions(fdbatch));
+  PetscCall(MatFDColoringSetUp(B, iscoloring, fdbatch));
+
+  PetscCall(DMCreateGlobalVector(user.da, &x));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(PetscRandomSetInterval(rand, -1.0, 1.0));
+  PetscCall(VecSetRandom(x, rand));
+  PetscCall(MatFDColoringApply(A, fd, x, NULL));
+  PetscCall(MatFDColoringApply(B, fdbatch, x, NULL));
+
+  PetscCall(MatNorm(A, NORM_FROBENIUS, &norm));
+  PetscCall(MatAXPY(B, -1.0, A, SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(B, NORM_FROBENIUS, &diff));
+  PetscCall(ISColoringGetColors(iscoloring, NULL, &ncolors, NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " colors evaluated in %" PetscInt_FMT " batched calls\n", user.nstates, user.ncalls));
+  if (diff < 1e-12 * norm) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference of the Jacobians: < 1e-12\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference of the Jacobians: %g\n", (double)(diff / norm)));
+  PetscCheck(user.nstates == ncolors, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Number of states evaluated %" PetscInt_FMT " does not match the number of colors %" PetscInt_FMT, user.nstates, ncolors);
+
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatFDColoringDestroy(&fd));
+  PetscCall(MatFDColoringDestroy(&fdbatch));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(DMDestroy(&user.dak));
+  PetscCall(DMDestroy(&user.da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2 3}}
+      args: -mat_fd_type {{wp ds}}
+      output_file: output/ex302_1.out
+
+   test:
+      suffix: 2
+      args: -k 2 -mat_fd_coloring_view ::ascii_info
+
+   test:
+      suffix: 3
+      nsize: {{1 2}}
+      args: -k 1 -mat_fd_type {{wp ds}}
+      output_file: output/ex302_3.out
+
+TEST*/
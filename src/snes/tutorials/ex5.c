@@ -5,7 +5,8 @@ The command line options include:\n\
   -par <parameter>, where <parameter> indicates the problem's nonlinearity\n\
      problem SFI:  <parameter> = Bratu parameter (0 <= par <= 6.81)\n\n\
   -m_par/n_par <parameter>, where <parameter> indicates an integer\n \
-      that MMS3 will be evaluated with 2^m_par, 2^n_par";
+      that MMS3 will be evaluated with 2^m_par, 2^n_par\n\
+  -split, to evaluate the interior of the residual while the ghost values are exchanged\n";
 
 /* ------------------------------------------------------------------------
 
@@ -620,7 +621,7 @@ int main(int argc, char **argv)
   PetscReal bratu_lambda_max = 6.81;
   PetscReal bratu_lambda_min = 0.;
   PetscInt  MMS              = 1;
-  PetscBool flg              = PETSC_FALSE, setMMS;
+  PetscBool flg              = PETSC_FALSE, split = PETSC_FALSE, setMMS;
   DM        da;
   Vec       r = NULL;
   KSP       ksp;
@@ -697,10 +698,13 @@ int main(int argc, char **argv)
   default:
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_USER, "Unknown MMS type %" PetscInt_FMT, MMS);
   }
-  PetscCall(DMDASNESSetFunctionLocal(da, INSERT_VALUES, (DMDASNESFunction)FormFunctionLocal, &user));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-split", &split, NULL));
+  if (split) PetscCall(DMDASNESSetFunctionLocalSplit(da, (DMDASNESFunction)FormFunctionLocal, &user));
+  else PetscCall(DMDASNESSetFunctionLocal(da, INSERT_VALUES, (DMDASNESFunction)FormFunctionLocal, &user));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-fd", &flg, NULL));
   if (!flg) PetscCall(DMDASNESSetJacobianLocal(da, (DMDASNESJacobian)FormJacobianLocal, &user));
 
+  flg = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-obj", &flg, NULL));
   if (flg) PetscCall(DMDASNESSetObjectiveLocal(da, (DMDASNESObjective)FormObjectiveLocal, &user));
 
@@ -935,6 +939,12 @@ int main(int argc, char **argv)
      suffix: 5_qn
      args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type qn -snes_linesearch_type cp -snes_qn_m 10
 
+   test:
+     suffix: 5_split
+     nsize: 4
+     args: -split {{0 1}} -fd -da_refine 3 -par 6.0 -snes_monitor_short -snes_converged_reason -ksp_converged_reason
+     output_file: output/ex5_5_split.out
+
    test:
      suffix: 6
      nsize: 4
@@ -15,6 +15,7 @@ typedef struct {
   void      *jacobianlocalctx;
   void      *objectivelocalctx;
   InsertMode residuallocalimode;
+  PetscBool  residuallocalsplit; /* evaluate the interior while the ghost values are exchanged */
 
   /*   For Picard iteration defined locally */
   PetscErrorCode (*rhsplocal)(DMDALocalInfo *, void *, void *, void *);
@@ -50,6 +51,45 @@ static PetscErrorCode DMDASNESGetContext(DM dm, DMSNES sdm, DMSNES_DA **dmdasnes
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Evaluates the residual on the interior from the global vector while the ghost values are in flight, then on the shell */
+static PetscErrorCode SNESComputeFunctionSplit_DMDA(SNES snes, DM dm, Vec X, Vec Xloc, Vec F, DMSNES_DA *dmdasnes)
+{
+  DMDALocalInfo info, sub;
+  const void   *x;
+  void         *f;
+  PetscInt      nb, corners[36];
+
+  PetscFunctionBegin;
+  PetscCall(DMDAGetLocalInfo(dm, &info));
+  sub = info;
+  PetscCall(DMDAGetInteriorCorners(dm, &sub.xs, &sub.ys, &sub.zs, &sub.xm, &sub.ym, &sub.zm));
+  PetscCall(DMDAGetShellCorners(dm, &nb, corners));
+  PetscCall(DMDAVecGetArray(dm, F, &f));
+  if (sub.xm && sub.ym && sub.zm) {
+    PetscCall(PetscLogEventBegin(SNES_FunctionEval, snes, X, F, 0));
+    PetscCall(DMDAVecGetArrayRead(dm, X, (void *)&x));
+    PetscCallBack("SNES DMDA local callback function", (*dmdasnes->residuallocal)(&sub, (void *)x, f, dmdasnes->residuallocalctx));
+    PetscCall(DMDAVecRestoreArrayRead(dm, X, (void *)&x));
+    PetscCall(PetscLogEventEnd(SNES_FunctionEval, snes, X, F, 0));
+  }
+  PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
+  PetscCall(PetscLogEventBegin(SNES_FunctionEval, snes, X, F, 0));
+  PetscCall(DMDAVecGetArrayRead(dm, Xloc, (void *)&x));
+  for (PetscInt b = 0; b < nb; ++b) {
+    sub.xs = corners[b * 6 + 0];
+    sub.ys = corners[b * 6 + 1];
+    sub.zs = corners[b * 6 + 2];
+    sub.xm = corners[b * 6 + 3];
+    sub.ym = corners[b * 6 + 4];
+    sub.zm = corners[b * 6 + 5];
+    PetscCallBack("SNES DMDA local callback function", (*dmdasnes->residuallocal)(&sub, (void *)x, f, dmdasnes->residuallocalctx));
+  }
+  PetscCall(DMDAVecRestoreArrayRead(dm, Xloc, (void *)&x));
+  PetscCall(PetscLogEventEnd(SNES_FunctionEval, snes, X, F, 0));
+  PetscCall(DMDAVecRestoreArray(dm, F, &f));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SNESComputeFunction_DMDA(SNES snes, Vec X, Vec F, void *ctx)
 {
   DM            dm;
@@ -66,6 +106,12 @@ static PetscErrorCode SNESComputeFunction_DMDA(SNES snes, Vec X, Vec F, void *ct
   PetscCall(SNESGetDM(snes, &dm));
   PetscCall(DMGetLocalVector(dm, &Xloc));
   PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
+  if (dmdasnes->residuallocalsplit) {
+    PetscCall(SNESComputeFunctionSplit_DMDA(snes, dm, X, Xloc, F, dmdasnes));
+    PetscCall(DMRestoreLocalVector(dm, &Xloc));
+    if (snes->domainerror) PetscCall(VecSetInf(F));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
   PetscCall(DMDAGetLocalInfo(dm, &info));
   switch (dmdasnes->residuallocalimode) {
@@ -236,6 +282,7 @@ PetscErrorCode DMDASNESSetFunctionLocal(DM dm, InsertMode imode, PetscErrorCode
   dmdasnes->residuallocalimode = imode;
   dmdasnes->residuallocal      = func;
   dmdasnes->residuallocalctx   = ctx;
+  dmdasnes->residuallocalsplit = PETSC_FALSE;
 
   PetscCall(DMSNESSetFunction(dm, SNESComputeFunction_DMDA, dmdasnes));
   if (!sdm->ops->computejacobian) { /* Call us for the Jacobian too, can be overridden by the user. */
@@ -244,6 +291,52 @@ PetscErrorCode DMDASNESSetFunctionLocal(DM dm, InsertMode imode, PetscErrorCode
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   DMDASNESSetFunctionLocalSplit - set a local residual evaluation function for use with `DMDA` that is first called on the
+   points whose stencil is owned while the ghost values are exchanged, then on the remaining points
+
+   Logically Collective
+
+   Input Parameters:
++  dm - `DM` to associate callback with
+.  func - local residual evaluation
+-  ctx - optional context for local residual evaluation
+
+   Calling sequence:
+   For PetscErrorCode (*func)(DMDALocalInfo *info,void *x, void *f, void *ctx),
++  info - `DMDALocalInfo` whose corners xs, ys, zs, xm, ym, zm define the box to evaluate the residual on
+.  x - dimensional pointer to state at which to evaluate residual (e.g. PetscScalar *x or **x or ***x), indexed with global indices
+.  f - dimensional pointer to residual, write the residual here (e.g. PetscScalar *f or **f or ***f)
+-  ctx - optional context passed above
+
+   Level: intermediate
+
+   Notes:
+   The function is the same as for `DMDASNESSetFunctionLocal()` with `INSERT_VALUES`, but it is called several times per
+   residual evaluation, on disjoint boxes covering the owned points. It must only compute f on the box given by the corners
+   of info and only read x within the stencil width of that box. The box of `DMDAGetInteriorCorners()` is evaluated from
+   the global vector while the ghost values are exchanged, the boxes of `DMDAGetShellCorners()` from the local vector
+   once the exchange completes.
+
+   This hides the latency of the ghost exchange behind the interior work, which matters when the subdomains are small.
+
+.seealso: `DMDA`, `DMDASNESSetFunctionLocal()`, `DMDAGetInteriorCorners()`, `DMDAGetShellCorners()`, `DMSNESSetFunction()`
+@*/
+PetscErrorCode DMDASNESSetFunctionLocalSplit(DM dm, PetscErrorCode (*func)(DMDALocalInfo *, void *, void *, void *), void *ctx)
+{
+  DMSNES     sdm;
+  DMSNES_DA *dmdasnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscCall(DMDASNESSetFunctionLocal(dm, INSERT_VALUES, func, ctx));
+  PetscCall(DMGetDMSNESWrite(dm, &sdm));
+  PetscCall(DMDASNESGetContext(dm, sdm, &dmdasnes));
+  dmdasnes->residuallocalvec   = NULL;
+  dmdasnes->residuallocalsplit = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    DMDASNESSetFunctionLocalVec - set a local residual evaluation function that operates on a local vector for `DMDA`
 
@@ -279,6 +372,7 @@ PetscErrorCode DMDASNESSetFunctionLocalVec(DM dm, InsertMode imode, PetscErrorCo
   dmdasnes->residuallocalimode = imode;
   dmdasnes->residuallocalvec   = func;
   dmdasnes->residuallocalctx   = ctx;
+  dmdasnes->residuallocalsplit = PETSC_FALSE;
 
   PetscCall(DMSNESSetFunction(dm, SNESComputeFunction_DMDA, dmdasnes));
   if (!sdm->ops->computejacobian) { /* Call us for the Jacobian too, can be overridden by the user. */
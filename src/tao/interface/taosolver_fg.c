@@ -194,12 +194,64 @@ PetscErrorCode TaoComputeObjective(Tao tao, Vec X, PetscReal *f)
     PetscCall(PetscLogEventEnd(TAO_ObjGradEval, tao, X, NULL, NULL));
     PetscCall(VecDestroy(&temp));
     tao->nfuncgrads++;
+  } else if (tao->ops->computeobjectivebatch) {
+    PetscCall(TaoComputeObjectiveBatch(tao, 1, &X, f));
   } else SETERRQ(PetscObjectComm((PetscObject)tao), PETSC_ERR_ARG_WRONGSTATE, "TaoSetObjective() has not been called");
   PetscCall(PetscInfo(tao, "TAO Function evaluation: %20.19e\n", (double)(*f)));
   PetscCall(VecLockReadPop(X));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  TaoComputeObjectiveBatch - Computes the objective function values at a set of points
+
+  Collective
+
+  Input Parameters:
++ tao - the `Tao` context
+. n - the number of points
+- X - the points
+
+  Output Parameter:
+. f - the objective values at the points
+
+  Level: developer
+
+  Notes:
+  The points are evaluated with a single call of the routine provided with `TaoSetObjectiveBatch()`, which may evaluate
+  them concurrently. Without such a routine, the points are evaluated one after the other with `TaoComputeObjective()`.
+
+  `TaoComputeObjectiveBatch()` is typically used within the implementation of derivative-free optimization algorithms,
+  so most users would not generally call this routine themselves.
+
+.seealso: [](chapter_tao), `Tao`, `TaoComputeObjective()`, `TaoSetObjectiveBatch()`, `TaoComputeResidualBatch()`
+@*/
+PetscErrorCode TaoComputeObjectiveBatch(Tao tao, PetscInt n, Vec X[], PetscReal f[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tao, TAO_CLASSID, 1);
+  PetscCheck(n >= 0, PetscObjectComm((PetscObject)tao), PETSC_ERR_ARG_OUTOFRANGE, "Number of points %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscValidPointer(X, 3);
+  PetscValidRealPointer(f, 4);
+  if (tao->ops->computeobjectivebatch) {
+    for (PetscInt i = 0; i < n; i++) {
+      PetscValidHeaderSpecific(X[i], VEC_CLASSID, 3);
+      PetscCheckSameComm(tao, 1, X[i], 3);
+      PetscCall(VecLockReadPush(X[i]));
+    }
+    PetscCall(PetscLogEventBegin(TAO_ObjectiveEval, tao, NULL, NULL, NULL));
+    PetscCallBack("Tao callback batch objective", (*tao->ops->computeobjectivebatch)(tao, n, X, f, tao->user_objbatchP));
+    PetscCall(PetscLogEventEnd(TAO_ObjectiveEval, tao, NULL, NULL, NULL));
+    for (PetscInt i = 0; i < n; i++) PetscCall(VecLockReadPop(X[i]));
+    tao->nfuncs += n;
+    PetscCall(PetscInfo(tao, "TAO batch function evaluation at %" PetscInt_FMT " points\n", n));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(TaoComputeObjective(tao, X[i], &f[i]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   TaoComputeObjectiveAndGradient - Computes the objective function value at a given point
 
@@ -318,6 +370,48 @@ PetscErrorCode TaoGetObjective(Tao tao, PetscErrorCode (**func)(Tao, Vec, PetscR
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  TaoSetObjectiveBatch - Sets a routine that evaluates the objective function at several points in a single call
+
+  Logically collective
+
+  Input Parameters:
++ tao - the `Tao` context
+. func - the batch objective function
+- ctx - [optional] user-defined context for private data for the function evaluation
+        routine (may be `NULL`)
+
+  Calling sequence of func:
+$      func (Tao tao, PetscInt n, Vec x[], PetscReal f[], void *ctx);
+
++ n - the number of points
+. x - the points, on the communicator of `tao`
+. f - the function values (output), the same on all processes
+- ctx - [optional] user-defined function context
+
+  Level: intermediate
+
+  Notes:
+  The derivative-free solvers `TAONM` and `TAOPOUNDERS` propose several points at once when they build their simplex
+  or their interpolation model, and `TAONM` can also evaluate all its trial points of an iteration together. This
+  routine lets the application evaluate these points concurrently, for example by distributing them over
+  sub-communicators created with `PetscSubcommCreate()`, which is useful when a single evaluation is an expensive
+  simulation that does not scale to the whole communicator.
+
+  The points are only valid during the call. If `TaoSetObjective()` is not used, single points are also evaluated with this
+  routine.
+
+.seealso: [](chapter_tao), `Tao`, `TaoSetObjective()`, `TaoComputeObjectiveBatch()`, `TaoSetResidualBatchRoutine()`, `TAONM`
+@*/
+PetscErrorCode TaoSetObjectiveBatch(Tao tao, PetscErrorCode (*func)(Tao, PetscInt, Vec[], PetscReal[], void *), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tao, TAO_CLASSID, 1);
+  if (ctx) tao->user_objbatchP = ctx;
+  if (func) tao->ops->computeobjectivebatch = func;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   TaoSetResidualRoutine - Sets the residual evaluation routine for least-square applications
 
@@ -354,6 +448,48 @@ PetscErrorCode TaoSetResidualRoutine(Tao tao, Vec res, PetscErrorCode (*func)(Ta
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  TaoSetResidualBatchRoutine - Sets a routine that evaluates the least-squares residual at several points in a single call
+
+  Logically collective
+
+  Input Parameters:
++ tao - the `Tao` context
+. res - a vector to hold the residual, it defines the layout of the residuals
+. func - the batch residual evaluation routine
+- ctx - [optional] user-defined context for private data for the function evaluation
+        routine (may be `NULL`)
+
+  Calling sequence of func:
+$      func (Tao tao, PetscInt n, Vec x[], Vec f[], void *ctx);
+
++ n - the number of points
+. x - the points
+. f - the residual vectors at the points (output)
+- ctx - [optional] user-defined function context
+
+  Level: intermediate
+
+  Notes:
+  `TAOPOUNDERS` uses this routine to evaluate the points of its initial interpolation set and its geometry-improving
+  points concurrently, see `TaoSetObjectiveBatch()`. If `TaoSetResidualRoutine()` is not used, single points are also
+  evaluated with this routine.
+
+.seealso: [](chapter_tao), `Tao`, `TaoSetResidualRoutine()`, `TaoComputeResidualBatch()`, `TaoSetObjectiveBatch()`, `TAOPOUNDERS`
+@*/
+PetscErrorCode TaoSetResidualBatchRoutine(Tao tao, Vec res, PetscErrorCode (*func)(Tao, PetscInt, Vec[], Vec[], void *), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tao, TAO_CLASSID, 1);
+  PetscValidHeaderSpecific(res, VEC_CLASSID, 2);
+  PetscCall(PetscObjectReference((PetscObject)res));
+  PetscCall(VecDestroy(&tao->ls_res));
+  tao->ls_res                    = res;
+  tao->user_lsresbatchP          = ctx;
+  tao->ops->computeresidualbatch = func;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   TaoSetResidualWeights - Give weights for the residual values. A vector can be used if only diagonal terms are used, otherwise a matrix can be give.
    If this function is not provided, or if `sigma_v` and `vals` are both `NULL`, then the identity matrix will be used for weights.
@@ -439,11 +575,60 @@ PetscErrorCode TaoComputeResidual(Tao tao, Vec X, Vec F)
     PetscCallBack("Tao callback least-squares residual", (*tao->ops->computeresidual)(tao, X, F, tao->user_lsresP));
     PetscCall(PetscLogEventEnd(TAO_ObjectiveEval, tao, X, NULL, NULL));
     tao->nfuncs++;
+  } else if (tao->ops->computeresidualbatch) {
+    PetscCall(TaoComputeResidualBatch(tao, 1, &X, &F));
   } else SETERRQ(PetscObjectComm((PetscObject)tao), PETSC_ERR_ARG_WRONGSTATE, "TaoSetResidualRoutine() has not been called");
   PetscCall(PetscInfo(tao, "TAO least-squares residual evaluation.\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  TaoComputeResidualBatch - Computes the least-squares residual vectors at a set of points
+
+  Collective
+
+  Input Parameters:
++ tao - the `Tao` context
+. n - the number of points
+- X - the points
+
+  Output Parameter:
+. F - the residual vectors at the points
+
+  Level: developer
+
+  Notes:
+  The points are evaluated with a single call of the routine provided with `TaoSetResidualBatchRoutine()`, which may evaluate
+  them concurrently. Without such a routine, the points are evaluated one after the other with `TaoComputeResidual()`.
+
+.seealso: [](chapter_tao), `Tao`, `TaoComputeResidual()`, `TaoSetResidualBatchRoutine()`, `TaoComputeObjectiveBatch()`
+@*/
+PetscErrorCode TaoComputeResidualBatch(Tao tao, PetscInt n, Vec X[], Vec F[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tao, TAO_CLASSID, 1);
+  PetscCheck(n >= 0, PetscObjectComm((PetscObject)tao), PETSC_ERR_ARG_OUTOFRANGE, "Number of points %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscValidPointer(X, 3);
+  PetscValidPointer(F, 4);
+  if (tao->ops->computeresidualbatch) {
+    for (PetscInt i = 0; i < n; i++) {
+      PetscValidHeaderSpecific(X[i], VEC_CLASSID, 3);
+      PetscValidHeaderSpecific(F[i], VEC_CLASSID, 4);
+      PetscCheckSameComm(tao, 1, X[i], 3);
+      PetscCheckSameComm(tao, 1, F[i], 4);
+    }
+    PetscCall(PetscLogEventBegin(TAO_ObjectiveEval, tao, NULL, NULL, NULL));
+    PetscCallBack("Tao callback batch least-squares residual", (*tao->ops->computeresidualbatch)(tao, n, X, F, tao->user_lsresbatchP));
+    PetscCall(PetscLogEventEnd(TAO_ObjectiveEval, tao, NULL, NULL, NULL));
+    tao->nfuncs += n;
+    PetscCall(PetscInfo(tao, "TAO batch least-squares residual evaluation at %" PetscInt_FMT " points\n", n));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(TaoComputeResidual(tao, X[i], F[i]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   TaoSetGradient - Sets the gradient evaluation routine for the function to be optimized
 
@@ -25,14 +25,14 @@ static PetscErrorCode pounders_fg(Tao subtao, Vec x, PetscReal *f, Vec g, void *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode pounders_feval(Tao tao, Vec x, Vec F, PetscReal *fsum)
+/* Weighted sum of squares of the residual F */
+static PetscErrorCode pounders_fsum(Tao tao, Vec F, PetscReal *fsum)
 {
   TAO_POUNDERS *mfqP = (TAO_POUNDERS *)tao->data;
   PetscInt      i, row, col;
   PetscReal     fr, fc;
 
   PetscFunctionBegin;
-  PetscCall(TaoComputeResidual(tao, x, F));
   if (tao->res_weights_v) {
     PetscCall(VecPointwiseMult(mfqP->workfvec, tao->res_weights_v, F));
     PetscCall(VecDot(mfqP->workfvec, mfqP->workfvec, fsum));
@@ -53,6 +53,23 @@ static PetscErrorCode pounders_feval(Tao tao, Vec x, Vec F, PetscReal *fsum)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode pounders_feval(Tao tao, Vec x, Vec F, PetscReal *fsum)
+{
+  PetscFunctionBegin;
+  PetscCall(TaoComputeResidual(tao, x, F));
+  PetscCall(pounders_fsum(tao, F, fsum));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Evaluates n points with one call of the batch residual routine, if the application provides one */
+static PetscErrorCode pounders_fevalbatch(Tao tao, PetscInt n, Vec x[], Vec F[], PetscReal fsum[])
+{
+  PetscFunctionBegin;
+  PetscCall(TaoComputeResidualBatch(tao, n, x, F));
+  for (PetscInt i = 0; i < n; i++) PetscCall(pounders_fsum(tao, F[i], &fsum[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode gqtwrap(Tao tao, PetscReal *gnorm, PetscReal *qmin)
 {
 #if defined(PETSC_USE_REAL_SINGLE)
@@ -232,6 +249,45 @@ static PetscErrorCode pounders_update_res(Tao tao)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Entries of a point (or of a residual with the f variants) on every process, the model is built redundantly */
+static PetscErrorCode pounders_getx(TAO_POUNDERS *mfqP, Vec X, const PetscReal **x)
+{
+  PetscFunctionBegin;
+  if (mfqP->size > 1) {
+    PetscCall(VecScatterBegin(mfqP->scatterx, X, mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(mfqP->scatterx, X, mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
+    X = mfqP->localx;
+  }
+  PetscCall(VecGetArrayRead(X, x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode pounders_restorex(TAO_POUNDERS *mfqP, Vec X, const PetscReal **x)
+{
+  PetscFunctionBegin;
+  PetscCall(VecRestoreArrayRead(mfqP->size > 1 ? mfqP->localx : X, x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode pounders_getf(TAO_POUNDERS *mfqP, Vec F, const PetscReal **f)
+{
+  PetscFunctionBegin;
+  if (mfqP->size > 1) {
+    PetscCall(VecScatterBegin(mfqP->scatterf, F, mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(mfqP->scatterf, F, mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
+    F = mfqP->localf;
+  }
+  PetscCall(VecGetArrayRead(F, f));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode pounders_restoref(TAO_POUNDERS *mfqP, Vec F, const PetscReal **f)
+{
+  PetscFunctionBegin;
+  PetscCall(VecRestoreArrayRead(mfqP->size > 1 ? mfqP->localf : F, f));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode phi2eval(PetscReal *x, PetscInt n, PetscReal *phi)
 {
   /* Phi = .5*[x(1)^2  sqrt(2)*x(1)*x(2) ... sqrt(2)*x(1)*x(n) ... x(2)^2 sqrt(2)*x(2)*x(3) .. x(n)^2] */
@@ -339,10 +395,10 @@ static PetscErrorCode morepoints(TAO_POUNDERS *mfqP)
   PetscFunctionBegin;
   /* Initialize M,N */
   for (i = 0; i < mfqP->n + 1; i++) {
-    PetscCall(VecGetArrayRead(mfqP->Xhist[mfqP->model_indices[i]], &x));
+    PetscCall(pounders_getx(mfqP, mfqP->Xhist[mfqP->model_indices[i]], &x));
     mfqP->M[(mfqP->n + 1) * i] = 1.0;
     for (j = 0; j < mfqP->n; j++) mfqP->M[j + 1 + ((mfqP->n + 1) * i)] = (x[j] - mfqP->xmin[j]) / mfqP->delta;
-    PetscCall(VecRestoreArrayRead(mfqP->Xhist[mfqP->model_indices[i]], &x));
+    PetscCall(pounders_restorex(mfqP, mfqP->Xhist[mfqP->model_indices[i]], &x));
     PetscCall(phi2eval(&mfqP->M[1 + ((mfqP->n + 1) * i)], mfqP->n, &mfqP->N[mfqP->n * (mfqP->n + 1) / 2 * i]));
   }
 
@@ -372,10 +428,10 @@ static PetscErrorCode morepoints(TAO_POUNDERS *mfqP)
       continue;
     }
 
-    PetscCall(VecGetArrayRead(mfqP->Xhist[point], &x));
+    PetscCall(pounders_getx(mfqP, mfqP->Xhist[point], &x));
     mfqP->M[(mfqP->n + 1) * mfqP->nmodelpoints] = 1.0;
     for (j = 0; j < mfqP->n; j++) mfqP->M[j + 1 + ((mfqP->n + 1) * mfqP->nmodelpoints)] = (x[j] - mfqP->xmin[j]) / mfqP->delta;
-    PetscCall(VecRestoreArrayRead(mfqP->Xhist[point], &x));
+    PetscCall(pounders_restorex(mfqP, mfqP->Xhist[point], &x));
     PetscCall(phi2eval(&mfqP->M[1 + (mfqP->n + 1) * mfqP->nmodelpoints], mfqP->n, &mfqP->N[mfqP->n * (mfqP->n + 1) / 2 * (mfqP->nmodelpoints)]));
 
     /* Update QR factorization */
@@ -447,7 +503,7 @@ static PetscErrorCode morepoints(TAO_POUNDERS *mfqP)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-/* Only call from modelimprove, addpoint() needs ->Q_tmp and ->work to be set */
+/* Only call from modelimprove, addpoint() needs ->Q_tmp and ->work to be set; the new point is evaluated by modelimprove() */
 static PetscErrorCode addpoint(Tao tao, TAO_POUNDERS *mfqP, PetscInt index)
 {
   PetscFunctionBegin;
@@ -461,10 +517,7 @@ static PetscErrorCode addpoint(Tao tao, TAO_POUNDERS *mfqP, PetscInt index)
   /* Project into feasible region */
   if (tao->XU && tao->XL) PetscCall(VecMedian(mfqP->Xhist[mfqP->nHist], tao->XL, tao->XU, mfqP->Xhist[mfqP->nHist]));
 
-  /* Compute value of new vector */
   PetscCall(VecDuplicate(mfqP->Fhist[0], &mfqP->Fhist[mfqP->nHist]));
-  CHKMEMQ;
-  PetscCall(pounders_feval(tao, mfqP->Xhist[mfqP->nHist], mfqP->Fhist[mfqP->nHist], &mfqP->Fres[mfqP->nHist]));
 
   /* Add new vector to model */
   mfqP->model_indices[mfqP->nmodelpoints] = mfqP->nHist;
@@ -476,7 +529,7 @@ static PetscErrorCode addpoint(Tao tao, TAO_POUNDERS *mfqP, PetscInt index)
 static PetscErrorCode modelimprove(Tao tao, TAO_POUNDERS *mfqP, PetscInt addallpoints)
 {
   /* modeld = Q(:,np+1:n)' */
-  PetscInt     i, j, minindex = 0;
+  PetscInt     i, j, minindex = 0, first = mfqP->nHist;
   PetscReal    dp, half = 0.5, one = 1.0, minvalue = PETSC_INFINITY;
   PetscBLASInt blasn = mfqP->n, blasnpmax = mfqP->npmax, blask, info;
   PetscBLASInt blas1 = 1, blasnmax = mfqP->nmax;
@@ -508,6 +561,8 @@ static PetscErrorCode modelimprove(Tao tao, TAO_POUNDERS *mfqP, PetscInt addallp
     if (addallpoints != 0) PetscCall(addpoint(tao, mfqP, i));
   }
   if (!addallpoints) PetscCall(addpoint(tao, mfqP, minindex));
+  /* Compute the values of the new vectors */
+  PetscCall(pounders_fevalbatch(tao, mfqP->nHist - first, &mfqP->Xhist[first], &mfqP->Fhist[first], &mfqP->Fres[first]));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -521,9 +576,9 @@ static PetscErrorCode affpoints(TAO_POUNDERS *mfqP, PetscReal *xmin, PetscReal c
 
   PetscFunctionBegin;
   for (i = mfqP->nHist - 1; i >= 0; i--) {
-    PetscCall(VecGetArrayRead(mfqP->Xhist[i], &x));
+    PetscCall(pounders_getx(mfqP, mfqP->Xhist[i], &x));
     for (j = 0; j < mfqP->n; j++) mfqP->work[j] = (x[j] - xmin[j]) / mfqP->delta;
-    PetscCall(VecRestoreArrayRead(mfqP->Xhist[i], &x));
+    PetscCall(pounders_restorex(mfqP, mfqP->Xhist[i], &x));
     PetscCallBLAS("BLAScopy", BLAScopy_(&blasn, mfqP->work, &ione, mfqP->work2, &ione));
     PetscCallBLAS("BLASnrm2", normd = BLASnrm2_(&blasn, mfqP->work, &ione));
     if (normd <= c) {
@@ -563,7 +618,7 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
   PetscInt         low, high;
   PetscReal        minnorm;
   PetscReal       *x, *f;
-  const PetscReal *xmint, *fmin;
+  const PetscReal *xmint, *fmin, *xh, *fh;
   PetscReal        deltaold;
   PetscReal        gnorm;
   PetscBLASInt     info, ione = 1, iblas;
@@ -625,10 +680,6 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
   /* using a forward difference scheme. */
 
   PetscCall(PetscInfo(tao, "Initialize simplex; delta = %10.9e\n", (double)mfqP->delta));
-  PetscCall(pounders_feval(tao, mfqP->Xhist[0], mfqP->Fhist[0], &mfqP->Fres[0]));
-  mfqP->minindex = 0;
-  minnorm        = mfqP->Fres[0];
-
   PetscCall(VecGetOwnershipRange(mfqP->Xhist[0], &low, &high));
   for (i = 1; i < mfqP->n + 1; ++i) {
     PetscCall(VecCopy(mfqP->Xhist[0], mfqP->Xhist[i]));
@@ -638,8 +689,11 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
       x[i - 1 - low] += mfqP->delta;
       PetscCall(VecRestoreArray(mfqP->Xhist[i], &x));
     }
-    CHKMEMQ;
-    PetscCall(pounders_feval(tao, mfqP->Xhist[i], mfqP->Fhist[i], &mfqP->Fres[i]));
+  }
+  PetscCall(pounders_fevalbatch(tao, mfqP->n + 1, mfqP->Xhist, mfqP->Fhist, mfqP->Fres));
+  mfqP->minindex = 0;
+  minnorm        = mfqP->Fres[0];
+  for (i = 1; i < mfqP->n + 1; ++i) {
     if (mfqP->Fres[i] < minnorm) {
       mfqP->minindex = i;
       minnorm        = mfqP->Fres[i];
@@ -694,14 +748,14 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
     for (i = 0; i < mfqP->n + 1; i++) {
       if (i == mfqP->minindex) continue;
 
-      PetscCall(VecScatterBegin(mfqP->scatterx, mfqP->Xhist[ii], mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
-      PetscCall(VecScatterEnd(mfqP->scatterx, mfqP->Xhist[ii], mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
+      PetscCall(VecScatterBegin(mfqP->scatterx, mfqP->Xhist[i], mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
+      PetscCall(VecScatterEnd(mfqP->scatterx, mfqP->Xhist[i], mfqP->localx, INSERT_VALUES, SCATTER_FORWARD));
       PetscCall(VecGetArray(mfqP->localx, &x));
       for (j = 0; j < mfqP->n; j++) mfqP->Disp[ii + mfqP->npmax * j] = (x[j] - mfqP->xmin[j]) / mfqP->delta;
       PetscCall(VecRestoreArray(mfqP->localx, &x));
 
-      PetscCall(VecScatterBegin(mfqP->scatterf, mfqP->Fhist[ii], mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
-      PetscCall(VecScatterEnd(mfqP->scatterf, mfqP->Fhist[ii], mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
+      PetscCall(VecScatterBegin(mfqP->scatterf, mfqP->Fhist[i], mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
+      PetscCall(VecScatterEnd(mfqP->scatterf, mfqP->Fhist[i], mfqP->localf, INSERT_VALUES, SCATTER_FORWARD));
       PetscCall(VecGetArray(mfqP->localf, &f));
       for (j = 0; j < mfqP->m; j++) mfqP->Fdiff[ii + mfqP->n * j] = f[j] - fmin[j];
       PetscCall(VecRestoreArray(mfqP->localf, &f));
@@ -785,9 +839,9 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
       minnorm        = mfqP->Fres[mfqP->minindex];
       PetscCall(VecCopy(mfqP->Fhist[mfqP->minindex], tao->ls_res));
       /* Change current center */
-      PetscCall(VecGetArrayRead(mfqP->Xhist[mfqP->minindex], &xmint));
+      PetscCall(pounders_getx(mfqP, mfqP->Xhist[mfqP->minindex], &xmint));
       for (i = 0; i < mfqP->n; i++) mfqP->xmin[i] = xmint[i];
-      PetscCall(VecRestoreArrayRead(mfqP->Xhist[mfqP->minindex], &xmint));
+      PetscCall(pounders_restorex(mfqP, mfqP->Xhist[mfqP->minindex], &xmint));
     }
 
     /* Evaluate at a model-improving point if necessary */
@@ -833,25 +887,26 @@ static PetscErrorCode TaoSolve_POUNDERS(Tao tao)
     mfqP->model_indices[0] = mfqP->minindex;
     PetscCall(morepoints(mfqP));
     for (i = 0; i < mfqP->nmodelpoints; i++) {
-      PetscCall(VecGetArray(mfqP->Xhist[mfqP->model_indices[i]], &x));
-      for (j = 0; j < mfqP->n; j++) mfqP->Disp[i + mfqP->npmax * j] = (x[j] - mfqP->xmin[j]) / deltaold;
-      PetscCall(VecRestoreArray(mfqP->Xhist[mfqP->model_indices[i]], &x));
-      PetscCall(VecGetArray(mfqP->Fhist[mfqP->model_indices[i]], &f));
+      PetscCall(pounders_getx(mfqP, mfqP->Xhist[mfqP->model_indices[i]], &xh));
+      for (j = 0; j < mfqP->n; j++) mfqP->Disp[i + mfqP->npmax * j] = (xh[j] - mfqP->xmin[j]) / deltaold;
+      PetscCall(pounders_restorex(mfqP, mfqP->Xhist[mfqP->model_indices[i]], &xh));
+      PetscCall(pounders_getf(mfqP, mfqP->Fhist[mfqP->model_indices[i]], &fh));
       for (j = 0; j < mfqP->m; j++) {
         for (k = 0; k < mfqP->n; k++) {
           mfqP->work[k] = 0.0;
           for (l = 0; l < mfqP->n; l++) mfqP->work[k] += mfqP->H[j + mfqP->m * (k + mfqP->n * l)] * mfqP->Disp[i + mfqP->npmax * l];
         }
-        PetscCallBLAS("BLASdot", mfqP->RES[j * mfqP->npmax + i] = -mfqP->C[j] - BLASdot_(&blasn, &mfqP->Fdiff[j * mfqP->n], &ione, &mfqP->Disp[i], &blasnpmax) - 0.5 * BLASdot_(&blasn, mfqP->work, &ione, &mfqP->Disp[i], &blasnpmax) + f[j]);
+        PetscCallBLAS("BLASdot", mfqP->RES[j * mfqP->npmax + i] = -mfqP->C[j] - BLASdot_(&blasn, &mfqP->Fdiff[j * mfqP->n], &ione, &mfqP->Disp[i], &blasnpmax) - 0.5 * BLASdot_(&blasn, mfqP->work, &ione, &mfqP->Disp[i], &blasnpmax) + fh[j]);
       }
-      PetscCall(VecRestoreArray(mfqP->Fhist[mfqP->model_indices[i]], &f));
+      PetscCall(pounders_restoref(mfqP, mfqP->Fhist[mfqP->model_indices[i]], &fh));
     }
 
     /* Update the quadratic model */
     PetscCall(PetscInfo(tao, "Get Quad, size: %" PetscInt_FMT ", points: %" PetscInt_FMT "\n", mfqP->n, mfqP->nmodelpoints));
     PetscCall(getquadpounders(mfqP));
-    PetscCall(VecGetArrayRead(mfqP->Fhist[mfqP->minindex], &fmin));
+    PetscCall(pounders_getf(mfqP, mfqP->Fhist[mfqP->minindex], &fmin));
     PetscCallBLAS("BLAScopy", BLAScopy_(&blasm, fmin, &ione, mfqP->C, &ione));
+    PetscCall(pounders_restoref(mfqP, mfqP->Fhist[mfqP->minindex], &fmin));
     /* G = G*(delta/deltaold) + Gdel */
     ratio = mfqP->delta / deltaold;
     iblas = blasm * blasn;
@@ -1093,6 +1148,8 @@ static PetscErrorCode TaoDestroy_POUNDERS(Tao tao)
     PetscCall(VecDestroy(&mfqP->localxmin));
     PetscCall(VecDestroy(&mfqP->localf));
     PetscCall(VecDestroy(&mfqP->localfmin));
+    PetscCall(VecScatterDestroy(&mfqP->scatterx));
+    PetscCall(VecScatterDestroy(&mfqP->scatterf));
   }
   PetscCall(PetscFree(tao->data));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1141,6 +1198,11 @@ static PetscErrorCode TaoView_POUNDERS(Tao tao, PetscViewer viewer)
 
   Level: beginner
 
+  Note:
+  The points of the initial interpolation set and the geometry-improving points are evaluated with
+  `TaoComputeResidualBatch()`, so they are evaluated concurrently if the application provides `TaoSetResidualBatchRoutine()`.
+
+.seealso: `Tao`, `TaoSetResidualBatchRoutine()`, `TAONM`
 M*/
 
 PETSC_EXTERN PetscErrorCode TaoCreate_POUNDERS(Tao tao)
@@ -0,0 +1,210 @@
+static char help[] = "Tests TaoSetObjectiveBatch() and TaoSetResidualBatchRoutine() with TAONM and TAOPOUNDERS on the extended Rosenbrock function.\n\
+The points of a batch are distributed over sub-communicators, which evaluate them concurrently.\n\
+Input parameters include:\n\
+  -n <n>       : number of parameters, even\n\
+  -nsub <nsub> : number of sub-communicators\n\n";
+
+#include <petsctao.h>
+
+typedef struct {
+  PetscSubcomm psub;    /* point i of a batch is evaluated by the sub-communicator of color i % nsub */
+  VecScatter   scatter; /* gathers a point on every process */
+  Vec          xall;
+  PetscInt     n, nbatches, npoints;
+} AppCtx;
+
+/* Residual r(x) of the extended Rosenbrock function, each process of the sub-communicator computes every size-th component */
+static PetscErrorCode RosenbrockSub(AppCtx *user, const PetscReal *x, PetscReal *r)
+{
+  MPI_Comm    subcomm = PetscSubcommChild(user->psub);
+  PetscMPIInt rank, size;
+
+  PetscFunctionBeginUser;
+  PetscCallMPI(MPI_Comm_rank(subcomm, &rank));
+  PetscCallMPI(MPI_Comm_size(subcomm, &size));
+  PetscCall(PetscArrayzero(r, user->n));
+  for (PetscInt k = rank; k < user->n / 2; k += size) {
+    r[2 * k]     = 10.0 * (x[2 * k + 1] - x[2 * k] * x[2 * k]);
+    r[2 * k + 1] = 1.0 - x[2 * k];
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, r, (PetscMPIInt)user->n, MPIU_REAL, MPIU_SUM, subcomm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Every point is evaluated by one sub-communicator, then the residuals are shared by all processes */
+static PetscErrorCode EvaluateBatch(AppCtx *user, PetscInt np, Vec X[], PetscReal *r)
+{
+  PetscMPIInt        subrank;
+  const PetscScalar *x;
+
+  PetscFunctionBeginUser;
+  PetscCallMPI(MPI_Comm_rank(PetscSubcommChild(user->psub), &subrank));
+  PetscCall(PetscArrayzero(r, np * user->n));
+  for (PetscInt i = 0; i < np; i++) {
+    PetscCall(VecScatterBegin(user->scatter, X[i], user->xall, INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(user->scatter, X[i], user->xall, INSERT_VALUES, SCATTER_FORWARD));
+    if (i % user->psub->n != user->psub->color) continue;
+    PetscCall(VecGetArrayRead(user->xall, &x));
+    PetscCall(RosenbrockSub(user, x, &r[i * user->n]));
+    PetscCall(VecRestoreArrayRead(user->xall, &x));
+    if (subrank) PetscCall(PetscArrayzero(&r[i * user->n], user->n));
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, r, (PetscMPIInt)(np * user->n), MPIU_REAL, MPIU_SUM, PETSC_COMM_WORLD));
+  user->nbatches++;
+  user->npoints += np;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ObjectiveBatch(Tao tao, PetscInt np, Vec X[], PetscReal f[], void *ctx)
+{
+  AppCtx    *user = (AppCtx *)ctx;
+  PetscReal *r;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscMalloc1(np * user->n, &r));
+  PetscCall(EvaluateBatch(user, np, X, r));
+  for (PetscInt i = 0; i < np; i++) {
+    f[i] = 0.0;
+    for (PetscInt j = 0; j < user->n; j++) f[i] += r[i * user->n + j] * r[i * user->n + j];
+  }
+  PetscCall(PetscFree(r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ResidualBatch(Tao tao, PetscInt np, Vec X[], Vec F[], void *ctx)
+{
+  AppCtx      *user = (AppCtx *)ctx;
+  PetscReal   *r;
+  PetscScalar *f;
+  PetscInt     rstart, rend;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscMalloc1(np * user->n, &r));
+  PetscCall(EvaluateBatch(user, np, X, r));
+  for (PetscInt i = 0; i < np; i++) {
+    PetscCall(VecGetOwnershipRange(F[i], &rstart, &rend));
+    PetscCall(VecGetArray(F[i], &f));
+    for (PetscInt j = rstart; j < rend; j++) f[j - rstart] = r[i * user->n + j];
+    PetscCall(VecRestoreArray(F[i], &f));
+  }
+  PetscCall(PetscFree(r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The same evaluations one point at a time, for the reference solve */
+static PetscErrorCode Objective(Tao tao, Vec X, PetscReal *f, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(ObjectiveBatch(tao, 1, &X, f, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Residual(Tao tao, Vec X, Vec F, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(ResidualBatch(tao, 1, &X, &F, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  AppCtx      user;
+  Tao         tao[2];
+  Vec         x[2], r;
+  PetscInt    nsub = 2, ncalls[2], npoints[2];
+  PetscMPIInt size;
+  PetscReal   norm, diff;
+  PetscBool   pounders;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  user.n = 4;
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &user.n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsub", &nsub, NULL));
+  PetscCheck(user.n % 2 == 0, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "The number of parameters must be even");
+  nsub = PetscMin(nsub, size);
+  PetscCall(PetscSubcommCreate(PETSC_COMM_WORLD, &user.psub));
+  PetscCall(PetscSubcommSetNumber(user.psub, nsub));
+  PetscCall(PetscSubcommSetType(user.psub, PETSC_SUBCOMM_CONTIGUOUS));
+
+  PetscCall(VecCreateMPI(PETSC_COMM_WORLD, PETSC_DECIDE, user.n, &x[0]));
+  PetscCall(VecDuplicate(x[0], &x[1]));
+  PetscCall(VecDuplicate(x[0], &r));
+  PetscCall(VecScatterCreateToAll(x[0], &user.scatter, &user.xall));
+
+  /* tao[0] evaluates one point at a time, tao[1] only has the batch routines */
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(VecSet(x[k], 1.0));
+    for (PetscInt i = 0; i < user.n; i += 2) PetscCall(VecSetValue(x[k], i, -1.2, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(x[k]));
+    PetscCall(VecAssemblyEnd(x[k]));
+    PetscCall(TaoCreate(PETSC_COMM_WORLD, &tao[k]));
+    PetscCall(TaoSetType(tao[k], TAONM));
+    PetscCall(TaoSetSolution(tao[k], x[k]));
+    if (k) {
+      PetscCall(TaoSetObjectiveBatch(tao[k], ObjectiveBatch, &user));
+      PetscCall(TaoSetResidualBatchRoutine(tao[k], r, ResidualBatch, &user));
+    } else {
+      PetscCall(TaoSetObjective(tao[k], Objective, &user));
+      PetscCall(TaoSetResidualRoutine(tao[k], r, Residual, &user));
+    }
+    PetscCall(TaoSetMaximumFunctionEvaluations(tao[k], 100000));
+    PetscCall(TaoSetFromOptions(tao[k]));
+    user.nbatches = 0;
+    user.npoints  = 0;
+    PetscCall(TaoSolve(tao[k]));
+    ncalls[k]  = user.nbatches;
+    npoints[k] = user.npoints;
+  }
+
+  PetscCall(PetscObjectTypeCompare((PetscObject)tao[1], TAOPOUNDERS, &pounders));
+  PetscCall(VecNorm(x[0], NORM_2, &norm));
+  PetscCall(VecAXPY(x[1], -1.0, x[0]));
+  PetscCall(VecNorm(x[1], NORM_2, &diff));
+  if (diff < 1e-12 * norm) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference to the solution with sequential evaluations: < 1e-12\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative difference to the solution with sequential evaluations: %g\n", (double)(diff / norm)));
+  /* the speculative points of NM are evaluated in addition to those of the sequential solve, so the calls are compared, not the points */
+  if (ncalls[1] < ncalls[0]) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: fewer calls than with sequential evaluations: yes\n", pounders ? "POUNDERS" : "NM"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: fewer calls than with sequential evaluations: no, %" PetscInt_FMT " batches against %" PetscInt_FMT " calls\n", pounders ? "POUNDERS" : "NM", ncalls[1], ncalls[0]));
+  PetscCall(PetscInfo(NULL, "%s: %" PetscInt_FMT " points evaluated in %" PetscInt_FMT " batches, %" PetscInt_FMT " sequential calls\n", pounders ? "POUNDERS" : "NM", npoints[1], ncalls[1], ncalls[0]));
+
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(TaoDestroy(&tao[k]));
+    PetscCall(VecDestroy(&x[k]));
+  }
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&user.xall));
+  PetscCall(VecScatterDestroy(&user.scatter));
+  PetscCall(PetscSubcommDestroy(&user.psub));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+      requires: !complex
+
+   test:
+      suffix: nm
+      nsize: {{1 2 3}}
+      requires: !single
+      args: -tao_nm_speculative 0
+      output_file: output/batch_nm.out
+
+   test:
+      suffix: nm_speculative
+      nsize: {{1 2 3}}
+      requires: !single
+      args: -tao_nm_speculative
+      output_file: output/batch_nm_speculative.out
+
+   test:
+      suffix: pounders
+      nsize: {{1 2 3}}
+      requires: !single
+      args: -tao_type pounders
+      output_file: output/batch_pounders.out
+
+TEST*/
@@ -49,10 +49,12 @@ static PetscErrorCode TaoSetUp_NM(Tao tao)
   PetscCall(VecDuplicateVecs(tao->solution, nm->N + 1, &nm->simplex));
   PetscCall(PetscMalloc1(nm->N + 1, &nm->f_values));
   PetscCall(PetscMalloc1(nm->N + 1, &nm->indices));
+  PetscCall(PetscMalloc2(nm->N, &nm->Xbatch, nm->N, &nm->fbatch));
   PetscCall(VecDuplicate(tao->solution, &nm->Xbar));
   PetscCall(VecDuplicate(tao->solution, &nm->Xmur));
   PetscCall(VecDuplicate(tao->solution, &nm->Xmue));
   PetscCall(VecDuplicate(tao->solution, &nm->Xmuc));
+  PetscCall(VecDuplicate(tao->solution, &nm->Xmuic));
 
   tao->gradient = NULL;
   tao->step     = 0;
@@ -68,12 +70,14 @@ static PetscErrorCode TaoDestroy_NM(Tao tao)
   if (tao->setupcalled) {
     PetscCall(VecDestroyVecs(nm->N + 1, &nm->simplex));
     PetscCall(VecDestroy(&nm->Xmuc));
+    PetscCall(VecDestroy(&nm->Xmuic));
     PetscCall(VecDestroy(&nm->Xmue));
     PetscCall(VecDestroy(&nm->Xmur));
     PetscCall(VecDestroy(&nm->Xbar));
   }
   PetscCall(PetscFree(nm->indices));
   PetscCall(PetscFree(nm->f_values));
+  PetscCall(PetscFree2(nm->Xbatch, nm->fbatch));
   PetscCall(PetscFree(tao->data));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -91,6 +95,7 @@ static PetscErrorCode TaoSetFromOptions_NM(Tao tao, PetscOptionItems *PetscOptio
   nm->mu_ic = -nm->mu_oc;
   nm->mu_r  = nm->mu_oc * 2.0;
   nm->mu_e  = nm->mu_oc * 4.0;
+  PetscCall(PetscOptionsBool("-tao_nm_speculative", "Evaluate the reflection, expansion and contraction points together", "TaoSetObjectiveBatch", nm->speculative, &nm->speculative, NULL));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -110,6 +115,7 @@ static PetscErrorCode TaoView_NM(Tao tao, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "inside contractions: %" PetscInt_FMT "\n", nm->nincontract));
     PetscCall(PetscViewerASCIIPrintf(viewer, "outside contractionss: %" PetscInt_FMT "\n", nm->noutcontract));
     PetscCall(PetscViewerASCIIPrintf(viewer, "Shrink steps: %" PetscInt_FMT "\n", nm->nshrink));
+    if (tao->ops->computeobjectivebatch) PetscCall(PetscViewerASCIIPrintf(viewer, "Batch evaluation of the trial points of an iteration: %s\n", PetscBools[nm->speculative]));
     PetscCall(PetscViewerASCIIPopTab(viewer));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -121,10 +127,11 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
   TAO_NelderMead *nm = (TAO_NelderMead *)tao->data;
   PetscReal      *x;
   PetscInt        i;
-  Vec             Xmur = nm->Xmur, Xmue = nm->Xmue, Xmuc = nm->Xmuc, Xbar = nm->Xbar;
-  PetscReal       fr, fe, fc;
+  Vec             Xmur = nm->Xmur, Xmue = nm->Xmue, Xmuc = nm->Xmuc, Xmuic = nm->Xmuic, Xbar = nm->Xbar;
+  PetscReal       fr, fe = 0.0, foc = 0.0, fic = 0.0;
   PetscInt        shrink;
   PetscInt        low, high;
+  PetscBool       speculative = (PetscBool)(nm->speculative && tao->ops->computeobjectivebatch);
 
   PetscFunctionBegin;
   nm->nshrink      = 0;
@@ -136,7 +143,6 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
   if (tao->XL || tao->XU || tao->ops->computebounds) PetscCall(PetscInfo(tao, "WARNING: Variable bounds have been set but will be ignored by NelderMead algorithm\n"));
 
   PetscCall(VecCopy(tao->solution, nm->simplex[0]));
-  PetscCall(TaoComputeObjective(tao, nm->simplex[0], &nm->f_values[0]));
   nm->indices[0] = 0;
   for (i = 1; i < nm->N + 1; i++) {
     PetscCall(VecCopy(tao->solution, nm->simplex[i]));
@@ -146,10 +152,9 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
       x[i - 1 - low] += nm->lambda;
       PetscCall(VecRestoreArray(nm->simplex[i], &x));
     }
-
-    PetscCall(TaoComputeObjective(tao, nm->simplex[i], &nm->f_values[i]));
     nm->indices[i] = i;
   }
+  PetscCall(TaoComputeObjectiveBatch(tao, nm->N + 1, nm->simplex, nm->f_values));
 
   /*  Xbar  = (Sum of all simplex vectors - worst vector)/N */
   PetscCall(NelderMeadSort(nm));
@@ -170,7 +175,20 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
 
     /* x(mu) = (1 + mu)Xbar - mu*X_N+1 */
     PetscCall(VecAXPBYPCZ(Xmur, 1 + nm->mu_r, -nm->mu_r, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
-    PetscCall(TaoComputeObjective(tao, Xmur, &fr));
+    if (speculative) {
+      /* all the points the iteration may need, so that they are evaluated concurrently */
+      Vec       trial[4] = {Xmur, Xmue, Xmuc, Xmuic};
+      PetscReal ftrial[4];
+
+      PetscCall(VecAXPBYPCZ(Xmue, 1 + nm->mu_e, -nm->mu_e, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+      PetscCall(VecAXPBYPCZ(Xmuc, 1 + nm->mu_oc, -nm->mu_oc, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+      PetscCall(VecAXPBYPCZ(Xmuic, 1 + nm->mu_ic, -nm->mu_ic, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+      PetscCall(TaoComputeObjectiveBatch(tao, 4, trial, ftrial));
+      fr  = ftrial[0];
+      fe  = ftrial[1];
+      foc = ftrial[2];
+      fic = ftrial[3];
+    } else PetscCall(TaoComputeObjective(tao, Xmur, &fr));
 
     if (nm->f_values[nm->indices[0]] <= fr && fr < nm->f_values[nm->indices[nm->N - 1]]) {
       /*  reflect */
@@ -181,8 +199,10 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
       /*  expand */
       nm->nexpand++;
       PetscCall(PetscInfo(0, "Expand\n"));
-      PetscCall(VecAXPBYPCZ(Xmue, 1 + nm->mu_e, -nm->mu_e, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
-      PetscCall(TaoComputeObjective(tao, Xmue, &fe));
+      if (!speculative) {
+        PetscCall(VecAXPBYPCZ(Xmue, 1 + nm->mu_e, -nm->mu_e, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+        PetscCall(TaoComputeObjective(tao, Xmue, &fe));
+      }
       if (fe < fr) {
         PetscCall(NelderMeadReplace(nm, nm->indices[nm->N], Xmue, fe));
       } else {
@@ -192,20 +212,23 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
       /* outside contraction */
       nm->noutcontract++;
       PetscCall(PetscInfo(0, "Outside Contraction\n"));
-      PetscCall(VecAXPBYPCZ(Xmuc, 1 + nm->mu_oc, -nm->mu_oc, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
-
-      PetscCall(TaoComputeObjective(tao, Xmuc, &fc));
-      if (fc <= fr) {
-        PetscCall(NelderMeadReplace(nm, nm->indices[nm->N], Xmuc, fc));
+      if (!speculative) {
+        PetscCall(VecAXPBYPCZ(Xmuc, 1 + nm->mu_oc, -nm->mu_oc, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+        PetscCall(TaoComputeObjective(tao, Xmuc, &foc));
+      }
+      if (foc <= fr) {
+        PetscCall(NelderMeadReplace(nm, nm->indices[nm->N], Xmuc, foc));
       } else shrink = 1;
     } else {
       /* inside contraction */
       nm->nincontract++;
       PetscCall(PetscInfo(0, "Inside Contraction\n"));
-      PetscCall(VecAXPBYPCZ(Xmuc, 1 + nm->mu_ic, -nm->mu_ic, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
-      PetscCall(TaoComputeObjective(tao, Xmuc, &fc));
-      if (fc < nm->f_values[nm->indices[nm->N]]) {
-        PetscCall(NelderMeadReplace(nm, nm->indices[nm->N], Xmuc, fc));
+      if (!speculative) {
+        PetscCall(VecAXPBYPCZ(Xmuic, 1 + nm->mu_ic, -nm->mu_ic, 0, Xbar, nm->simplex[nm->indices[nm->N]]));
+        PetscCall(TaoComputeObjective(tao, Xmuic, &fic));
+      }
+      if (fic < nm->f_values[nm->indices[nm->N]]) {
+        PetscCall(NelderMeadReplace(nm, nm->indices[nm->N], Xmuic, fic));
       } else shrink = 1;
     }
 
@@ -215,8 +238,10 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
 
       for (i = 1; i < nm->N + 1; i++) {
         PetscCall(VecAXPBY(nm->simplex[nm->indices[i]], 1.5, -0.5, nm->simplex[nm->indices[0]]));
-        PetscCall(TaoComputeObjective(tao, nm->simplex[nm->indices[i]], &nm->f_values[nm->indices[i]]));
+        nm->Xbatch[i - 1] = nm->simplex[nm->indices[i]];
       }
+      PetscCall(TaoComputeObjectiveBatch(tao, nm->N, nm->Xbatch, nm->fbatch));
+      for (i = 1; i < nm->N + 1; i++) nm->f_values[nm->indices[i]] = nm->fbatch[i - 1];
       PetscCall(VecAXPBY(Xbar, 1.5 * nm->oneOverN, -0.5, nm->simplex[nm->indices[0]]));
 
       /*  Add last vector's fraction of average */
@@ -235,9 +260,18 @@ static PetscErrorCode TaoSolve_NM(Tao tao)
 
  Options Database Keys:
 + -tao_nm_lambda - initial step length
-- -tao_nm_mu - expansion/contraction factor
+. -tao_nm_mu - expansion/contraction factor
+- -tao_nm_speculative - evaluate the reflection, expansion and both contraction points of an iteration together when a batch objective is provided
 
  Level: beginner
+
+ Note:
+ The points of the initial simplex and of a shrink step are evaluated with `TaoComputeObjectiveBatch()`, so they are evaluated
+ concurrently if the application provides `TaoSetObjectiveBatch()`. In that case each iteration also evaluates all its
+ trial points together by default, which trades up to three extra evaluations for a single round of concurrent evaluations.
+ The iterates are the same as with the sequential algorithm.
+
+.seealso: `Tao`, `TaoSetObjectiveBatch()`, `TAOPOUNDERS`
 M*/
 
 PETSC_EXTERN PetscErrorCode TaoCreate_NM(Tao tao)
@@ -266,5 +300,7 @@ PETSC_EXTERN PetscErrorCode TaoCreate_NM(Tao tao)
   nm->mu_r  = 1.0;
   nm->mu_e  = 2.0;
 
+  nm->speculative = PETSC_TRUE;
+
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -12,13 +12,17 @@ typedef struct {
 
   PetscInt  N;
   PetscReal oneOverN;
-  Vec       Xbar, Xmuc, Xmur, Xmue;
+  Vec       Xbar, Xmuc, Xmur, Xmue, Xmuic;
   Vec       G;
   Vec      *simplex;
 
   PetscReal *f_values;
   PetscInt  *indices;
 
+  PetscBool  speculative; /* evaluate all the trial points of an iteration with one batch, see TaoSetObjectiveBatch() */
+  Vec       *Xbatch;      /* points of a shrink step, evaluated together */
+  PetscReal *fbatch;
+
   PetscInt nshrink;
   PetscInt nexpand;
   PetscInt nreflect;
@@ -0,0 +1,808 @@
+/*
+  Code for integrating many small independent ODE systems of the same size together, with explicit Runge-Kutta or
+  Rosenbrock-W tableaux, per-instance adaptive time steps, and batched dense LU factorizations
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+
+typedef struct {
+  PetscInt           m;         /* size of each system */
+  PetscInt           n;         /* number of local instances */
+  char              *type;      /* name of the TSRK or TSROSW tableau */
+  PetscBool          implicit;  /* use a TSROSW tableau */
+  TSBatchRHSFunction rhsfunction;
+  void              *rhsfunctionctx;
+  TSBatchRHSJacobian rhsjacobian;
+  void              *rhsjacobianctx;
+
+  /* Tableau, copied from a TSRK or TSROSW at setup */
+  PetscInt   order, s;
+  PetscReal *A, *Gamma, *b, *bembed, *c;
+
+  /* Per-instance state */
+  PetscReal *time, *dt, *h, *stime, *err;
+  PetscInt  *nreject;   /* consecutive rejections */
+  PetscBool *singular;  /* the Rosenbrock matrix could not be factored */
+  PetscInt   accepted, rejected;
+
+  /* Instance-interleaved work arrays: entry j of instance i at j*n + i, entry (r,c) of a matrix at (r*m + c)*n + i */
+  PetscScalar *Y, *K, *F, *U1, *E, *J, *W;
+  PetscInt    *piv;
+} TS_Batch;
+
+/*
+  LU factorization with partial pivoting of the n interleaved m x m matrices W, with the loops over the instances innermost so
+  that they are vectorized. The row interchanges of each instance are stored in piv.
+*/
+static PetscErrorCode TSBatchLUFactor(PetscInt m, PetscInt n, PetscScalar *W, PetscInt *piv, PetscBool *singular)
+{
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < m; k++) {
+    for (PetscInt i = 0; i < n; i++) {
+      PetscInt  p   = k;
+      PetscReal big = PetscAbsScalar(W[(k * m + k) * n + i]);
+
+      for (PetscInt r = k + 1; r < m; r++) {
+        if (PetscAbsScalar(W[(r * m + k) * n + i]) > big) {
+          big = PetscAbsScalar(W[(r * m + k) * n + i]);
+          p   = r;
+        }
+      }
+      piv[k * n + i] = p;
+      if (p != k) {
+        for (PetscInt c = 0; c < m; c++) {
+          const PetscScalar w = W[(k * m + c) * n + i];
+
+          W[(k * m + c) * n + i] = W[(p * m + c) * n + i];
+          W[(p * m + c) * n + i] = w;
+        }
+      }
+      if (big == 0.0) {
+        singular[i]            = PETSC_TRUE;
+        W[(k * m + k) * n + i] = 1.0;
+      }
+    }
+    for (PetscInt r = k + 1; r < m; r++) {
+      PetscScalar       *wr = W + r * m * n;
+      const PetscScalar *wk = W + k * m * n;
+
+      PetscPragmaSIMD
+      for (PetscInt i = 0; i < n; i++) wr[k * n + i] /= wk[k * n + i];
+      for (PetscInt c = k + 1; c < m; c++) {
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < n; i++) wr[c * n + i] -= wr[k * n + i] * wk[c * n + i];
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Solves in place with the factors of TSBatchLUFactor() */
+static PetscErrorCode TSBatchLUSolve(PetscInt m, PetscInt n, const PetscScalar *W, const PetscInt *piv, PetscScalar *x)
+{
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < m; k++) {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt p = piv[k * n + i];
+
+      if (p != k) {
+        const PetscScalar v = x[k * n + i];
+
+        x[k * n + i] = x[p * n + i];
+        x[p * n + i] = v;
+      }
+    }
+  }
+  for (PetscInt r = 1; r < m; r++) {
+    for (PetscInt c = 0; c < r; c++) {
+      PetscPragmaSIMD
+      for (PetscInt i = 0; i < n; i++) x[r * n + i] -= W[(r * m + c) * n + i] * x[c * n + i];
+    }
+  }
+  for (PetscInt r = m - 1; r >= 0; r--) {
+    for (PetscInt c = r + 1; c < m; c++) {
+      PetscPragmaSIMD
+      for (PetscInt i = 0; i < n; i++) x[r * n + i] -= W[(r * m + c) * n + i] * x[c * n + i];
+    }
+    PetscPragmaSIMD
+    for (PetscInt i = 0; i < n; i++) x[r * n + i] /= W[(r * m + r) * n + i];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Jacobians of all instances at the states U, from the user or by finite differences in one component for all instances at once */
+static PetscErrorCode TSBatchComputeRHSJacobian(TS ts, const PetscReal t[], const PetscScalar *U)
+{
+  TS_Batch      *bt = (TS_Batch *)ts->data;
+  const PetscInt m = bt->m, n = bt->n;
+
+  PetscFunctionBegin;
+  if (bt->rhsjacobian) {
+    PetscCallBack("TSBatch callback Jacobian", (*bt->rhsjacobian)(ts, n, t, U, bt->J, bt->rhsjacobianctx));
+    ts->rhsjacs++;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCallBack("TSBatch callback function", (*bt->rhsfunction)(ts, n, t, U, bt->F, bt->rhsfunctionctx));
+  ts->rhsfuncs++;
+  for (PetscInt c = 0; c < m; c++) {
+    PetscCall(PetscArraycpy(bt->Y, U, m * n));
+    for (PetscInt i = 0; i < n; i++) bt->Y[c * n + i] += PETSC_SQRT_MACHINE_EPSILON * (1.0 + PetscAbsScalar(U[c * n + i]));
+    PetscCallBack("TSBatch callback function", (*bt->rhsfunction)(ts, n, t, bt->Y, bt->E, bt->rhsfunctionctx));
+    ts->rhsfuncs++;
+    for (PetscInt r = 0; r < m; r++) {
+      PetscPragmaSIMD
+      for (PetscInt i = 0; i < n; i++) bt->J[(r * m + c) * n + i] = (bt->E[r * n + i] - bt->F[r * n + i]) / (bt->Y[c * n + i] - U[c * n + i]);
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  One attempt of a step for every instance that has not reached the final time, each with its own time step. The stages are
+  computed for all instances, and the solution, time and time step of each instance are then updated according to its own
+  error estimate.
+*/
+static PetscErrorCode TSStep_Batch(TS ts)
+{
+  TS_Batch         *bt = (TS_Batch *)ts->data;
+  const PetscInt    m = bt->m, n = bt->n, s = bt->s;
+  const PetscReal   tf = ts->max_time;
+  PetscScalar      *U;
+  const PetscScalar *atol = NULL, *rtol = NULL;
+  PetscReal         safety, reject_safety, clip[2], hmin, hmax, scale_failed, gfact = 0.0, tmin = PETSC_MAX_REAL, dtmin = PETSC_MAX_REAL;
+  PetscBool         adapt, failed = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)ts->adapt, TSADAPTNONE, &adapt));
+  adapt = (PetscBool)(!adapt && bt->bembed);
+  PetscCall(TSAdaptGetSafety(ts->adapt, &safety, &reject_safety));
+  PetscCall(TSAdaptGetClip(ts->adapt, &clip[0], &clip[1]));
+  PetscCall(TSAdaptGetStepLimits(ts->adapt, &hmin, &hmax));
+  PetscCall(TSAdaptGetScaleSolveFailed(ts->adapt, &scale_failed));
+  if (ts->steprestart) {
+    for (PetscInt i = 0; i < n; i++) {
+      bt->time[i]    = ts->ptime;
+      bt->dt[i]      = ts->time_step;
+      bt->nreject[i] = 0;
+    }
+  }
+
+  /* Instances that reached the final time are masked with a zero step */
+  for (PetscInt i = 0; i < n; i++) {
+    bt->h[i]        = bt->time[i] < tf ? PetscMin(bt->dt[i], tf - bt->time[i]) : 0.0;
+    bt->singular[i] = PETSC_FALSE;
+    if (bt->h[i] > 0.0 && PetscIsCloseAtTol(bt->time[i] + bt->h[i], tf, 10 * PETSC_MACHINE_EPSILON * PetscAbsReal(tf), 0)) bt->h[i] = tf - bt->time[i];
+  }
+
+  PetscCall(VecGetArray(ts->vec_sol, &U));
+  if (bt->implicit) PetscCall(TSBatchComputeRHSJacobian(ts, bt->time, U));
+  for (PetscInt st = 0; st < s; st++) {
+    PetscScalar *Kst = bt->K + st * m * n;
+
+    /* Y = U + sum_j A[st][j] K_j, where K_j is the stage derivative for Runge-Kutta and the stage increment for Rosenbrock */
+    PetscCall(PetscArraycpy(bt->Y, U, m * n));
+    for (PetscInt j = 0; j < st; j++) {
+      const PetscReal    a  = bt->A[st * s + j];
+      const PetscScalar *Kj = bt->K + j * m * n;
+
+      if (a == 0.0) continue;
+      for (PetscInt r = 0; r < m; r++) {
+        if (bt->implicit) {
+          PetscPragmaSIMD
+          for (PetscInt i = 0; i < n; i++) bt->Y[r * n + i] += a * Kj[r * n + i];
+        } else {
+          PetscPragmaSIMD
+          for (PetscInt i = 0; i < n; i++) bt->Y[r * n + i] += a * bt->h[i] * Kj[r * n + i];
+        }
+      }
+    }
+    for (PetscInt i = 0; i < n; i++) bt->stime[i] = bt->time[i] + bt->c[st] * bt->h[i];
+    PetscCallBack("TSBatch callback function", (*bt->rhsfunction)(ts, n, bt->stime, bt->Y, bt->implicit ? bt->F : Kst, bt->rhsfunctionctx));
+    ts->rhsfuncs++;
+    if (bt->implicit) {
+      const PetscReal gamma = bt->Gamma[st * s + st];
+
+      /* (I - h gamma_ii J) K_st = h F(Y) + h J sum_j gamma_ij K_j */
+      PetscCall(PetscArrayzero(bt->E, m * n));
+      for (PetscInt j = 0; j < st; j++) {
+        const PetscReal    g  = bt->Gamma[st * s + j];
+        const PetscScalar *Kj = bt->K + j * m * n;
+
+        if (g == 0.0) continue;
+        for (PetscInt r = 0; r < m; r++) {
+          PetscPragmaSIMD
+          for (PetscInt i = 0; i < n; i++) bt->E[r * n + i] += g * Kj[r * n + i];
+        }
+      }
+      for (PetscInt r = 0; r < m; r++) {
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < n; i++) Kst[r * n + i] = bt->F[r * n + i];
+        for (PetscInt c = 0; c < m; c++) {
+          PetscPragmaSIMD
+          for (PetscInt i = 0; i < n; i++) Kst[r * n + i] += bt->J[(r * m + c) * n + i] * bt->E[c * n + i];
+        }
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < n; i++) Kst[r * n + i] *= bt->h[i];
+      }
+      if (gamma != 0.0) {
+        /* The methods usually have a single diagonal coefficient, so that the factorization is shared by the stages */
+        if (gamma != gfact) {
+          for (PetscInt r = 0; r < m; r++) {
+            for (PetscInt c = 0; c < m; c++) {
+              PetscPragmaSIMD
+              for (PetscInt i = 0; i < n; i++) bt->W[(r * m + c) * n + i] = (r == c ? 1.0 : 0.0) - bt->h[i] * gamma * bt->J[(r * m + c) * n + i];
+            }
+          }
+          PetscCall(TSBatchLUFactor(m, n, bt->W, bt->piv, bt->singular));
+          gfact = gamma;
+        }
+        PetscCall(TSBatchLUSolve(m, n, bt->W, bt->piv, Kst));
+      }
+    }
+  }
+
+  /* Completion, and the error estimate with the embedded method */
+  PetscCall(PetscArraycpy(bt->U1, U, m * n));
+  PetscCall(PetscArrayzero(bt->E, m * n));
+  for (PetscInt j = 0; j < s; j++) {
+    const PetscReal    bj = bt->b[j], ej = bt->bembed ? bt->b[j] - bt->bembed[j] : 0.0;
+    const PetscScalar *Kj = bt->K + j * m * n;
+
+    for (PetscInt r = 0; r < m; r++) {
+      if (bt->implicit) {
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < n; i++) {
+          bt->U1[r * n + i] += bj * Kj[r * n + i];
+          bt->E[r * n + i] += ej * Kj[r * n + i];
+        }
+      } else {
+        PetscPragmaSIMD
+        for (PetscInt i = 0; i < n; i++) {
+          bt->U1[r * n + i] += bj * bt->h[i] * Kj[r * n + i];
+          bt->E[r * n + i] += ej * bt->h[i] * Kj[r * n + i];
+        }
+      }
+    }
+  }
+  if (ts->vatol) PetscCall(VecGetArrayRead(ts->vatol, &atol));
+  if (ts->vrtol) PetscCall(VecGetArrayRead(ts->vrtol, &rtol));
+  PetscCall(PetscArrayzero(bt->err, n));
+  for (PetscInt r = 0; r < m; r++) {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt  k   = r * n + i;
+      const PetscReal tol = (atol ? PetscRealPart(atol[k]) : ts->atol) + (rtol ? PetscRealPart(rtol[k]) : ts->rtol) * PetscMax(PetscAbsScalar(U[k]), PetscAbsScalar(bt->U1[k]));
+      const PetscReal e   = PetscAbsScalar(bt->E[k]) / tol;
+
+      bt->err[i] += e * e;
+    }
+  }
+  if (ts->vatol) PetscCall(VecRestoreArrayRead(ts->vatol, &atol));
+  if (ts->vrtol) PetscCall(VecRestoreArrayRead(ts->vrtol, &rtol));
+
+  /* Accept or reject the step of each instance, and choose its next step */
+  for (PetscInt i = 0; i < n; i++) {
+    PetscReal err = PetscSqrtReal(bt->err[i] / m), hfac;
+    PetscBool accept;
+
+    if (bt->h[i] == 0.0) continue;
+    for (PetscInt r = 0; r < m; r++) {
+      if (PetscIsInfOrNanScalar(bt->U1[r * n + i])) bt->singular[i] = PETSC_TRUE;
+    }
+    if (bt->singular[i] || PetscIsInfOrNanReal(err)) {
+      accept = PETSC_FALSE;
+      hfac   = scale_failed;
+    } else if (!adapt) {
+      accept = PETSC_TRUE;
+      hfac   = 1.0;
+    } else {
+      const PetscReal sf = bt->nreject[i] ? safety * reject_safety : safety;
+
+      accept = (PetscBool)(err <= 1.0 || bt->h[i] < (1 + PETSC_SQRT_MACHINE_EPSILON) * hmin);
+      hfac   = err > 0.0 ? sf * PetscPowReal(err, -1.0 / bt->order) : clip[1];
+      hfac   = PetscClipInterval(hfac, clip[0], clip[1]);
+    }
+    if (accept) {
+      for (PetscInt r = 0; r < m; r++) U[r * n + i] = bt->U1[r * n + i];
+      bt->time[i]    = bt->h[i] == tf - bt->time[i] ? tf : bt->time[i] + bt->h[i];
+      bt->nreject[i] = 0;
+      bt->accepted++;
+    } else {
+      bt->nreject[i]++;
+      bt->rejected++;
+      if (ts->max_reject >= 0 && bt->nreject[i] > ts->max_reject) failed = PETSC_TRUE;
+    }
+    if (adapt || !accept) bt->dt[i] = PetscClipInterval(bt->h[i] * hfac, hmin, hmax);
+  }
+  PetscCall(VecRestoreArray(ts->vec_sol, &U));
+
+  /* The TS is at the earliest time of its instances */
+  for (PetscInt i = 0; i < n; i++) {
+    tmin = PetscMin(tmin, bt->time[i]);
+    if (bt->time[i] < tf) dtmin = PetscMin(dtmin, bt->dt[i]);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &tmin, 1, MPIU_REAL, MPIU_MIN, PetscObjectComm((PetscObject)ts)));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &dtmin, 1, MPIU_REAL, MPIU_MIN, PetscObjectComm((PetscObject)ts)));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &failed, 1, MPIU_BOOL, MPI_LOR, PetscObjectComm((PetscObject)ts)));
+  ts->ptime = tmin < PETSC_MAX_REAL ? tmin : tf;
+  if (dtmin < PETSC_MAX_REAL) ts->time_step = dtmin;
+  if (failed) ts->reason = TS_DIVERGED_STEP_REJECTED;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchTableauReset(TS ts)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree5(bt->A, bt->Gamma, bt->b, bt->bembed, bt->c));
+  bt->s = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSReset_Batch(TS ts)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSBatchTableauReset(ts));
+  PetscCall(PetscFree7(bt->time, bt->dt, bt->h, bt->stime, bt->err, bt->nreject, bt->singular));
+  PetscCall(PetscFree7(bt->Y, bt->K, bt->F, bt->U1, bt->E, bt->J, bt->W));
+  PetscCall(PetscFree(bt->piv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSDestroy_Batch(TS ts)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSReset_Batch(ts));
+  PetscCall(PetscFree(bt->type));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetSystemSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetSystemSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRKType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRosWType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetStepCounts_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Copies the tableau of the chosen TSRK or TSROSW type, queried from a TS of that type */
+static PetscErrorCode TSBatchTableauSetUp(TS ts)
+{
+  TS_Batch        *bt = (TS_Batch *)ts->data;
+  TS               tab;
+  PetscInt         s;
+  const PetscReal *A, *Gamma = NULL, *b, *bembed, *c = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(TSCreate(PETSC_COMM_SELF, &tab));
+  if (bt->implicit) {
+    PetscCall(TSSetType(tab, TSROSW));
+    PetscCall(TSRosWSetType(tab, bt->type));
+    PetscCall(TSRosWGetTableau(tab, &bt->order, &s, &A, &Gamma, &b, &bembed));
+  } else {
+    PetscCall(TSSetType(tab, TSRK));
+    PetscCall(TSRKSetType(tab, bt->type));
+    PetscCall(TSRKGetTableau(tab, &s, &A, &b, &c, &bembed, NULL, NULL, NULL));
+    PetscCall(TSRKGetOrder(tab, &bt->order));
+  }
+  bt->s = s;
+  PetscCall(PetscMalloc5(s * s, &bt->A, s * s, &bt->Gamma, s, &bt->b, bembed ? s : 0, &bt->bembed, s, &bt->c));
+  PetscCall(PetscArraycpy(bt->A, A, s * s));
+  PetscCall(PetscArraycpy(bt->b, b, s));
+  if (bembed) PetscCall(PetscArraycpy(bt->bembed, bembed, s));
+  else bt->bembed = NULL;
+  if (Gamma) PetscCall(PetscArraycpy(bt->Gamma, Gamma, s * s));
+  else PetscCall(PetscArrayzero(bt->Gamma, s * s));
+  /* Rosenbrock stages are at the row sums of A */
+  for (PetscInt i = 0; i < s; i++) {
+    bt->c[i] = 0.0;
+    if (c) bt->c[i] = c[i];
+    else
+      for (PetscInt j = 0; j < s; j++) bt->c[i] += A[i * s + j];
+  }
+  PetscCall(TSDestroy(&tab));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetUp_Batch(TS ts)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+  PetscInt  N, m, n, s;
+
+  PetscFunctionBegin;
+  PetscCheck(bt->rhsfunction, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Must call TSBatchSetRHSFunction() first");
+  PetscCheck(bt->m > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Must call TSBatchSetSystemSize() first");
+  PetscCall(VecGetLocalSize(ts->vec_sol, &N));
+  PetscCheck(N % bt->m == 0, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local solution size %" PetscInt_FMT " is not a multiple of the system size %" PetscInt_FMT, N, bt->m);
+  PetscCall(TSBatchTableauSetUp(ts));
+  m     = bt->m;
+  n     = N / m;
+  s     = bt->s;
+  bt->n = n;
+  PetscCall(PetscMalloc7(n, &bt->time, n, &bt->dt, n, &bt->h, n, &bt->stime, n, &bt->err, n, &bt->nreject, n, &bt->singular));
+  PetscCall(PetscMalloc7(m * n, &bt->Y, s * m * n, &bt->K, m * n, &bt->F, m * n, &bt->U1, m * n, &bt->E, bt->implicit ? m * m * n : 0, &bt->J, bt->implicit ? m * m * n : 0, &bt->W));
+  PetscCall(PetscMalloc1(bt->implicit ? m * n : 0, &bt->piv));
+  for (PetscInt i = 0; i < n; i++) {
+    bt->time[i]    = ts->ptime;
+    bt->dt[i]      = ts->time_step;
+    bt->nreject[i] = 0;
+  }
+  if (!bt->bembed) PetscCall(TSAdaptSetType(ts->adapt, TSADAPTNONE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetFromOptions_Batch(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+  char      type[256];
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Batch ODE solver options");
+  {
+    PetscCall(PetscOptionsInt("-ts_batch_system_size", "Size of each system", "TSBatchSetSystemSize", bt->m, &bt->m, NULL));
+    PetscCall(PetscOptionsString("-ts_batch_rk_type", "Explicit Runge-Kutta tableau", "TSBatchSetRKType", bt->implicit ? TSRK3BS : bt->type, type, sizeof(type), &flg));
+    if (flg) PetscCall(TSBatchSetRKType(ts, type));
+    PetscCall(PetscOptionsString("-ts_batch_rosw_type", "Rosenbrock-W tableau", "TSBatchSetRosWType", bt->implicit ? bt->type : TSROSWRA34PW2, type, sizeof(type), &flg));
+    if (flg) PetscCall(TSBatchSetRosWType(ts, type));
+  }
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSView_Batch(TS ts, PetscViewer viewer)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+  PetscBool iascii;
+  PetscInt  counts[3] = {bt->n, bt->accepted, bt->rejected};
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, counts, 3, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)ts)));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  %s tableau: %s\n", bt->implicit ? "Rosenbrock-W" : "Runge-Kutta", bt->type));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  system size %" PetscInt_FMT ", number of instances %" PetscInt_FMT "\n", bt->m, counts[0]));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  accepted instance steps %" PetscInt_FMT ", rejected instance steps %" PetscInt_FMT "\n", counts[1], counts[2]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetSystemSize_Batch(TS ts, PetscInt m)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(m > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "System size %" PetscInt_FMT " must be positive", m);
+  if (m != bt->m) PetscCall(TSReset(ts));
+  bt->m = m;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchGetSystemSize_Batch(TS ts, PetscInt *m)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  *m = bt->m;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRHSFunction_Batch(TS ts, TSBatchRHSFunction f, void *ctx)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  bt->rhsfunction    = f;
+  bt->rhsfunctionctx = ctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRHSJacobian_Batch(TS ts, TSBatchRHSJacobian f, void *ctx)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  bt->rhsjacobian    = f;
+  bt->rhsjacobianctx = ctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetType_Private(TS ts, const char type[], PetscBool implicit)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+  PetscBool match;
+
+  PetscFunctionBegin;
+  PetscCall(PetscStrcmp(bt->type, type, &match));
+  if (match && implicit == bt->implicit) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ts->setupcalled) PetscCall(TSReset(ts));
+  PetscCall(PetscFree(bt->type));
+  PetscCall(PetscStrallocpy(type, &bt->type));
+  bt->implicit = implicit;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRKType_Batch(TS ts, TSRKType type)
+{
+  PetscFunctionBegin;
+  PetscCall(TSBatchSetType_Private(ts, type, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRosWType_Batch(TS ts, TSRosWType type)
+{
+  PetscFunctionBegin;
+  PetscCall(TSBatchSetType_Private(ts, type, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchGetStepCounts_Batch(TS ts, PetscInt *accepted, PetscInt *rejected)
+{
+  TS_Batch *bt = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  if (accepted) *accepted = bt->accepted;
+  if (rejected) *rejected = bt->rejected;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSBatchSetSystemSize - Sets the size of each of the independent systems integrated by a `TSBATCH`
+
+   Logically Collective
+
+   Input Parameters:
++  ts - timestepping context
+-  m - size of each system
+
+   Options Database Key:
+.  -ts_batch_system_size <m> - Size of each system
+
+   Level: intermediate
+
+   Note:
+   The local size of the solution vector must be a multiple of `m`, the number of local instances is the quotient.
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSBatchGetSystemSize()`, `TSBatchSetRHSFunction()`
+@*/
+PetscErrorCode TSBatchSetSystemSize(TS ts, PetscInt m)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, m, 2);
+  PetscTryMethod(ts, "TSBatchSetSystemSize_C", (TS, PetscInt), (ts, m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSBatchGetSystemSize - Gets the size of each of the independent systems integrated by a `TSBATCH`
+
+   Not Collective
+
+   Input Parameter:
+.  ts - timestepping context
+
+   Output Parameter:
+.  m - size of each system
+
+   Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSBatchSetSystemSize()`
+@*/
+PetscErrorCode TSBatchGetSystemSize(TS ts, PetscInt *m)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidIntPointer(m, 2);
+  PetscUseMethod(ts, "TSBatchGetSystemSize_C", (TS, PetscInt *), (ts, m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   TSBatchSetRHSFunction - Sets the routine evaluating the right hand side of all the instances of a `TSBATCH` at once
+
+   Logically Collective
+
+   Input Parameters:
++  ts - timestepping context
+.  f - routine evaluating the right hand side
+-  ctx - [optional] user-defined context for the routine (may be `NULL`)
+
+   Calling sequence of f:
+$     PetscErrorCode f(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], PetscScalar F[], void *ctx);
+
++   ts - timestepping context
+.   n - number of local instances
+.   t - time of each instance
+.   u - states of the instances, interleaved so that component j of instance i is u[j*n + i]
+.   F - right hand sides of the instances, with the same layout
+-   ctx - [optional] user-defined context
+
+   Level: intermediate
+
+   Note:
+   The routine is always called for all the local instances, so that the loops over the instances can be vectorized. The
+   results of the instances that have reached the final time, or whose step is discarded, are ignored.
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSBatchSetRHSJacobian()`, `TSBatchSetSystemSize()`
+@*/
+PetscErrorCode TSBatchSetRHSFunction(TS ts, TSBatchRHSFunction f, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSBatchSetRHSFunction_C", (TS, TSBatchRHSFunction, void *), (ts, f, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   TSBatchSetRHSJacobian - Sets the routine evaluating the Jacobians of the right hand side of all the instances of a `TSBATCH`
+   at once, used by the Rosenbrock-W methods
+
+   Logically Collective
+
+   Input Parameters:
++  ts - timestepping context
+.  f - routine evaluating the Jacobians
+-  ctx - [optional] user-defined context for the routine (may be `NULL`)
+
+   Calling sequence of f:
+$     PetscErrorCode f(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], PetscScalar J[], void *ctx);
+
++   ts - timestepping context
+.   n - number of local instances
+.   t - time of each instance
+.   u - states of the instances, interleaved so that component j of instance i is u[j*n + i]
+.   J - dense Jacobians of the instances, interleaved so that entry (r,c) of instance i is J[(r*m + c)*n + i] for systems of size m
+-   ctx - [optional] user-defined context
+
+   Level: intermediate
+
+   Note:
+   Without this routine, the Jacobians are computed by finite differences, perturbing one component of all the instances at once.
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSBatchSetRHSFunction()`, `TSBatchSetRosWType()`
+@*/
+PetscErrorCode TSBatchSetRHSJacobian(TS ts, TSBatchRHSJacobian f, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSBatchSetRHSJacobian_C", (TS, TSBatchRHSJacobian, void *), (ts, f, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   TSBatchSetRKType - Integrates the instances of a `TSBATCH` with the tableau of an explicit Runge-Kutta method
+
+   Logically Collective
+
+   Input Parameters:
++  ts - timestepping context
+-  type - a `TSRKType`, such as `TSRK3BS` (the default) or `TSRK5DP`
+
+   Options Database Key:
+.  -ts_batch_rk_type <type> - Explicit Runge-Kutta tableau
+
+   Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSRKType`, `TSBatchSetRosWType()`
+@*/
+PetscErrorCode TSBatchSetRKType(TS ts, TSRKType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidCharPointer(type, 2);
+  PetscTryMethod(ts, "TSBatchSetRKType_C", (TS, TSRKType), (ts, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   TSBatchSetRosWType - Integrates the instances of a `TSBATCH` with the tableau of a Rosenbrock-W method, for stiff systems
+
+   Logically Collective
+
+   Input Parameters:
++  ts - timestepping context
+-  type - a `TSRosWType`, such as `TSROSWRA34PW2`
+
+   Options Database Key:
+.  -ts_batch_rosw_type <type> - Rosenbrock-W tableau
+
+   Level: intermediate
+
+   Note:
+   The Jacobians are evaluated once per step at the start of the step, and the time derivative of the right hand side is
+   neglected, as in a W-method.
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSRosWType`, `TSBatchSetRKType()`, `TSBatchSetRHSJacobian()`
+@*/
+PetscErrorCode TSBatchSetRosWType(TS ts, TSRosWType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidCharPointer(type, 2);
+  PetscTryMethod(ts, "TSBatchSetRosWType_C", (TS, TSRosWType), (ts, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSBatchGetStepCounts - Gets the number of accepted and rejected steps summed over the local instances of a `TSBATCH`
+
+   Not Collective
+
+   Input Parameter:
+.  ts - timestepping context
+
+   Output Parameters:
++  accepted - number of accepted instance steps
+-  rejected - number of rejected instance steps
+
+   Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSBATCH`, `TSGetStepNumber()`
+@*/
+PetscErrorCode TSBatchGetStepCounts(TS ts, PetscInt *accepted, PetscInt *rejected)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscUseMethod(ts, "TSBatchGetStepCounts_C", (TS, PetscInt *, PetscInt *), (ts, accepted, rejected));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+      TSBATCH - ODE solver integrating many small independent systems of the same size together
+
+   Options Database Keys:
++  -ts_batch_system_size <m> - Size of each system
+.  -ts_batch_rk_type <type> - Integrate with an explicit Runge-Kutta tableau, see `TSRKType`
+-  -ts_batch_rosw_type <type> - Integrate with a Rosenbrock-W tableau, see `TSRosWType`
+
+   Level: intermediate
+
+   Notes:
+   The solution vector holds the states of the instances interleaved, component j of instance i at local index j*n + i for n
+   local instances, so that the stages of all instances are computed by loops that vectorize over the instances. The right hand
+   sides, and for Rosenbrock-W methods their dense Jacobians, are evaluated for all the local instances at once by the routines
+   set with `TSBatchSetRHSFunction()` and `TSBatchSetRHSJacobian()`. The linear systems of the Rosenbrock-W stages are solved by
+   LU factorizations with partial pivoting batched over the instances. No `SNES`, `KSP` or `Mat` is created.
+
+   Each instance has its own time and time step, chosen from the embedded error estimate of the tableau with the tolerances of
+   `TSSetTolerances()` and the safety factors, clipping and step limits of the `TSAdapt`; use `-ts_adapt_type none` for fixed time
+   steps. A step of the `TS` attempts one step for every instance that has not reached the final time, masking the others; the
+   time of the `TS` is the earliest time of its instances. All instances stop exactly at the final time.
+
+   The instances are distributed with the solution vector, each process integrating its own instances without communication
+   except for the reductions computing the time of the `TS`.
+
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSBatchSetSystemSize()`, `TSBatchSetRHSFunction()`, `TSBatchSetRHSJacobian()`, `TSBatchSetRKType()`, `TSBatchSetRosWType()`, `TSRK`, `TSROSW`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Batch(TS ts)
+{
+  TS_Batch *bt;
+
+  PetscFunctionBegin;
+  PetscCall(TSRKInitializePackage());
+  PetscCall(TSRosWInitializePackage());
+  ts->ops->reset          = TSReset_Batch;
+  ts->ops->destroy        = TSDestroy_Batch;
+  ts->ops->view           = TSView_Batch;
+  ts->ops->setup          = TSSetUp_Batch;
+  ts->ops->step           = TSStep_Batch;
+  ts->ops->setfromoptions = TSSetFromOptions_Batch;
+  ts->default_adapt_type  = TSADAPTBASIC;
+
+  PetscCall(PetscNew(&bt));
+  ts->data = (void *)bt;
+  PetscCall(PetscStrallocpy(TSRK3BS, &bt->type));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetSystemSize_C", TSBatchSetSystemSize_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetSystemSize_C", TSBatchGetSystemSize_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", TSBatchSetRHSFunction_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", TSBatchSetRHSJacobian_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRKType_C", TSBatchSetRKType_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRosWType_C", TSBatchSetRosWType_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetStepCounts_C", TSBatchGetStepCounts_Batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
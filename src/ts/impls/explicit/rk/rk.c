@@ -669,6 +669,7 @@ static PetscErrorCode TSRollBack_RK(TS ts)
   }
   for (j = 0; j < s; j++) w[j] = -h * b[j];
   PetscCall(VecMAXPY(ts->vec_sol, s, w, YdotRHS));
+  rk->wlte_valid = PETSC_FALSE;
   if (quadts && ts->costintegralfwd) {
     for (j = 0; j < s; j++) {
       /* Revert the quadrature TS solution */
@@ -783,6 +784,160 @@ static PetscErrorCode TSForwardReset_RK(TS ts)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  The fused updates below replace the copies, VecMAXPY() and error norm of the stages and of the completion by single passes
+  over memory. The entries are processed in blocks that stay in cache while the stage derivatives are accumulated, so that
+  the inner loops vectorize. They are used for the standard host vector types only.
+*/
+#define TSRK_FUSED_BLOCK 256
+
+static PetscErrorCode TSRKUseFused_Private(TS ts, PetscBool *fused)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+
+  PetscFunctionBegin;
+  *fused = PETSC_FALSE;
+  if (!rk->fused || rk->use_multirate || rk->dtratio != 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)ts->vec_sol, fused, VECSEQ, VECMPI, ""));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Y = U + sum_j w[j] YdotRHS[j] for the first nk stage derivatives */
+static PetscErrorCode TSRKStageFused_Private(TS ts, Vec Y, PetscInt nk, const PetscScalar *w)
+{
+  TS_RK              *rk = (TS_RK *)ts->data;
+  const PetscScalar **k  = (const PetscScalar **)rk->karray, *u;
+  PetscScalar        *y;
+  PetscInt            n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(Y, &n));
+  PetscCall(VecGetArrayRead(ts->vec_sol, &u));
+  PetscCall(VecGetArrayWrite(Y, &y));
+  for (PetscInt j = 0; j < nk; j++) PetscCall(VecGetArrayRead(rk->YdotRHS[j], &k[j]));
+  for (PetscInt i0 = 0; i0 < n; i0 += TSRK_FUSED_BLOCK) {
+    const PetscInt i1 = PetscMin(n, i0 + TSRK_FUSED_BLOCK);
+
+    PetscPragmaSIMD
+    for (PetscInt i = i0; i < i1; i++) y[i] = u[i];
+    for (PetscInt j = 0; j < nk; j++) {
+      const PetscScalar a = w[j], *kj = k[j];
+
+      PetscPragmaSIMD
+      for (PetscInt i = i0; i < i1; i++) y[i] += a * kj[i];
+    }
+  }
+  for (PetscInt j = 0; j < nk; j++) PetscCall(VecRestoreArrayRead(rk->YdotRHS[j], &k[j]));
+  PetscCall(VecRestoreArrayWrite(Y, &y));
+  PetscCall(VecRestoreArrayRead(ts->vec_sol, &u));
+  PetscCall(PetscLogFlops(2.0 * nk * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Completes the step in place, U += h sum_j b[j] YdotRHS[j], and with estimate computes on the fly the weighted norm of the
+  difference with the embedded method, as TSErrorWeightedNorm() does, for TSEvaluateWLTE_RK()
+*/
+static PetscErrorCode TSRKCompleteFused_Private(TS ts, PetscReal h, PetscBool estimate)
+{
+  TS_RK              *rk  = (TS_RK *)ts->data;
+  RKTableau           tab = rk->tableau;
+  const PetscInt      s   = tab->s;
+  const PetscScalar **k = (const PetscScalar **)rk->karray, *atol = NULL, *rtol = NULL;
+  PetscScalar        *w = rk->work, *we = rk->ework, *u, e[TSRK_FUSED_BLOCK];
+  PetscReal           err[2] = {0.0, 0.0}, ignore = ts->adapt->ignore_max;
+  NormType            wnormtype = ts->adapt->wnormtype;
+  PetscInt            n;
+
+  PetscFunctionBegin;
+  for (PetscInt j = 0; j < s; j++) {
+    w[j]  = h * tab->b[j];
+    we[j] = estimate ? h * (tab->b[j] - tab->bembed[j]) : 0.0;
+  }
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  PetscCall(VecGetArray(ts->vec_sol, &u));
+  for (PetscInt j = 0; j < s; j++) PetscCall(VecGetArrayRead(rk->YdotRHS[j], &k[j]));
+  if (estimate && ts->vatol) PetscCall(VecGetArrayRead(ts->vatol, &atol));
+  if (estimate && ts->vrtol) PetscCall(VecGetArrayRead(ts->vrtol, &rtol));
+  for (PetscInt i0 = 0; i0 < n; i0 += TSRK_FUSED_BLOCK) {
+    const PetscInt i1 = PetscMin(n, i0 + TSRK_FUSED_BLOCK);
+
+    if (!estimate) {
+      for (PetscInt j = 0; j < s; j++) {
+        const PetscScalar a = w[j], *kj = k[j];
+
+        PetscPragmaSIMD
+        for (PetscInt i = i0; i < i1; i++) u[i] += a * kj[i];
+      }
+      continue;
+    }
+    for (PetscInt i = i0; i < i1; i++) e[i - i0] = 0.0;
+    for (PetscInt j = 0; j < s; j++) {
+      const PetscScalar a = w[j], ae = we[j], *kj = k[j];
+
+      PetscPragmaSIMD
+      for (PetscInt i = i0; i < i1; i++) {
+        u[i] += a * kj[i];
+        e[i - i0] += ae * kj[i];
+      }
+    }
+    /* The embedded solution is U - E */
+    for (PetscInt i = i0; i < i1; i++) {
+      const PetscReal ua = PetscAbsScalar(u[i]), ya = PetscAbsScalar(u[i] - e[i - i0]), diff = PetscAbsScalar(e[i - i0]);
+      PetscReal       tol;
+
+      if (ua < ignore || ya < ignore) continue;
+      tol = (atol ? PetscRealPart(atol[i]) : ts->atol) + (rtol ? PetscRealPart(rtol[i]) : ts->rtol) * PetscMax(ua, ya);
+      if (tol > 0.) {
+        if (wnormtype == NORM_2) {
+          err[0] += PetscSqr(diff / tol);
+          err[1] += 1;
+        } else err[0] = PetscMax(err[0], diff / tol);
+      }
+    }
+  }
+  if (rtol) PetscCall(VecRestoreArrayRead(ts->vrtol, &rtol));
+  if (atol) PetscCall(VecRestoreArrayRead(ts->vatol, &atol));
+  for (PetscInt j = 0; j < s; j++) PetscCall(VecRestoreArrayRead(rk->YdotRHS[j], &k[j]));
+  PetscCall(VecRestoreArray(ts->vec_sol, &u));
+  PetscCall(PetscLogFlops((estimate ? 4.0 : 2.0) * s * n));
+  if (estimate) {
+    if (wnormtype == NORM_2) {
+      PetscCall(MPIU_Allreduce(MPI_IN_PLACE, err, 2, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)ts)));
+      rk->wlte = err[1] > 0. ? PetscSqrtReal(err[0] / err[1]) : 0.;
+    } else {
+      PetscCall(MPIU_Allreduce(MPI_IN_PLACE, err, 1, MPIU_REAL, MPIU_MAX, PetscObjectComm((PetscObject)ts)));
+      rk->wlte = err[0];
+    }
+    PetscCheck(!PetscIsInfOrNanReal(rk->wlte), PetscObjectComm((PetscObject)ts), PETSC_ERR_FP, "Infinite or not-a-number generated in norm");
+    rk->wlte_type  = wnormtype;
+    rk->wlte_valid = PETSC_TRUE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSEvaluateWLTE_RK(TS ts, NormType wnormtype, PetscInt *order, PetscReal *wlte)
+{
+  TS_RK    *rk  = (TS_RK *)ts->data;
+  RKTableau tab = rk->tableau;
+
+  PetscFunctionBegin;
+  if (rk->wlte_valid && rk->wlte_type == wnormtype) *wlte = rk->wlte;
+  else {
+    DM        dm;
+    Vec       Y;
+    PetscReal wltea, wlter;
+
+    PetscCall(TSGetDM(ts, &dm));
+    PetscCall(DMGetGlobalVector(dm, &Y));
+    PetscCall(TSEvaluateStep(ts, tab->order - 1, Y, NULL));
+    PetscCall(TSErrorWeightedNorm(ts, ts->vec_sol, Y, wnormtype, wlte, &wltea, &wlter));
+    PetscCall(DMRestoreGlobalVector(dm, &Y));
+  }
+  if (order) *order = tab->order;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSStep_RK(TS ts)
 {
   TS_RK           *rk  = (TS_RK *)ts->data;
@@ -797,21 +952,32 @@ static PetscErrorCode TSStep_RK(TS ts)
   PetscInt         rejections = 0;
   PetscBool        stageok, accept = PETSC_TRUE;
   PetscReal        next_time_step = ts->time_step;
+  PetscBool        fused, estimate = PETSC_FALSE;
 
   PetscFunctionBegin;
   if (ts->steprollback || ts->steprestart) FSAL = PETSC_FALSE;
   if (FSAL) PetscCall(VecCopy(YdotRHS[s - 1], YdotRHS[0]));
+  PetscCall(TSRKUseFused_Private(ts, &fused));
+  /* Only the adaptors that use TSEvaluateWLTE() need the error estimate */
+  if (fused && tab->bembed) {
+    PetscCall(TSGetAdapt(ts, &adapt));
+    PetscCall(PetscObjectTypeCompareAny((PetscObject)adapt, &estimate, TSADAPTBASIC, TSADAPTDSP, ""));
+  }
 
   rk->status = TS_STEP_INCOMPLETE;
   while (!ts->reason && rk->status != TS_STEP_COMPLETE) {
     PetscReal t = ts->ptime;
     PetscReal h = ts->time_step;
+    rk->wlte_valid = PETSC_FALSE;
     for (i = 0; i < s; i++) {
       rk->stage_time = t + h * c[i];
       PetscCall(TSPreStage(ts, rk->stage_time));
-      PetscCall(VecCopy(ts->vec_sol, Y[i]));
       for (j = 0; j < i; j++) w[j] = h * A[i * s + j];
-      PetscCall(VecMAXPY(Y[i], i, w, YdotRHS));
+      if (fused) PetscCall(TSRKStageFused_Private(ts, Y[i], i, w));
+      else {
+        PetscCall(VecCopy(ts->vec_sol, Y[i]));
+        PetscCall(VecMAXPY(Y[i], i, w, YdotRHS));
+      }
       PetscCall(TSPostStage(ts, rk->stage_time, i, Y));
       PetscCall(TSGetAdapt(ts, &adapt));
       PetscCall(TSAdaptCheckStage(adapt, ts, rk->stage_time, Y[i], &stageok));
@@ -821,7 +987,8 @@ static PetscErrorCode TSStep_RK(TS ts)
     }
 
     rk->status = TS_STEP_INCOMPLETE;
-    PetscCall(TSEvaluateStep(ts, tab->order, ts->vec_sol, NULL));
+    if (fused) PetscCall(TSRKCompleteFused_Private(ts, h, estimate));
+    else PetscCall(TSEvaluateStep(ts, tab->order, ts->vec_sol, NULL));
     rk->status = TS_STEP_PENDING;
     PetscCall(TSGetAdapt(ts, &adapt));
     PetscCall(TSAdaptCandidatesClear(adapt));
@@ -1098,6 +1265,7 @@ static PetscErrorCode TSRKTableauReset(TS ts)
   PetscFunctionBegin;
   if (!tab) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCall(PetscFree(rk->work));
+  PetscCall(PetscFree2(rk->karray, rk->ework));
   PetscCall(VecDestroyVecs(tab->s, &rk->Y));
   PetscCall(VecDestroyVecs(tab->s, &rk->YdotRHS));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1146,6 +1314,7 @@ static PetscErrorCode TSRKTableauSetUp(TS ts)
 
   PetscFunctionBegin;
   PetscCall(PetscMalloc1(tab->s, &rk->work));
+  PetscCall(PetscMalloc2(tab->s, &rk->karray, tab->s, &rk->ework));
   PetscCall(VecDuplicateVecs(ts->vec_sol, tab->s, &rk->Y));
   PetscCall(VecDuplicateVecs(ts->vec_sol, tab->s, &rk->YdotRHS));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1195,6 +1364,7 @@ static PetscErrorCode TSSetFromOptions_RK(TS ts, PetscOptionItems *PetscOptionsO
     PetscCall(PetscOptionsEList("-ts_rk_type", "Family of RK method", "TSRKSetType", (const char *const *)namelist, count, rk->tableau->name, &choice, &flg));
     if (flg) PetscCall(TSRKSetType(ts, namelist[choice]));
     PetscCall(PetscFree(namelist));
+    PetscCall(PetscOptionsBool("-ts_rk_fused", "Form the stages, the completion and the error estimate in single passes over memory", "TSRKSetFused", rk->fused, &rk->fused, NULL));
   }
   PetscOptionsHeadEnd();
   PetscOptionsBegin(PetscObjectComm((PetscObject)ts), NULL, "Multirate methods options", "");
@@ -1378,6 +1548,8 @@ static PetscErrorCode TSDestroy_RK(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetTableau_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirate_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetMultirate_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetFused_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetFused_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSSetUp_RK_MultirateSplit_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSReset_RK_MultirateSplit_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSSetUp_RK_MultirateNonsplit_C", NULL));
@@ -1466,6 +1638,83 @@ PetscErrorCode TSRKGetMultirate(TS ts, PetscBool *use_multirate)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode TSRKSetFused_RK(TS ts, PetscBool fused)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+
+  PetscFunctionBegin;
+  rk->fused = fused;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSRKGetFused_RK(TS ts, PetscBool *fused)
+{
+  TS_RK *rk = (TS_RK *)ts->data;
+
+  PetscFunctionBegin;
+  *fused = rk->fused;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSRKSetFused - Sets whether the `TSRK` stages, the completion of the step and its error estimate are formed with fused updates
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+-  fused - `PETSC_TRUE` (the default) to use the fused updates
+
+  Options Database Key:
+.   -ts_rk_fused - <true,false>
+
+  Level: advanced
+
+  Notes:
+  The fused updates form each stage state with a single pass over the solution and the previous stage derivatives, instead of a
+  copy followed by `VecMAXPY()`. The completion of the step computes the weighted norm of the embedded error estimate in the
+  same pass that updates the solution, instead of forming the embedded solution in a work vector and then computing its
+  difference with `TSErrorWeightedNorm()`. This reduces the memory traffic of a step, which bounds the performance of explicit
+  methods on large problems. The error estimate is only formed this way for the `TSADAPTBASIC` and `TSADAPTDSP` adaptors.
+
+  The fused updates are only used for the `VECSEQ` and `VECMPI` vector types, and not with the multirate methods. The results
+  agree with the unfused updates up to rounding.
+
+.seealso: [](chapter_ts), `TSRK`, `TSRKGetFused()`, `TSErrorWeightedNorm()`
+@*/
+PetscErrorCode TSRKSetFused(TS ts, PetscBool fused)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, fused, 2);
+  PetscTryMethod(ts, "TSRKSetFused_C", (TS, PetscBool), (ts, fused));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSRKGetFused - Gets whether the `TSRK` stages, the completion of the step and its error estimate are formed with fused updates
+
+  Not collective
+
+  Input Parameter:
+.  ts - timestepping context
+
+  Output Parameter:
+.  fused - `PETSC_TRUE` if the fused updates are used
+
+  Level: advanced
+
+.seealso: [](chapter_ts), `TSRK`, `TSRKSetFused()`
+@*/
+PetscErrorCode TSRKGetFused(TS ts, PetscBool *fused)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidBoolPointer(fused, 2);
+  PetscUseMethod(ts, "TSRKGetFused_C", (TS, PetscBool *), (ts, fused));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*MC
       TSRK - ODE and DAE solver using Runge-Kutta schemes
 
@@ -1477,8 +1726,11 @@ PetscErrorCode TSRKGetMultirate(TS ts, PetscBool *use_multirate)
   Notes:
   The default is `TSRK3BS`, it can be changed with `TSRKSetType()` or -ts_rk_type
 
+  For the standard vector types, each stage, and the completion of the step together with the embedded error estimate, are
+  formed in a single pass over memory, see `TSRKSetFused()`.
+
 .seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSRK`, `TSSetType()`, `TSRKSetType()`, `TSRKGetType()`, `TSRK2D`, `TSRK2E`, `TSRK3`,
-          `TSRK4`, `TSRK5`, `TSRKPRSSP2`, `TSRKBPR3`, `TSRKType`, `TSRKRegister()`, `TSRKSetMultirate()`, `TSRKGetMultirate()`, `TSType`
+          `TSRK4`, `TSRK5`, `TSRKPRSSP2`, `TSRKBPR3`, `TSRKType`, `TSRKRegister()`, `TSRKSetMultirate()`, `TSRKGetMultirate()`, `TSRKSetFused()`, `TSType`
 M*/
 PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
 {
@@ -1495,6 +1747,7 @@ PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
   ts->ops->interpolate    = TSInterpolate_RK;
   ts->ops->step           = TSStep_RK;
   ts->ops->evaluatestep   = TSEvaluateStep_RK;
+  ts->ops->evaluatewlte   = TSEvaluateWLTE_RK;
   ts->ops->rollback       = TSRollBack_RK;
   ts->ops->setfromoptions = TSSetFromOptions_RK;
   ts->ops->getstages      = TSGetStages_RK;
@@ -1521,8 +1774,11 @@ PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetTableau_C", TSRKGetTableau_RK));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetMultirate_C", TSRKSetMultirate_RK));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetMultirate_C", TSRKGetMultirate_RK));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKSetFused_C", TSRKSetFused_RK));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRKGetFused_C", TSRKGetFused_RK));
 
   PetscCall(TSRKSetType(ts, TSRKDefault));
   rk->dtratio = 1;
+  rk->fused   = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
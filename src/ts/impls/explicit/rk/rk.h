@@ -43,4 +43,10 @@ typedef struct {
   Mat         *MatsFwdStageSensip;
   Mat         *MatsFwdSensipTemp;
   Vec          VecDeltaFwdSensipCol; /* Working vector for holding one column of the sensitivity matrix */
+  PetscBool    fused;                /* Form the stages, the completion and the error estimate in single passes over memory */
+  PetscScalar **karray;              /* Arrays of the stage derivatives, for the fused updates */
+  PetscScalar *ework;                /* Weights of the error estimate, for the fused updates */
+  PetscBool    wlte_valid;           /* wlte was computed by the fused completion of the current step */
+  NormType     wlte_type;
+  PetscReal    wlte;
 } TS_RK;
@@ -0,0 +1,801 @@
+/*
+  Code for parallel-in-time integration with the Parareal algorithm and its two-level MGRIT (FCF-relaxation) variant
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+#include <petscdm.h>
+
+typedef struct {
+  TS                fine, coarse; /* propagators over one time slice */
+  MPI_Comm          tcomm;        /* one process of each spatial group, ordered in time; MPI_COMM_NULL for a single group */
+  PetscMPIInt       trank, tsize;
+  PetscInt          nslices;    /* total number of time slices, a multiple of tsize */
+  PetscInt          s0, nlocal; /* this group owns slices s0, ..., s0 + nlocal - 1 */
+  PetscInt          coarsening; /* coarse time step in units of the fine one, PETSC_DECIDE for one coarse step per slice */
+  PetscInt          max_it, its;
+  PetscReal         tol;
+  PetscBool         fcf, monitor;
+  PetscReal         t0, tf;
+  Vec              *U;    /* U[k] starts local slice k, U[nlocal] ends the last one */
+  Vec              *F, *G; /* fine and coarse propagation of U[k] over local slice k */
+  Vec               work;
+  TSConvergedReason reason; /* first failure of a propagator of this group */
+} TS_Parareal;
+
+static inline PetscReal TSPararealSliceTime(TS_Parareal *pr, PetscInt n)
+{
+  return n == pr->nslices ? pr->tf : pr->t0 + n * (pr->tf - pr->t0) / pr->nslices;
+}
+
+/* Y = the propagation of U with sub over slice n, starting with time step dt */
+static PetscErrorCode TSPararealPropagate(TS ts, TS sub, PetscReal dt, PetscInt n, Vec U, Vec Y)
+{
+  TS_Parareal      *pr = (TS_Parareal *)ts->data;
+  TSConvergedReason reason;
+  Vec               X;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetSolution(sub, &X));
+  PetscCall(VecCopy(U, X));
+  PetscCall(TSSetTime(sub, TSPararealSliceTime(pr, n)));
+  PetscCall(TSSetMaxTime(sub, TSPararealSliceTime(pr, n + 1)));
+  PetscCall(TSSetTimeStep(sub, dt));
+  PetscCall(TSSetStepNumber(sub, 0));
+  PetscCall(TSSolve(sub, X));
+  PetscCall(TSGetConvergedReason(sub, &reason));
+  if (reason < 0 && pr->reason >= 0) pr->reason = reason;
+  ts->snes_its += sub->snes_its;
+  ts->ksp_its += sub->ksp_its;
+  PetscCall(VecCopy(X, Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Point-to-point transfers of local vector arrays between consecutive time groups */
+static PetscErrorCode TSPararealSend(TS ts, Vec X)
+{
+  TS_Parareal       *pr = (TS_Parareal *)ts->data;
+  const PetscScalar *x;
+  PetscInt           n;
+  PetscMPIInt        nn;
+
+  PetscFunctionBegin;
+  if (pr->trank == pr->tsize - 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCallMPI(MPI_Send(x, nn, MPIU_SCALAR, pr->trank + 1, 0, pr->tcomm));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealRecv(TS ts, Vec X)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscScalar *x;
+  PetscInt     n;
+  PetscMPIInt  nn;
+
+  PetscFunctionBegin;
+  if (pr->trank == 0) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArray(X, &x));
+  PetscCallMPI(MPI_Recv(x, nn, MPIU_SCALAR, pr->trank - 1, 0, pr->tcomm, MPI_STATUS_IGNORE));
+  PetscCall(VecRestoreArray(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Sends X to the next time group and receives Y from the previous one, at the same time */
+static PetscErrorCode TSPararealShift(TS ts, Vec X, Vec Y)
+{
+  TS_Parareal       *pr = (TS_Parareal *)ts->data;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscInt           n;
+  PetscMPIInt        nn, next, prev;
+
+  PetscFunctionBegin;
+  if (pr->tsize == 1) PetscFunctionReturn(PETSC_SUCCESS);
+  next = pr->trank == pr->tsize - 1 ? MPI_PROC_NULL : pr->trank + 1;
+  prev = pr->trank == 0 ? MPI_PROC_NULL : pr->trank - 1;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(VecGetArray(Y, &y));
+  PetscCallMPI(MPI_Sendrecv(x, nn, MPIU_SCALAR, next, 0, y, nn, MPIU_SCALAR, prev, 0, pr->tcomm, MPI_STATUS_IGNORE));
+  PetscCall(VecRestoreArray(Y, &y));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* A failure of any propagator stops all the time groups */
+static PetscErrorCode TSPararealCheckFailure(TS ts, PetscBool *failed)
+{
+  TS_Parareal *pr     = (TS_Parareal *)ts->data;
+  PetscInt     reason = (PetscInt)pr->reason;
+
+  PetscFunctionBegin;
+  if (pr->tsize > 1) PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &reason, 1, MPIU_INT, MPI_MIN, pr->tcomm));
+  *failed = reason < 0 ? PETSC_TRUE : PETSC_FALSE;
+  if (*failed) {
+    ts->reason = (TSConvergedReason)reason;
+    PetscCheck(!ts->errorifstepfailed, PetscObjectComm((PetscObject)ts), PETSC_ERR_NOT_CONVERGED, "A TSPARAREAL propagator has failed due to %s", TSConvergedReasons[ts->reason]);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSolve_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscInt     nlocal = pr->nlocal, s0 = pr->s0, step0 = ts->steps, it;
+  PetscReal    dtf = ts->time_step, dtc, change = 0.0;
+  PetscBool    failed;
+  Vec         *U = pr->U, *F = pr->F, *G = pr->G;
+
+  PetscFunctionBegin;
+  pr->t0     = ts->ptime;
+  pr->tf     = ts->max_time;
+  pr->reason = TS_CONVERGED_ITERATING;
+  pr->its    = 0;
+  dtc        = pr->coarsening == PETSC_DECIDE ? (pr->tf - pr->t0) / pr->nslices : pr->coarsening * dtf;
+
+  /* Initial coarse sweep, pipelined over the time groups */
+  if (pr->trank == 0) PetscCall(VecCopy(ts->vec_sol, U[0]));
+  else PetscCall(TSPararealRecv(ts, U[0]));
+  for (PetscInt k = 0; k < nlocal; k++) {
+    PetscCall(TSPararealPropagate(ts, pr->coarse, dtc, s0 + k, U[k], G[k]));
+    PetscCall(VecCopy(G[k], U[k + 1]));
+  }
+  PetscCall(TSPararealSend(ts, U[nlocal]));
+  PetscCall(TSPararealCheckFailure(ts, &failed));
+  if (failed) PetscFunctionReturn(PETSC_SUCCESS);
+
+  for (it = 1; it <= pr->max_it; it++) {
+    if (pr->fcf) {
+      /* F-relaxation followed by C-relaxation, which moves the fine values to the slice end points */
+      for (PetscInt k = 0; k < nlocal; k++) PetscCall(TSPararealPropagate(ts, pr->fine, dtf, s0 + k, U[k], F[k]));
+      PetscCall(TSPararealShift(ts, F[nlocal - 1], U[0]));
+      for (PetscInt k = 0; k < nlocal; k++) PetscCall(VecCopy(F[k], U[k + 1]));
+      /* Second F-relaxation, the coarse propagation of the relaxed values enters the correction below */
+      for (PetscInt k = 0; k < nlocal; k++) {
+        PetscCall(TSPararealPropagate(ts, pr->fine, dtf, s0 + k, U[k], F[k]));
+        PetscCall(TSPararealPropagate(ts, pr->coarse, dtc, s0 + k, U[k], G[k]));
+      }
+    } else {
+      /* After iteration it - 1 the first it slice end points are exact, so slices before it - 1 need no more work */
+      for (PetscInt k = 0; k < nlocal; k++) {
+        if (s0 + k < it - 1) continue;
+        PetscCall(TSPararealPropagate(ts, pr->fine, dtf, s0 + k, U[k], F[k]));
+      }
+    }
+
+    /* Coarse-grid correction U[k+1] = G(U[k]) + F[k] - G[k], pipelined over the time groups */
+    change = 0.0;
+    PetscCall(TSPararealRecv(ts, U[0]));
+    for (PetscInt k = 0; k < nlocal; k++) {
+      PetscReal nrm, diff;
+      Vec       tmp;
+
+      if (!pr->fcf && s0 + k < it - 1) continue;
+      PetscCall(TSPararealPropagate(ts, pr->coarse, dtc, s0 + k, U[k], pr->work));
+      PetscCall(VecAYPX(G[k], -1.0, F[k]));
+      PetscCall(VecAXPY(G[k], 1.0, pr->work));
+      PetscCall(VecAXPY(U[k + 1], -1.0, G[k]));
+      PetscCall(VecNorm(U[k + 1], NORM_2, &diff));
+      PetscCall(VecNorm(G[k], NORM_2, &nrm));
+      change = PetscMax(change, nrm > 0.0 ? diff / nrm : diff);
+      /* Rotate: the corrected value becomes U[k+1], the new coarse propagation becomes G[k] */
+      tmp      = U[k + 1];
+      U[k + 1] = G[k];
+      G[k]     = pr->work;
+      pr->work = tmp;
+    }
+    PetscCall(TSPararealSend(ts, U[nlocal]));
+    PetscCall(TSPararealCheckFailure(ts, &failed));
+    if (failed) PetscFunctionReturn(PETSC_SUCCESS);
+    if (pr->tsize > 1) PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &change, 1, MPIU_REAL, MPIU_MAX, pr->tcomm));
+    pr->its = it;
+    if (pr->monitor && pr->trank == 0) PetscCall(PetscPrintf(PetscObjectComm((PetscObject)ts), "  Parareal iteration %" PetscInt_FMT " relative change %g\n", it, (double)change));
+    if (change <= pr->tol || it >= pr->nslices) break;
+  }
+  PetscCall(PetscInfo(ts, "Parareal stopped after %" PetscInt_FMT " iterations with relative change %g\n", pr->its, (double)change));
+
+  /* The final solution lives on the last time group */
+  if (pr->trank == pr->tsize - 1) PetscCall(VecCopy(U[nlocal], ts->vec_sol));
+  if (pr->tsize > 1) {
+    PetscScalar *x;
+    PetscInt     n;
+    PetscMPIInt  nn;
+
+    PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+    PetscCall(PetscMPIIntCast(n, &nn));
+    PetscCall(VecGetArray(ts->vec_sol, &x));
+    PetscCallMPI(MPI_Bcast(x, nn, MPIU_SCALAR, pr->tsize - 1, pr->tcomm));
+    PetscCall(VecRestoreArray(ts->vec_sol, &x));
+  }
+
+  /* The slice end points are the steps of the parallel-in-time integration */
+  for (PetscInt k = 0; k <= nlocal; k++) {
+    const PetscInt n = s0 + k;
+
+    if (k == nlocal && pr->trank < pr->tsize - 1) break;
+    ts->steps      = step0 + n;
+    ts->ptime      = TSPararealSliceTime(pr, n);
+    ts->ptime_prev = n ? TSPararealSliceTime(pr, n - 1) : ts->ptime;
+    PetscCall(TSTrajectorySet(ts->trajectory, ts, ts->steps, ts->ptime, U[k]));
+    PetscCall(TSMonitor(ts, ts->steps, ts->ptime, U[k]));
+  }
+  ts->steps      = step0 + pr->nslices;
+  ts->ptime      = pr->tf;
+  ts->ptime_prev = TSPararealSliceTime(pr, pr->nslices - 1);
+  ts->reason     = TS_CONVERGED_TIME;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The sub-TS share the callbacks of ts through a clone of its DM with its own DMSNES */
+static PetscErrorCode TSPararealSetSubDM(TS ts, TS sub)
+{
+  DM dm, newdm;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetDM(ts, &dm));
+  PetscCall(DMClone(dm, &newdm));
+  PetscCall(DMCopyDMTS(dm, newdm));
+  PetscCall(TSSetDM(sub, newdm));
+  PetscCall(DMDestroy(&newdm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealCreateSubTS(TS ts, const char prefix[], TS *sub)
+{
+  const char *pprefix;
+
+  PetscFunctionBegin;
+  PetscCall(TSCreate(PetscObjectComm((PetscObject)ts), sub));
+  PetscCall(PetscObjectIncrementTabLevel((PetscObject)*sub, (PetscObject)ts, 1));
+  PetscCall(PetscObjectSetOptions((PetscObject)*sub, ((PetscObject)ts)->options));
+  PetscCall(TSGetOptionsPrefix(ts, &pprefix));
+  PetscCall(TSSetOptionsPrefix(*sub, pprefix));
+  PetscCall(TSAppendOptionsPrefix(*sub, prefix));
+  PetscCall(TSSetErrorIfStepFails(*sub, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The fine propagator uses the Jacobian matrices of ts, the coarse one copies of them */
+static PetscErrorCode TSPararealSetUpSubTS(TS ts, TS sub, PetscBool duplicate)
+{
+  TSIJacobian ijac;
+  Vec         X;
+  DM          dm;
+
+  PetscFunctionBegin;
+  PetscCall(TSPararealSetSubDM(ts, sub));
+  PetscCall(TSSetProblemType(sub, ts->problem_type));
+  PetscCall(TSSetEquationType(sub, ts->equation_type));
+  PetscCall(TSSetExactFinalTime(sub, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetMaxSteps(sub, PETSC_MAX_INT));
+  PetscCall(TSGetDM(ts, &dm));
+  PetscCall(DMTSGetIJacobian(dm, &ijac, NULL));
+  if (ts->Arhs) {
+    Mat A = ts->Arhs, B = ts->Brhs;
+
+    if (duplicate) {
+      PetscCall(MatDuplicate(ts->Arhs, MAT_COPY_VALUES, &A));
+      if (ts->Brhs && ts->Brhs != ts->Arhs) PetscCall(MatDuplicate(ts->Brhs, MAT_COPY_VALUES, &B));
+      else if (ts->Brhs) PetscCall(PetscObjectReference((PetscObject)(B = A)));
+    }
+    PetscCall(TSSetRHSJacobian(sub, A, B, NULL, NULL));
+    if (duplicate) {
+      PetscCall(MatDestroy(&A));
+      PetscCall(MatDestroy(&B));
+    }
+  }
+  if (ijac && ts->snes) {
+    Mat Amat, Pmat, A, B;
+
+    PetscCall(SNESGetJacobian(ts->snes, &Amat, &Pmat, NULL, NULL));
+    A = Amat;
+    B = Pmat;
+    if (A && duplicate) {
+      PetscCall(MatDuplicate(Amat, MAT_COPY_VALUES, &A));
+      if (Pmat && Pmat != Amat) PetscCall(MatDuplicate(Pmat, MAT_COPY_VALUES, &B));
+      else if (Pmat) PetscCall(PetscObjectReference((PetscObject)(B = A)));
+    }
+    if (A) PetscCall(TSSetIJacobian(sub, A, B, NULL, NULL));
+    if (A && duplicate) {
+      PetscCall(MatDestroy(&A));
+      PetscCall(MatDestroy(&B));
+    }
+  }
+  PetscCall(VecDuplicate(ts->vec_sol, &X));
+  PetscCall(TSSetSolution(sub, X));
+  PetscCall(VecDestroy(&X));
+  PetscCall(TSSetUp(sub));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetFineTS_Parareal(TS ts, TS *fine)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (!pr->fine) PetscCall(TSPararealCreateSubTS(ts, "parareal_fine_", &pr->fine));
+  *fine = pr->fine;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetCoarseTS_Parareal(TS ts, TS *coarse)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (!pr->coarse) PetscCall(TSPararealCreateSubTS(ts, "parareal_coarse_", &pr->coarse));
+  *coarse = pr->coarse;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetUp_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TS           sub;
+  PetscInt     n, range[2];
+
+  PetscFunctionBegin;
+  if (pr->tcomm != MPI_COMM_NULL) {
+    PetscCallMPI(MPI_Comm_rank(pr->tcomm, &pr->trank));
+    PetscCallMPI(MPI_Comm_size(pr->tcomm, &pr->tsize));
+  } else {
+    pr->trank = 0;
+    pr->tsize = 1;
+  }
+  if (pr->nslices == PETSC_DECIDE) pr->nslices = pr->tsize;
+  PetscCheck(pr->nslices > 0 && pr->nslices % pr->tsize == 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "The number of time slices %" PetscInt_FMT " must be a positive multiple of the size %d of the time communicator", pr->nslices, pr->tsize);
+  PetscCheck(ts->max_time < PETSC_MAX_REAL, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "TSPARAREAL needs a finite final time, call TSSetMaxTime()");
+  pr->nlocal = pr->nslices / pr->tsize;
+  pr->s0     = pr->trank * pr->nlocal;
+  if (pr->max_it == PETSC_DEFAULT) pr->max_it = pr->nslices;
+
+  /* The time groups exchange the local arrays of their solution vectors */
+  PetscCall(VecGetLocalSize(ts->vec_sol, &n));
+  range[0] = n;
+  range[1] = -n;
+  if (pr->tsize > 1) PetscCall(MPIU_Allreduce(MPI_IN_PLACE, range, 2, MPIU_INT, MPI_MAX, pr->tcomm));
+  PetscCheck(range[0] == -range[1], PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_INCOMP, "Processes of the time communicator must own the same part of the solution, local sizes range from %" PetscInt_FMT " to %" PetscInt_FMT, -range[1], range[0]);
+
+  PetscCall(TSPararealGetFineTS_Parareal(ts, &sub));
+  PetscCall(TSPararealSetUpSubTS(ts, sub, PETSC_FALSE));
+  PetscCall(TSPararealGetCoarseTS_Parareal(ts, &sub));
+  PetscCall(TSPararealSetUpSubTS(ts, sub, PETSC_TRUE));
+
+  PetscCall(VecDuplicateVecs(ts->vec_sol, pr->nlocal + 1, &pr->U));
+  PetscCall(VecDuplicateVecs(ts->vec_sol, pr->nlocal, &pr->F));
+  PetscCall(VecDuplicateVecs(ts->vec_sol, pr->nlocal, &pr->G));
+  PetscCall(VecDuplicate(ts->vec_sol, &pr->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSReset_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (pr->U) PetscCall(VecDestroyVecs(pr->nlocal + 1, &pr->U));
+  if (pr->F) PetscCall(VecDestroyVecs(pr->nlocal, &pr->F));
+  if (pr->G) PetscCall(VecDestroyVecs(pr->nlocal, &pr->G));
+  PetscCall(VecDestroy(&pr->work));
+  if (pr->fine) PetscCall(TSReset(pr->fine));
+  if (pr->coarse) PetscCall(TSReset(pr->coarse));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSDestroy_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSReset_Parareal(ts));
+  PetscCall(TSDestroy(&pr->fine));
+  PetscCall(TSDestroy(&pr->coarse));
+  if (pr->tcomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&pr->tcomm));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTimeCommunicator_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetFineTS_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetCoarseTS_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumSlices_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetCoarseningFactor_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetFCFRelaxation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetFromOptions_Parareal(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TS           sub;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Parareal ODE solver options");
+  {
+    PetscCall(PetscOptionsInt("-ts_parareal_num_slices", "Number of time slices, a multiple of the size of the time communicator", "TSPararealSetNumSlices", pr->nslices, &pr->nslices, NULL));
+    PetscCall(PetscOptionsInt("-ts_parareal_coarsening_factor", "Coarse time step in units of the fine one", "TSPararealSetCoarseningFactor", pr->coarsening, &pr->coarsening, NULL));
+    PetscCall(PetscOptionsReal("-ts_parareal_tol", "Relative change of the slice end points to stop the iteration", "TSPararealSetTolerances", pr->tol, &pr->tol, NULL));
+    PetscCall(PetscOptionsInt("-ts_parareal_max_it", "Maximum number of iterations", "TSPararealSetTolerances", pr->max_it, &pr->max_it, NULL));
+    PetscCall(PetscOptionsBool("-ts_parareal_fcf", "Use FCF-relaxation, which is two-level MGRIT", "TSPararealSetFCFRelaxation", pr->fcf, &pr->fcf, NULL));
+    PetscCall(PetscOptionsBool("-ts_parareal_monitor", "Monitor the iterations", "TSPARAREAL", pr->monitor, &pr->monitor, NULL));
+  }
+  PetscOptionsHeadEnd();
+  PetscCall(TSPararealGetFineTS_Parareal(ts, &sub));
+  PetscCall(TSSetFromOptions(sub));
+  PetscCall(TSPararealGetCoarseTS_Parareal(ts, &sub));
+  PetscCall(TSSetFromOptions(sub));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSView_Parareal(TS ts, PetscViewer viewer)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscBool    iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  %s, %" PetscInt_FMT " time slices over %d time groups\n", pr->fcf ? "two-level MGRIT with FCF-relaxation" : "Parareal", pr->nslices, pr->tsize));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  relative tolerance %g, maximum iterations %" PetscInt_FMT ", iterations %" PetscInt_FMT "\n", (double)pr->tol, pr->max_it, pr->its));
+    if (pr->coarsening == PETSC_DECIDE) PetscCall(PetscViewerASCIIPrintf(viewer, "  one coarse time step per slice\n"));
+    else PetscCall(PetscViewerASCIIPrintf(viewer, "  coarsening factor %" PetscInt_FMT "\n", pr->coarsening));
+  }
+  if (pr->fine) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  Fine propagator:\n"));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(TSView(pr->fine, viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  if (pr->coarse) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  Coarse propagator:\n"));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(TSView(pr->coarse, viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetTimeCommunicator_Parareal(TS ts, MPI_Comm tcomm)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (pr->tcomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&pr->tcomm));
+  if (tcomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_dup(tcomm, &pr->tcomm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetNumSlices_Parareal(TS ts, PetscInt nslices)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  pr->nslices = nslices;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetCoarseningFactor_Parareal(TS ts, PetscInt factor)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  pr->coarsening = factor;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetTolerances_Parareal(TS ts, PetscReal tol, PetscInt max_it)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (tol != (PetscReal)PETSC_DEFAULT) pr->tol = tol;
+  if (max_it != PETSC_DEFAULT) pr->max_it = max_it;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetFCFRelaxation_Parareal(TS ts, PetscBool fcf)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  pr->fcf = fcf;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetIterationNumber_Parareal(TS ts, PetscInt *its)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  *its = pr->its;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetTimeCommunicator - Sets the communicator across which the time slices of `TSPARAREAL` are distributed
+
+  Logically Collective
+
+  Input Parameters:
++ ts - timestepping context
+- tcomm - the time communicator, it is duplicated internally
+
+  Level: intermediate
+
+  Notes:
+  The processes of the communicator of `ts` form a spatial group, which integrates consecutive time slices. The time communicator contains
+  one process of each spatial group, processes with the same rank in their spatial groups, ordered in time. Such communicators
+  are usually obtained by splitting `PETSC_COMM_WORLD` twice with `MPI_Comm_split()`, see src/ts/tests/ex36.c.
+
+  The processes of a time communicator must own the same part of the solution vector.
+
+  Without a time communicator all the time slices are integrated by the processes of `ts`, one after the other.
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealSetNumSlices()`
+@*/
+PetscErrorCode TSPararealSetTimeCommunicator(TS ts, MPI_Comm tcomm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSPararealSetTimeCommunicator_C", (TS, MPI_Comm), (ts, tcomm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetFineTS - Gets the `TS` used to propagate the solution accurately over a time slice
+
+  Not Collective
+
+  Input Parameter:
+. ts - timestepping context
+
+  Output Parameter:
+. fine - the fine propagator, its options prefix is that of `ts` followed by "parareal_fine_"
+
+  Level: intermediate
+
+  Note:
+  The fine propagator starts every time slice with the time step of `ts`, see `TSSetTimeStep()`.
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealGetCoarseTS()`
+@*/
+PetscErrorCode TSPararealGetFineTS(TS ts, TS *fine)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidPointer(fine, 2);
+  PetscUseMethod(ts, "TSPararealGetFineTS_C", (TS, TS *), (ts, fine));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetCoarseTS - Gets the `TS` used to propagate the solution cheaply over a time slice
+
+  Not Collective
+
+  Input Parameter:
+. ts - timestepping context
+
+  Output Parameter:
+. coarse - the coarse propagator, its options prefix is that of `ts` followed by "parareal_coarse_"
+
+  Level: intermediate
+
+  Note:
+  The coarse propagator starts every time slice with the time step set by `TSPararealSetCoarseningFactor()`.
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealGetFineTS()`
+@*/
+PetscErrorCode TSPararealGetCoarseTS(TS ts, TS *coarse)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidPointer(coarse, 2);
+  PetscUseMethod(ts, "TSPararealGetCoarseTS_C", (TS, TS *), (ts, coarse));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetNumSlices - Sets the number of time slices of `TSPARAREAL`
+
+  Logically Collective
+
+  Input Parameters:
++ ts - timestepping context
+- nslices - the number of time slices, a multiple of the size of the time communicator, or `PETSC_DECIDE` for one slice per time group
+
+  Options Database Key:
+. -ts_parareal_num_slices <nslices> - number of time slices
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealSetTimeCommunicator()`
+@*/
+PetscErrorCode TSPararealSetNumSlices(TS ts, PetscInt nslices)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, nslices, 2);
+  PetscTryMethod(ts, "TSPararealSetNumSlices_C", (TS, PetscInt), (ts, nslices));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetCoarseningFactor - Sets the time step of the coarse propagator of `TSPARAREAL` relative to the fine one
+
+  Logically Collective
+
+  Input Parameters:
++ ts - timestepping context
+- factor - the coarse time step in units of the time step of `ts`, or `PETSC_DECIDE` for one coarse step per time slice
+
+  Options Database Key:
+. -ts_parareal_coarsening_factor <factor> - coarsening factor
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealGetCoarseTS()`
+@*/
+PetscErrorCode TSPararealSetCoarseningFactor(TS ts, PetscInt factor)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, factor, 2);
+  PetscTryMethod(ts, "TSPararealSetCoarseningFactor_C", (TS, PetscInt), (ts, factor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetTolerances - Sets the stopping criteria of the `TSPARAREAL` iteration
+
+  Logically Collective
+
+  Input Parameters:
++ ts - timestepping context
+. tol - the iteration stops when the largest relative change of the slice end points is below `tol`
+- max_it - maximum number of iterations
+
+  Options Database Keys:
++ -ts_parareal_tol <tol> - relative tolerance
+- -ts_parareal_max_it <max_it> - maximum number of iterations
+
+  Level: intermediate
+
+  Note:
+  The iteration always stops after as many iterations as there are time slices, then it reproduces the sequential fine integration.
+  Use `PETSC_DEFAULT` to retain a value.
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealGetIterationNumber()`
+@*/
+PetscErrorCode TSPararealSetTolerances(TS ts, PetscReal tol, PetscInt max_it)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(ts, tol, 2);
+  PetscValidLogicalCollectiveInt(ts, max_it, 3);
+  PetscTryMethod(ts, "TSPararealSetTolerances_C", (TS, PetscReal, PetscInt), (ts, tol, max_it));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetFCFRelaxation - Use FCF-relaxation in `TSPARAREAL`, which turns it into two-level MGRIT
+
+  Logically Collective
+
+  Input Parameters:
++ ts - timestepping context
+- fcf - `PETSC_TRUE` to relax with two fine propagations per iteration
+
+  Options Database Key:
+. -ts_parareal_fcf - use FCF-relaxation
+
+  Level: intermediate
+
+  Note:
+  FCF-relaxation doubles the fine work per iteration but usually converges in fewer iterations, with a more robust coarse propagator.
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealSetTolerances()`
+@*/
+PetscErrorCode TSPararealSetFCFRelaxation(TS ts, PetscBool fcf)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, fcf, 2);
+  PetscTryMethod(ts, "TSPararealSetFCFRelaxation_C", (TS, PetscBool), (ts, fcf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetIterationNumber - Gets the number of iterations of the last `TSSolve()` with `TSPARAREAL`
+
+  Not Collective
+
+  Input Parameter:
+. ts - timestepping context
+
+  Output Parameter:
+. its - number of iterations
+
+  Level: intermediate
+
+.seealso: [](chapter_ts), `TS`, `TSPARAREAL`, `TSPararealSetTolerances()`
+@*/
+PetscErrorCode TSPararealGetIterationNumber(TS ts, PetscInt *its)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidIntPointer(its, 2);
+  PetscUseMethod(ts, "TSPararealGetIterationNumber_C", (TS, PetscInt *), (ts, its));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+      TSPARAREAL - Parallel-in-time integration with the Parareal algorithm, or two-level MGRIT
+
+  The time interval is split into time slices, distributed over the groups of processes of a time communicator. Each iteration
+  propagates the slice end points with the fine `TS` in parallel, then corrects them with a sequential sweep of the cheap coarse `TS`,
+  U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old). The fine and coarse propagators can be any `TS` type, they share the callbacks of the
+  outer `TS`.
+
+  Options Database Keys:
++ -ts_parareal_num_slices <nslices> - number of time slices, see `TSPararealSetNumSlices()`
+. -ts_parareal_coarsening_factor <factor> - coarse time step in units of the fine one, see `TSPararealSetCoarseningFactor()`
+. -ts_parareal_tol <tol> - relative change of the slice end points to stop the iteration, see `TSPararealSetTolerances()`
+. -ts_parareal_max_it <max_it> - maximum number of iterations
+. -ts_parareal_fcf - use FCF-relaxation, see `TSPararealSetFCFRelaxation()`
+. -ts_parareal_monitor - print the relative change at each iteration
+. -parareal_fine_ts_type <type> - the fine propagator, for example arkimex or bdf, see `TSPararealGetFineTS()`
+- -parareal_coarse_ts_type <type> - the coarse propagator, see `TSPararealGetCoarseTS()`
+
+  Level: advanced
+
+  Notes:
+  The fine propagator takes the time step of the outer `TS`, the final time must be set with `TSSetMaxTime()`.
+
+  The slice end points are the steps of the outer `TS`: they are passed to its monitors and stored in its `TSTrajectory`,
+  by the time group owning them, once the iteration has stopped. The solution at the final time is available on all the time groups.
+
+  The iterations after the first one only propagate the slices which have not yet reached the sequential fine solution. This
+  assumes the propagators are deterministic, without time step adaptivity carried over from one slice to the next and with
+  linear and nonlinear solver tolerances well below the tolerance of the iteration.
+
+  Sensitivity analysis and events are not supported.
+
+.seealso: [](chapter_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSPararealSetTimeCommunicator()`, `TSPararealGetFineTS()`, `TSPararealGetCoarseTS()`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Parareal(TS ts)
+{
+  TS_Parareal *pr;
+
+  PetscFunctionBegin;
+  ts->ops->setup          = TSSetUp_Parareal;
+  ts->ops->solve          = TSSolve_Parareal;
+  ts->ops->reset          = TSReset_Parareal;
+  ts->ops->destroy        = TSDestroy_Parareal;
+  ts->ops->setfromoptions = TSSetFromOptions_Parareal;
+  ts->ops->view           = TSView_Parareal;
+  ts->default_adapt_type  = TSADAPTNONE;
+
+  PetscCall(PetscNew(&pr));
+  ts->data = (void *)pr;
+
+  pr->tcomm      = MPI_COMM_NULL;
+  pr->nslices    = PETSC_DECIDE;
+  pr->coarsening = PETSC_DECIDE;
+  pr->max_it     = PETSC_DEFAULT;
+  pr->tol        = 1e-8;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTimeCommunicator_C", TSPararealSetTimeCommunicator_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetFineTS_C", TSPararealGetFineTS_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetCoarseTS_C", TSPararealGetCoarseTS_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumSlices_C", TSPararealSetNumSlices_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetCoarseningFactor_C", TSPararealSetCoarseningFactor_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", TSPararealSetTolerances_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetFCFRelaxation_C", TSPararealSetFCFRelaxation_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", TSPararealGetIterationNumber_Parareal));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
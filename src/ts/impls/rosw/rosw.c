@@ -1510,6 +1510,34 @@ PetscErrorCode TSRosWSetRecomputeJacobian(TS ts, PetscBool flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   TSRosWGetTableau - Get info on the `TSROSW` tableau
+
+   Not Collective
+
+   Input Parameter:
+.  ts - timestepping context
+
+   Output Parameters:
++  order - approximation order of the method
+.  s - number of stages, this is the dimension of the matrices below
+.  A - table of propagated stage coefficients (dimension s*s, row-major), strictly lower triangular
+.  Gamma - table of coefficients in implicit stage equations (dimension s*s, row-major), lower triangular
+.  b - step completion table (dimension s)
+-  bembed - step completion table for a scheme of order one less (dimension s; NULL if not available)
+
+   Level: developer
+
+.seealso: [](chapter_ts), `TSROSW`, `TSRosWRegister()`, `TSRosWSetType()`, `TSRKGetTableau()`
+@*/
+PetscErrorCode TSRosWGetTableau(TS ts, PetscInt *order, PetscInt *s, const PetscReal **A, const PetscReal **Gamma, const PetscReal **b, const PetscReal **bembed)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscUseMethod(ts, "TSRosWGetTableau_C", (TS, PetscInt *, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **), (ts, order, s, A, Gamma, b, bembed));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSRosWGetType_RosW(TS ts, TSRosWType *rostype)
 {
   TS_RosW *ros = (TS_RosW *)ts->data;
@@ -1552,6 +1580,21 @@ static PetscErrorCode TSRosWSetRecomputeJacobian_RosW(TS ts, PetscBool flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode TSRosWGetTableau_RosW(TS ts, PetscInt *order, PetscInt *s, const PetscReal **A, const PetscReal **Gamma, const PetscReal **b, const PetscReal **bembed)
+{
+  TS_RosW    *ros = (TS_RosW *)ts->data;
+  RosWTableau tab = ros->tableau;
+
+  PetscFunctionBegin;
+  if (order) *order = tab->order;
+  if (s) *s = tab->s;
+  if (A) *A = tab->A;
+  if (Gamma) *Gamma = tab->Gamma;
+  if (b) *b = tab->b;
+  if (bembed) *bembed = tab->bembed;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSDestroy_RosW(TS ts)
 {
   PetscFunctionBegin;
@@ -1564,6 +1607,7 @@ static PetscErrorCode TSDestroy_RosW(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWGetType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWSetType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWSetRecomputeJacobian_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWGetTableau_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1659,6 +1703,7 @@ PETSC_EXTERN PetscErrorCode TSCreate_RosW(TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWGetType_C", TSRosWGetType_RosW));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWSetType_C", TSRosWSetType_RosW));
   PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWSetRecomputeJacobian_C", TSRosWSetRecomputeJacobian_RosW));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSRosWGetTableau_C", TSRosWGetTableau_RosW));
 
   PetscCall(TSRosWSetType(ts, TSRosWDefault));
   PetscFunctionReturn(PETSC_SUCCESS);
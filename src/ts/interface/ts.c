@@ -52,6 +52,8 @@ static PetscErrorCode TSAdaptSetDefaultType(TSAdapt adapt, TSAdaptType default_t
 .  -ts_rhs_jacobian_test_mult_transpose -mat_shell_test_mult_transpose_view - test the Jacobian at each iteration against finite difference with RHS function
 .  -ts_adjoint_solve <yes,no> - After solving the ODE/DAE solve the adjoint problem (requires `-ts_save_trajectory`)
 .  -ts_fd_color - Use finite differences with coloring to compute IJacobian
+.  -ts_jacobian_reuse - Reuse the Jacobian and preconditioner across stages and steps when the heuristics of `TSSetJacobianReuse()` allow it
+.  -ts_ijacobian_split - Assemble dF/dUdot and dF/dU once from the IJacobian and form the Jacobian from them, see `TSSetIJacobianSplit()`
 .  -ts_monitor - print information at each timestep
 .  -ts_monitor_cancel - Cancel all monitors
 .  -ts_monitor_lg_solution - Monitor solution graphically
@@ -129,6 +131,18 @@ PetscErrorCode TSSetFromOptions(TS ts)
   PetscCall(PetscOptionsBool("-ts_rhs_jacobian_test_mult", "Test the RHS Jacobian for consistency with RHS at each solve ", "None", ts->testjacobian, &ts->testjacobian, NULL));
   PetscCall(PetscOptionsBool("-ts_rhs_jacobian_test_mult_transpose", "Test the RHS Jacobian transpose for consistency with RHS at each solve ", "None", ts->testjacobiantranspose, &ts->testjacobiantranspose, NULL));
   PetscCall(PetscOptionsBool("-ts_use_splitrhsfunction", "Use the split RHS function for multirate solvers ", "TSSetUseSplitRHSFunction", ts->use_splitrhsfunction, &ts->use_splitrhsfunction, NULL));
+  PetscCall(PetscOptionsBool("-ts_jacobian_reuse", "Reuse the Jacobian and preconditioner across stages and steps when possible", "TSSetJacobianReuse", ts->jacreuse.enabled, &ts->jacreuse.enabled, NULL));
+  PetscCall(PetscOptionsReal("-ts_jacobian_reuse_shift_tol", "Relative change of the shift below which the Jacobian is reused", "TSSetJacobianReuseTolerances", ts->jacreuse.shift_tol, &ts->jacreuse.shift_tol, NULL));
+  PetscCall(PetscOptionsReal("-ts_jacobian_reuse_rate", "Nonlinear convergence rate above which the Jacobian is evaluated", "TSSetJacobianReuseTolerances", ts->jacreuse.rate_tol, &ts->jacreuse.rate_tol, NULL));
+  PetscCall(PetscOptionsReal("-ts_jacobian_reuse_ksp_growth", "Growth of the linear iterations above which the Jacobian is evaluated", "TSSetJacobianReuseTolerances", ts->jacreuse.ksp_growth, &ts->jacreuse.ksp_growth, NULL));
+  PetscCall(PetscOptionsInt("-ts_jacobian_reuse_max_steps", "Maximum number of steps between two Jacobian evaluations", "TSSetJacobianReuseTolerances", ts->jacreuse.max_steps, &ts->jacreuse.max_steps, NULL));
+  {
+    PetscBool split = ts->ijacsplit.enabled;
+
+    PetscCall(PetscOptionsBool("-ts_ijacobian_split", "Assemble dF/dUdot and dF/dU once and form the Jacobian from them", "TSSetIJacobianSplit", split, &split, &flg));
+    if (flg && split && !ts->ijacsplit.enabled) PetscCall(TSSetIJacobianSplit(ts, NULL, NULL, DIFFERENT_NONZERO_PATTERN));
+    else if (flg && !split) ts->ijacsplit.enabled = PETSC_FALSE;
+  }
 #if defined(PETSC_HAVE_SAWS)
   {
     PetscBool set;
@@ -866,6 +880,134 @@ static PetscErrorCode TSRecoverRHSJacobian(TS ts, Mat A, Mat B)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   TSJacobianReuseApply_Private - Decides, when the nonlinear solver requests a Jacobian, whether the matrices computed at an earlier
+   request can be kept, possibly after updating their shift, instead of evaluating the Jacobian and rebuilding the preconditioner
+
+   The matrices are kept unless they were modified elsewhere, a nonlinear solve failed, the Jacobian is older than the maximum number
+   of steps, the nonlinear iteration contracts slower than the rate tolerance, or the linear iterations grew by more than the allowed
+   factor since the preconditioner was last rebuilt. When the shift changed by more than its relative tolerance, the matrices are only
+   kept if the mass matrix is the identity, so that J = shift*I - dG/dU can be updated with a diagonal shift.
+
+   With SNESKSPONLY or a TS_LINEAR problem there is no Newton iteration to correct for an inexact operator, so any change of the
+   shift is applied exactly, and the Jacobian is evaluated when the time changed unless it is constant.
+*/
+static PetscErrorCode TSJacobianReuseApply_Private(TS ts, PetscReal t, PetscReal shift, Mat A, Mat B, PetscBool identity, PetscBool constant, PetscBool *kept)
+{
+  KSP              ksp;
+  PetscInt         it, kits;
+  PetscReal        fnorm, rate = 0.0;
+  PetscBool        mf, ksponly, exact, shifted;
+  PetscObjectState Astate, Bstate;
+  const char      *why = NULL;
+
+  PetscFunctionBegin;
+  *kept = PETSC_FALSE;
+  PetscCall(SNESGetIterationNumber(ts->snes, &it));
+  PetscCall(SNESGetFunctionNorm(ts->snes, &fnorm));
+  PetscCall(SNESGetKSP(ts->snes, &ksp));
+  PetscCall(KSPGetIterationNumber(ksp, &kits));
+  if (it > 0 && it == ts->jacreuse.snes_it + 1 && ts->jacreuse.fnorm > 0.0) rate = fnorm / ts->jacreuse.fnorm;
+  ts->jacreuse.snes_it = it;
+  ts->jacreuse.fnorm   = fnorm;
+  /* the last linear solve is the first one after the preconditioner was rebuilt */
+  if (ts->jacreuse.rebuilt) {
+    ts->jacreuse.ksp_its = PetscMax(kits, 1);
+    ts->jacreuse.rebuilt = PETSC_FALSE;
+  }
+
+  /* with -snes_mf_operator the matrix-free operator is always current and only B holds the Jacobian */
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATMFFD, &mf));
+  PetscCall(PetscObjectStateGet((PetscObject)A, &Astate));
+  PetscCall(PetscObjectStateGet((PetscObject)B, &Bstate));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)ts->snes, &ksponly, SNESKSPONLY, SNESKSPTRANSPOSEONLY, ""));
+  exact = (PetscBool)(ksponly || ts->problem_type == TS_LINEAR);
+  if (exact) shifted = (PetscBool)(shift != ts->jacreuse.shift);
+  else shifted = (PetscBool)(PetscAbsReal(shift - ts->jacreuse.shift) > ts->jacreuse.shift_tol * PetscAbsReal(ts->jacreuse.shift));
+  if (!ts->jacreuse.valid) why = "there is no Jacobian to reuse";
+  else if ((!mf && Astate != ts->jacreuse.Astate) || Bstate != ts->jacreuse.Bstate) why = "the matrices were modified";
+  else if (ts->num_snes_failures != ts->jacreuse.snes_failures) why = "the nonlinear solve failed";
+  else if (exact && !constant && t != ts->jacreuse.time) why = "the time changed";
+  else if (ts->steps - ts->jacreuse.step >= ts->jacreuse.max_steps) why = "the Jacobian reached the maximum age";
+  else if (rate > ts->jacreuse.rate_tol) why = "the nonlinear convergence is too slow";
+  else if (kits > ts->jacreuse.ksp_growth * ts->jacreuse.ksp_its) why = "the linear iterations grew";
+  else if (shifted && !identity) why = "the shift changed";
+  if (why) {
+    PetscCall(PetscInfo(ts, "Evaluating the Jacobian at step %" PetscInt_FMT " since %s\n", ts->steps, why));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  if (shifted) {
+    PetscCall(PetscInfo(ts, "Updating the shift of the Jacobian from %g to %g at step %" PetscInt_FMT "\n", (double)ts->jacreuse.shift, (double)shift, ts->steps));
+    if (!mf) PetscCall(MatShift(A, shift - ts->jacreuse.shift));
+    if (A != B) PetscCall(MatShift(B, shift - ts->jacreuse.shift));
+    if (A == ts->Arhs) ts->rhsjacobian.shift = shift;
+    ts->jacreuse.shift   = shift;
+    ts->jacreuse.rebuilt = PETSC_TRUE;
+    ts->jacreuse.shifts++;
+  } else {
+    PetscCall(PetscInfo(ts, "Reusing the Jacobian and preconditioner at step %" PetscInt_FMT "\n", ts->steps));
+    ts->jacreuse.reuses++;
+  }
+  /* the matrix-free operator must be told about the new linearization point */
+  if (mf) {
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(PetscObjectStateGet((PetscObject)A, &ts->jacreuse.Astate));
+  PetscCall(PetscObjectStateGet((PetscObject)B, &ts->jacreuse.Bstate));
+  ts->jacreuse.time = t;
+  *kept = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   TSComputeIJacobianSplit_Private - Forms shift*dF/dUdot + dF/dU from the matrices of TSSetIJacobianSplit(), assembling them from the
+   IJacobian at the first call if they were not provided
+
+   Both matrices share the nonzero pattern of the preconditioning matrix when it is not changed by the IJacobian, so that the operator
+   is formed with a copy and an axpy of the values only, and the preconditioner sees a numerical update with the same nonzero pattern.
+   The matrices are left untouched, and the preconditioner is not rebuilt, when neither the shift nor the matrices changed.
+*/
+static PetscErrorCode TSComputeIJacobianSplit_Private(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal shift, Mat A, Mat B, TSIJacobian ijacobian, void *ctx)
+{
+  PetscBool        mf;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  PetscCheck(ts->problem_type == TS_LINEAR, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "The split IJacobian is only formed once, and requires a TS_LINEAR problem");
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATMFFD, &mf));
+  PetscCheck(A == B || mf, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "The split IJacobian requires the same Jacobian and preconditioning matrices, or a matrix-free Jacobian");
+  if (!ts->ijacsplit.K) {
+    PetscObjectState nz0, nz1;
+
+    /* F is affine in Udot, and its Jacobian does not depend on t, U and Udot */
+    PetscCall(PetscInfo(ts, "Assembling dF/dUdot and dF/dU from the IJacobian\n"));
+    PetscCallBack("TS callback implicit Jacobian", (*ijacobian)(ts, t, U, Udot, 0.0, A, B, ctx));
+    PetscCall(MatGetNonzeroState(B, &nz0));
+    PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &ts->ijacsplit.K));
+    PetscCallBack("TS callback implicit Jacobian", (*ijacobian)(ts, t, U, Udot, 1.0, A, B, ctx));
+    PetscCall(MatGetNonzeroState(B, &nz1));
+    PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &ts->ijacsplit.M));
+    ts->ijacsplit.str = nz0 == nz1 ? SAME_NONZERO_PATTERN : DIFFERENT_NONZERO_PATTERN;
+    PetscCall(MatAXPY(ts->ijacsplit.M, -1.0, ts->ijacsplit.K, ts->ijacsplit.str));
+    ts->ijacsplit.owned = PETSC_TRUE;
+    ts->ijacs += 2;
+  }
+  PetscCall(PetscObjectStateGet((PetscObject)B, &state));
+  if (shift != ts->ijacsplit.shift || state != ts->ijacsplit.Bstate) {
+    PetscCall(MatCopy(ts->ijacsplit.K, B, ts->ijacsplit.str));
+    PetscCall(MatAXPY(B, shift, ts->ijacsplit.M, ts->ijacsplit.str));
+    PetscCall(PetscObjectStateGet((PetscObject)B, &ts->ijacsplit.Bstate));
+    ts->ijacsplit.shift = shift;
+  }
+  if (mf) {
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    TSComputeIJacobian - Evaluates the Jacobian of the DAE
 
@@ -902,6 +1044,7 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
   TSRHSJacobian rhsjacobian;
   DM            dm;
   void         *ctx;
+  PetscBool     reuse = ts->jacreuse.active, split;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
@@ -916,15 +1059,31 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
   PetscCall(DMTSGetIJacobian(dm, &ijacobian, &ctx));
   PetscCall(DMTSGetRHSJacobian(dm, &rhsjacobian, NULL));
 
-  PetscCheck(rhsjacobian || ijacobian, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must call TSSetRHSJacobian() and / or TSSetIJacobian()");
+  /* without an IJacobian the split is only usable if its matrices were provided */
+  split = (PetscBool)(ts->ijacsplit.enabled && (ijacobian || ts->ijacsplit.K));
+  PetscCheck(rhsjacobian || ijacobian || split, PetscObjectComm((PetscObject)ts), PETSC_ERR_USER, "Must call TSSetRHSJacobian() and / or TSSetIJacobian()");
+
+  ts->jacreuse.active = PETSC_FALSE;
+  if (reuse) {
+    PetscBool identity, constant, kept;
+
+    /* the shift can only be updated separately when the mass matrix is the identity */
+    identity = (PetscBool)((!ijacobian && !split) || ts->equation_type == TS_EQ_ODE_EXPLICIT);
+    /* the split IJacobian is only used for TS_LINEAR problems whose Jacobian does not depend on the time */
+    constant = (PetscBool)((!ijacobian || split || ijacobian == TSComputeIJacobianConstant) && (!rhsjacobian || rhsjacobian == TSComputeRHSJacobianConstant));
+    PetscCall(TSJacobianReuseApply_Private(ts, t, shift, A, B, identity, constant, &kept));
+    if (kept) PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   PetscCall(PetscLogEventBegin(TS_JacobianEval, ts, U, A, B));
-  if (ijacobian) {
+  if (split) {
+    PetscCall(TSComputeIJacobianSplit_Private(ts, t, U, Udot, shift, A, B, ijacobian, ctx));
+  } else if (ijacobian) {
     PetscCallBack("TS callback implicit Jacobian", (*ijacobian)(ts, t, U, Udot, shift, A, B, ctx));
     ts->ijacs++;
   }
   if (imex) {
-    if (!ijacobian) { /* system was written as Udot = G(t,U) */
+    if (!ijacobian && !split) { /* system was written as Udot = G(t,U) */
       PetscBool assembled;
       if (rhsjacobian) {
         Mat Arhs = NULL;
@@ -991,8 +1150,8 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
       }
       ts->rhsjacobian.scale = -1;
       ts->rhsjacobian.shift = shift;
-    } else if (Arhs) {  /* Both IJacobian and RHSJacobian */
-      if (!ijacobian) { /* No IJacobian provided, but we have a separate RHS matrix */
+    } else if (Arhs) {              /* Both IJacobian and RHSJacobian */
+      if (!ijacobian && !split) { /* No IJacobian provided, but we have a separate RHS matrix */
         PetscCall(MatZeroEntries(A));
         PetscCall(MatShift(A, shift));
         if (A != B) {
@@ -1006,6 +1165,17 @@ PetscErrorCode TSComputeIJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal
     }
   }
   PetscCall(PetscLogEventEnd(TS_JacobianEval, ts, U, A, B));
+  if (reuse) {
+    ts->jacreuse.valid         = PETSC_TRUE;
+    ts->jacreuse.rebuilt       = PETSC_TRUE;
+    ts->jacreuse.shift         = shift;
+    ts->jacreuse.time          = t;
+    ts->jacreuse.step          = ts->steps;
+    ts->jacreuse.snes_failures = ts->num_snes_failures;
+    ts->jacreuse.evals++;
+    PetscCall(PetscObjectStateGet((PetscObject)A, &ts->jacreuse.Astate));
+    PetscCall(PetscObjectStateGet((PetscObject)B, &ts->jacreuse.Bstate));
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -2007,6 +2177,8 @@ PetscErrorCode TSView(TS ts, PetscViewer viewer)
       PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of linear solver iterations=%" PetscInt_FMT "\n", ts->ksp_its));
       PetscCall(PetscObjectTypeCompareAny((PetscObject)ts->snes, &lin, SNESKSPONLY, SNESKSPTRANSPOSEONLY, ""));
       PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of %slinear solve failures=%" PetscInt_FMT "\n", lin ? "" : "non", ts->num_snes_failures));
+      if (ts->ijacsplit.enabled) PetscCall(PetscViewerASCIIPrintf(viewer, "  Jacobian formed from %s dF/dUdot and dF/dU\n", ts->ijacsplit.owned || !ts->ijacsplit.K ? "assembled" : "provided"));
+      if (ts->jacreuse.enabled) PetscCall(PetscViewerASCIIPrintf(viewer, "  Jacobian reuse: evaluations=%" PetscInt_FMT ", shift updates=%" PetscInt_FMT ", reuses=%" PetscInt_FMT "\n", ts->jacreuse.evals, ts->jacreuse.shifts, ts->jacreuse.reuses));
     }
     PetscCall(PetscViewerASCIIPrintf(viewer, "  total number of rejected steps=%" PetscInt_FMT "\n", ts->reject));
     if (ts->vrtol) PetscCall(PetscViewerASCIIPrintf(viewer, "  using vector of relative error tolerances, "));
@@ -2676,6 +2848,13 @@ PetscErrorCode TSReset(TS ts)
   }
   ts->tsrhssplit     = NULL;
   ts->num_rhs_splits = 0;
+  ts->jacreuse.valid = PETSC_FALSE;
+  if (ts->ijacsplit.owned) {
+    PetscCall(MatDestroy(&ts->ijacsplit.M));
+    PetscCall(MatDestroy(&ts->ijacsplit.K));
+    ts->ijacsplit.owned = PETSC_FALSE;
+  }
+  ts->ijacsplit.Bstate = 0;
   if (ts->tspan) {
     PetscCall(PetscFree(ts->tspan->span_times));
     PetscCall(VecDestroyVecs(ts->tspan->num_span_times, &ts->tspan->vecs_sol));
@@ -2723,6 +2902,8 @@ PetscErrorCode TSDestroy(TS *ts)
 
   PetscCall(SNESDestroy(&(*ts)->snes));
   PetscCall(DMDestroy(&(*ts)->dm));
+  PetscCall(MatDestroy(&(*ts)->ijacsplit.M));
+  PetscCall(MatDestroy(&(*ts)->ijacsplit.K));
   PetscCall(TSMonitorCancel((*ts)));
   PetscCall(TSAdjointMonitorCancel((*ts)));
 
@@ -3765,6 +3946,9 @@ PetscErrorCode TSSolve(TS ts, Vec u)
      restarts the step after an event. Resetting these counters in such case causes
      TSTrajectory to incorrectly save the output files
   */
+  /* the problem may have changed since the last solve */
+  ts->jacreuse.valid = PETSC_FALSE;
+
   /* reset time step and iteration counters */
   if (!ts->steps) {
     ts->ksp_its           = 0;
@@ -4264,7 +4448,9 @@ PetscErrorCode SNESTSFormJacobian(SNES snes, Vec U, Mat A, Mat B, void *ctx)
   PetscValidPointer(B, 4);
   PetscValidHeaderSpecific(B, MAT_CLASSID, 4);
   PetscValidHeaderSpecific(ts, TS_CLASSID, 5);
+  ts->jacreuse.active = ts->jacreuse.enabled;
   PetscCall((ts->ops->snesjacobian)(snes, U, A, B, ts));
+  ts->jacreuse.active = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -4401,10 +4587,9 @@ $     M Udot = F(U,t)
 
 $    shift*M + J
 
-  where J is the Jacobian of -F(U).  Support may be added in a future version of PETSc, but for now, the user must store
-  a copy of M or reassemble it when requested.
+  where J is the Jacobian of -F(U).  For linear problems whose implicit operator has this form, use `TSSetIJacobianSplit()` instead.
 
-.seealso: [](chapter_ts), `TS`, `TSROSW`, `TSARKIMEX`, `TSSetIFunction()`, `TSSetIJacobian()`, `TSComputeIFunctionLinear()`
+.seealso: [](chapter_ts), `TS`, `TSROSW`, `TSARKIMEX`, `TSSetIFunction()`, `TSSetIJacobian()`, `TSComputeIFunctionLinear()`, `TSSetIJacobianSplit()`
 @*/
 PetscErrorCode TSComputeIJacobianConstant(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal shift, Mat A, Mat B, void *ctx)
 {
@@ -4697,6 +4882,218 @@ PetscErrorCode TSSetMaxSNESFailures(TS ts, PetscInt fails)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   TSSetIJacobianSplit - Sets the derivatives of the implicit function with respect to Udot and U, so that the `TS` forms the
+   Jacobian shift*dF/dUdot + dF/dU with a copy and an axpy of their values instead of calling the IJacobian at each change of the shift
+
+   Logically Collective
+
+   Input Parameters:
++  ts - `TS` context
+.  M - dF/dUdot, or `NULL` to have the `TS` assemble it from the IJacobian
+.  K - dF/dU, or `NULL` to have the `TS` assemble it from the IJacobian
+-  str - relation of the nonzero patterns of `M` and `K` to the preconditioning matrix passed to `TSSetIJacobian()`, see `MatAXPY()`
+
+   Options Database Key:
+.  -ts_ijacobian_split - Assemble dF/dUdot and dF/dU from the IJacobian
+
+   Level: intermediate
+
+   Notes:
+   This is meant for linear problems whose implicit function F(t,U,Udot) has a Jacobian that does not depend on t, U and Udot, since
+   `M` and `K` are never formed again. The problem type must be set to `TS_LINEAR` with `TSSetProblemType()` before this call. A Jacobian
+   from the RHS function is still evaluated and added as usual.
+
+   When `M` and `K` are `NULL`, the IJacobian is evaluated with shifts 0 and 1 at the first request and the matrices are stored by the
+   `TS`; they share the nonzero pattern of the preconditioning matrix unless the IJacobian changes it. Use `SAME_NONZERO_PATTERN` for
+   provided matrices with the same pattern as the preconditioning matrix, so that forming the Jacobian only touches its values and the
+   preconditioner is updated numerically. The Jacobian is not formed again, and the preconditioner is not rebuilt, while the shift is
+   unchanged.
+
+   The Jacobian and preconditioning matrices set with `TSSetIJacobian()` must be the same, or the Jacobian must be matrix-free with
+   `-snes_mf_operator`. The IJacobian routine may be `NULL` when `M` and `K` are provided.
+
+.seealso: [](chapter_ts), `TS`, `TSGetIJacobianSplit()`, `TSSetIJacobian()`, `TSComputeIJacobian()`, `TSSetProblemType()`, `MatAXPY()`, `TSSetJacobianReuse()`
+@*/
+PetscErrorCode TSSetIJacobianSplit(TS ts, Mat M, Mat K, MatStructure str)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  if (M) PetscValidHeaderSpecific(M, MAT_CLASSID, 2);
+  if (K) PetscValidHeaderSpecific(K, MAT_CLASSID, 3);
+  PetscValidLogicalCollectiveEnum(ts, str, 4);
+  PetscCheck((M && K) || (!M && !K), PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONG, "Must provide both dF/dUdot and dF/dU, or neither");
+  PetscCheck(ts->problem_type == TS_LINEAR, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "The split IJacobian requires a TS_LINEAR problem, call TSSetProblemType() first");
+  if (M) PetscCall(PetscObjectReference((PetscObject)M));
+  if (K) PetscCall(PetscObjectReference((PetscObject)K));
+  PetscCall(MatDestroy(&ts->ijacsplit.M));
+  PetscCall(MatDestroy(&ts->ijacsplit.K));
+  ts->ijacsplit.M       = M;
+  ts->ijacsplit.K       = K;
+  ts->ijacsplit.str     = str;
+  ts->ijacsplit.owned   = PETSC_FALSE;
+  ts->ijacsplit.enabled = PETSC_TRUE;
+  ts->ijacsplit.Bstate  = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSGetIJacobianSplit - Gets the derivatives of the implicit function with respect to Udot and U used to form the Jacobian
+
+   Not Collective
+
+   Input Parameter:
+.  ts - `TS` context
+
+   Output Parameters:
++  M - dF/dUdot, or `NULL`
+-  K - dF/dU, or `NULL`
+
+   Level: intermediate
+
+   Note:
+   The matrices are `NULL` if `TSSetIJacobianSplit()` was not called, or if the `TS` assembles them and no Jacobian was requested yet.
+
+.seealso: [](chapter_ts), `TS`, `TSSetIJacobianSplit()`
+@*/
+PetscErrorCode TSGetIJacobianSplit(TS ts, Mat *M, Mat *K)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  if (M) *M = ts->ijacsplit.M;
+  if (K) *K = ts->ijacsplit.K;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSSetJacobianReuse - Lets the `TS` reuse the Jacobian and preconditioner computed at earlier stages and steps when the
+   nonlinear solver requests a new Jacobian, based on the change of the shift, the nonlinear convergence rate and the growth of
+   the linear iterations
+
+   Logically Collective
+
+   Input Parameters:
++  ts - `TS` context
+-  flg - `PETSC_TRUE` to reuse the Jacobian when possible
+
+   Options Database Key:
+.  -ts_jacobian_reuse - Reuse the Jacobian and preconditioner when possible
+
+   Level: intermediate
+
+   Notes:
+   At each request of the nonlinear solver of an implicit integrator, the Jacobian is evaluated if the matrices were modified outside
+   of the `TS`, a nonlinear solve failed, the Jacobian was evaluated more steps ago than allowed, the last nonlinear iteration
+   contracted the residual norm by less than the rate tolerance, or the number of linear iterations grew by more than the allowed
+   factor since the preconditioner was last built. Otherwise, if the shift (the derivative of the stage derivative with respect to
+   the stage value, typically proportional to 1/dt) changed by less than its relative tolerance, the matrices are left untouched
+   and the preconditioner is not rebuilt, so that Newton's method becomes a chord method. If the shift changed more, the matrices
+   are updated with `MatShift()` when the mass matrix is the identity, that is when only `TSSetRHSJacobian()` is provided or the
+   equation type is `TS_EQ_ODE_EXPLICIT`, and the Jacobian is evaluated otherwise.
+
+   With `SNESKSPONLY` or a `TS_LINEAR` problem, the single linear solve cannot correct an inexact operator, so the shift is always
+   updated exactly and the Jacobian is evaluated whenever the time changed, unless it is constant: the RHS Jacobian, if any, is
+   `TSComputeRHSJacobianConstant()`, and the IJacobian, if any, is `TSComputeIJacobianConstant()` or formed with `TSSetIJacobianSplit()`.
+   Otherwise the nonlinear tolerances should be tight enough for the chord iteration to be accurate.
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianReuseTolerances()`, `TSGetJacobianReuseCounts()`, `SNESSetLagJacobian()`, `SNESSetLagPreconditioner()`, `TSSetEquationType()`
+@*/
+PetscErrorCode TSSetJacobianReuse(TS ts, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ts, flg, 2);
+  ts->jacreuse.enabled = flg;
+  ts->jacreuse.valid   = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSSetJacobianReuseTolerances - Sets the tolerances deciding when a reused Jacobian must be evaluated again
+
+   Logically Collective
+
+   Input Parameters:
++  ts - `TS` context
+.  shift_tol - relative change of the shift below which the Jacobian is reused as it is (default 0.3)
+.  rate - contraction rate of the nonlinear residual norm above which the Jacobian is evaluated (default 0.3)
+.  ksp_growth - factor by which the linear iterations may grow before the Jacobian is evaluated (default 2)
+-  max_steps - maximum number of steps between two evaluations of the Jacobian (default 20)
+
+   Options Database Keys:
++  -ts_jacobian_reuse_shift_tol <shift_tol> - Relative change of the shift below which the Jacobian is reused
+.  -ts_jacobian_reuse_rate <rate> - Nonlinear convergence rate above which the Jacobian is evaluated
+.  -ts_jacobian_reuse_ksp_growth <ksp_growth> - Growth of the linear iterations above which the Jacobian is evaluated
+-  -ts_jacobian_reuse_max_steps <max_steps> - Maximum number of steps between two Jacobian evaluations
+
+   Level: advanced
+
+   Note:
+   Use `PETSC_DEFAULT` to leave a value unchanged.
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianReuse()`, `TSGetJacobianReuseCounts()`
+@*/
+PetscErrorCode TSSetJacobianReuseTolerances(TS ts, PetscReal shift_tol, PetscReal rate, PetscReal ksp_growth, PetscInt max_steps)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(ts, shift_tol, 2);
+  PetscValidLogicalCollectiveReal(ts, rate, 3);
+  PetscValidLogicalCollectiveReal(ts, ksp_growth, 4);
+  PetscValidLogicalCollectiveInt(ts, max_steps, 5);
+  if (shift_tol != (PetscReal)PETSC_DEFAULT) {
+    PetscCheck(shift_tol >= 0.0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Shift tolerance %g must be non-negative", (double)shift_tol);
+    ts->jacreuse.shift_tol = shift_tol;
+  }
+  if (rate != (PetscReal)PETSC_DEFAULT) {
+    PetscCheck(rate > 0.0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Convergence rate %g must be positive", (double)rate);
+    ts->jacreuse.rate_tol = rate;
+  }
+  if (ksp_growth != (PetscReal)PETSC_DEFAULT) {
+    PetscCheck(ksp_growth >= 1.0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Linear iteration growth %g must be at least 1", (double)ksp_growth);
+    ts->jacreuse.ksp_growth = ksp_growth;
+  }
+  if (max_steps != PETSC_DEFAULT) {
+    PetscCheck(max_steps > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Maximum number of steps %" PetscInt_FMT " must be positive", max_steps);
+    ts->jacreuse.max_steps = max_steps;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   TSGetJacobianReuseCounts - Gets the number of Jacobian requests of the nonlinear solver that were served by an evaluation, by a
+   shift update, or by reusing the matrices and preconditioner
+
+   Not Collective
+
+   Input Parameter:
+.  ts - `TS` context
+
+   Output Parameters:
++  evals - number of evaluations of the Jacobian
+.  shifts - number of shift updates
+-  reuses - number of reuses of the Jacobian and preconditioner
+
+   Level: intermediate
+
+   Notes:
+   The counters are only incremented when `TSSetJacobianReuse()` is active.
+
+   The evaluations counted here are the Jacobians formed for the nonlinear solver. The number of RHS Jacobian evaluations reported by
+   `TSView()` also counts the calls of the RHS Jacobian routine made by `TSComputeRHSFunctionLinear()` to apply the operator.
+
+.seealso: [](chapter_ts), `TS`, `TSSetJacobianReuse()`, `TSSetJacobianReuseTolerances()`
+@*/
+PetscErrorCode TSGetJacobianReuseCounts(TS ts, PetscInt *evals, PetscInt *shifts, PetscInt *reuses)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  if (evals) *evals = ts->jacreuse.evals;
+  if (shifts) *shifts = ts->jacreuse.shifts;
+  if (reuses) *reuses = ts->jacreuse.reuses;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    TSSetErrorIfStepFails - Immediately error if no step succeeds during `TSSolve()`
 
@@ -57,6 +57,11 @@ PetscErrorCode TSCreate(MPI_Comm comm, TS *ts)
   t->rhsjacobian.scale = 1.0;
   t->ijacobian.shift   = 1.0;
 
+  t->jacreuse.shift_tol  = 0.3;
+  t->jacreuse.rate_tol   = 0.3;
+  t->jacreuse.ksp_growth = 2.0;
+  t->jacreuse.max_steps  = 20;
+
   /* All methods that do adaptivity should specify
    * its preferred adapt type in their constructor */
   t->default_adapt_type = TSADAPTNONE;
@@ -22,6 +22,8 @@ PETSC_EXTERN PetscErrorCode TSCreate_BasicSymplectic(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_MPRK(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_DiscGrad(TS);
 PETSC_EXTERN PetscErrorCode TSCreate_IRK(TS);
+PETSC_EXTERN PetscErrorCode TSCreate_Parareal(TS);
+PETSC_EXTERN PetscErrorCode TSCreate_Batch(TS);
 
 /*@C
   TSRegisterAll - Registers all of the timesteppers in the `TS` package.
@@ -67,5 +69,7 @@ PetscErrorCode TSRegisterAll(void)
   PetscCall(TSRegister(TSMPRK, TSCreate_MPRK));
   PetscCall(TSRegister(TSDISCGRAD, TSCreate_DiscGrad));
   PetscCall(TSRegister(TSIRK, TSCreate_IRK));
+  PetscCall(TSRegister(TSPARAREAL, TSCreate_Parareal));
+  PetscCall(TSRegister(TSBATCH, TSCreate_Batch));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -0,0 +1,212 @@
+static char help[] = "Tests TSPARAREAL on the heat equation, with the time slices distributed over groups of processes.\n\
+Input parameters include:\n\
+  -nt <nt>           : number of time groups, which divides the number of processes\n\
+  -nslices <nslices> : number of time slices\n\
+  -implicit          : use the implicit form of the equation\n\n";
+
+#include <petscts.h>
+#include <petscdmda.h>
+
+/* u_t = u_xx on the periodic unit interval */
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec U, Vec F, void *ctx)
+{
+  DM                 da;
+  Vec                Ul;
+  const PetscScalar *u;
+  PetscScalar       *f;
+  PetscInt           xs, xm, M;
+  PetscReal          hx;
+
+  PetscFunctionBeginUser;
+  PetscCall(TSGetDM(ts, &da));
+  PetscCall(DMDAGetInfo(da, NULL, &M, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  hx = 1.0 / M;
+  PetscCall(DMGetLocalVector(da, &Ul));
+  PetscCall(DMGlobalToLocalBegin(da, U, INSERT_VALUES, Ul));
+  PetscCall(DMGlobalToLocalEnd(da, U, INSERT_VALUES, Ul));
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  PetscCall(DMDAVecGetArrayRead(da, Ul, &u));
+  PetscCall(DMDAVecGetArray(da, F, &f));
+  for (PetscInt i = xs; i < xs + xm; i++) f[i] = (u[i - 1] - 2.0 * u[i] + u[i + 1]) / (hx * hx);
+  PetscCall(DMDAVecRestoreArray(da, F, &f));
+  PetscCall(DMDAVecRestoreArrayRead(da, Ul, &u));
+  PetscCall(DMRestoreLocalVector(da, &Ul));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec U, Mat A, Mat B, void *ctx)
+{
+  DM        da;
+  PetscInt  xs, xm, M;
+  PetscReal hx;
+
+  PetscFunctionBeginUser;
+  PetscCall(TSGetDM(ts, &da));
+  PetscCall(DMDAGetInfo(da, NULL, &M, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+  hx = 1.0 / M;
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  for (PetscInt i = xs; i < xs + xm; i++) {
+    MatStencil  row = {0}, col[3] = {{0}};
+    PetscScalar v[3];
+
+    row.i = i;
+    for (PetscInt j = 0; j < 3; j++) {
+      col[j].i = i + j - 1;
+      v[j]     = (j == 1 ? -2.0 : 1.0) / (hx * hx);
+    }
+    PetscCall(MatSetValuesStencil(B, 1, &row, 3, col, v, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode IFunction(TS ts, PetscReal t, Vec U, Vec Udot, Vec F, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(RHSFunction(ts, t, U, F, ctx));
+  PetscCall(VecAYPX(F, -1.0, Udot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode IJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal shift, Mat A, Mat B, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(RHSJacobian(ts, t, U, A, B, ctx));
+  PetscCall(MatScale(B, -1.0));
+  PetscCall(MatShift(B, shift));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SetEquation(TS ts, Mat J, PetscBool implicit)
+{
+  PetscFunctionBeginUser;
+  if (implicit) {
+    PetscCall(TSSetIFunction(ts, NULL, IFunction, NULL));
+    PetscCall(TSSetIJacobian(ts, J, J, IJacobian, NULL));
+  } else {
+    PetscCall(TSSetRHSFunction(ts, NULL, RHSFunction, NULL));
+    PetscCall(TSSetRHSJacobian(ts, J, J, RHSJacobian, NULL));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  TS          ts, fine, coarse, ref;
+  DM          da, daref;
+  Mat         J, Jref;
+  Vec         u, v;
+  MPI_Comm    scomm, tcomm;
+  PetscMPIInt size, rank;
+  PetscInt    nt = 1, nslices = 4, its, xs, xm;
+  PetscReal   tf = 0.1, dt = 0.005, nrm, err;
+  PetscBool   implicit = PETSC_FALSE;
+  TSType      type;
+  PetscScalar *x;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nt", &nt, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nslices", &nslices, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-implicit", &implicit, NULL));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCheck(nt > 0 && size % nt == 0, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "The number of time groups %" PetscInt_FMT " must divide the number of processes %d", nt, size);
+
+  /* Consecutive processes form a spatial group, processes with the same rank in their groups a time communicator */
+  PetscCallMPI(MPI_Comm_split(PETSC_COMM_WORLD, (PetscMPIInt)(rank / (size / nt)), rank, &scomm));
+  PetscCallMPI(MPI_Comm_split(PETSC_COMM_WORLD, (PetscMPIInt)(rank % (size / nt)), rank, &tcomm));
+
+  PetscCall(DMDACreate1d(scomm, DM_BOUNDARY_PERIODIC, 32, 1, 1, NULL, &da));
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMCreateMatrix(da, &J));
+  PetscCall(DMCreateGlobalVector(da, &u));
+  PetscCall(DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL));
+  PetscCall(DMDAVecGetArray(da, u, &x));
+  for (PetscInt i = xs; i < xs + xm; i++) x[i] = PetscSinReal(2.0 * PETSC_PI * i / 32) + 0.5 * PetscCosReal(6.0 * PETSC_PI * i / 32);
+  PetscCall(DMDAVecRestoreArray(da, u, &x));
+  PetscCall(VecDuplicate(u, &v));
+  PetscCall(VecCopy(u, v));
+
+  PetscCall(TSCreate(scomm, &ts));
+  PetscCall(TSSetDM(ts, da));
+  PetscCall(TSSetType(ts, TSPARAREAL));
+  PetscCall(SetEquation(ts, J, implicit));
+  PetscCall(TSSetMaxTime(ts, tf));
+  PetscCall(TSSetTimeStep(ts, dt));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSPararealSetTimeCommunicator(ts, tcomm));
+  PetscCall(TSPararealSetNumSlices(ts, nslices));
+  PetscCall(TSPararealGetFineTS(ts, &fine));
+  PetscCall(TSSetType(fine, TSCN));
+  PetscCall(TSPararealGetCoarseTS(ts, &coarse));
+  PetscCall(TSSetType(coarse, TSBEULER));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSolve(ts, u));
+  PetscCall(TSPararealGetIterationNumber(ts, &its));
+
+  /* The sequential fine integration, restarted at every slice */
+  PetscCall(DMClone(da, &daref));
+  PetscCall(MatDuplicate(J, MAT_DO_NOT_COPY_VALUES, &Jref));
+  PetscCall(TSCreate(scomm, &ref));
+  PetscCall(TSSetOptionsPrefix(ref, "ref_"));
+  PetscCall(TSSetDM(ref, daref));
+  PetscCall(TSGetType(fine, &type));
+  PetscCall(TSSetType(ref, type));
+  PetscCall(SetEquation(ref, Jref, implicit));
+  PetscCall(TSSetExactFinalTime(ref, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetFromOptions(ref));
+  for (PetscInt n = 0; n < nslices; n++) {
+    PetscCall(TSSetMaxTime(ref, n == nslices - 1 ? tf : (n + 1) * tf / nslices));
+    PetscCall(TSSetTimeStep(ref, dt));
+    PetscCall(TSSetStepNumber(ref, 0));
+    PetscCall(TSSolve(ref, v));
+  }
+  PetscCall(VecNorm(v, NORM_2, &nrm));
+  PetscCall(VecAXPY(v, -1.0, u));
+  PetscCall(VecNorm(v, NORM_2, &err));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Parareal iterations %" PetscInt_FMT " for %" PetscInt_FMT " slices\n", its, nslices));
+  /* the error is below the parareal tolerances of the tests, its value is only printed when the check fails */
+  if (err < 1e-4 * nrm) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative error to the sequential fine integration: < 1e-4\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative error to the sequential fine integration: %.2e\n", (double)(err / nrm)));
+
+  PetscCall(TSDestroy(&ref));
+  PetscCall(MatDestroy(&Jref));
+  PetscCall(DMDestroy(&daref));
+  PetscCall(TSDestroy(&ts));
+  PetscCall(VecDestroy(&v));
+  PetscCall(VecDestroy(&u));
+  PetscCall(MatDestroy(&J));
+  PetscCall(DMDestroy(&da));
+  PetscCallMPI(MPI_Comm_free(&tcomm));
+  PetscCallMPI(MPI_Comm_free(&scomm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -nslices 8 -ts_parareal_tol 1e-3 -ts_monitor
+
+   test:
+      suffix: 2
+      nsize: {{2 4}}
+      args: -nt 2 -nslices 8 -ts_parareal_tol 1e-3 -implicit {{0 1}}
+      output_file: output/ex36_2.out
+
+   test:
+      suffix: fcf
+      nsize: 2
+      args: -nt 2 -ts_parareal_fcf -ts_parareal_tol 1e-10
+      output_file: output/ex36_fcf.out
+
+   test:
+      suffix: arkimex
+      nsize: 4
+      args: -nt 4 -nslices 8 -implicit -parareal_fine_ts_type arkimex -parareal_fine_ts_adapt_type none -parareal_fine_ksp_rtol 1e-10 -ref_ts_adapt_type none -ref_ksp_rtol 1e-10 -ts_parareal_coarsening_factor 2 -ts_parareal_tol 1e-4
+
+TEST*/
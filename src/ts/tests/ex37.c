@@ -0,0 +1,255 @@
+static char help[] = "Tests TSBATCH on an ensemble of Van der Pol oscillators with different stiffness parameters.\n\
+Input parameters include:\n\
+  -n <n>        : number of instances\n\
+  -fd           : compute the Jacobians by finite differences\n\
+  -adaptive     : compare with a tight-tolerance integration instead of fixed steps\n\n";
+
+#include <petscts.h>
+
+typedef struct {
+  PetscInt   n;  /* number of local instances */
+  PetscReal *mu; /* stiffness parameter of each local instance */
+} Ensemble;
+
+/* u_0' = u_1, u_1' = mu ((1 - u_0^2) u_1 - u_0), for all instances at once */
+static PetscErrorCode BatchRHSFunction(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], PetscScalar f[], void *ctx)
+{
+  Ensemble *e = (Ensemble *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt i = 0; i < n; i++) {
+    f[i]     = u[n + i];
+    f[n + i] = e->mu[i] * ((1.0 - u[i] * u[i]) * u[n + i] - u[i]);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BatchRHSJacobian(TS ts, PetscInt n, const PetscReal t[], const PetscScalar u[], PetscScalar J[], void *ctx)
+{
+  Ensemble *e = (Ensemble *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt i = 0; i < n; i++) {
+    J[0 * n + i] = 0.0;
+    J[1 * n + i] = 1.0;
+    J[2 * n + i] = -e->mu[i] * (2.0 * u[i] * u[n + i] + 1.0);
+    J[3 * n + i] = e->mu[i] * (1.0 - u[i] * u[i]);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The same system for a single instance, for the standard integrators */
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec U, Vec F, void *ctx)
+{
+  PetscReal         *mu = (PetscReal *)ctx;
+  const PetscScalar *u;
+  PetscScalar       *f;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetArrayRead(U, &u));
+  PetscCall(VecGetArray(F, &f));
+  f[0] = u[1];
+  f[1] = *mu * ((1.0 - u[0] * u[0]) * u[1] - u[0]);
+  PetscCall(VecRestoreArray(F, &f));
+  PetscCall(VecRestoreArrayRead(U, &u));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec U, Mat A, Mat B, void *ctx)
+{
+  PetscReal         *mu = (PetscReal *)ctx;
+  const PetscScalar *u;
+  PetscInt           rows[2] = {0, 1};
+  PetscScalar        J[4];
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetArrayRead(U, &u));
+  J[0] = 0.0;
+  J[1] = 1.0;
+  J[2] = -*mu * (2.0 * u[0] * u[1] + 1.0);
+  J[3] = *mu * (1.0 - u[0] * u[0]);
+  PetscCall(VecRestoreArrayRead(U, &u));
+  PetscCall(MatSetValues(B, 2, rows, 2, rows, J, INSERT_VALUES));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The implicit form, since TSROSW treats the right hand side as nonstiff */
+static PetscErrorCode IFunction(TS ts, PetscReal t, Vec U, Vec Udot, Vec F, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(RHSFunction(ts, t, U, F, ctx));
+  PetscCall(VecAYPX(F, -1.0, Udot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode IJacobian(TS ts, PetscReal t, Vec U, Vec Udot, PetscReal shift, Mat A, Mat B, void *ctx)
+{
+  PetscFunctionBeginUser;
+  PetscCall(RHSJacobian(ts, t, U, A, B, ctx));
+  PetscCall(MatScale(B, -1.0));
+  PetscCall(MatShift(B, shift));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  TS                 ts;
+  Vec                u;
+  Ensemble           e;
+  PetscInt           N = 16, n = PETSC_DECIDE, rstart;
+  PetscReal          tf = 2.0, dt = 0.01, err = 0.0, tol, time;
+  PetscBool          fd = PETSC_FALSE, adaptive = PETSC_FALSE;
+  const PetscScalar *x;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &N, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-fd", &fd, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-adaptive", &adaptive, NULL));
+  PetscCall(PetscSplitOwnership(PETSC_COMM_WORLD, &n, &N));
+  PetscCallMPI(MPI_Scan(&n, &rstart, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  rstart -= n;
+
+  /* Instance i starts at (2, 0) with mu = 1 + i, its state is interleaved with the others */
+  e.n = n;
+  PetscCall(PetscMalloc1(n, &e.mu));
+  for (PetscInt i = 0; i < n; i++) e.mu[i] = 1.0 + rstart + i;
+  PetscCall(VecCreateMPI(PETSC_COMM_WORLD, 2 * n, PETSC_DETERMINE, &u));
+  PetscCall(VecSet(u, 0.0));
+  {
+    PetscScalar *y;
+
+    PetscCall(VecGetArray(u, &y));
+    for (PetscInt i = 0; i < n; i++) y[i] = 2.0;
+    PetscCall(VecRestoreArray(u, &y));
+  }
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetType(ts, TSBATCH));
+  PetscCall(TSBatchSetSystemSize(ts, 2));
+  PetscCall(TSBatchSetRHSFunction(ts, BatchRHSFunction, &e));
+  if (!fd) PetscCall(TSBatchSetRHSJacobian(ts, BatchRHSJacobian, &e));
+  PetscCall(TSSetMaxTime(ts, tf));
+  PetscCall(TSSetTimeStep(ts, dt));
+  PetscCall(TSSetMaxSteps(ts, 100000));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetTolerances(ts, 1e-6, NULL, 1e-6, NULL));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSSolve(ts, u));
+  PetscCall(TSGetSolveTime(ts, &time));
+
+  /* Each instance integrated by itself, with the same method and fixed steps or with a tight tolerance */
+  PetscCall(VecGetArrayRead(u, &x));
+  for (PetscInt i = 0; i < n; i++) {
+    TS        ref;
+    Vec       v;
+    Mat       J;
+    char      type[256] = TSRK3BS;
+    PetscBool rosw;
+
+    PetscCall(VecCreateSeq(PETSC_COMM_SELF, 2, &v));
+    PetscCall(VecSetValue(v, 0, 2.0, INSERT_VALUES));
+    PetscCall(VecSetValue(v, 1, 0.0, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(v));
+    PetscCall(VecAssemblyEnd(v));
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF, 2, 2, NULL, &J));
+    PetscCall(TSCreate(PETSC_COMM_SELF, &ref));
+    PetscCall(TSSetOptionsPrefix(ref, "ref_"));
+    PetscCall(TSSetMaxTime(ref, tf));
+    PetscCall(TSSetTimeStep(ref, dt));
+    PetscCall(TSSetMaxSteps(ref, 1000000));
+    PetscCall(TSSetExactFinalTime(ref, TS_EXACTFINALTIME_MATCHSTEP));
+    PetscCall(PetscOptionsGetString(NULL, NULL, "-ts_batch_rosw_type", type, sizeof(type), &rosw));
+    if (adaptive) {
+      PetscCall(TSSetRHSFunction(ref, NULL, RHSFunction, &e.mu[i]));
+      PetscCall(TSSetType(ref, TSRK));
+      PetscCall(TSRKSetType(ref, TSRK5DP));
+      PetscCall(TSSetTolerances(ref, 1e-12, NULL, 1e-12, NULL));
+    } else {
+      TSAdapt adapt;
+
+      if (rosw) {
+        SNES snes;
+        KSP  ksp;
+        PC   pc;
+
+        PetscCall(TSSetIFunction(ref, NULL, IFunction, &e.mu[i]));
+        PetscCall(TSSetIJacobian(ref, J, J, IJacobian, &e.mu[i]));
+        PetscCall(TSSetType(ref, TSROSW));
+        PetscCall(TSRosWSetType(ref, type));
+        PetscCall(TSGetSNES(ref, &snes));
+        PetscCall(SNESGetKSP(snes, &ksp));
+        PetscCall(KSPSetType(ksp, KSPPREONLY));
+        PetscCall(KSPGetPC(ksp, &pc));
+        PetscCall(PCSetType(pc, PCLU));
+      } else {
+        PetscCall(TSSetRHSFunction(ref, NULL, RHSFunction, &e.mu[i]));
+        PetscCall(PetscOptionsGetString(NULL, NULL, "-ts_batch_rk_type", type, sizeof(type), NULL));
+        PetscCall(TSSetType(ref, TSRK));
+        PetscCall(TSRKSetType(ref, type));
+      }
+      PetscCall(TSGetAdapt(ref, &adapt));
+      PetscCall(TSAdaptSetType(adapt, TSADAPTNONE));
+    }
+    PetscCall(TSSetFromOptions(ref));
+    PetscCall(TSSolve(ref, v));
+    {
+      const PetscScalar *y;
+
+      PetscCall(VecGetArrayRead(v, &y));
+      for (PetscInt j = 0; j < 2; j++) err = PetscMax(err, PetscAbsScalar(x[j * n + i] - y[j]) / (1.0 + PetscAbsScalar(y[j])));
+      PetscCall(VecRestoreArrayRead(v, &y));
+    }
+    PetscCall(TSDestroy(&ref));
+    PetscCall(MatDestroy(&J));
+    PetscCall(VecDestroy(&v));
+  }
+  PetscCall(VecRestoreArrayRead(u, &x));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &err, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+  /* with fixed steps the difference is round-off, or the error of the finite difference Jacobian, with adaptive steps the instances
+     integrated one by one take different steps and the difference is bounded by the error tolerances of the adaptor */
+  tol = adaptive ? 1e-4 : (fd ? 1e-6 : 1e-10);
+  if (PetscAbsReal(time - tf) < 1e-12) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "All instances at the final time: yes\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "All instances at the final time: no, stopped at %g\n", (double)time));
+  if (err < tol) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Maximum relative difference to the instance by instance integration: < %g\n", (double)tol));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Maximum relative difference to the instance by instance integration: %.1e\n", (double)err));
+
+  PetscCall(TSDestroy(&ts));
+  PetscCall(VecDestroy(&u));
+  PetscCall(PetscFree(e.mu));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: rk
+      args: -ts_adapt_type none -ts_batch_rk_type {{3bs 4 5dp}}
+      output_file: output/ex37_1.out
+
+   test:
+      suffix: rosw
+      args: -ts_adapt_type none -ts_batch_rosw_type {{ra34pw2 rodas3 sandu3}}
+      output_file: output/ex37_1.out
+
+   test:
+      suffix: rosw_fd
+      args: -ts_adapt_type none -ts_batch_rosw_type {{ra34pw2 rodas3 sandu3}} -fd
+      output_file: output/ex37_rosw_fd.out
+
+   test:
+      suffix: adaptive
+      nsize: {{1 2}}
+      args: -adaptive -n 15 -ts_batch_rk_type 5dp
+      output_file: output/ex37_adaptive.out
+
+   test:
+      suffix: adaptive_rosw
+      nsize: {{1 2}}
+      args: -adaptive -n 15 -ts_batch_rosw_type ra34pw2
+      output_file: output/ex37_adaptive_rosw.out
+
+TEST*/
@@ -34,7 +34,8 @@ typedef enum {
   REVOLVE_OFFLINE,
   REVOLVE_ONLINE,
   REVOLVE_MULTISTAGE,
-  CAMS_OFFLINE
+  CAMS_OFFLINE,
+  MULTILEVEL_OFFLINE
 } SchedulerType;
 
 typedef enum {
@@ -47,17 +48,32 @@ typedef enum {
 typedef enum {
   TJ_REVOLVE,
   TJ_CAMS,
-  TJ_PETSC
+  TJ_PETSC,
+  TJ_MULTILEVEL
 } TSTrajectoryMemoryType;
-static const char *const TSTrajectoryMemoryTypes[] = {"REVOLVE", "CAMS", "PETSC", "TSTrajectoryMemoryType", "TJ_", NULL};
+static const char *const TSTrajectoryMemoryTypes[] = {"REVOLVE", "CAMS", "PETSC", "MULTILEVEL", "TSTrajectoryMemoryType", "TJ_", NULL};
+
+typedef enum {
+  TJ_COMPRESSION_NONE,
+  TJ_COMPRESSION_LOSSLESS,
+  TJ_COMPRESSION_LOSSY
+} TSTrajectoryMemoryCompressionType;
+static const char *const TSTrajectoryMemoryCompressionTypes[] = {"NONE", "LOSSLESS", "LOSSY", "TSTrajectoryMemoryCompressionType", "TJ_COMPRESSION_", NULL};
 
 #define HaveSolution(m) ((m) == SOLUTIONONLY || (m) == SOLUTION_STAGES)
 #define HaveStages(m)   ((m) == STAGESONLY || (m) == SOLUTION_STAGES)
 
+/* A compressed stage vector, see StageEncode() */
+typedef struct {
+  size_t         size;
+  unsigned char *data;
+} CompressedVec;
+
 typedef struct _StackElement {
   PetscInt       stepnum;
   Vec            X;
   Vec           *Y;
+  CompressedVec *Yc; /* replaces Y when the stages are compressed */
   PetscReal      time;
   PetscReal      timeprev; /* for no solution_only mode */
   PetscReal      timenext; /* for solution_only mode */
@@ -91,6 +107,25 @@ typedef struct _CAMSCTX {
 } CAMSCTX;
 #endif
 
+/* A checkpoint of the multilevel schedule, with the number of free slots left for the checkpoints placed after it on the same level */
+typedef struct {
+  PetscInt  stepnum;
+  PetscBool disk;
+  PetscInt  nfree;
+} MLCheckpoint;
+
+typedef struct _MultilevelCTX {
+  PetscInt      m;                 /* the disk checkpoints are placed on multiples of m steps */
+  PetscInt      nlen, nlevels;     /* number of segment lengths and of disk capacities tabulated */
+  PetscInt     *splitA, *splitB;   /* first disk checkpoint of the segments of length k*m and total_steps-k*m, in units of m, 0 for none */
+  PetscBool     rootdisk;          /* the initial condition is stored on disk */
+  PetscReal     cost;              /* predicted cost of the adjoint sweep, in time steps */
+  MLCheckpoint *cps;               /* active checkpoints, by increasing step number */
+  PetscInt      top, maxcps;
+  PetscInt      next;              /* next checkpoint of the forward sweep */
+  PetscBool     nextdisk;
+} MultilevelCTX;
+
 typedef struct _Stack {
   PetscInt      stacksize;
   PetscInt      top;
@@ -99,6 +134,14 @@ typedef struct _Stack {
   PetscInt      numY;
   PetscBool     solution_only;
   PetscBool     use_dram;
+  /* compression of the stages */
+  TSTrajectoryMemoryCompressionType compression;
+  PetscReal                         compression_tol; /* absolute error bound for lossy compression */
+  PetscInt                          nreal;           /* local number of reals in a stage */
+  PetscReal                        *rec[2];          /* decoded values of the last two stages compressed */
+  unsigned char                    *cbuf;            /* encoding buffer */
+  Vec                              *Ywork;           /* decompressed stages */
+  PetscLogDouble                    bytes_raw, bytes_stored;
 } Stack;
 
 typedef struct _DiskStack {
@@ -107,6 +150,31 @@ typedef struct _DiskStack {
   PetscInt *container;
 } DiskStack;
 
+/* Checkpoints serialized for asynchronous disk I/O, see PackRecord() */
+typedef struct {
+  unsigned char *data;
+  size_t         size, alloc;
+} TJBuffer;
+
+/* Local extent of a checkpoint file written with asynchronous I/O */
+typedef struct {
+  PetscBool  stack; /* TS-STACK or TS-CPS file */
+  PetscInt   id;
+  MPI_Offset offset;
+  size_t     size;
+} TJDiskFile;
+
+/* A pending write or prefetch */
+typedef struct {
+  PetscBool stack, active;
+  PetscInt  id;
+  TJBuffer  buf;
+#if defined(PETSC_HAVE_MPIIO)
+  MPI_File    fh;
+  MPI_Request req;
+#endif
+} TJDiskIO;
+
 typedef struct _TJScheduler {
   SchedulerType          stype;
   TSTrajectoryMemoryType tj_memory_type;
@@ -130,6 +198,13 @@ typedef struct _TJScheduler {
   Stack       stack;
   DiskStack   diskstack;
   PetscViewer viewer;
+  PetscBool   async_io;         /* write and prefetch disk checkpoints in the background */
+  TJDiskIO    wio, rio;         /* pending write and prefetch */
+  PetscInt    nfiles, maxfiles; /* checkpoint files written */
+  TJDiskFile *files;
+
+  MultilevelCTX *mctx;
+  PetscReal      disk_write_cost, disk_read_cost; /* in time steps */
 } TJScheduler;
 
 static PetscErrorCode TurnForwardWithStepsize(TS ts, PetscReal nextstepsize)
@@ -163,11 +238,204 @@ static PetscErrorCode TurnBackward(TS ts)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack, StackElement *e)
+/*
+  Stages are encoded one real at a time against a reference, the decoded previous stage of the same checkpoint, as a 64-bit word:
+  the exclusive or of the bits of the two reals for lossless compression, or the zigzag-encoded number of quantization steps between
+  them for lossy compression. Only the nonzero low-order bytes of each word are stored, with their count held in a 4-bit header.
+  Consecutive stages of a step are close, so that most words have few significant bytes.
+
+  Layout: mode byte, quantization step (lossy only), (n + 1) / 2 header bytes, payload. Encodings which would not be smaller than the
+  data are replaced by the raw data, after the mode byte.
+*/
+#define TJ_CODEC_RAW       0
+#define TJ_CODEC_XOR       1
+#define TJ_CODEC_QUANTIZED 2
+
+static inline PetscReal Dequantize(PetscReal ref, PetscReal step, int64_t q)
+{
+  return ref + step * (PetscReal)q;
+}
+
+/* Returns the size of the encoding of y, or 0 if raw data should be stored instead; rec holds the values decoding will give */
+static size_t StageEncode(PetscInt n, const PetscReal y[], const PetscReal ref[], PetscReal step, unsigned char *out, PetscReal rec[])
+{
+  const size_t   raw   = (size_t)n * sizeof(PetscReal);
+  const size_t   hsize = 1 + (step > 0 ? sizeof(PetscReal) : 0) + (size_t)(n + 1) / 2;
+  unsigned char *nib   = out + hsize - (n + 1) / 2, *p = out + hsize;
+
+  if (hsize >= raw) return 0;
+  out[0] = step > 0 ? TJ_CODEC_QUANTIZED : TJ_CODEC_XOR;
+  if (step > 0) memcpy(out + 1, &step, sizeof(PetscReal));
+  memset(nib, 0, (n + 1) / 2);
+  for (PetscInt i = 0; i < n; ++i) {
+    const PetscReal r  = ref ? ref[i] : 0.0;
+    uint64_t        w  = 0;
+    int             nb = 0;
+
+    if (step > 0) {
+      const PetscReal d = (y[i] - r) / step;
+      int64_t         q;
+
+      if (!(PetscAbsReal(d) < 1.0e18)) return 0; /* also catches NaN and Inf */
+      q      = (int64_t)PetscFloorReal(d + 0.5);
+      w      = ((uint64_t)q << 1) ^ (uint64_t)(q >> 63);
+      rec[i] = Dequantize(r, step, q);
+    } else {
+      uint64_t a = 0, b = 0;
+
+      memcpy(&a, &y[i], sizeof(PetscReal));
+      memcpy(&b, &r, sizeof(PetscReal));
+      w      = a ^ b;
+      rec[i] = y[i];
+    }
+    for (uint64_t t = w; t; t >>= 8) ++nb;
+    if ((size_t)(p - out) + nb >= raw) return 0;
+    nib[i / 2] |= (unsigned char)(nb << (4 * (i % 2)));
+    for (int k = 0; k < nb; ++k) *p++ = (unsigned char)(w >> (8 * k));
+  }
+  return (size_t)(p - out);
+}
+
+static void StageDecode(PetscInt n, const unsigned char *in, const PetscReal ref[], PetscReal y[])
+{
+  const PetscBool      quantized = in[0] == TJ_CODEC_QUANTIZED ? PETSC_TRUE : PETSC_FALSE;
+  PetscReal            step      = 0.0;
+  const unsigned char *nib, *p;
+
+  if (in[0] == TJ_CODEC_RAW) {
+    memcpy(y, in + 1, (size_t)n * sizeof(PetscReal));
+    return;
+  }
+  if (quantized) memcpy(&step, in + 1, sizeof(PetscReal));
+  nib = in + 1 + (quantized ? sizeof(PetscReal) : 0);
+  p   = nib + (n + 1) / 2;
+  for (PetscInt i = 0; i < n; ++i) {
+    const PetscReal r  = ref ? ref[i] : 0.0;
+    const int       nb = (nib[i / 2] >> (4 * (i % 2))) & 0xF;
+    uint64_t        w  = 0;
+
+    for (int k = 0; k < nb; ++k) w |= (uint64_t)p[k] << (8 * k);
+    p += nb;
+    if (quantized) {
+      y[i] = Dequantize(r, step, (int64_t)(w >> 1) ^ -(int64_t)(w & 1));
+    } else {
+      uint64_t b = 0;
+
+      memcpy(&b, &r, sizeof(PetscReal));
+      b ^= w;
+      memcpy(&y[i], &b, sizeof(PetscReal));
+    }
+  }
+}
+
+static PetscErrorCode StackSetUpCompression(Stack *stack, Vec Y)
+{
+  PetscInt n;
+
+  PetscFunctionBegin;
+  if (stack->cbuf) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetLocalSize(Y, &n));
+  stack->nreal = n * (PetscInt)(sizeof(PetscScalar) / sizeof(PetscReal));
+  PetscCall(PetscMalloc3(stack->nreal, &stack->rec[0], stack->nreal, &stack->rec[1], stack->nreal * sizeof(PetscReal) + 1, &stack->cbuf));
+  PetscCall(VecDuplicateVecs(Y, stack->numY, &stack->Ywork));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CompressedVecSet(Stack *stack, CompressedVec *v, const unsigned char *data, size_t size)
+{
+  PetscFunctionBegin;
+  if (v->size != size) {
+    if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
+    PetscCall(PetscFree(v->data));
+    PetscCall(PetscMalloc1(size, &v->data));
+    if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
+    v->size = size;
+  }
+  PetscCall(PetscMemcpy(v->data, data, size));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Stores the stages Y in a checkpoint */
+static PetscErrorCode ElementSetStages(Stack *stack, StackElement e, Vec *Y)
+{
+  const PetscReal step = stack->compression == TJ_COMPRESSION_LOSSY ? 2.0 * stack->compression_tol : 0.0;
+
+  PetscFunctionBegin;
+  if (!stack->compression) {
+    for (PetscInt i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], e->Y[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!stack->numY) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(StackSetUpCompression(stack, Y[0]));
+  for (PetscInt i = 0; i < stack->numY; i++) {
+    const size_t       raw = (size_t)stack->nreal * sizeof(PetscReal);
+    const PetscScalar *y;
+    size_t             size;
+
+    PetscCall(VecGetArrayRead(Y[i], &y));
+    size = StageEncode(stack->nreal, (const PetscReal *)y, i ? stack->rec[(i - 1) % 2] : NULL, step, stack->cbuf, stack->rec[i % 2]);
+    if (!size) {
+      stack->cbuf[0] = TJ_CODEC_RAW;
+      PetscCall(PetscMemcpy(stack->cbuf + 1, y, raw));
+      PetscCall(PetscMemcpy(stack->rec[i % 2], y, raw));
+      size = raw + 1;
+    }
+    PetscCall(VecRestoreArrayRead(Y[i], &y));
+    PetscCall(CompressedVecSet(stack, &e->Yc[i], stack->cbuf, size));
+    stack->bytes_raw += raw;
+    stack->bytes_stored += size;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Copies the stages of a checkpoint into Y */
+static PetscErrorCode ElementGetStages(Stack *stack, StackElement e, Vec *Y)
+{
+  PetscFunctionBegin;
+  if (!stack->compression) {
+    for (PetscInt i = 0; i < stack->numY; i++) PetscCall(VecCopy(e->Y[i], Y[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (PetscInt i = 0; i < stack->numY; i++) {
+    const PetscScalar *ref = NULL;
+    PetscScalar       *y;
+
+    PetscCall(VecGetArrayWrite(Y[i], &y));
+    if (i) PetscCall(VecGetArrayRead(Y[i - 1], &ref));
+    StageDecode(stack->nreal, e->Yc[i].data, (const PetscReal *)ref, (PetscReal *)y);
+    if (i) PetscCall(VecRestoreArrayRead(Y[i - 1], &ref));
+    PetscCall(VecRestoreArrayWrite(Y[i], &y));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ElementDestroyStages(Stack *stack, StackElement e)
+{
+  PetscFunctionBegin;
+  if (e->Y) PetscCall(VecDestroyVecs(stack->numY, &e->Y));
+  if (e->Yc) {
+    for (PetscInt i = 0; i < stack->numY; i++) PetscCall(PetscFree(e->Yc[i].data));
+    PetscCall(PetscFree(e->Yc));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ElementCreateStages(TS ts, Stack *stack, StackElement e)
 {
-  Vec  X;
   Vec *Y;
 
+  PetscFunctionBegin;
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (!stack->numY) PetscFunctionReturn(PETSC_SUCCESS);
+  if (stack->compression) PetscCall(PetscCalloc1(stack->numY, &e->Yc));
+  else PetscCall(VecDuplicateVecs(Y[0], stack->numY, &e->Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack, StackElement *e)
+{
+  Vec X;
+
   PetscFunctionBegin;
   if (stack->top < stack->stacksize - 1 && stack->container[stack->top + 1]) {
     *e = stack->container[stack->top + 1];
@@ -176,11 +444,8 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
       PetscCall(VecDuplicate(X, &(*e)->X));
     }
     if (cptype == 1 && (*e)->X) PetscCall(VecDestroy(&(*e)->X));
-    if (HaveStages(cptype) && !(*e)->Y) {
-      PetscCall(TSGetStages(ts, &stack->numY, &Y));
-      if (stack->numY) PetscCall(VecDuplicateVecs(Y[0], stack->numY, &(*e)->Y));
-    }
-    if (cptype == 0 && (*e)->Y) PetscCall(VecDestroyVecs(stack->numY, &(*e)->Y));
+    if (HaveStages(cptype) && !(*e)->Y && !(*e)->Yc) PetscCall(ElementCreateStages(ts, stack, *e));
+    if (cptype == 0) PetscCall(ElementDestroyStages(stack, *e));
     (*e)->cptype = cptype;
     PetscFunctionReturn(PETSC_SUCCESS);
   }
@@ -190,10 +455,7 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
     PetscCall(TSGetSolution(ts, &X));
     PetscCall(VecDuplicate(X, &(*e)->X));
   }
-  if (HaveStages(cptype)) {
-    PetscCall(TSGetStages(ts, &stack->numY, &Y));
-    if (stack->numY) PetscCall(VecDuplicateVecs(Y[0], stack->numY, &(*e)->Y));
-  }
+  if (HaveStages(cptype)) PetscCall(ElementCreateStages(ts, stack, *e));
   if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
   stack->nallocated++;
   (*e)->cptype = cptype;
@@ -203,14 +465,13 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
 static PetscErrorCode ElementSet(TS ts, Stack *stack, StackElement *e, PetscInt stepnum, PetscReal time, Vec X)
 {
   Vec      *Y;
-  PetscInt  i;
   PetscReal timeprev;
 
   PetscFunctionBegin;
   if (HaveSolution((*e)->cptype)) PetscCall(VecCopy(X, (*e)->X));
   if (HaveStages((*e)->cptype)) {
     PetscCall(TSGetStages(ts, &stack->numY, &Y));
-    for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], (*e)->Y[i]));
+    PetscCall(ElementSetStages(stack, *e, Y));
   }
   (*e)->stepnum = stepnum;
   (*e)->time    = time;
@@ -229,7 +490,7 @@ static PetscErrorCode ElementDestroy(Stack *stack, StackElement e)
   PetscFunctionBegin;
   if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
   PetscCall(VecDestroy(&e->X));
-  if (e->Y) PetscCall(VecDestroyVecs(stack->numY, &e->Y));
+  PetscCall(ElementDestroyStages(stack, e));
   PetscCall(PetscFree(e));
   if (stack->use_dram) PetscCall(PetscMallocResetDRAM());
   stack->nallocated--;
@@ -289,6 +550,10 @@ static PetscErrorCode StackDestroy(Stack *stack)
   const PetscInt n = stack->nallocated;
 
   PetscFunctionBegin;
+  if (stack->cbuf) {
+    PetscCall(PetscFree3(stack->rec[0], stack->rec[1], stack->cbuf));
+    PetscCall(VecDestroyVecs(stack->numY, &stack->Ywork));
+  }
   if (!stack->container) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCheck(stack->top + 1 <= n, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Stack size does not match element counter %" PetscInt_FMT, n);
   for (PetscInt i = 0; i < n; i++) PetscCall(ElementDestroy(stack, stack->container[i]));
@@ -339,6 +604,253 @@ static PetscErrorCode ReadFromDisk(PetscBool stifflyaccurate, PetscInt *stepnum,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Asynchronous disk I/O: the checkpoints of a file are serialized into a buffer holding the local part of the vectors, which each
+  process writes to its own extent of the file with nonblocking MPI-IO. The write completes when the next file is written, or when
+  the file is needed again. When a file is read, the file of the previous stride, which the two-level schedules need next, is
+  prefetched. The extents are only kept in memory, so that these files can only be read back by the run that wrote them.
+*/
+static PetscErrorCode BufferAppend(TJBuffer *b, const void *data, size_t len)
+{
+  PetscFunctionBegin;
+  if (b->size + len > b->alloc) {
+    b->alloc = PetscMax(2 * b->alloc, b->size + len);
+    PetscCall(PetscRealloc(b->alloc, &b->data));
+  }
+  PetscCall(PetscMemcpy(b->data + b->size, data, len));
+  b->size += len;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BufferAppendVec(TJBuffer *b, Vec X)
+{
+  const PetscScalar *x;
+  PetscInt           n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(BufferAppend(b, x, (size_t)n * sizeof(PetscScalar)));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline void BufferRead(const unsigned char **p, void *data, size_t len)
+{
+  if (data) memcpy(data, *p, len);
+  *p += len;
+}
+
+/* Same content as WriteToDisk(), with compressed stages kept as they are and all stages stored */
+static PetscErrorCode PackRecord(Stack *stack, TJBuffer *b, PetscInt stepnum, PetscReal time, PetscReal timeprev, Vec X, Vec *Y, CompressedVec *Yc, CheckpointType cptype)
+{
+  const unsigned char raw = TJ_CODEC_RAW;
+
+  PetscFunctionBegin;
+  PetscCall(BufferAppend(b, &stepnum, sizeof(PetscInt)));
+  PetscCall(BufferAppend(b, &time, sizeof(PetscReal)));
+  PetscCall(BufferAppend(b, &timeprev, sizeof(PetscReal)));
+  if (HaveSolution(cptype)) PetscCall(BufferAppendVec(b, X));
+  if (HaveStages(cptype)) {
+    for (PetscInt i = 0; i < stack->numY; i++) {
+      if (Yc) {
+        PetscCall(BufferAppend(b, &Yc[i].size, sizeof(size_t)));
+        PetscCall(BufferAppend(b, Yc[i].data, Yc[i].size));
+      } else {
+        PetscInt n;
+        size_t   size;
+
+        PetscCall(VecGetLocalSize(Y[i], &n));
+        size = (size_t)n * sizeof(PetscScalar) + 1;
+        PetscCall(BufferAppend(b, &size, sizeof(size_t)));
+        PetscCall(BufferAppend(b, &raw, 1));
+        PetscCall(BufferAppendVec(b, Y[i]));
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Reads a record written by PackRecord(), with the stages going into either Y or Yc */
+static PetscErrorCode UnpackRecord(Stack *stack, const unsigned char **p, PetscInt *stepnum, PetscReal *time, PetscReal *timeprev, Vec X, Vec *Y, CompressedVec *Yc, CheckpointType cptype)
+{
+  PetscInt n;
+
+  PetscFunctionBegin;
+  BufferRead(p, stepnum, sizeof(PetscInt));
+  BufferRead(p, time, sizeof(PetscReal));
+  BufferRead(p, timeprev, sizeof(PetscReal));
+  if (HaveSolution(cptype)) {
+    PetscScalar *x;
+
+    PetscCall(VecGetLocalSize(X, &n));
+    PetscCall(VecGetArrayWrite(X, &x));
+    BufferRead(p, x, (size_t)n * sizeof(PetscScalar));
+    PetscCall(VecRestoreArrayWrite(X, &x));
+  }
+  if (HaveStages(cptype)) {
+    for (PetscInt i = 0; i < stack->numY; i++) {
+      size_t size;
+
+      BufferRead(p, &size, sizeof(size_t));
+      if (Yc) {
+        PetscCall(CompressedVecSet(stack, &Yc[i], *p, size));
+      } else if (Y) {
+        const PetscScalar *ref = NULL;
+        PetscScalar       *y;
+
+        PetscCall(VecGetLocalSize(Y[i], &n));
+        PetscCall(VecGetArrayWrite(Y[i], &y));
+        if (i) PetscCall(VecGetArrayRead(Y[i - 1], &ref));
+        StageDecode(n * (PetscInt)(sizeof(PetscScalar) / sizeof(PetscReal)), *p, (const PetscReal *)ref, (PetscReal *)y);
+        if (i) PetscCall(VecRestoreArrayRead(Y[i - 1], &ref));
+        PetscCall(VecRestoreArrayWrite(Y[i], &y));
+      }
+      BufferRead(p, NULL, size);
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DiskFileFind(TJScheduler *tjsch, PetscBool stack, PetscInt id, TJDiskFile **file)
+{
+  PetscFunctionBegin;
+  *file = NULL;
+  for (PetscInt f = 0; f < tjsch->nfiles; ++f)
+    if (tjsch->files[f].stack == stack && tjsch->files[f].id == id) *file = &tjsch->files[f];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DiskFileName(TSTrajectory tj, PetscBool stack, PetscInt id, char filename[])
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSNPrintf(filename, PETSC_MAX_PATH_LEN, stack ? "%s/TS-STACK%06" PetscInt_FMT ".bin" : "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Completes a pending write or prefetch, keeping its buffer */
+static PetscErrorCode DiskIOEnd(TJDiskIO *io)
+{
+  PetscFunctionBegin;
+  if (!io->active) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCallMPI(MPI_Wait(&io->req, MPI_STATUS_IGNORE));
+  PetscCallMPI(MPI_File_close(&io->fh));
+#endif
+  io->active = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DiskIOReset(TJDiskIO *io)
+{
+  PetscFunctionBegin;
+  PetscCall(DiskIOEnd(io));
+  PetscCall(PetscFree(io->buf.data));
+  io->buf.size  = 0;
+  io->buf.alloc = 0;
+  io->id        = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Starts writing a serialized file, taking ownership of the buffer */
+static PetscErrorCode DiskWrite(TSTrajectory tj, PetscBool stack, PetscInt id, TJBuffer *b)
+{
+  MPI_Comm comm = PetscObjectComm((PetscObject)tj);
+#if defined(PETSC_HAVE_MPIIO)
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  TJDiskFile  *file;
+  PetscInt64   size = (PetscInt64)b->size, offset = 0;
+  PetscMPIInt  rank, count;
+  char         filename[PETSC_MAX_PATH_LEN];
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCall(DiskIOReset(&tjsch->wio));
+  /* a prefetch of the previous version of this file is stale */
+  if (tjsch->rio.stack == stack && tjsch->rio.id == id) PetscCall(DiskIOReset(&tjsch->rio));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Exscan(&size, &offset, 1, MPIU_INT64, MPI_SUM, comm));
+  if (!rank) offset = 0;
+  PetscCall(DiskFileFind(tjsch, stack, id, &file));
+  if (!file) {
+    if (tjsch->nfiles == tjsch->maxfiles) {
+      tjsch->maxfiles = PetscMax(2 * tjsch->maxfiles, 8);
+      PetscCall(PetscRealloc(tjsch->maxfiles * sizeof(TJDiskFile), &tjsch->files));
+    }
+    file        = &tjsch->files[tjsch->nfiles++];
+    file->stack = stack;
+    file->id    = id;
+  }
+  file->offset = (MPI_Offset)offset;
+  file->size   = b->size;
+  PetscCall(DiskFileName(tj, stack, id, filename));
+  PetscCall(PetscMPIIntCast(size, &count));
+  PetscCallMPI(MPI_File_open(comm, filename, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &tjsch->wio.fh));
+  PetscCallMPI(MPI_File_iwrite_at(tjsch->wio.fh, file->offset, b->data, count, MPI_BYTE, &tjsch->wio.req));
+  tjsch->wio.stack  = stack;
+  tjsch->wio.id     = id;
+  tjsch->wio.buf    = *b;
+  tjsch->wio.active = PETSC_TRUE;
+  PetscCall(PetscMemzero(b, sizeof(TJBuffer)));
+#else
+  SETERRQ(comm, PETSC_ERR_SUP_SYS, "Asynchronous checkpoint I/O requires MPI-IO");
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Starts reading a file in the background */
+static PetscErrorCode DiskPrefetch(TSTrajectory tj, PetscBool stack, PetscInt id)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  TJDiskFile  *file;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscMPIInt count;
+  char        filename[PETSC_MAX_PATH_LEN];
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(DiskFileFind(tjsch, stack, id, &file));
+  if (!file || (tjsch->wio.stack == stack && tjsch->wio.id == id)) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCall(DiskIOReset(&tjsch->rio));
+  PetscCall(DiskFileName(tj, stack, id, filename));
+  PetscCall(PetscMPIIntCast(file->size, &count));
+  PetscCall(PetscMalloc1(file->size, &tjsch->rio.buf.data));
+  tjsch->rio.buf.size  = file->size;
+  tjsch->rio.buf.alloc = file->size;
+  PetscCallMPI(MPI_File_open(PetscObjectComm((PetscObject)tj), filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &tjsch->rio.fh));
+  PetscCallMPI(MPI_File_iread_at(tjsch->rio.fh, file->offset, tjsch->rio.buf.data, count, MPI_BYTE, &tjsch->rio.req));
+  tjsch->rio.stack  = stack;
+  tjsch->rio.id     = id;
+  tjsch->rio.active = PETSC_TRUE;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Gets the content of a file written by DiskWrite(), which the caller frees, then prefetches the file of the previous stride */
+static PetscErrorCode DiskRead(TSTrajectory tj, PetscBool stack, PetscInt id, TJBuffer *b)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  TJDiskIO    *io    = NULL;
+
+  PetscFunctionBegin;
+  if (tjsch->wio.stack == stack && tjsch->wio.id == id) io = &tjsch->wio; /* still in memory */
+  else if (tjsch->rio.stack == stack && tjsch->rio.id == id) io = &tjsch->rio;
+  if (!io) {
+    PetscCall(PetscInfo(tj, "Checkpoint file %" PetscInt_FMT " was not prefetched\n", id));
+    PetscCall(DiskPrefetch(tj, stack, id));
+    PetscCheck(tjsch->rio.stack == stack && tjsch->rio.id == id, PetscObjectComm((PetscObject)tj), PETSC_ERR_PLIB, "Checkpoint file %" PetscInt_FMT " was never written", id);
+    io = &tjsch->rio;
+  }
+  PetscCall(DiskIOEnd(io));
+  *b = io->buf;
+  PetscCall(PetscMemzero(&io->buf, sizeof(TJBuffer)));
+  io->id = -1;
+  if (id > 0) PetscCall(DiskPrefetch(tj, stack, id - 1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
 {
   Vec         *Y;
@@ -355,23 +867,43 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump stack id %" PetscInt_FMT " to file\n", id));
     PetscCall(PetscViewerASCIIPopTab(tj->monitor));
   }
+  ndumped = stack->top + 1;
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (tjsch->async_io) {
+    TJBuffer b = {NULL, 0, 0};
+
+    PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+    PetscCall(BufferAppend(&b, &ndumped, sizeof(PetscInt)));
+    for (PetscInt i = 0; i < ndumped; i++) {
+      e          = stack->container[i];
+      cptype_int = (PetscInt)e->cptype;
+      PetscCall(BufferAppend(&b, &cptype_int, sizeof(PetscInt)));
+      PetscCall(PackRecord(stack, &b, e->stepnum, e->time, e->timeprev, e->X, e->Y, e->Yc, e->cptype));
+      ts->trajectory->diskwrites++;
+    }
+    PetscCall(PackRecord(stack, &b, ts->steps, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, NULL, SOLUTION_STAGES));
+    PetscCall(DiskWrite(tj, PETSC_TRUE, id, &b));
+    PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+    ts->trajectory->diskwrites++;
+    for (PetscInt i = 0; i < ndumped; i++) PetscCall(StackPop(stack, &e));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
   PetscCall(PetscViewerSetUp(tjsch->viewer));
-  ndumped = stack->top + 1;
   PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &ndumped, 1, PETSC_INT));
   for (PetscInt i = 0; i < ndumped; i++) {
     e          = stack->container[i];
     cptype_int = (PetscInt)e->cptype;
     PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &cptype_int, 1, PETSC_INT));
     PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
-    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, e->X, e->Y, stack->numY, e->cptype, tjsch->viewer));
+    if (e->Yc) PetscCall(ElementGetStages(stack, e, stack->Ywork));
+    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, e->X, e->Yc ? stack->Ywork : e->Y, stack->numY, e->cptype, tjsch->viewer));
     PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
     ts->trajectory->diskwrites++;
     PetscCall(StackPop(stack, &e));
   }
   /* save the last step for restart, the last step is in memory when using single level schemes, but not necessarily the case for multi level schemes */
-  PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
   PetscCall(WriteToDisk(ts->stifflyaccurate, ts->steps, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, tjsch->viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
@@ -384,6 +916,7 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
   Vec         *Y;
   PetscInt     i, nloaded, cptype_int;
   StackElement e;
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
   PetscViewer  viewer;
   char         filename[PETSC_MAX_PATH_LEN];
 
@@ -393,6 +926,30 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load stack from file\n"));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (tjsch->async_io) {
+    TJBuffer             b;
+    const unsigned char *p;
+
+    PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    PetscCall(DiskRead(tj, PETSC_TRUE, id, &b));
+    p = b.data;
+    BufferRead(&p, &nloaded, sizeof(PetscInt));
+    for (i = 0; i < nloaded; i++) {
+      BufferRead(&p, &cptype_int, sizeof(PetscInt));
+      PetscCall(ElementCreate(ts, (CheckpointType)cptype_int, stack, &e));
+      PetscCall(StackPush(stack, e));
+      PetscCall(UnpackRecord(stack, &p, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, e->Yc, e->cptype));
+      ts->trajectory->diskreads++;
+    }
+    PetscCall(UnpackRecord(stack, &p, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, NULL, SOLUTION_STAGES));
+    PetscCall(PetscFree(b.data));
+    PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    ts->trajectory->diskreads++;
+    PetscCall(TurnBackward(ts));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (stack->compression && stack->numY) PetscCall(StackSetUpCompression(stack, Y[0]));
   PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
@@ -403,12 +960,15 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(ElementCreate(ts, (CheckpointType)cptype_int, stack, &e));
     PetscCall(StackPush(stack, e));
     PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-    PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, stack->numY, e->cptype, viewer));
+    if (e->Yc) {
+      PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, stack->Ywork, stack->numY, e->cptype, viewer));
+      if (ts->stifflyaccurate && HaveSolution(e->cptype)) PetscCall(VecCopy(e->X, stack->Ywork[stack->numY - 1]));
+      PetscCall(ElementSetStages(stack, e, stack->Ywork));
+    } else PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, stack->numY, e->cptype, viewer));
     PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
     ts->trajectory->diskreads++;
   }
   /* load the last step into TS */
-  PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
   PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
@@ -438,6 +998,27 @@ static PetscErrorCode StackLoadLast(TSTrajectory tj, TS ts, Stack *stack, PetscI
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (((TJScheduler *)tj->data)->async_io) {
+    TJBuffer             b;
+    const unsigned char *p;
+    PetscInt             nloaded, cptype_int;
+
+    /* the records have variable sizes, so that they are all read into TS, and the last one stays */
+    PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    PetscCall(DiskRead(tj, PETSC_TRUE, id, &b));
+    p = b.data;
+    BufferRead(&p, &nloaded, sizeof(PetscInt));
+    for (PetscInt i = 0; i < nloaded; i++) {
+      BufferRead(&p, &cptype_int, sizeof(PetscInt));
+      PetscCall(UnpackRecord(stack, &p, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, NULL, (CheckpointType)cptype_int));
+    }
+    PetscCall(UnpackRecord(stack, &p, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, NULL, SOLUTION_STAGES));
+    PetscCall(PetscFree(b.data));
+    PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    ts->trajectory->diskreads++;
+    PetscCall(TurnBackward(ts));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetSize(Y[0], &size));
   /* VecView writes to file two extra int's for class id and number of rows */
   off = -((stack->solution_only ? 0 : stack->numY) + 1) * (size * PETSC_BINARY_SCALAR_SIZE + 2 * PETSC_BINARY_INT_SIZE) - PETSC_BINARY_INT_SIZE - 2 * PETSC_BINARY_SCALAR_SIZE;
@@ -485,11 +1066,21 @@ static PetscErrorCode DumpSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
   PetscCall(TSGetStepNumber(ts, &stepnum));
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (tjsch->async_io) {
+    TJBuffer b = {NULL, 0, 0};
+
+    PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+    PetscCall(PackRecord(stack, &b, stepnum, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, NULL, SOLUTION_STAGES));
+    PetscCall(DiskWrite(tj, PETSC_FALSE, id, &b));
+    PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
+    ts->trajectory->diskwrites++;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
   PetscCall(PetscViewerSetUp(tjsch->viewer));
 
-  PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
   PetscCall(WriteToDisk(ts->stifflyaccurate, stepnum, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, tjsch->viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
@@ -509,11 +1100,24 @@ static PetscErrorCode LoadSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
     PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load a single point from file\n"));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
+  PetscCall(TSGetStages(ts, &stack->numY, &Y));
+  if (((TJScheduler *)tj->data)->async_io) {
+    TJBuffer             b;
+    const unsigned char *p;
+
+    PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    PetscCall(DiskRead(tj, PETSC_FALSE, id, &b));
+    p = b.data;
+    PetscCall(UnpackRecord(stack, &p, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, NULL, SOLUTION_STAGES));
+    PetscCall(PetscFree(b.data));
+    PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    ts->trajectory->diskreads++;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
   PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
   PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
-  PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
   PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
@@ -524,8 +1128,7 @@ static PetscErrorCode LoadSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
 
 static PetscErrorCode UpdateTS(TS ts, Stack *stack, StackElement e, PetscInt stepnum, PetscBool adjoint_mode)
 {
-  Vec     *Y;
-  PetscInt i;
+  Vec *Y;
 
   PetscFunctionBegin;
   /* In adjoint mode we do not need to copy solution if the stepnum is the same */
@@ -533,9 +1136,12 @@ static PetscErrorCode UpdateTS(TS ts, Stack *stack, StackElement e, PetscInt ste
   if (HaveStages(e->cptype)) {
     PetscCall(TSGetStages(ts, &stack->numY, &Y));
     if (e->stepnum && e->stepnum == stepnum) {
-      for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(e->Y[i], Y[i]));
+      PetscCall(ElementGetStages(stack, e, Y));
     } else if (ts->stifflyaccurate) {
-      PetscCall(VecCopy(e->Y[stack->numY - 1], ts->vec_sol));
+      if (e->Yc) {
+        PetscCall(ElementGetStages(stack, e, stack->Ywork));
+        PetscCall(VecCopy(stack->Ywork[stack->numY - 1], ts->vec_sol));
+      } else PetscCall(VecCopy(e->Y[stack->numY - 1], ts->vec_sol));
     }
   }
   if (adjoint_mode) {
@@ -1045,7 +1651,7 @@ static PetscErrorCode TSTrajectoryMemorySet_RON(TSTrajectory tj, TS ts, TJSchedu
 {
   Stack          *stack = &tjsch->stack;
   Vec            *Y;
-  PetscInt        i, store;
+  PetscInt        store;
   PetscReal       timeprev;
   StackElement    e;
   RevolveCTX     *rctx = tjsch->rctx;
@@ -1064,7 +1670,7 @@ static PetscErrorCode TSTrajectoryMemorySet_RON(TSTrajectory tj, TS ts, TJSchedu
       if (HaveSolution(e->cptype)) PetscCall(VecCopy(X, e->X));
       if (HaveStages(e->cptype)) {
         PetscCall(TSGetStages(ts, &stack->numY, &Y));
-        for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], e->Y[i]));
+        PetscCall(ElementSetStages(stack, e, Y));
       }
       e->stepnum = stepnum;
       e->time    = time;
@@ -1690,6 +2296,276 @@ static PetscErrorCode TSTrajectoryMemoryGet_AOF(TSTrajectory tj, TS ts, TJSchedu
 }
 #endif
 
+/*
+  Multilevel offline checkpointing with checkpoints in RAM and on disk, see Stumm and Walther, MultiStage approaches for optimal offline
+  checkpointing, SIAM J. Sci. Comput., 2009, and Aupy, Herrmann, Hovland and Robert, Optimal multistage algorithm for adjoint computation,
+  SIAM J. Sci. Comput., 2016.
+
+  Copies between the TS and RAM are free, writing a checkpoint to disk costs w and reading it r time steps. The number of steps recomputed
+  to reverse l steps from a checkpoint in RAM with c free RAM slots is T(l, c), given in closed form by the binomial schedule of revolve.
+  A segment of l steps starting at a disk checkpoint with d free disk slots is either reversed from a copy of that checkpoint in RAM, or
+  split by a disk checkpoint j steps further, which is reversed first:
+
+    D(l, d) = min(T(l, c_ram - 1), min_j j + w + D(l - j, d - 1) + r + D(j, d))
+
+  The disk checkpoints are restricted to multiples of m steps, with m chosen to keep the cost of this dynamic program modest for long
+  horizons. Only the segments starting at 0 and ending at a multiple of m, or starting at a multiple of m and ending at the last step,
+  are then needed.
+*/
+
+/* Binomial coefficient C(n, k), exact as long as it fits in the mantissa */
+static PetscReal MLBinomial(PetscInt n, PetscInt k)
+{
+  PetscReal b = 1.0;
+
+  if (k < 0 || k > n) return 0.0;
+  k = PetscMin(k, n - k);
+  for (PetscInt i = 1; i <= k; i++) b = b * (n - k + i) / i;
+  return b;
+}
+
+/* Smallest tau such that l <= C(s + tau, s) */
+static PetscInt MLRepetitions(PetscInt l, PetscInt s)
+{
+  PetscInt tau = 0;
+
+  while (MLBinomial(s + tau, s) < l) tau++;
+  return tau;
+}
+
+/* Recomputations of the binomial schedule reversing l steps from a checkpoint in RAM with c free RAM slots */
+static PetscReal MLRevolveCost(PetscInt l, PetscInt c)
+{
+  PetscInt tau;
+
+  if (l <= 1) return 0.0;
+  if (!c) return 0.5 * l * (l - 1);
+  tau = MLRepetitions(l, c + 1);
+  return (PetscReal)tau * l - MLBinomial(c + 1 + tau, tau - 1);
+}
+
+/* Distance to the next checkpoint of the binomial schedule reversing l >= 2 steps with c >= 1 free RAM slots */
+static PetscInt MLRevolveSplit(PetscInt l, PetscInt c)
+{
+  const PetscInt tau = MLRepetitions(l, c + 1);
+
+  return (PetscInt)PetscMin(MLBinomial(c + tau, c + 1), l - MLBinomial(c + tau - 1, c));
+}
+
+static PetscErrorCode MultilevelCreate(TSTrajectory tj, TJScheduler *tjsch)
+{
+  MultilevelCTX  *mctx;
+  const PetscInt  N = tjsch->total_steps, cram = tjsch->max_cps_ram, cdisk = PetscMax(tjsch->max_cps_disk, 0);
+  const PetscReal w = tjsch->disk_write_cost, r = tjsch->disk_read_cost;
+  PetscInt        kmax, K, m, nd;
+  PetscReal      *DA, *DB;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&mctx));
+  mctx->top    = -1;
+  mctx->next   = -1;
+  mctx->maxcps = cram + cdisk + 1;
+  PetscCall(PetscMalloc1(mctx->maxcps, &mctx->cps));
+  mctx->cost = MLRevolveCost(N, cram - 1);
+  if (cdisk) {
+    /* the dynamic program takes about nd * K^2 / 2 operations */
+    kmax = (PetscInt)PetscSqrtReal(2.0e7 / (PetscMin(cdisk, 1024) + 1));
+    kmax = PetscMax(PetscMin(kmax, 1024), 2);
+    m    = (N + kmax - 1) / kmax;
+    K    = (N + m - 1) / m;
+    nd   = PetscMin(cdisk - 1, K) + 1; /* more disk slots than multiples of m are useless */
+    PetscCall(PetscMalloc2(nd * K, &DA, nd * K, &DB));
+    PetscCall(PetscMalloc2(nd * K, &mctx->splitA, nd * K, &mctx->splitB));
+    for (PetscInt d = 0; d < nd; d++) {
+      PetscReal *A = DA + d * K, *B = DB + d * K;
+      PetscInt  *sA = mctx->splitA + d * K, *sB = mctx->splitB + d * K;
+
+      /* segments of k * m steps starting at a multiple of m */
+      A[0]  = 0.0;
+      sA[0] = 0;
+      for (PetscInt k = 1; k < K; k++) {
+        A[k]  = d ? DA[k] : MLRevolveCost(k * m, cram - 1);
+        sA[k] = 0;
+        for (PetscInt i = 1; d && i < k; i++) {
+          const PetscReal cost = i * m + w + A[k - i - K] + r + A[i];
+
+          if (cost < A[k]) {
+            A[k]  = cost;
+            sA[k] = i;
+          }
+        }
+      }
+      /* segments from k * m to the last step */
+      for (PetscInt k = 0; k < K; k++) {
+        B[k]  = d ? DB[k] : MLRevolveCost(N - k * m, cram - 1);
+        sB[k] = 0;
+        for (PetscInt i = 1; d && k + i < K; i++) {
+          const PetscReal cost = i * m + w + B[k + i - K] + r + A[i];
+
+          if (cost < B[k]) {
+            B[k]  = cost;
+            sB[k] = i;
+          }
+        }
+      }
+    }
+    if (w + DB[(nd - 1) * K] < mctx->cost) {
+      mctx->rootdisk = PETSC_TRUE;
+      mctx->cost     = w + DB[(nd - 1) * K];
+    }
+    mctx->m       = m;
+    mctx->nlen    = K;
+    mctx->nlevels = nd;
+    PetscCall(PetscFree2(DA, DB));
+  }
+  PetscCall(PetscInfo(tj, "Multilevel checkpointing of %" PetscInt_FMT " steps with %" PetscInt_FMT " checkpoints in RAM and %" PetscInt_FMT " on disk: predicted cost of %g time steps\n", N, cram, cdisk, (double)mctx->cost));
+  tjsch->mctx = mctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MultilevelDestroy(MultilevelCTX **mctx)
+{
+  PetscFunctionBegin;
+  if (!*mctx) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree((*mctx)->cps));
+  if ((*mctx)->nlevels) PetscCall(PetscFree2((*mctx)->splitA, (*mctx)->splitB));
+  PetscCall(PetscFree(*mctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The next checkpoint to take on the way from the last checkpoint to stepnum, -1 for none */
+static PetscErrorCode MultilevelPlan(TJScheduler *tjsch, PetscInt stepnum, PetscInt *next, PetscBool *disk)
+{
+  MultilevelCTX *mctx = tjsch->mctx;
+  MLCheckpoint  *cp   = &mctx->cps[mctx->top];
+  const PetscInt l    = stepnum - cp->stepnum;
+
+  PetscFunctionBegin;
+  *next = -1;
+  *disk = PETSC_FALSE;
+  if (l <= 1) PetscFunctionReturn(PETSC_SUCCESS);
+  if (cp->disk) {
+    const PetscInt d = PetscMin(cp->nfree, mctx->nlevels - 1);
+    PetscInt       j;
+
+    if (stepnum == tjsch->total_steps) j = mctx->splitB[d * mctx->nlen + cp->stepnum / mctx->m];
+    else {
+      PetscCheck(l % mctx->m == 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Segment of %" PetscInt_FMT " steps not on the grid of the disk checkpoints", l);
+      j = mctx->splitA[d * mctx->nlen + l / mctx->m];
+    }
+    if (!j) { /* reverse the segment from a copy of the checkpoint in RAM */
+      *next = cp->stepnum;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    *next = cp->stepnum + j * mctx->m;
+    *disk = PETSC_TRUE;
+  } else {
+    if (!cp->nfree) PetscFunctionReturn(PETSC_SUCCESS);
+    *next = cp->stepnum + MLRevolveSplit(l, cp->nfree);
+  }
+  if (*next == stepnum - 1) *next = -1; /* would be released right away */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Checkpoint the current state of the TS */
+static PetscErrorCode MultilevelStore(TSTrajectory tj, TS ts, TJScheduler *tjsch, PetscInt stepnum, PetscBool disk)
+{
+  MultilevelCTX *mctx  = tjsch->mctx;
+  Stack         *stack = &tjsch->stack;
+  MLCheckpoint  *cp, *prev = mctx->top >= 0 ? &mctx->cps[mctx->top] : NULL;
+  StackElement   e;
+
+  PetscFunctionBegin;
+  PetscCheck(mctx->top + 1 < mctx->maxcps, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Maximum number of checkpoints (%" PetscInt_FMT ") exceeded", mctx->maxcps);
+  cp          = &mctx->cps[++mctx->top];
+  cp->stepnum = stepnum;
+  cp->disk    = disk;
+  if (disk) cp->nfree = prev ? prev->nfree - 1 : tjsch->max_cps_disk - 1;
+  else cp->nfree = prev && !prev->disk ? prev->nfree - 1 : tjsch->max_cps_ram - 1;
+  if (tj->monitor) {
+    PetscCall(PetscViewerASCIIAddTab(tj->monitor, ((PetscObject)tj)->tablevel));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Store the checkpoint of step %" PetscInt_FMT " %s\n", stepnum, disk ? "on disk" : "in RAM"));
+    PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
+  }
+  if (disk) {
+    PetscCall(DumpSingle(tj, ts, stack, stepnum));
+  } else {
+    PetscCall(ElementCreate(ts, SOLUTIONONLY, stack, &e));
+    PetscCall(ElementSet(ts, stack, &e, stepnum, ts->ptime, ts->vec_sol));
+    e->timeprev = ts->ptime_prev; /* the time step is negative when copying a disk checkpoint of step 0 during the adjoint */
+    PetscCall(StackPush(stack, e));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSTrajectoryMemorySet_ML(TSTrajectory tj, TS ts, TJScheduler *tjsch, PetscInt stepnum, PetscReal time, Vec X)
+{
+  MultilevelCTX *mctx = tjsch->mctx;
+  PetscBool      disk = mctx->rootdisk;
+
+  PetscFunctionBegin;
+  if (tjsch->recompute) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ts->reason) {
+    PetscCheck(stepnum == tjsch->total_steps, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "The multilevel schedule was computed for %" PetscInt_FMT " steps but the forward run took %" PetscInt_FMT, tjsch->total_steps, stepnum);
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (stepnum) {
+    if (stepnum != mctx->next) PetscFunctionReturn(PETSC_SUCCESS);
+    disk = mctx->nextdisk;
+  }
+  do {
+    PetscCall(MultilevelStore(tj, ts, tjsch, stepnum, disk));
+    PetscCall(MultilevelPlan(tjsch, tjsch->total_steps, &mctx->next, &disk));
+  } while (mctx->next == stepnum);
+  mctx->nextdisk = disk;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSTrajectoryMemoryGet_ML(TSTrajectory tj, TS ts, TJScheduler *tjsch, PetscInt stepnum)
+{
+  MultilevelCTX *mctx  = tjsch->mctx;
+  Stack         *stack = &tjsch->stack;
+  MLCheckpoint  *cp;
+  StackElement   e;
+  PetscInt       cur, next;
+  PetscBool      disk;
+
+  PetscFunctionBegin;
+  if (ts->reason) PetscFunctionReturn(PETSC_SUCCESS);
+  if (stepnum == tjsch->total_steps) {
+    PetscCall(TurnBackward(ts));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  /* restore the last checkpoint */
+  cp  = &mctx->cps[mctx->top];
+  cur = cp->stepnum;
+  if (cp->disk) {
+    PetscCall(LoadSingle(tj, ts, stack, cp->stepnum));
+  } else {
+    PetscCall(StackTop(stack, &e));
+    PetscCall(UpdateTS(ts, stack, e, stepnum, PETSC_TRUE));
+  }
+  /* checkpoint the segment on the way to stepnum */
+  PetscCall(MultilevelPlan(tjsch, stepnum, &next, &disk));
+  while (next >= 0) {
+    if (next > cur) {
+      PetscCall(TurnForward(ts));
+      PetscCall(ReCompute(ts, tjsch, cur, next));
+      cur = next;
+    }
+    PetscCall(MultilevelStore(tj, ts, tjsch, next, disk));
+    PetscCall(MultilevelPlan(tjsch, stepnum, &next, &disk));
+  }
+  PetscCall(TurnForward(ts));
+  PetscCall(ReCompute(ts, tjsch, cur, stepnum));
+  /* release the checkpoints which are not needed any more */
+  while (mctx->top >= 0 && mctx->cps[mctx->top].stepnum >= stepnum - 1) {
+    if (!mctx->cps[mctx->top].disk) PetscCall(StackPop(stack, &e));
+    mctx->top--;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory tj, TS ts, PetscInt stepnum, PetscReal time, Vec X)
 {
   TJScheduler *tjsch = (TJScheduler *)tj->data;
@@ -1740,6 +2616,10 @@ static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory tj, TS ts, PetscInt st
     PetscCall(TSTrajectoryMemorySet_AOF(tj, ts, tjsch, stepnum, time, X));
     break;
 #endif
+  case MULTILEVEL_OFFLINE:
+    PetscCheck(tj->adjoint_solve_mode, PetscObjectComm((PetscObject)tj), PETSC_ERR_SUP, "Not implemented");
+    PetscCall(TSTrajectoryMemorySet_ML(tj, ts, tjsch, stepnum, time, X));
+    break;
   default:
     break;
   }
@@ -1795,6 +2675,10 @@ static PetscErrorCode TSTrajectoryGet_Memory(TSTrajectory tj, TS ts, PetscInt st
     PetscCall(TSTrajectoryMemoryGet_AOF(tj, ts, tjsch, stepnum));
     break;
 #endif
+  case MULTILEVEL_OFFLINE:
+    PetscCheck(tj->adjoint_solve_mode, PetscObjectComm((PetscObject)tj), PETSC_ERR_SUP, "Not implemented");
+    PetscCall(TSTrajectoryMemoryGet_ML(tj, ts, tjsch, stepnum));
+    break;
   default:
     break;
   }
@@ -1894,13 +2778,17 @@ PETSC_UNUSED static PetscErrorCode TSTrajectorySetUseDRAM(TSTrajectory tj, Petsc
 
    Input Parameters:
 +  tj - the `TSTrajectory` context
--  tj_memory_type - Revolve or CAMS
+-  tj_memory_type - Revolve, CAMS, PETSc or multilevel
 
    Options Database Key:
-.  -ts_trajectory_memory_type <tj_memory_type> - petsc, revolve, cams
+.  -ts_trajectory_memory_type <tj_memory_type> - petsc, revolve, cams, multilevel
 
    Level: intermediate
 
+   Note:
+   The multilevel schedule is computed by PETSc and places the checkpoints in RAM and on disk so as to minimize the recomputations plus
+   the cost of the disk transfers, see `TSTRAJECTORYMEMORY`.
+
 .seealso: [](chapter_ts), `TSTrajectory`, `TSTrajectorySetMaxUnitsRAM()`, `TSTrajectoryMemoryType`
 @*/
 PetscErrorCode TSTrajectoryMemorySetType(TSTrajectory tj, TSTrajectoryMemoryType tj_memory_type)
@@ -2024,8 +2912,19 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(TSTrajectory tj, PetscOp
     PetscCall(PetscOptionsBool("-ts_trajectory_use_dram", "Use DRAM for checkpointing", "TSTrajectorySetUseDRAM", tjsch->stack.use_dram, &tjsch->stack.use_dram, NULL));
     PetscCall(PetscOptionsEnum("-ts_trajectory_memory_type", "Checkpointing scchedule software to use", "TSTrajectoryMemorySetType", TSTrajectoryMemoryTypes, (PetscEnum)(int)(tjsch->tj_memory_type), &etmp, &flg));
     if (flg) PetscCall(TSTrajectoryMemorySetType(tj, (TSTrajectoryMemoryType)etmp));
+    PetscCall(PetscOptionsEnum("-ts_trajectory_memory_compression", "Compression of the stages in the checkpoints", "TSTRAJECTORYMEMORY", TSTrajectoryMemoryCompressionTypes, (PetscEnum)tjsch->stack.compression, (PetscEnum *)&tjsch->stack.compression, NULL));
+    PetscCall(PetscOptionsReal("-ts_trajectory_memory_compression_tol", "Absolute error bound of the lossy compression", "TSTRAJECTORYMEMORY", tjsch->stack.compression_tol, &tjsch->stack.compression_tol, NULL));
+    PetscCall(PetscOptionsBool("-ts_trajectory_memory_async_io", "Write and prefetch disk checkpoints asynchronously", "TSTRAJECTORYMEMORY", tjsch->async_io, &tjsch->async_io, NULL));
+    PetscCall(PetscOptionsReal("-ts_trajectory_memory_disk_write_cost", "Cost of writing a checkpoint to disk, in time steps", "TSTRAJECTORYMEMORY", tjsch->disk_write_cost, &tjsch->disk_write_cost, NULL));
+    PetscCall(PetscOptionsReal("-ts_trajectory_memory_disk_read_cost", "Cost of reading a checkpoint from disk, in time steps", "TSTRAJECTORYMEMORY", tjsch->disk_read_cost, &tjsch->disk_read_cost, NULL));
   }
   PetscOptionsHeadEnd();
+  PetscCheck(tjsch->stack.compression != TJ_COMPRESSION_LOSSY || tjsch->stack.compression_tol > 0.0, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_OUTOFRANGE, "Lossy compression requires -ts_trajectory_memory_compression_tol > 0");
+  PetscCheck(tjsch->stack.compression == TJ_COMPRESSION_NONE || sizeof(PetscReal) <= sizeof(int64_t), PetscObjectComm((PetscObject)tj), PETSC_ERR_SUP, "Compression of the stages is not available for this precision");
+  PetscCheck(tjsch->disk_write_cost >= 0.0 && tjsch->disk_read_cost >= 0.0, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_OUTOFRANGE, "The costs of the disk checkpoints cannot be negative");
+#if !defined(PETSC_HAVE_MPIIO)
+  PetscCheck(!tjsch->async_io, PetscObjectComm((PetscObject)tj), PETSC_ERR_SUP_SYS, "Asynchronous checkpoint I/O requires MPI-IO");
+#endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -2084,6 +2983,9 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
         case TJ_REVOLVE:
           tjsch->stype = (tjsch->max_cps_disk > 1) ? REVOLVE_MULTISTAGE : REVOLVE_OFFLINE;
           break;
+        case TJ_MULTILEVEL:
+          tjsch->stype = MULTILEVEL_OFFLINE;
+          break;
         default:
           break;
         }
@@ -2094,7 +2996,10 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 #endif
     PetscCheck(tjsch->stype == NONE || tjsch->max_cps_ram >= 1 || tjsch->max_cps_disk >= 1, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_INCOMP, "The specified storage capacity is insufficient for one checkpoint, which is the minimum");
   }
-  if (tjsch->stype >= CAMS_OFFLINE) {
+  if (tjsch->stype == MULTILEVEL_OFFLINE) {
+    PetscCheck(tjsch->max_cps_ram >= 1, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_INCOMP, "The multilevel schedule needs at least one checkpoint in RAM");
+    PetscCall(MultilevelCreate(tj, tjsch));
+  } else if (tjsch->stype == CAMS_OFFLINE) {
 #ifndef PETSC_HAVE_CAMS
     SETERRQ(PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "CAMS is needed when there is not enough memory to checkpoint all time steps according to the user's settings, please reconfigure with the additional option --download-cams.");
 #else
@@ -2194,8 +3099,20 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
     }
   }
 
-  if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE) { /* these types need to use disk */
+  if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE || (tjsch->stype == MULTILEVEL_OFFLINE && tjsch->max_cps_disk > 0)) { /* these types need to use disk */
     PetscCall(TSTrajectorySetUp_Basic(tj, ts));
+    if (tjsch->async_io) { /* every process opens the files */
+      char        dirname[PETSC_MAX_PATH_LEN];
+      PetscMPIInt rank;
+
+      PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)tj), &rank));
+      if (rank == 0) PetscCall(PetscStrncpy(dirname, tj->dirname, sizeof(dirname)));
+      PetscCallMPI(MPI_Bcast(dirname, sizeof(dirname), MPI_CHAR, 0, PetscObjectComm((PetscObject)tj)));
+      if (rank) {
+        PetscCall(PetscFree(tj->dirname));
+        PetscCall(PetscStrallocpy(dirname, &tj->dirname));
+      }
+    }
   }
 
   stack->stacksize = PetscMax(stack->stacksize, 1);
@@ -2206,13 +3123,21 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 
 static PetscErrorCode TSTrajectoryReset_Memory(TSTrajectory tj)
 {
-#if defined(PETSC_HAVE_REVOLVE) || defined(PETSC_HAVE_CAMS)
   TJScheduler *tjsch = (TJScheduler *)tj->data;
-#endif
+  Stack       *stack = &tjsch->stack;
 
   PetscFunctionBegin;
+  PetscCall(DiskIOReset(&tjsch->wio));
+  PetscCall(DiskIOReset(&tjsch->rio));
+  tjsch->nfiles = 0;
+  if (stack->bytes_raw > 0) {
+    PetscCall(PetscInfo(tj, "Compressed stages to %g%% of their size\n", 100.0 * stack->bytes_stored / stack->bytes_raw));
+    stack->bytes_raw    = 0;
+    stack->bytes_stored = 0;
+  }
+  PetscCall(MultilevelDestroy(&tjsch->mctx));
 #if defined(PETSC_HAVE_REVOLVE)
-  if (tjsch->stype > TWO_LEVEL_NOREVOLVE) {
+  if (tjsch->stype > TWO_LEVEL_NOREVOLVE && tjsch->stype != MULTILEVEL_OFFLINE) {
     revolve_reset();
     if (tjsch->stype == TWO_LEVEL_TWO_REVOLVE) {
       revolve2_reset();
@@ -2240,6 +3165,9 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 
   PetscFunctionBegin;
   PetscCall(StackDestroy(&tjsch->stack));
+  PetscCall(DiskIOReset(&tjsch->wio));
+  PetscCall(DiskIOReset(&tjsch->rio));
+  PetscCall(PetscFree(tjsch->files));
   PetscCall(PetscViewerDestroy(&tjsch->viewer));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsRAM_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsDisk_C", NULL));
@@ -2253,8 +3181,26 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 /*MC
       TSTRAJECTORYMEMORY - Stores each solution of the ODE/ADE in memory
 
+  Options Database Keys:
++ -ts_trajectory_memory_compression <none,lossless,lossy> - compress the stages stored in RAM against the previous stage of the same step
+. -ts_trajectory_memory_compression_tol <tol> - absolute error bound on each entry of the stages with lossy compression
+. -ts_trajectory_memory_async_io - write the disk checkpoints of the two-level schedules with nonblocking MPI-IO, and prefetch the checkpoints of the previous stride during the adjoint
+. -ts_trajectory_memory_disk_write_cost <w> - cost of writing a checkpoint to disk for the multilevel schedule, in time steps
+- -ts_trajectory_memory_disk_read_cost <r> - cost of reading a checkpoint from disk for the multilevel schedule, in time steps
+
   Level: intermediate
 
+  Notes:
+  Lossless compression stores the difference of each stage with the previous stage of the same step, which pays off when the stages
+  are close to each other, that is when the time steps are small. Lossy compression quantizes this difference.
+
+  Checkpoint files written with `-ts_trajectory_memory_async_io` can only be read back by the run that wrote them.
+
+  The multilevel schedule, selected with `-ts_trajectory_memory_type multilevel`, uses up to `-ts_trajectory_max_cps_ram` checkpoints in
+  RAM and `-ts_trajectory_max_cps_disk` checkpoints on disk, which only store the solution. It minimizes the number of recomputed steps
+  plus the cost of the disk transfers, assuming that copies from and to RAM are free. It requires a fixed time step. For long horizons,
+  the disk checkpoints are restricted to a grid of about a thousand points.
+
 .seealso: [](chapter_ts), `TSTrajectoryCreate()`, `TS`, `TSTrajectorySetType()`, `TSTrajectoryType`, `TSTrajectory`
 M*/
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
@@ -2277,7 +3223,11 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
 #if defined(PETSC_HAVE_REVOLVE)
   tjsch->use_online = PETSC_FALSE;
 #endif
-  tjsch->save_stack = PETSC_TRUE;
+  tjsch->save_stack      = PETSC_TRUE;
+  tjsch->wio.id          = -1;
+  tjsch->rio.id          = -1;
+  tjsch->disk_write_cost = 1.0;
+  tjsch->disk_read_cost  = 1.0;
 
   tjsch->stack.solution_only = tj->solution_only;
   PetscCall(PetscViewerCreate(PetscObjectComm((PetscObject)tj), &tjsch->viewer));
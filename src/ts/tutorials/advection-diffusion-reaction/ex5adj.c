@@ -226,6 +226,18 @@ PetscErrorCode InitialConditions(DM da, Vec U)
       args: -ts_max_steps 10 -implicitform 0 -ts_type rk -ts_rk_type 4 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -snes_fd_color
       output_file: output/ex5adj_1.out
 
+   test:
+      suffix: async
+      nsize: 2
+      args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only 0 -ts_trajectory_memory_async_io -ts_trajectory_memory_compression lossless
+      output_file: output/ex5adj_async.out
+
+   test:
+      suffix: multilevel
+      nsize: 2
+      args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -ts_trajectory_type memory -ts_trajectory_solution_only 0 -ts_trajectory_memory_type multilevel -ts_trajectory_max_cps_ram 2 -ts_trajectory_max_cps_disk 2 -ts_trajectory_memory_async_io {{0 1}}
+      output_file: output/ex5adj_multilevel.out
+
    test:
       suffix: knl
       args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -ts_trajectory_type memory -ts_trajectory_solution_only 0 -malloc_hbw -ts_trajectory_use_dram 1
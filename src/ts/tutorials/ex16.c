@@ -183,7 +183,7 @@ int main(int argc, char **argv)
   TS             ts; /* nonlinear solver */
   Vec            x;  /* solution, residual vectors */
   Mat            A;  /* Jacobian matrix */
-  PetscInt       steps;
+  PetscInt       steps, evals, shifts, reuses;
   PetscReal      ftime   = 0.5;
   PetscBool      monitor = PETSC_FALSE;
   PetscScalar   *x_ptr;
@@ -253,6 +253,8 @@ int main(int argc, char **argv)
   PetscCall(TSGetSolveTime(ts, &ftime));
   PetscCall(TSGetStepNumber(ts, &steps));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD, "mu %g, steps %" PetscInt_FMT ", ftime %g\n", (double)user.mu, steps, (double)ftime));
+  PetscCall(TSGetJacobianReuseCounts(ts, &evals, &shifts, &reuses));
+  if (evals) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Jacobian evaluations %" PetscInt_FMT ", shift updates %" PetscInt_FMT ", reuses %" PetscInt_FMT "\n", evals, shifts, reuses));
   PetscCall(VecView(x, PETSC_VIEWER_STDOUT_WORLD));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -273,4 +275,9 @@ int main(int argc, char **argv)
       args: -ts_type arkimex -ts_arkimex_type myark2 -ts_adapt_type none
       requires: !single
 
+    test:
+      suffix: jacreuse
+      args: -ts_type bdf -ts_jacobian_reuse -snes_rtol 1e-10
+      requires: !single
+
 TEST*/
@@ -213,11 +213,18 @@ int main(int argc, char **argv)
     test:
       requires: !single
       suffix: 2
-      args: -implicitform false -ts_type rk -ts_rk_type 5dp -ts_adapt_type dsp
+      args: -implicitform false -ts_type rk -ts_rk_type 5dp -ts_adapt_type dsp -ts_rk_fused {{0 1}}
+      output_file: output/ex20_2.out
 
     test:
       requires: !single
       suffix: 3
       args: -implicitform false -ts_type rk -ts_rk_type 5dp -ts_adapt_type dsp -ts_adapt_dsp_filter H0312
 
+    test:
+      requires: !single
+      suffix: 4
+      args: -implicitform false -ts_type rk -ts_rk_type 5dp -ts_adapt_wnormtype infinity -ts_atol 1e-8 -ts_rtol 1e-8 -ts_rk_fused {{0 1}}
+      output_file: output/ex20_4.out
+
 TEST*/
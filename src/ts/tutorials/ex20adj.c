@@ -539,4 +539,31 @@ int main(int argc, char **argv)
       suffix: 25
       args: -imexform -ts_max_steps 15 -ts_trajectory_type memory
       output_file: output/ex20adj_imex.out
+
+    # Compressed stages and asynchronous disk checkpoints must not change the adjoint: the lossless compression and the
+    # disk round trip are exact, and the lossy tolerance 1e-10 is well below the 6 digits printed, so 26-28 reuse ex20adj_2.out
+    test:
+      suffix: 26
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only 0 -ts_trajectory_save_stack {{0 1}} -ts_trajectory_memory_compression lossless -ts_trajectory_memory_async_io {{0 1}}
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 27
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_solution_only 0 -ts_trajectory_memory_compression lossy -ts_trajectory_memory_compression_tol 1e-10
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 28
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only -ts_trajectory_save_stack {{0 1}} -ts_trajectory_memory_async_io
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 29
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_type multilevel -ts_trajectory_max_cps_ram 2 -ts_trajectory_max_cps_disk {{0 3}}
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 30
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_solution_only -ts_trajectory_memory_type multilevel -ts_trajectory_max_cps_ram 2 -ts_trajectory_max_cps_disk 3 -ts_trajectory_memory_disk_read_cost 0.5 -ts_trajectory_monitor
+      output_file: output/ex20adj_multilevel.out
 TEST*/
@@ -4,6 +4,7 @@ Input parameters include:\n\
   -m <points>, where <points> = number of grid points\n\
   -time_dependent_rhs : Treat the problem as having a time-dependent right-hand side\n\
   -use_ifunc          : Use IFunction/IJacobian interface\n\
+  -use_split          : Provide dF/dUdot and dF/dU to TSSetIJacobianSplit() with the IFunction interface\n\
   -debug              : Activate debugging printouts\n\
   -nox                : Deactivate x-window graphics\n\n";
 
@@ -188,6 +189,23 @@ int main(int argc, char **argv)
     PetscCall(MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &J));
     PetscCall(TSSetIFunction(ts, NULL, IFunctionHeat, &appctx));
     PetscCall(TSSetIJacobian(ts, J, J, IJacobianHeat, &appctx));
+    flg = PETSC_FALSE;
+    PetscCall(PetscOptionsGetBool(NULL, NULL, "-use_split", &flg, NULL));
+    if (flg) {
+      Mat M, K;
+
+      /*
+         The Jacobian shift*I - A is formed by the TS from the identity and -A,
+         which share the nonzero pattern of J, instead of calling IJacobianHeat()
+      */
+      PetscCall(MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &M));
+      PetscCall(MatShift(M, 1.0));
+      PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &K));
+      PetscCall(MatScale(K, -1.0));
+      PetscCall(TSSetIJacobianSplit(ts, M, K, SAME_NONZERO_PATTERN));
+      PetscCall(MatDestroy(&M));
+      PetscCall(MatDestroy(&K));
+    }
     PetscCall(MatDestroy(&J));
 
     PetscCall(PetscObjectReference((PetscObject)A));
@@ -598,6 +616,28 @@ PetscErrorCode IJacobianHeat(TS ts, PetscReal t, Vec X, Vec Xdot, PetscReal s, M
       suffix: fischer_guess_3
       args: -nox -ts_type beuler -use_ifunc -ts_dt 0.0005 -ksp_guess_type fischer -ksp_guess_fischer_model 3,10 -pc_type none -ksp_converged_reason
 
+    test:
+      requires: !single
+      suffix: ijacobian_split
+      args: -nox -ts_type bdf -use_ifunc -ts_dt 0.0005 -ts_max_steps 20 -ts_ijacobian_split -ksp_converged_reason
+
+    test:
+      requires: !single
+      suffix: ijacobian_split_provided
+      args: -nox -ts_type bdf -use_ifunc -use_split -ts_dt 0.0005 -ts_max_steps 20 -ksp_converged_reason
+
+    test:
+      requires: !single
+      suffix: jacreuse
+      args: -nox -ts_type bdf -ts_max_steps 20 -ts_jacobian_reuse
+
+    # the Jacobian depends on the time, so it is evaluated at each request of the linear solve
+    test:
+      requires: !single
+      suffix: jacreuse_time_dependent
+      args: -nox -ts_type bdf -ts_max_steps 20 -ts_jacobian_reuse -time_dependent_rhs
+      filter: grep "Jacobian reuse"
+
     test:
       requires: !single
       suffix: stringview